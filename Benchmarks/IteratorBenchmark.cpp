@@ -0,0 +1,226 @@
+#include "FlowField.hpp"
+#include "GlobalBoundaryFactory.hpp"
+#include "Iterators.hpp"
+#include "MeshsizeFactory.hpp"
+#include "Threading.hpp"
+
+#include "Stencils/FGHStencil.hpp"
+#include "Stencils/RHSStencil.hpp"
+#include "Stencils/VelocityStencil.hpp"
+#include "Stencils/ObstacleStencil.hpp"
+#include "Stencils/MaxUStencil.hpp"
+#include "Stencils/ViscosityStencil.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <math.h>
+#include <vector>
+
+/** Compares the sweeps of the hot stencils through the virtual FieldIterator and through the
+ *  StaticFieldIterator on a 3D domain with a uniform mesh. Both iterators are threaded, as in the
+ *  simulation; the number of threads is taken from OMP_NUM_THREADS. Finally, the separate FGH,
+ *  global boundary FGH and RHS sweeps are compared with the FusedFieldIterator, and the separate
+ *  velocity, obstacle and max. velocity sweeps with the PostProjectionIterator.
+ *
+ *  Usage: IteratorBenchmark [cells per direction = 64] [sweeps = 10]
+ */
+
+static void initializeParameters(NSEOF::Parameters& parameters, int size) {
+    parameters.geometry.dim = 3;
+    parameters.geometry.sizeX = size;
+    parameters.geometry.sizeY = size;
+    parameters.geometry.sizeZ = size;
+    parameters.geometry.lengthX = 1.0;
+    parameters.geometry.lengthY = 1.0;
+    parameters.geometry.lengthZ = 1.0;
+    parameters.geometry.meshsizeType = NSEOF::Uniform;
+
+    for (int d = 0; d < 3; d++) {
+        parameters.parallel.localSize[d] = size;
+        parameters.parallel.firstCorner[d] = 0;
+
+        parameters.walls.vectorLeft[d] = 0.0;
+        parameters.walls.vectorRight[d] = 0.0;
+        parameters.walls.vectorBottom[d] = 0.0;
+        parameters.walls.vectorTop[d] = 0.0;
+        parameters.walls.vectorFront[d] = 0.0;
+        parameters.walls.vectorBack[d] = 0.0;
+    }
+
+    // A single subdomain of a cavity, with global boundaries on all sides
+    parameters.simulation.scenario = "cavity";
+    parameters.parallel.leftNb = -1;
+    parameters.parallel.rightNb = -1;
+    parameters.parallel.bottomNb = -1;
+    parameters.parallel.topNb = -1;
+    parameters.parallel.frontNb = -1;
+    parameters.parallel.backNb = -1;
+
+    parameters.flow.Re = 1000;
+    parameters.timestep.dt = 1e-3;
+    parameters.solver.gamma = 0.5;
+    parameters.environment.gx = 0.0;
+    parameters.environment.gy = 0.0;
+    parameters.environment.gz = 0.0;
+    parameters.turbulence.model = 0;
+    parameters.kernels.hugePages = false;
+
+    NSEOF::MeshsizeFactory::getInstance().initMeshsize(parameters);
+}
+
+static void initializeFlowField(NSEOF::FlowField& flowField) {
+    for (int k = 0; k < flowField.getCellsZ(); k++) {
+        for (int j = 0; j < flowField.getCellsY(); j++) {
+            for (int i = 0; i < flowField.getCellsX(); i++) {
+                for (int component = 0; component < 3; component++) {
+                    flowField.getVelocity().getComponent(component, i, j, k) = sin(0.1 * (i + 2 * j + 3 * k + component));
+                }
+
+                flowField.getPressure().getScalar(i, j, k) = cos(0.1 * (i + j + k));
+                flowField.getDistance().getScalar(i, j, k) = 1.0;
+            }
+        }
+    }
+}
+
+template <class IteratorType>
+static FLOAT measureCellsPerSecond(IteratorType& iterator, long cells, int sweeps) {
+    iterator.iterate(); // Warm-up
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int sweep = 0; sweep < sweeps; sweep++) {
+        iterator.iterate();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return cells * sweeps / elapsed.count();
+}
+
+template <class StencilType>
+static void benchmark(const std::string& name, NSEOF::FlowField& flowField, const NSEOF::Parameters& parameters, int sweeps) {
+    StencilType stencil(parameters);
+
+    NSEOF::FieldIterator<NSEOF::FlowField> virtualIterator(flowField, parameters, stencil, 0, 0, true);
+    NSEOF::StaticFieldIterator<NSEOF::FlowField, StencilType> staticIterator(flowField, parameters, stencil, 0, 0, true);
+
+    const long cells = static_cast<long>(flowField.getCellsX() - 2) * (flowField.getCellsY() - 2) * (flowField.getCellsZ() - 2);
+
+    const FLOAT virtualRate = measureCellsPerSecond(virtualIterator, cells, sweeps);
+    const FLOAT staticRate = measureCellsPerSecond(staticIterator, cells, sweeps);
+
+    std::cout << std::left << std::setw(12) << name << std::right << std::scientific << std::setprecision(3)
+              << std::setw(14) << virtualRate << std::setw(14) << staticRate
+              << std::fixed << std::setprecision(2) << std::setw(10) << staticRate / virtualRate << std::endl;
+}
+
+/** Runs several iterators one after the other, as Simulation does without kernel fusion
+ */
+class IteratorSequence : public NSEOF::Iterator<NSEOF::FlowField> {
+private:
+    std::vector<NSEOF::Iterator<NSEOF::FlowField>*> iterators_;
+
+public:
+    IteratorSequence(NSEOF::FlowField& flowField, const NSEOF::Parameters& parameters,
+                     std::vector<NSEOF::Iterator<NSEOF::FlowField>*> iterators)
+        : NSEOF::Iterator<NSEOF::FlowField>(flowField, parameters)
+        , iterators_(iterators) {}
+
+    void iterate() override {
+        for (NSEOF::Iterator<NSEOF::FlowField>* iterator : iterators_) {
+            iterator->iterate();
+        }
+    }
+};
+
+static void printFusedHeader() {
+    std::cout << std::endl << std::left << std::setw(12) << "Stencils" << std::right
+              << std::setw(14) << "separate [c/s]" << std::setw(14) << "fused [c/s]" << std::setw(10) << "speedup" << std::endl;
+}
+
+static void printFusedRow(const std::string& name, FLOAT separateRate, FLOAT fusedRate) {
+    std::cout << std::left << std::setw(12) << name << std::right << std::scientific << std::setprecision(3)
+              << std::setw(14) << separateRate << std::setw(14) << fusedRate
+              << std::fixed << std::setprecision(2) << std::setw(10) << fusedRate / separateRate << std::endl;
+}
+
+static void benchmarkFusedFGHRHS(NSEOF::FlowField& flowField, NSEOF::Parameters& parameters, int sweeps) {
+    NSEOF::Stencils::FGHStencil fghStencil(parameters);
+    NSEOF::Stencils::RHSStencil rhsStencil(parameters);
+
+    NSEOF::GlobalBoundaryFactory globalBoundaryFactory(parameters);
+    NSEOF::GlobalBoundaryIterator<NSEOF::FlowField> wallFGHIterator = globalBoundaryFactory.getGlobalBoundaryFGHIterator(flowField);
+
+    NSEOF::StaticFieldIterator<NSEOF::FlowField, NSEOF::Stencils::FGHStencil> fghIterator(flowField, parameters, fghStencil, 0, 0, true);
+    NSEOF::StaticFieldIterator<NSEOF::FlowField, NSEOF::Stencils::RHSStencil> rhsIterator(flowField, parameters, rhsStencil, 0, 0, true);
+    IteratorSequence separateIterator(flowField, parameters, {&fghIterator, &wallFGHIterator, &rhsIterator});
+
+    NSEOF::FusedFieldIterator<NSEOF::FlowField, NSEOF::Stencils::FGHStencil, NSEOF::Stencils::RHSStencil> fusedIterator(
+        flowField, parameters, fghStencil, rhsStencil, wallFGHIterator, true);
+
+    const long cells = static_cast<long>(flowField.getCellsX() - 2) * (flowField.getCellsY() - 2) * (flowField.getCellsZ() - 2);
+
+    const FLOAT separateRate = measureCellsPerSecond(separateIterator, cells, sweeps);
+    const FLOAT fusedRate = measureCellsPerSecond(fusedIterator, cells, sweeps);
+
+    printFusedRow("FGH+RHS", separateRate, fusedRate);
+}
+
+static void benchmarkPostProjection(NSEOF::FlowField& flowField, NSEOF::Parameters& parameters, int sweeps) {
+    NSEOF::Stencils::VelocityStencil velocityStencil(parameters);
+    NSEOF::Stencils::ObstacleStencil obstacleStencil(parameters);
+    NSEOF::Stencils::MaxUStencil maxUStencil(parameters);
+    maxUStencil.reset();
+
+    NSEOF::GlobalBoundaryFactory globalBoundaryFactory(parameters);
+    NSEOF::GlobalBoundaryIterator<NSEOF::FlowField> wallVelocityIterator = globalBoundaryFactory.getGlobalBoundaryVelocityIterator(flowField);
+    NSEOF::GlobalBoundaryIterator<NSEOF::FlowField> maxUBoundaryIterator(flowField, parameters, maxUStencil);
+
+    NSEOF::StaticFieldIterator<NSEOF::FlowField, NSEOF::Stencils::VelocityStencil> velocityIterator(flowField, parameters, velocityStencil, 0, 0, true);
+    NSEOF::StaticFieldIterator<NSEOF::FlowField, NSEOF::Stencils::ObstacleStencil> obstacleIterator(flowField, parameters, obstacleStencil, 0, 0, true);
+    NSEOF::StaticFieldIterator<NSEOF::FlowField, NSEOF::Stencils::MaxUStencil> maxUIterator(flowField, parameters, maxUStencil, 0, 0, true);
+    IteratorSequence separateIterator(flowField, parameters,
+                                      {&velocityIterator, &obstacleIterator, &wallVelocityIterator, &maxUIterator, &maxUBoundaryIterator});
+
+    NSEOF::PostProjectionIterator<NSEOF::FlowField, NSEOF::Stencils::VelocityStencil, NSEOF::Stencils::ObstacleStencil,
+                                  NSEOF::Stencils::MaxUStencil> postProjectionIterator(
+        flowField, parameters, velocityStencil, obstacleStencil, maxUStencil, true);
+    NSEOF::ShellFieldIterator<NSEOF::FlowField, NSEOF::Stencils::MaxUStencil> maxUShellIterator(flowField, parameters, maxUStencil);
+    IteratorSequence fusedIterator(flowField, parameters,
+                                   {&postProjectionIterator, &wallVelocityIterator, &maxUShellIterator, &maxUBoundaryIterator});
+
+    const long cells = static_cast<long>(flowField.getCellsX() - 2) * (flowField.getCellsY() - 2) * (flowField.getCellsZ() - 2);
+
+    const FLOAT separateRate = measureCellsPerSecond(separateIterator, cells, sweeps);
+    const FLOAT fusedRate = measureCellsPerSecond(fusedIterator, cells, sweeps);
+
+    printFusedRow("Velocity", separateRate, fusedRate);
+}
+
+int main(int argc, char* argv[]) {
+    const int size = argc > 1 ? atoi(argv[1]) : 64;
+    const int sweeps = argc > 2 ? atoi(argv[2]) : 10;
+
+    NSEOF::Parameters parameters;
+    initializeParameters(parameters, size);
+
+    NSEOF::FlowField flowField(parameters);
+    initializeFlowField(flowField);
+
+    std::cout << "Domain: " << size << "^3 cells, " << sweeps << " sweeps per measurement, "
+              << NSEOF::getMaxThreads() << " thread(s)" << std::endl;
+    std::cout << std::left << std::setw(12) << "Stencil" << std::right
+              << std::setw(14) << "virtual [c/s]" << std::setw(14) << "static [c/s]" << std::setw(10) << "speedup" << std::endl;
+
+    benchmark<NSEOF::Stencils::FGHStencil>("FGH", flowField, parameters, sweeps);
+    benchmark<NSEOF::Stencils::RHSStencil>("RHS", flowField, parameters, sweeps);
+    benchmark<NSEOF::Stencils::VelocityStencil>("Velocity", flowField, parameters, sweeps);
+    benchmark<NSEOF::Stencils::ObstacleStencil>("Obstacle", flowField, parameters, sweeps);
+    benchmark<NSEOF::Stencils::MaxUStencil>("MaxU", flowField, parameters, sweeps);
+    benchmark<NSEOF::Stencils::ViscosityStencil>("Viscosity", flowField, parameters, sweeps);
+
+    printFusedHeader();
+    benchmarkFusedFGHRHS(flowField, parameters, sweeps);
+    benchmarkPostProjection(flowField, parameters, sweeps);
+
+    return EXIT_SUCCESS;
+}
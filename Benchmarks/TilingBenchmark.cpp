@@ -0,0 +1,134 @@
+#include "FlowField.hpp"
+#include "Iterators.hpp"
+#include "MeshsizeFactory.hpp"
+#include "Threading.hpp"
+
+#include "Stencils/FGHStencil.hpp"
+#include "Stencils/TurbulentFGHStencil.hpp"
+#include "Stencils/ViscosityStencil.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <math.h>
+#include <vector>
+
+/** Compares the StaticFieldIterator with the TiledFieldIterator for the stencils reading three
+ *  k-planes of velocities, on cubic 3D domains of growing size. The tile sizes are selected from
+ *  the cache size, unless given. Both iterators are threaded; the number of threads is taken from
+ *  OMP_NUM_THREADS.
+ *
+ *  Usage: TilingBenchmark [sweeps = 5] [tile size x = auto] [tile size y = auto] [cells per direction ... = 64 128 256 512]
+ *
+ *  Mind the memory: a 512^3 flow field takes about 12 GB.
+ */
+
+static void initializeParameters(NSEOF::Parameters& parameters, int size) {
+    parameters.geometry.dim = 3;
+    parameters.geometry.sizeX = size;
+    parameters.geometry.sizeY = size;
+    parameters.geometry.sizeZ = size;
+    parameters.geometry.lengthX = 1.0;
+    parameters.geometry.lengthY = 1.0;
+    parameters.geometry.lengthZ = 1.0;
+    parameters.geometry.meshsizeType = NSEOF::Uniform;
+
+    for (int d = 0; d < 3; d++) {
+        parameters.parallel.localSize[d] = size;
+        parameters.parallel.firstCorner[d] = 0;
+    }
+
+    parameters.flow.Re = 1000;
+    parameters.timestep.dt = 1e-3;
+    parameters.solver.gamma = 0.5;
+    parameters.environment.gx = 0.0;
+    parameters.environment.gy = 0.0;
+    parameters.environment.gz = 0.0;
+    parameters.turbulence.model = 0;
+    parameters.kernels.hugePages = false;
+
+    NSEOF::MeshsizeFactory::getInstance().initMeshsize(parameters);
+}
+
+static void initializeFlowField(NSEOF::FlowField& flowField) {
+    for (int k = 0; k < flowField.getCellsZ(); k++) {
+        for (int j = 0; j < flowField.getCellsY(); j++) {
+            for (int i = 0; i < flowField.getCellsX(); i++) {
+                for (int component = 0; component < 3; component++) {
+                    flowField.getVelocity().getComponent(component, i, j, k) = sin(0.1 * (i + 2 * j + 3 * k + component));
+                }
+
+                flowField.getEddyViscosity().getScalar(i, j, k) = 1e-3 * (1.0 + cos(0.1 * (i + j + k)));
+                flowField.getDistance().getScalar(i, j, k) = 1.0;
+            }
+        }
+    }
+}
+
+template <class IteratorType>
+static FLOAT measureCellsPerSecond(IteratorType& iterator, long cells, int sweeps) {
+    iterator.iterate(); // Warm-up
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int sweep = 0; sweep < sweeps; sweep++) {
+        iterator.iterate();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return cells * sweeps / elapsed.count();
+}
+
+template <class StencilType>
+static void benchmark(const std::string& name, NSEOF::FlowField& flowField, const NSEOF::Parameters& parameters,
+                      int size, int tileSizeX, int tileSizeY, int sweeps) {
+    StencilType stencil(parameters);
+
+    NSEOF::StaticFieldIterator<NSEOF::FlowField, StencilType> staticIterator(flowField, parameters, stencil, 0, 0, true);
+    NSEOF::TiledFieldIterator<NSEOF::FlowField, StencilType> tiledIterator(flowField, parameters, stencil,
+                                                                          tileSizeX, tileSizeY, true);
+
+    const long cells = static_cast<long>(size) * size * size;
+
+    const FLOAT staticRate = measureCellsPerSecond(staticIterator, cells, sweeps);
+    const FLOAT tiledRate = measureCellsPerSecond(tiledIterator, cells, sweeps);
+
+    std::ostringstream tile;
+    tile << tiledIterator.getTileSizeX() << "x" << tiledIterator.getTileSizeY();
+
+    std::cout << std::setw(6) << size << "  " << std::left << std::setw(14) << name << std::right << std::setw(10) << tile.str()
+              << std::scientific << std::setprecision(3) << std::setw(14) << staticRate << std::setw(14) << tiledRate
+              << std::fixed << std::setprecision(2) << std::setw(10) << tiledRate / staticRate << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    const int sweeps = argc > 1 ? atoi(argv[1]) : 5;
+    const int tileSizeX = argc > 2 ? atoi(argv[2]) : 0;
+    const int tileSizeY = argc > 3 ? atoi(argv[3]) : 0;
+
+    std::vector<int> sizes;
+    for (int arg = 4; arg < argc; arg++) {
+        sizes.push_back(atoi(argv[arg]));
+    }
+    if (sizes.empty()) {
+        sizes = {64, 128, 256, 512};
+    }
+
+    std::cout << sweeps << " sweeps per measurement, " << NSEOF::getMaxThreads() << " thread(s), L2 cache "
+              << NSEOF::getL2CacheSize() / 1024 << " KiB" << std::endl;
+    std::cout << std::setw(6) << "Size" << "  " << std::left << std::setw(14) << "Stencil" << std::right << std::setw(10) << "Tile"
+              << std::setw(14) << "static [c/s]" << std::setw(14) << "tiled [c/s]" << std::setw(10) << "speedup" << std::endl;
+
+    for (const int size : sizes) {
+        NSEOF::Parameters parameters;
+        initializeParameters(parameters, size);
+
+        NSEOF::FlowField flowField(parameters);
+        initializeFlowField(flowField);
+
+        benchmark<NSEOF::Stencils::FGHStencil>("FGH", flowField, parameters, size, tileSizeX, tileSizeY, sweeps);
+        benchmark<NSEOF::Stencils::TurbulentFGHStencil>("TurbulentFGH", flowField, parameters, size, tileSizeX, tileSizeY, sweeps);
+        benchmark<NSEOF::Stencils::ViscosityStencil>("Viscosity", flowField, parameters, size, tileSizeX, tileSizeY, sweeps);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -61,6 +61,11 @@ void readBoolOptional(bool & storage, tinyxml2::XMLElement *node, const char* ta
     }
 }
 
+void readStringOptional(std::string & storage, tinyxml2::XMLElement *node, const char* tag, const std::string & defaultValue = "") {
+    const char *value = node->Attribute(tag);
+    storage = value == NULL ? defaultValue : value;
+}
+
 void readStringMandatory(std::string & storage, tinyxml2::XMLElement *node) {
     const char *myText = node->GetText();
     if (myText == NULL) {
@@ -238,6 +243,108 @@ void Configuration::loadParameters(Parameters & parameters, const MPI_Comm & com
         readFloatMandatory(parameters.solver.gamma, node, "gamma");
         readIntOptional(parameters.solver.maxIterations, node, "maxIterations");
 
+        readStringOptional(parameters.solver.type, node, "type");
+        readStringOptional(parameters.solver.preconditioner, node, "preconditioner");
+        readStringOptional(parameters.solver.krylov, node, "krylov");
+        readFloatOptional(parameters.solver.tolerance, node, "tol");
+        readFloatOptional(parameters.solver.divergenceTolerance, node, "divergenceTol");
+        readStringOptional(parameters.solver.cycle, node, "cycle", "V");
+        readIntOptional(parameters.solver.preSmoothing, node, "preSmoothing", 2);
+        readIntOptional(parameters.solver.postSmoothing, node, "postSmoothing", 2);
+        readStringOptional(parameters.solver.smoother, node, "smoother", "point");
+
+        bool direct = false;
+        readBoolOptional(direct, node, "direct");
+        parameters.solver.direct = (int) direct;
+        readStringOptional(parameters.solver.factorizationFile, node, "factorizationFile");
+
+        bool mixedPrecision = false;
+        readBoolOptional(mixedPrecision, node, "mixedPrecision");
+        parameters.solver.mixedPrecision = (int) mixedPrecision;
+        readIntOptional(parameters.solver.extrapolationOrder, node, "extrapolation");
+
+        bool timing = false;
+        readBoolOptional(timing, node, "timing");
+        parameters.solver.timing = (int) timing;
+
+        if (parameters.solver.type == "") {
+            // Eigen for sequential runs, otherwise the parallel solver of the build
+            int nproc;
+            MPI_Comm_size(communicator, &nproc);
+#ifdef BUILD_WITH_PETSC
+            parameters.solver.type = nproc == 1 ? "eigen" : "petsc";
+#else
+            parameters.solver.type = nproc == 1 ? "eigen" : "sor";
+#endif
+        }
+
+        if (parameters.solver.type != "sor" && parameters.solver.type != "eigen"
+            && parameters.solver.type != "petsc" && parameters.solver.type != "multigrid"
+            && parameters.solver.type != "fast" && parameters.solver.type != "cg") {
+            HANDLE_ERROR(1, "Unknown solver type");
+        }
+
+        if (parameters.solver.type == "eigen" && parameters.solver.preconditioner != ""
+            && parameters.solver.preconditioner != "diagonal" && parameters.solver.preconditioner != "ilut"
+            && parameters.solver.preconditioner != "none") {
+            HANDLE_ERROR(1, "The Eigen solver supports the diagonal, ilut and none preconditioners");
+        }
+
+        if (parameters.solver.type == "cg" && parameters.solver.preconditioner != ""
+            && parameters.solver.preconditioner != "jacobi" && parameters.solver.preconditioner != "ssor"
+            && parameters.solver.preconditioner != "chebyshev") {
+            HANDLE_ERROR(1, "The CG solver supports the jacobi, ssor and chebyshev preconditioners");
+        }
+
+        if (parameters.solver.type == "cg" && parameters.solver.krylov != ""
+            && parameters.solver.krylov != "cg" && parameters.solver.krylov != "pipecg") {
+            HANDLE_ERROR(1, "The CG solver supports the cg and pipecg methods");
+        }
+
+        if (parameters.solver.krylov != "" && parameters.solver.type != "cg" && parameters.solver.type != "petsc") {
+            HANDLE_ERROR(1, "The Krylov method can only be chosen for the cg and petsc solvers");
+        }
+
+        if (parameters.solver.direct && parameters.solver.type != "eigen") {
+            HANDLE_ERROR(1, "The direct mode is only available for the Eigen solver");
+        }
+
+        if (parameters.solver.mixedPrecision && parameters.solver.type != "multigrid"
+            && (parameters.solver.type != "eigen" || parameters.solver.direct)) {
+            HANDLE_ERROR(1, "Mixed precision is only available for the multigrid and the iterative Eigen solver");
+        }
+
+        if (parameters.solver.mixedPrecision && parameters.solver.type == "eigen"
+            && parameters.solver.preconditioner != "" && parameters.solver.preconditioner != "diagonal") {
+            HANDLE_ERROR(1, "Mixed precision Eigen solves only support the diagonal preconditioner");
+        }
+
+        if (parameters.solver.cycle != "V" && parameters.solver.cycle != "F") {
+            HANDLE_ERROR(1, "The multigrid cycle must be V or F");
+        }
+
+        if (parameters.solver.smoother != "point" && parameters.solver.smoother != "line") {
+            HANDLE_ERROR(1, "The smoother must be point or line");
+        }
+
+        if (parameters.solver.preSmoothing < 0 || parameters.solver.postSmoothing < 0
+            || parameters.solver.preSmoothing + parameters.solver.postSmoothing == 0) {
+            HANDLE_ERROR(1, "The multigrid solver needs at least one smoothing sweep");
+        }
+
+        if (parameters.solver.divergenceTolerance < 0) {
+            HANDLE_ERROR(1, "The divergence tolerance must not be negative");
+        }
+
+        if (parameters.solver.divergenceTolerance > 0
+            && (parameters.solver.type == "fast" || parameters.solver.direct)) {
+            HANDLE_ERROR(1, "The divergence tolerance needs an iterative pressure solver");
+        }
+
+        if (parameters.solver.extrapolationOrder < 0 || parameters.solver.extrapolationOrder > 2) {
+            HANDLE_ERROR(1, "The pressure extrapolation must be of order 0, 1 or 2");
+        }
+
         //--------------------------------------------------
         // Environmental parameters
         //--------------------------------------------------
@@ -408,6 +515,43 @@ void Configuration::loadParameters(Parameters & parameters, const MPI_Comm & com
 
         readIntOptional(parameters.turbulence.model, node, "model");
         readIntOptional(parameters.turbulence.turbViscosity, node, "turb_viscosity");
+
+        //--------------------------------------------------
+        // Kernel selection, all optional
+        //--------------------------------------------------
+        node = confFile.FirstChildElement()->FirstChildElement("kernels");
+
+        parameters.kernels.fuseFGHAndRHS = false;
+        parameters.kernels.fuseVelocityUpdate = false;
+        parameters.kernels.tiling = false;
+        parameters.kernels.tileSizeX = 0;
+        parameters.kernels.tileSizeY = 0;
+        parameters.kernels.hugePages = false;
+
+        if (node != NULL) {
+            bool buffer = false;
+            readBoolOptional(buffer, node, "fuseFGHAndRHS");
+            parameters.kernels.fuseFGHAndRHS = (int) buffer;
+
+            buffer = false;
+            readBoolOptional(buffer, node, "fuseVelocityUpdate");
+            parameters.kernels.fuseVelocityUpdate = (int) buffer;
+
+            buffer = false;
+            readBoolOptional(buffer, node, "tiling");
+            parameters.kernels.tiling = (int) buffer;
+
+            readIntOptional(parameters.kernels.tileSizeX, node, "tileSizeX");
+            readIntOptional(parameters.kernels.tileSizeY, node, "tileSizeY");
+
+            if (parameters.kernels.tileSizeX < 0 || parameters.kernels.tileSizeY < 0) {
+                HANDLE_ERROR(1, "Tile sizes must not be negative");
+            }
+
+            buffer = false;
+            readBoolOptional(buffer, node, "hugePages");
+            parameters.kernels.hugePages = (int) buffer;
+        }
     }
 
     // Broadcasting of the values
@@ -431,7 +575,15 @@ void Configuration::loadParameters(Parameters & parameters, const MPI_Comm & com
     MPI_Bcast(&(parameters.flow.Re), 1, MY_MPI_FLOAT, 0, communicator);
 
     MPI_Bcast(&(parameters.solver.gamma),         1, MY_MPI_FLOAT, 0, communicator);
-    MPI_Bcast(&(parameters.solver.maxIterations), 1, MY_MPI_FLOAT, 0, communicator);
+    MPI_Bcast(&(parameters.solver.maxIterations), 1, MPI_INT, 0, communicator);
+    MPI_Bcast(&(parameters.solver.tolerance),     1, MY_MPI_FLOAT, 0, communicator);
+    MPI_Bcast(&(parameters.solver.divergenceTolerance), 1, MY_MPI_FLOAT, 0, communicator);
+    MPI_Bcast(&(parameters.solver.preSmoothing),  1, MPI_INT, 0, communicator);
+    MPI_Bcast(&(parameters.solver.postSmoothing), 1, MPI_INT, 0, communicator);
+    MPI_Bcast(&(parameters.solver.direct),        1, MPI_INT, 0, communicator);
+    MPI_Bcast(&(parameters.solver.mixedPrecision), 1, MPI_INT, 0, communicator);
+    MPI_Bcast(&(parameters.solver.extrapolationOrder), 1, MPI_INT, 0, communicator);
+    MPI_Bcast(&(parameters.solver.timing), 1, MPI_INT, 0, communicator);
 
     MPI_Bcast(&(parameters.environment.gx), 1, MY_MPI_FLOAT, 0, communicator);
     MPI_Bcast(&(parameters.environment.gy), 1, MY_MPI_FLOAT, 0, communicator);
@@ -445,6 +597,12 @@ void Configuration::loadParameters(Parameters & parameters, const MPI_Comm & com
     broadcastString(parameters.vtk.prefix, communicator);
     broadcastString(parameters.simulation.type, communicator);
     broadcastString(parameters.simulation.scenario, communicator);
+    broadcastString(parameters.solver.type, communicator);
+    broadcastString(parameters.solver.preconditioner, communicator);
+    broadcastString(parameters.solver.krylov, communicator);
+    broadcastString(parameters.solver.cycle, communicator);
+    broadcastString(parameters.solver.smoother, communicator);
+    broadcastString(parameters.solver.factorizationFile, communicator);
 
     MPI_Bcast(&(parameters.bfStep.xRatio), 1, MY_MPI_FLOAT, 0, communicator);
     MPI_Bcast(&(parameters.bfStep.yRatio), 1, MY_MPI_FLOAT, 0, communicator);
@@ -467,6 +625,13 @@ void Configuration::loadParameters(Parameters & parameters, const MPI_Comm & com
 
     MPI_Bcast(&(parameters.turbulence.model), 1, MPI_INT, 0, communicator);
     MPI_Bcast(&(parameters.turbulence.turbViscosity), 1, MPI_INT, 0, communicator);
+
+    MPI_Bcast(&(parameters.kernels.fuseFGHAndRHS), 1, MPI_INT, 0, communicator);
+    MPI_Bcast(&(parameters.kernels.fuseVelocityUpdate), 1, MPI_INT, 0, communicator);
+    MPI_Bcast(&(parameters.kernels.tiling), 1, MPI_INT, 0, communicator);
+    MPI_Bcast(&(parameters.kernels.tileSizeX), 1, MPI_INT, 0, communicator);
+    MPI_Bcast(&(parameters.kernels.tileSizeY), 1, MPI_INT, 0, communicator);
+    MPI_Bcast(&(parameters.kernels.hugePages), 1, MPI_INT, 0, communicator);
 }
 
 } // namespace NSEOF
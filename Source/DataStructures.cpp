@@ -2,22 +2,18 @@
 
 namespace NSEOF {
 
-ScalarField::ScalarField(int Nx, int Ny)
-    : Field<FLOAT>(Nx, Ny, 1, 1) {
+ScalarField::ScalarField(int Nx, int Ny, FieldArena* arena)
+    : Field<FLOAT>(Nx, Ny, 1, 1, arena) {
 
     initialize();
 }
 
-ScalarField::ScalarField (int Nx, int Ny, int Nz)
-    : Field<FLOAT>(Nx, Ny, Nz, 1) {
+ScalarField::ScalarField (int Nx, int Ny, int Nz, FieldArena* arena)
+    : Field<FLOAT>(Nx, Ny, Nz, 1, arena) {
 
     initialize();
 }
 
-FLOAT& ScalarField::getScalar(int i, int j, int k) {
-    return data_[index2array(i, j, k)];
-}
-
 void ScalarField::show(const std::string title) {
     std::cout << std::endl << "--- " << title << " ---" << std::endl;
     for (int k = 0; k < sizeZ_; k++) {
@@ -32,26 +28,28 @@ void ScalarField::show(const std::string title) {
 }
 
 void ScalarField::initialize() {
-    for (int i = 0; i < size_; i++) {
-        data_[i] = 0.0;
-    }
+    firstTouch_(0.0, 1);
 }
 
-VectorField::VectorField(int Nx, int Ny)
-    : Field<FLOAT>(Nx, Ny, 1,  2) {
+VectorField::VectorField(int Nx, int Ny, FieldArena* arena)
+    : Field<FLOAT>(Nx, Ny, 1,  2, arena)
+    , cellsPerComponent_(size_ / 2) {
 
     initialize();
 }
 
-VectorField::VectorField(int Nx, int Ny, int Nz)
-    : Field<FLOAT>(Nx, Ny, Nz, 3) {
+VectorField::VectorField(int Nx, int Ny, int Nz, FieldArena* arena)
+    : Field<FLOAT>(Nx, Ny, Nz, 3, arena)
+    , cellsPerComponent_(size_ / 3) {
 
     initialize();
 }
 
+#ifndef USE_SOA_VECTOR_FIELDS
 FLOAT* VectorField::getVector(int i, int j, int k) {
     return &data_[index2array(i, j, k)];
 }
+#endif
 
 void VectorField::show(const std::string title) {
     std::cout << std::endl << "--- " << title << " ---" << std::endl;
@@ -59,7 +57,7 @@ void VectorField::show(const std::string title) {
     for (int k = 0; k < sizeZ_; k++) {
         for (int j = sizeY_ - 1; j > -1; j--) {
             for (int i = 0; i < sizeX_; i++) {
-                std::cout << getVector(i, j, k)[0] << "\t";
+                std::cout << getComponent(0, i, j, k) << "\t";
             }
             std::cout << std::endl;
         }
@@ -70,7 +68,7 @@ void VectorField::show(const std::string title) {
     for (int k = 0; k < sizeZ_; k++){
         for (int j = sizeY_ - 1; j > -1; j--){
             for (int i = 0; i < sizeX_; i++){
-                std::cout << getVector(i, j, k)[1] << "\t";
+                std::cout << getComponent(1, i, j, k) << "\t";
             }
             std::cout << std::endl;
         }
@@ -79,31 +77,27 @@ void VectorField::show(const std::string title) {
 }
 
 void VectorField::initialize() {
-    for (int i = 0; i < size_; i++){
-        data_[i] = 0.0;
-    }
+#ifdef USE_SOA_VECTOR_FIELDS
+    firstTouch_(0.0, components_);
+#else
+    firstTouch_(0.0, 1);
+#endif
 }
 
-IntScalarField::IntScalarField(int Nx, int Ny)
-    : Field<int>(Nx, Ny, 1, 1) {
+IntScalarField::IntScalarField(int Nx, int Ny, FieldArena* arena)
+    : Field<int>(Nx, Ny, 1, 1, arena) {
 
     initialize();
 }
 
-IntScalarField::IntScalarField(int Nx, int Ny, int Nz)
-    : Field<int>(Nx, Ny, Nz, 1) {
+IntScalarField::IntScalarField(int Nx, int Ny, int Nz, FieldArena* arena)
+    : Field<int>(Nx, Ny, Nz, 1, arena) {
 
     initialize();
 }
 
 void IntScalarField::initialize() {
-    for (int i = 0; i < size_; i++) {
-        data_[i] = 0;
-    }
-}
-
-int& IntScalarField::getValue(int i, int j, int k) {
-    return data_[index2array(i, j, k)];
+    firstTouch_(0, 1);
 }
 
 void IntScalarField::show(const std::string title) {
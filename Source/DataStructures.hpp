@@ -2,16 +2,25 @@
 #define __DATA_STRUCTURES_HPP__
 
 #include "Definitions.hpp"
+#include "FieldArena.hpp"
+
+#include <memory>
 
 namespace NSEOF {
 
 /** Storage of a scalar field
  *
  * Parent of storage classes. Contains the data pointer and sizes in each
- * dimension.
+ * dimension. Rows and planes are padded to whole cache lines, so that every
+ * row starts aligned. Strides of a multiple of ALIASING_LINES cache lines get
+ * one more line, since they would map consecutive rows to a few cache sets only.
  */
 template <class DataType>
 class Field {
+private:
+    //! Own storage, if the field is not placed in the arena of a flow field
+    std::unique_ptr<FieldArena> arena_;
+
 protected:
     //! Pointer to the data array
     DataType* data_;
@@ -20,40 +29,95 @@ protected:
     const int sizeY_; //! Size of the field in y direction, including ghost layers
     const int sizeZ_; //! Size of the field in z direction, including ghost layers
     const int components_; //! Number of components per position
-    const int size_;       //! Total size of the data array
+    const int strideY_;    //! Distance of two consecutive rows, in positions
+    const int strideZ_;    //! Distance of two consecutive planes, in positions
+    const int size_;       //! Total size of the data array, including the padding
+
+    /** Sets all values, with the rows distributed over the threads like in the threaded iterators
+     *
+     * Meant for the initialization, which places the pages close to the threads that work on them.
+     *
+     * @param value Value to set
+     * @param blocks Number of separately stored components, 1 if the components are interleaved
+     */
+    void firstTouch_(DataType value, int blocks) {
+        const int blockSize = size_ / blocks;
+        const int valuesPerPosition = components_ / blocks;
+
+        for (int block = 0; block < blocks; block++) {
+            DataType* const blockData = data_ + block * blockSize;
+
+            #pragma omp parallel for collapse(2) schedule(static)
+            for (int k = 0; k < sizeZ_; k++) {
+                for (int j = 0; j < sizeY_; j++) {
+                    // The last row of a plane also takes the padding of the plane
+                    const int first = valuesPerPosition * (j * strideY_ + k * strideZ_);
+                    const int last = valuesPerPosition * (j < sizeY_ - 1 ? (j + 1) * strideY_ + k * strideZ_ : (k + 1) * strideZ_);
+
+                    for (int index = first; index < last; index++) {
+                        blockData[index] = value;
+                    }
+                }
+            }
+        }
+    }
 
 public:
+    static constexpr int ALIASING_LINES = 8;
+
+    /** Pads a stride to whole cache lines, avoiding multiples of ALIASING_LINES lines
+     *
+     * @param positions Unpadded stride in positions
+     * @return Padded stride in positions
+     */
+    static int padStride(int positions) {
+        constexpr int positionsPerLine = CACHE_LINE_SIZE / sizeof(DataType);
+
+        int padded = (positions + positionsPerLine - 1) / positionsPerLine * positionsPerLine;
+        if ((padded / positionsPerLine) % ALIASING_LINES == 0) {
+            padded += positionsPerLine;
+        }
+        return padded;
+    }
+
+    /** Size of the data array of a field, including the padding
+     *
+     * @return Number of values
+     */
+    static int getPaddedSize(int Nx, int Ny, int Nz, int components) {
+        return components * padStride(padStride(Nx) * Ny) * Nz;
+    }
+
     /** Constructor for the field
      *
      * General constructor. Takes the three arguments even if the matrix is
-     * two dimensional. Doesn't allocate memory, only sets the dimensions.
+     * two dimensional. Takes the memory from the arena, or allocates its own
+     * if none is given, but leaves it uninitialized.
      *
      * @param Nx Number of cells in the x direction
      * @param Ny Number of cells in the y direction
      * @param Nz Number of cells in the z direction
+     * @param arena Arena to take the memory from
      */
-    Field(int Nx, int Ny, int Nz, int components)
+    Field(int Nx, int Ny, int Nz, int components, FieldArena* arena = NULL)
         : sizeX_(Nx)
         , sizeY_(Ny)
         , sizeZ_(Nz)
         , components_(components)
-        , size_(components * Nx * Ny * Nz) {
+        , strideY_(padStride(Nx))
+        , strideZ_(padStride(strideY_ * Ny))
+        , size_(components * strideZ_ * Nz) {
 
-        data_ = new DataType[size_];
-
-        // Check if the data was allocated successfully
-        if (data_ == 0) {
-            HANDLE_ERROR(1, "Unable to allocate memory");
+        if (arena == NULL) {
+            arena_.reset(new FieldArena(size_ * sizeof(DataType)));
+            arena = arena_.get();
         }
-    }
 
-    virtual ~Field() {
-        if (data_ != NULL) {
-            delete[] data_;
-            data_ = NULL;
-        }
+        data_ = arena->template allocate<DataType>(size_);
     }
 
+    virtual ~Field() = default;
+
     /** Returns the number of cells in the x direction
      *
      * @return The size in the x direction
@@ -84,9 +148,24 @@ public:
      * @return Position in the array
      */
     int index2array(int i, int j, int k = 0) const {
+        return components_ * index2cell(i, j, k);
+    }
+
+    /** Index to cell position mapper
+     *
+     * Converts the given index to the lexicographic position of the cell,
+     * regardless of the number of components stored per cell.
+     *
+     * @param i x index
+     * @param j y index
+     * @param k z index
+     *
+     * @return Position of the cell
+     */
+    int index2cell(int i, int j, int k = 0) const {
         ASSERTION((i < sizeX_) && (j < sizeY_) && (k < sizeZ_));
         ASSERTION((i >= 0) && (j >= 0) && (k >= 0));
-        return components_ * (i + (j * sizeX_) + (k * sizeX_ * sizeY_));
+        return i + (j * strideY_) + (k * strideZ_);
     }
 };
 
@@ -105,8 +184,9 @@ public:
      *
      * @param Nx Number of cells in direction x
      * @param Ny Number of cells in direction y
+     * @param arena Arena to take the memory from, NULL to allocate it separately
      */
-    ScalarField(int Nx, int Ny);
+    ScalarField(int Nx, int Ny, FieldArena* arena = NULL);
 
     /** 3D scalar field constructor.
      *
@@ -115,8 +195,9 @@ public:
      * @param Nx Number of cells in direction x
      * @param Ny Number of cells in direction y
      * @param Nz Number of cells in direction z
+     * @param arena Arena to take the memory from, NULL to allocate it separately
      */
-    ScalarField(int Nx, int Ny, int Nz);
+    ScalarField(int Nx, int Ny, int Nz, FieldArena* arena = NULL);
 
     /** Acces to element in scalar field
      *
@@ -127,7 +208,9 @@ public:
      * @param j y index
      * @param k z index. Not required for arrays of dimension two.
      */
-    FLOAT& getScalar(int i, int j, int k = 0);
+    inline FLOAT& getScalar(int i, int j, int k = 0) {
+        return data_[index2array(i, j, k)];
+    }
 
     /** Prints the contents of the field
      *
@@ -141,10 +224,15 @@ public:
 
 /** Vector field representation
  *
- * Stores a vector field of floats. Derived from Field.
+ * Stores a vector field of floats. Derived from Field. By default the components of a
+ * position are interleaved (array of structures). If built with USE_SOA_VECTOR_FIELDS,
+ * every component is stored in its own contiguous array instead (structure of arrays),
+ * so that sweeps over a single component run with unit stride.
  */
 class VectorField : public Field<FLOAT> {
 private:
+    const int cellsPerComponent_; //! Number of positions stored for each component
+
     void initialize();
 
 public:
@@ -155,8 +243,9 @@ public:
      * @param Nx Number of cells in direction x
      * @param Ny Number of cells in direction y
      * @param Nz Number of cells in direction z
+     * @param arena Arena to take the memory from, NULL to allocate it separately
      */
-    VectorField(int Nx, int Ny);
+    VectorField(int Nx, int Ny, FieldArena* arena = NULL);
 
     /** 3D Vector field constructor.
      *
@@ -165,19 +254,76 @@ public:
      * @param Nx Number of cells in direction x
      * @param Ny Number of cells in direction y
      * @param Nz Number of cells in direction z
+     * @param arena Arena to take the memory from, NULL to allocate it separately
      */
-    VectorField(int Nx, int Ny, int Nz);
+    VectorField(int Nx, int Ny, int Nz, FieldArena* arena = NULL);
 
+#ifndef USE_SOA_VECTOR_FIELDS
     /** Non constant acces to an element in the vector field
      *
      * Returns a pointer to the position in the array that can be used to
-     * modify it.
+     * modify it. Only available for the interleaved layout, since the
+     * components of a position are not adjacent otherwise.
      *
      * @param i x index
      * @param j y index
      * @param k z index
      */
     FLOAT* getVector(int i, int j, int k = 0);
+#endif
+
+    /** Access to a single component of the vector field
+     *
+     * Returns a reference to one component of the given position, independent
+     * of the memory layout of the field.
+     *
+     * @param component Component index (0 for x, 1 for y, 2 for z)
+     * @param i x index
+     * @param j y index
+     * @param k z index
+     */
+    inline FLOAT& getComponent(int component, int i, int j, int k = 0) {
+        ASSERTION((component >= 0) && (component < components_));
+#ifdef USE_SOA_VECTOR_FIELDS
+        return data_[component * cellsPerComponent_ + index2cell(i, j, k)];
+#else
+        return data_[index2array(i, j, k) + component];
+#endif
+    }
+
+    /** Base pointer of a component
+     *
+     * Returns the address of the given component at position (0, 0, 0). Consecutive
+     * positions in x direction are getComponentStride() elements apart.
+     *
+     * @param component Component index
+     */
+    inline FLOAT* getComponentData(int component) {
+        ASSERTION((component >= 0) && (component < components_));
+#ifdef USE_SOA_VECTOR_FIELDS
+        return data_ + component * cellsPerComponent_;
+#else
+        return data_ + component;
+#endif
+    }
+
+    /** Distance in memory between two consecutive positions of the same component
+     *
+     * @return 1 for the structure of arrays layout, the number of components otherwise
+     */
+    inline int getComponentStride() const {
+#ifdef USE_SOA_VECTOR_FIELDS
+        return 1;
+#else
+        return components_;
+#endif
+    }
+
+    /** Returns the number of components stored per position
+     *
+     * @return Number of components
+     */
+    int getComponents() const { return components_; }
 
     /** Prints the contents of the field
      *
@@ -203,16 +349,18 @@ public:
      *
      * @param Nx Size in the x direction
      * @param Ny Size in the Y direction
+     * @param arena Arena to take the memory from, NULL to allocate it separately
      */
-    IntScalarField(int Nx, int Ny);
+    IntScalarField(int Nx, int Ny, FieldArena* arena = NULL);
 
     /** 3D constructor
      *
      * @param Nx Size in the x direction
      * @param Ny Size in the Y direction
      * @param Nz SIze in the Z direction
+     * @param arena Arena to take the memory from, NULL to allocate it separately
      */
-    IntScalarField(int Nx, int Ny, int Nz);
+    IntScalarField(int Nx, int Ny, int Nz, FieldArena* arena = NULL);
 
     /** Access field values
      *
@@ -222,7 +370,9 @@ public:
      * @param j Y index
      * @param k Z index
      */
-    int& getValue(int i, int j, int k = 0);
+    inline int& getValue(int i, int j, int k = 0) {
+        return data_[index2array(i, j, k)];
+    }
 
     void show(const std::string title = "");
 };
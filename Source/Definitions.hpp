@@ -3,8 +3,6 @@
 
 #include <mpi.h>
 
-#define BUILD_WITH_EIGEN 1
-
 #ifdef BUILD_WITH_PETSC
 #include <petscksp.h>
 #else
@@ -0,0 +1,20 @@
+#ifndef __DIMENSION_HPP__
+#define __DIMENSION_HPP__
+
+namespace NSEOF {
+
+/** Compile-time tag for the number of spatial dimensions
+ *
+ * Stencil bodies shared by the 2D and the 3D overloads of apply are templated on it, so that the
+ * branches on the dimension fold at compile time instead of being tested for every cell.
+ */
+template <int D>
+struct Dim {
+    static_assert(D == 2 || D == 3, "Only 2D and 3D domains are supported");
+
+    static constexpr int value = D;
+};
+
+} // namespace NSEOF
+
+#endif // __DIMENSION_HPP__
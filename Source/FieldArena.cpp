@@ -0,0 +1,47 @@
+#include "FieldArena.hpp"
+
+#include <sys/mman.h>
+
+namespace NSEOF {
+
+FieldArena::FieldArena(size_t capacity, bool hugePages)
+    : block_(NULL)
+    , capacity_(getAlignedSize(capacity))
+    , used_(0) {
+
+    size_t alignment = CACHE_LINE_SIZE;
+    if (hugePages) {
+        alignment = HUGE_PAGE_SIZE;
+        capacity_ = (capacity_ + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    }
+
+    void* block = NULL;
+    if (posix_memalign(&block, alignment, capacity_ > 0 ? capacity_ : CACHE_LINE_SIZE) != 0) {
+        HANDLE_ERROR(1, "Unable to allocate memory");
+    }
+    block_ = static_cast<char*>(block);
+
+#ifdef MADV_HUGEPAGE
+    // Only a hint, the block is still usable with regular pages if the kernel declines
+    if (hugePages) {
+        madvise(block_, capacity_, MADV_HUGEPAGE);
+    }
+#endif
+}
+
+FieldArena::~FieldArena() {
+    free(block_);
+    block_ = NULL;
+}
+
+void* FieldArena::allocateBytes_(size_t bytes) {
+    if (used_ + bytes > capacity_) {
+        HANDLE_ERROR(1, "Field arena exhausted");
+    }
+
+    void* const piece = block_ + used_;
+    used_ += bytes;
+    return piece;
+}
+
+} // namespace NSEOF
@@ -0,0 +1,68 @@
+#ifndef __FIELD_ARENA_HPP__
+#define __FIELD_ARENA_HPP__
+
+#include "Definitions.hpp"
+#include "Threading.hpp"
+
+#include <stddef.h>
+
+namespace NSEOF {
+
+/** Single block of memory for the storage of several fields
+ *
+ * Allocates one block aligned to a cache line and hands out consecutive, cache line aligned pieces
+ * of it. The memory is not touched on allocation, so that the fields can initialize their values
+ * from the threads that later work on them (first touch), which places the pages on the NUMA node
+ * of these threads. The pieces are released together with the arena.
+ */
+class FieldArena {
+private:
+    char* block_;     //! Start of the block
+    size_t capacity_; //! Size of the block in bytes
+    size_t used_;     //! Number of bytes handed out so far
+
+    void* allocateBytes_(size_t bytes);
+
+public:
+    /** Size of the pages requested if huge pages are enabled, 2 MiB on x86-64
+     */
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    /** Allocates the block
+     *
+     * @param capacity Size of the block in bytes
+     * @param hugePages Align the block to huge pages and advise the kernel to back it with them
+     */
+    FieldArena(size_t capacity, bool hugePages = false);
+
+    ~FieldArena();
+
+    FieldArena(const FieldArena&) = delete;
+    FieldArena& operator=(const FieldArena&) = delete;
+
+    /** Takes an uninitialized array from the block
+     *
+     * Aborts if the block does not have enough space left.
+     *
+     * @param count Number of values of the array
+     * @return Pointer to the first value, aligned to a cache line
+     */
+    template <class DataType>
+    DataType* allocate(int count) {
+        return static_cast<DataType*>(allocateBytes_(getAlignedSize(count * sizeof(DataType))));
+    }
+
+    /** Rounds a number of bytes up to whole cache lines, which is the space an array of that size
+     *  takes in the arena
+     */
+    static size_t getAlignedSize(size_t bytes) {
+        return (bytes + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+    }
+
+    size_t getCapacity() const { return capacity_; }
+    size_t getUsed() const { return used_; }
+};
+
+} // namespace NSEOF
+
+#endif // __FIELD_ARENA_HPP__
@@ -2,6 +2,18 @@
 
 namespace NSEOF {
 
+// Size of the arena holding all fields of a flow field with the given number of cells
+static size_t getArenaSize(int dim, int cellsX, int cellsY, int cellsZ) {
+    const int layers = dim == 2 ? 1 : cellsZ;
+
+    const size_t scalarSize = FieldArena::getAlignedSize(Field<FLOAT>::getPaddedSize(cellsX, cellsY, layers, 1) * sizeof(FLOAT));
+    const size_t vectorSize = FieldArena::getAlignedSize(Field<FLOAT>::getPaddedSize(cellsX, cellsY, layers, dim) * sizeof(FLOAT));
+    const size_t flagsSize = FieldArena::getAlignedSize(Field<int>::getPaddedSize(cellsX, cellsY, layers, 1) * sizeof(int));
+
+    // Pressure, eddy viscosity, distance and RHS; velocity and FGH; flags
+    return 4 * scalarSize + 2 * vectorSize + flagsSize;
+}
+
 FlowField::FlowField(int Nx, int Ny)
     : sizeX_(Nx)
     , sizeY_(Ny)
@@ -9,15 +21,16 @@ FlowField::FlowField(int Nx, int Ny)
     , cellsX_(Nx + 3)
     , cellsY_(Ny + 3)
     , cellsZ_(1)
+    , arena_(getArenaSize(2, cellsX_, cellsY_, cellsZ_))
     // Pressure field doesn't need to have an extra layer, but this allows to address the same
     // positions with the same iterator for both pressures and velocities.
-    , pressure_(ScalarField(Nx + 3, Ny + 3))
-    , velocity_(VectorField(Nx + 3, Ny + 3))
-    , eddyViscosity_(ScalarField(Nx + 3, Ny + 3))
-    , distanceToWall_(ScalarField(Nx + 3, Ny + 3))
-    , flags_(IntScalarField(Nx + 3, Ny + 3))
-    , FGH_(VectorField(Nx + 3, Ny + 3))
-    , RHS_(ScalarField(Nx + 3, Ny + 3)) {
+    , pressure_(ScalarField(Nx + 3, Ny + 3, &arena_))
+    , velocity_(VectorField(Nx + 3, Ny + 3, &arena_))
+    , eddyViscosity_(ScalarField(Nx + 3, Ny + 3, &arena_))
+    , distanceToWall_(ScalarField(Nx + 3, Ny + 3, &arena_))
+    , flags_(IntScalarField(Nx + 3, Ny + 3, &arena_))
+    , FGH_(VectorField(Nx + 3, Ny + 3, &arena_))
+    , RHS_(ScalarField(Nx + 3, Ny + 3, &arena_)) {
 
     ASSERTION(Nx > 0);
     ASSERTION(Ny > 0);
@@ -30,13 +43,14 @@ FlowField::FlowField(int Nx, int Ny, int Nz)
     , cellsX_(Nx + 3)
     , cellsY_(Ny + 3)
     , cellsZ_(Nz + 3)
-    , pressure_(ScalarField(Nx + 3, Ny + 3, Nz + 3))
-    , velocity_(VectorField(Nx + 3, Ny + 3, Nz + 3))
-    , eddyViscosity_(ScalarField(Nx + 3, Ny + 3, Nz + 3))
-    , distanceToWall_(ScalarField(Nx + 3, Ny + 3, Nz + 3))
-    , flags_(IntScalarField(Nx + 3, Ny + 3, Nz + 3))
-    , FGH_(VectorField(Nx + 3, Ny + 3, Nz + 3))
-    , RHS_(ScalarField(Nx + 3, Ny + 3, Nz + 3)) {
+    , arena_(getArenaSize(3, cellsX_, cellsY_, cellsZ_))
+    , pressure_(ScalarField(Nx + 3, Ny + 3, Nz + 3, &arena_))
+    , velocity_(VectorField(Nx + 3, Ny + 3, Nz + 3, &arena_))
+    , eddyViscosity_(ScalarField(Nx + 3, Ny + 3, Nz + 3, &arena_))
+    , distanceToWall_(ScalarField(Nx + 3, Ny + 3, Nz + 3, &arena_))
+    , flags_(IntScalarField(Nx + 3, Ny + 3, Nz + 3, &arena_))
+    , FGH_(VectorField(Nx + 3, Ny + 3, Nz + 3, &arena_))
+    , RHS_(ScalarField(Nx + 3, Ny + 3, Nz + 3, &arena_)) {
 
     ASSERTION(Nx > 0);
     ASSERTION(Ny > 0);
@@ -50,86 +64,30 @@ FlowField::FlowField(const Parameters& parameters)
     , cellsX_(sizeX_ + 3)
     , cellsY_(sizeY_ + 3)
     , cellsZ_(sizeZ_ + 3)
-    , pressure_(parameters.geometry.dim == 2 ? ScalarField(sizeX_ + 3, sizeY_ + 3) : ScalarField(sizeX_ + 3, sizeY_ + 3, sizeZ_ + 3))
-    , velocity_(parameters.geometry.dim == 2 ? VectorField(sizeX_ + 3, sizeY_ + 3) : VectorField(sizeX_ + 3, sizeY_ + 3, sizeZ_ + 3))
-    , eddyViscosity_(parameters.geometry.dim == 2 ? ScalarField(sizeX_ + 3, sizeY_ + 3) : ScalarField(sizeX_ + 3, sizeY_ + 3, sizeZ_ + 3))
-    , distanceToWall_(parameters.geometry.dim == 2 ? ScalarField(sizeX_ + 3, sizeY_ + 3) : ScalarField(sizeX_ + 3, sizeY_ + 3, sizeZ_ + 3))
-    , flags_(parameters.geometry.dim == 2 ? IntScalarField(sizeX_ + 3, sizeY_ + 3) : IntScalarField(sizeX_ + 3, sizeY_ + 3, sizeZ_ + 3))
-    , FGH_(parameters.geometry.dim == 2 ? VectorField(sizeX_ + 3, sizeY_ + 3) : VectorField(sizeX_ + 3, sizeY_ + 3, sizeZ_ + 3))
-    , RHS_(parameters.geometry.dim == 2 ? ScalarField(sizeX_ + 3, sizeY_ + 3) : ScalarField(sizeX_ + 3, sizeY_ + 3, sizeZ_ + 3)) {}
-
-int FlowField::getNx() const {
-    return sizeX_;
-}
-
-int FlowField::getNy () const{
-    return sizeY_;
-}
-
-int FlowField::getNz () const{
-    return sizeZ_;
-}
-
-int FlowField::getCellsX() const{
-    return cellsX_;
-}
-
-int FlowField::getCellsY() const{
-    return cellsY_;
-}
-
-int FlowField::getCellsZ() const{
-    return cellsZ_;
-}
-
-ScalarField& FlowField::getPressure() {
-    return pressure_;
-}
-
-VectorField& FlowField::getVelocity() {
-    return velocity_;
-}
-
-ScalarField& FlowField::getEddyViscosity() {
-    return eddyViscosity_;
-}
-
-ScalarField& FlowField::getDistance() {
-    return distanceToWall_;
-}
-
-IntScalarField& FlowField::getFlags() {
-    return flags_;
-}
-
-VectorField& FlowField::getFGH() {
-    return FGH_;
-}
-
-ScalarField& FlowField::getRHS() {
-    return RHS_;
-}
+    , arena_(getArenaSize(parameters.geometry.dim, cellsX_, cellsY_, cellsZ_), parameters.kernels.hugePages)
+    , pressure_(parameters.geometry.dim == 2 ? ScalarField(sizeX_ + 3, sizeY_ + 3, &arena_) : ScalarField(sizeX_ + 3, sizeY_ + 3, sizeZ_ + 3, &arena_))
+    , velocity_(parameters.geometry.dim == 2 ? VectorField(sizeX_ + 3, sizeY_ + 3, &arena_) : VectorField(sizeX_ + 3, sizeY_ + 3, sizeZ_ + 3, &arena_))
+    , eddyViscosity_(parameters.geometry.dim == 2 ? ScalarField(sizeX_ + 3, sizeY_ + 3, &arena_) : ScalarField(sizeX_ + 3, sizeY_ + 3, sizeZ_ + 3, &arena_))
+    , distanceToWall_(parameters.geometry.dim == 2 ? ScalarField(sizeX_ + 3, sizeY_ + 3, &arena_) : ScalarField(sizeX_ + 3, sizeY_ + 3, sizeZ_ + 3, &arena_))
+    , flags_(parameters.geometry.dim == 2 ? IntScalarField(sizeX_ + 3, sizeY_ + 3, &arena_) : IntScalarField(sizeX_ + 3, sizeY_ + 3, sizeZ_ + 3, &arena_))
+    , FGH_(parameters.geometry.dim == 2 ? VectorField(sizeX_ + 3, sizeY_ + 3, &arena_) : VectorField(sizeX_ + 3, sizeY_ + 3, sizeZ_ + 3, &arena_))
+    , RHS_(parameters.geometry.dim == 2 ? ScalarField(sizeX_ + 3, sizeY_ + 3, &arena_) : ScalarField(sizeX_ + 3, sizeY_ + 3, sizeZ_ + 3, &arena_)) {}
 
 void FlowField::getPressureAndVelocity(FLOAT& pressure, FLOAT* const velocity, int i, int j) {
-    FLOAT* vHere = getVelocity().getVector(i, j);
-    FLOAT* vLeft = getVelocity().getVector(i - 1, j);
-    FLOAT* vDown = getVelocity().getVector(i, j - 1);
+    VectorField& v = getVelocity();
 
-    velocity[0] = (vHere[0] + vLeft[0]) / 2;
-    velocity[1] = (vHere[1] + vDown[1]) / 2;
+    velocity[0] = (v.getComponent(0, i, j) + v.getComponent(0, i - 1, j)) / 2;
+    velocity[1] = (v.getComponent(1, i, j) + v.getComponent(1, i, j - 1)) / 2;
 
     pressure = getPressure().getScalar(i, j);
 }
 
 void FlowField::getPressureAndVelocity(FLOAT& pressure, FLOAT* const velocity, int i, int j, int k) {
-    FLOAT* vHere = getVelocity().getVector(i, j, k);
-    FLOAT* vLeft = getVelocity().getVector(i - 1, j, k);
-    FLOAT* vDown = getVelocity().getVector(i, j - 1, k);
-    FLOAT* vBack = getVelocity().getVector(i, j, k - 1);
-
-    velocity[0] = (vHere[0] + vLeft[0]) / 2;
-    velocity[1] = (vHere[1] + vDown[1]) / 2;
-    velocity[2] = (vHere[2] + vBack[2]) / 2;
+    VectorField& v = getVelocity();
+
+    velocity[0] = (v.getComponent(0, i, j, k) + v.getComponent(0, i - 1, j, k)) / 2;
+    velocity[1] = (v.getComponent(1, i, j, k) + v.getComponent(1, i, j - 1, k)) / 2;
+    velocity[2] = (v.getComponent(2, i, j, k) + v.getComponent(2, i, j, k - 1)) / 2;
 
     pressure = getPressure().getScalar(i, j, k);
 }
@@ -8,7 +8,8 @@ namespace NSEOF {
 
 /** Flow field
  *
- * Class intended to contain the state of the domain.
+ * Class intended to contain the state of the domain. All fields are stored in
+ * a single arena.
  */
 class FlowField {
 private:
@@ -20,6 +21,8 @@ private:
     const int cellsY_;
     const int cellsZ_;
 
+    FieldArena arena_; //! Memory of all the fields below, in this order
+
     ScalarField pressure_; //! Scalar field representing the pressure
     VectorField velocity_; //! Multicomponent field representing velocity
 
@@ -68,35 +71,35 @@ public:
      *
      * @return Number of cells in the X direction
      */
-    int getNx() const;
+    int getNx() const { return sizeX_; }
 
     /** Obtain size in the Y direction
      *
      * @return Number of cells in the Y direction
      */
-    int getNy() const;
+    int getNy() const { return sizeY_; }
 
     /** Obtain size in the Z direction
      *
      * @return Number of cells in the Z direction
      */
-    int getNz() const;
+    int getNz() const { return sizeZ_; }
 
-    int getCellsX() const;
-    int getCellsY() const;
-    int getCellsZ() const;
+    int getCellsX() const { return cellsX_; }
+    int getCellsY() const { return cellsY_; }
+    int getCellsZ() const { return cellsZ_; }
 
-    ScalarField& getPressure();
-    VectorField& getVelocity();
+    ScalarField& getPressure() { return pressure_; }
+    VectorField& getVelocity() { return velocity_; }
 
-    ScalarField& getEddyViscosity();
-    ScalarField& getDistance();
+    ScalarField& getEddyViscosity() { return eddyViscosity_; }
+    ScalarField& getDistance() { return distanceToWall_; }
 
-    IntScalarField& getFlags();
+    IntScalarField& getFlags() { return flags_; }
 
-    VectorField& getFGH();
+    VectorField& getFGH() { return FGH_; }
 
-    ScalarField& getRHS();
+    ScalarField& getRHS() { return RHS_; }
 
     void getPressureAndVelocity(FLOAT &pressure, FLOAT* const velocity, int i, int j);
     void getPressureAndVelocity(FLOAT &pressure, FLOAT* const velocity, int i, int j, int k);
@@ -2,8 +2,13 @@
 #define __ITERATORS_HPP__
 
 #include "Parameters.hpp"
+#include "Threading.hpp"
 #include "Stencils/Stencil.hpp"
 
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
 namespace NSEOF {
 
 /** Iterator class
@@ -28,6 +33,22 @@ public:
     virtual void iterate() = 0;
 };
 
+/** Marks stencils with a row kernel for 3D domains
+ *
+ * Such stencils provide applyRow(flowField, firstI, lastI, j, k), which has the same effect as
+ * apply on the cells firstI to lastI of the row, but may share work between neighbouring cells.
+ * The iterators with the stencil type known at compile time then sweep 3D domains row by row.
+ * Specialise to std::true_type next to the stencil.
+ */
+template <class StencilType>
+struct HasRowKernel : std::false_type {};
+
+/** Applies the stencil to the cells firstI to lastI of a row of a 3D domain, through its row
+ *  kernel if it has one
+ */
+template <class FlowFieldType, class StencilType>
+void applyToRow(StencilType& stencil, FlowFieldType& flowField, int firstI, int lastI, int j, int k);
+
 template <class FlowFieldType>
 class FieldIterator : public Iterator<FlowFieldType> {
 private:
@@ -40,20 +61,197 @@ private:
     const int highOffset_;
     //@}
 
+    // Whether the outer loops are split across OpenMP threads
+    const bool threaded_;
+
 public:
+    /** The threaded variant may only be requested for stencils that are safe to apply
+     *  concurrently, i.e. that write to the visited cell only and keep their scratch data and
+     *  reductions per thread.
+     */
     FieldIterator(FlowFieldType& flowField, const Parameters& parameters, Stencils::FieldStencil<FlowFieldType>& stencil,
-                  int lowOffset = 0, int highOffset = 0);
+                  int lowOffset = 0, int highOffset = 0, bool threaded = false);
 
     virtual ~FieldIterator() override = default;
 
     /** Volume iteration over the field.
      *
      * Volume iteration. The stencil will be applied to all cells in the domain plus the upper
-     * boundaries. Lower boundaries are not included.
+     * boundaries. Lower boundaries are not included. If threaded, the j loop (2D) or the k and j
+     * loops (3D) are distributed statically over the OpenMP threads.
+     */
+    virtual void iterate() override;
+};
+
+/** Field iterator with the stencil type known at compile time
+ *
+ * Visits the same cells as FieldIterator, but calls the apply method of StencilType directly
+ * instead of going through the virtual FieldStencil interface, or its row kernel in 3D (see
+ * HasRowKernel). Combined with an explicit instantiation in the translation unit of the
+ * stencil, the stencil body is inlined into the loops. Meant for the stencils applied in every
+ * timestep; FieldIterator remains in use for the rest.
+ */
+template <class FlowFieldType, class StencilType>
+class StaticFieldIterator : public Iterator<FlowFieldType> {
+private:
+    StencilType& stencil_;
+
+    const int lowOffset_;
+    const int highOffset_;
+
+    const bool threaded_;
+
+public:
+    StaticFieldIterator(FlowFieldType& flowField, const Parameters& parameters, StencilType& stencil,
+                        int lowOffset = 0, int highOffset = 0, bool threaded = false);
+
+    virtual ~StaticFieldIterator() override = default;
+
+    /** Volume iteration over the field, see FieldIterator::iterate
      */
     virtual void iterate() override;
 };
 
+/** Field iterator visiting a 3D domain in tiles
+ *
+ * Visits the same cells as StaticFieldIterator. In 3D, the x-y plane is split into tiles of
+ * tileSizeX x tileSizeY cells, and the k loop runs innermost over the tiles, so that the planes
+ * k - 1, k and k + 1 of a tile, which stencils like FGHStencil read, are still in cache when the
+ * next plane is computed. The tiles are distributed over the threads. 2D domains are iterated as
+ * in StaticFieldIterator.
+ *
+ * Tile sizes of 0 are selected such that three planes of a tile fit into half of the L2 cache:
+ * whole rows as long as at least a few of them fit, shorter rows otherwise.
+ */
+template <class FlowFieldType, class StencilType>
+class TiledFieldIterator : public Iterator<FlowFieldType> {
+private:
+    StencilType& stencil_;
+
+    const bool threaded_;
+
+    int tileSizeX_;
+    int tileSizeY_;
+
+public:
+    //! Estimate of the bytes per cell column read and written by the stencil within a tile, i.e.
+    //! three planes of velocities, the flags and the result
+    static constexpr int BYTES_PER_COLUMN = 128;
+
+    //! Minimum number of rows per tile before the rows themselves are cut
+    static constexpr int MIN_TILE_ROWS = 4;
+
+    TiledFieldIterator(FlowFieldType& flowField, const Parameters& parameters, StencilType& stencil,
+                       int tileSizeX = 0, int tileSizeY = 0, bool threaded = false);
+
+    virtual ~TiledFieldIterator() override = default;
+
+    int getTileSizeX() const { return tileSizeX_; }
+    int getTileSizeY() const { return tileSizeY_; }
+
+    virtual void iterate() override;
+};
+
+/** Field iterator applying two dependent stencils in a single sweep
+ *
+ * The first stencil is applied to the same cells as in FieldIterator. The second stencil
+ * follows row by row, as soon as the values it reads are final, so that they are still in cache.
+ * It may only read results of the first stencil in the visited cell and in its lower neighbours
+ * (i-1, j-1, k-1), as the RHS stencil does with the FGH values.
+ *
+ * The boundary iterator may overwrite results of the first stencil in the lowest and highest
+ * visited layers, as the global boundary FGH stencils do. It is run after the sweep, and the
+ * second stencil is applied to the cells reading these layers only afterwards.
+ */
+template <class FlowFieldType, class FirstStencilType, class SecondStencilType>
+class FusedFieldIterator : public Iterator<FlowFieldType> {
+private:
+    FirstStencilType& firstStencil_;
+    SecondStencilType& secondStencil_;
+    Iterator<FlowFieldType>& boundaryIterator_;
+
+    const bool threaded_;
+
+    // Marks the first plane (3D) or row (2D) of every thread, for which the second stencil is
+    // postponed, since the preceding one is computed by another thread
+    std::vector<char> deferred_;
+
+    // Applies the second stencil to the cells firstI to lastI of the row j (and plane k in 3D)
+    void applySecondToRow_(FlowFieldType& flowField, int firstI, int lastI, int j, int k);
+
+public:
+    FusedFieldIterator(FlowFieldType& flowField, const Parameters& parameters,
+                       FirstStencilType& firstStencil, SecondStencilType& secondStencil,
+                       Iterator<FlowFieldType>& boundaryIterator, bool threaded = false);
+
+    virtual ~FusedFieldIterator() override = default;
+
+    /** Sweep with both stencils, then the boundary iterator, then the second stencil on the
+     *  cells whose values depend on the boundary.
+     */
+    virtual void iterate() override;
+};
+
+/** Field iterator for the velocity update after the pressure solve
+ *
+ * Applies the velocity stencil, the obstacle stencil and a reduction stencil, such as
+ * MaxUStencil, in a single sweep over the cells visited by FieldIterator. The obstacle stencil
+ * reads the new velocities of the neighbouring cells, so it follows one plane (row in 2D) behind
+ * the velocity stencil. It may only write cells that the velocity stencil leaves untouched, as
+ * the obstacle stencil does with the obstacle cells.
+ *
+ * The reduction stencil is applied to the cells that are not changed afterwards by the
+ * communication of the velocities or by the global boundary iterators, i.e. to all but the
+ * outermost visited layer. ShellFieldIterator visits that layer once they are done.
+ */
+template <class FlowFieldType, class VelocityStencilType, class ObstacleStencilType, class ReductionStencilType>
+class PostProjectionIterator : public Iterator<FlowFieldType> {
+private:
+    VelocityStencilType& velocityStencil_;
+    ObstacleStencilType& obstacleStencil_;
+    ReductionStencilType& reductionStencil_;
+
+    const bool threaded_;
+
+    // Marks the first and last plane (row in 2D) of every thread. Their neighbours are updated by
+    // other threads, so the obstacle and reduction stencils are applied to them after the sweep.
+    std::vector<char> deferred_;
+
+    // Applies the stencil to the plane (row in 2D), leaving out inset cells at either end
+    template <class StencilType>
+    void applyToLayer_(StencilType& stencil, int outer, int inset);
+
+    // Applies the obstacle and the reduction stencil to a plane (row in 2D)
+    void finishLayer_(int outer, int lastOuter);
+
+public:
+    PostProjectionIterator(FlowFieldType& flowField, const Parameters& parameters,
+                           VelocityStencilType& velocityStencil, ObstacleStencilType& obstacleStencil,
+                           ReductionStencilType& reductionStencil, bool threaded = false);
+
+    virtual ~PostProjectionIterator() override = default;
+
+    virtual void iterate() override;
+};
+
+/** Applies the stencil to the outermost layer of the cells visited by FieldIterator only, i.e.
+ *  to the cells with an index of 1 or cells - 2 in any direction
+ */
+template <class FlowFieldType, class StencilType>
+class ShellFieldIterator : public Iterator<FlowFieldType> {
+private:
+    StencilType& stencil_;
+
+    void applyToRow_(int j, int k, bool wholeRow);
+
+public:
+    ShellFieldIterator(FlowFieldType& flowField, const Parameters& parameters, StencilType& stencil);
+
+    virtual ~ShellFieldIterator() override = default;
+
+    virtual void iterate() override;
+};
+
 template <class FlowFieldType>
 class GlobalBoundaryIterator : public Iterator<FlowFieldType> {
 private:
@@ -0,0 +1,45 @@
+#include "MeshMetrics.hpp"
+
+namespace NSEOF {
+
+MeshMetrics::MeshMetrics(const Meshsize& meshsize, int dim, int cellsX, int cellsY, int cellsZ)
+    : dim_(dim)
+    , cells_{cellsX, cellsY, dim == 3 ? cellsZ : 1} {
+
+    ASSERTION(dim == 2 || dim == 3);
+
+    for (int axis = 0; axis < dim_; axis++) {
+        const int cells = cells_[axis];
+
+        spacing_[axis].resize(cells + 1);
+        inverseSpacing_[axis].resize(cells + 1);
+        centreSpacing_[axis].resize(cells);
+        inverseCentreSpacing_[axis].resize(cells);
+
+        for (int index = 0; index <= cells; index++) {
+            FLOAT spacing = 0.0;
+
+            if (axis == 0) {
+                spacing = meshsize.getDx(index, 0, 0);
+            } else if (axis == 1) {
+                spacing = meshsize.getDy(0, index, 0);
+            } else {
+                spacing = meshsize.getDz(0, 0, index);
+            }
+
+            if (spacing <= 0.0) {
+                HANDLE_ERROR(1, "Non-positive meshsize in MeshMetrics!");
+            }
+
+            spacing_[axis][index] = spacing;
+            inverseSpacing_[axis][index] = 1.0 / spacing;
+        }
+
+        for (int index = 0; index < cells; index++) {
+            centreSpacing_[axis][index] = 0.5 * (spacing_[axis][index] + spacing_[axis][index + 1]);
+            inverseCentreSpacing_[axis][index] = 1.0 / centreSpacing_[axis][index];
+        }
+    }
+}
+
+} // namespace NSEOF
@@ -0,0 +1,69 @@
+#ifndef __MESH_METRICS_HPP__
+#define __MESH_METRICS_HPP__
+
+#include "Meshsize.hpp"
+#include "Definitions.hpp"
+
+#include <vector>
+
+namespace NSEOF {
+
+/** Cache of the mesh spacings of the local subdomain
+ *
+ * All supported meshes are tensor products of 1D meshes, i.e. the spacing in x direction only
+ * depends on i, and so on. The spacings are therefore evaluated once per axis, including the
+ * ghost layers, and stored in 1D arrays that kernels can index directly instead of going
+ * through the virtual Meshsize interface for every cell.
+ *
+ * For every axis and cell index i the following arrays are kept:
+ *   spacing             dx(i)
+ *   centre spacing      0.5 * (dx(i) + dx(i + 1)), the distance between the centres of cells i and i + 1
+ *   inverse spacing     1 / dx(i)
+ *   inverse centre      1 / centre spacing
+ */
+class MeshMetrics {
+private:
+    const int dim_;
+    int cells_[3]; //! Number of cells per axis, including ghost layers
+
+    std::vector<FLOAT> spacing_[3];
+    std::vector<FLOAT> centreSpacing_[3];
+    std::vector<FLOAT> inverseSpacing_[3];
+    std::vector<FLOAT> inverseCentreSpacing_[3];
+
+public:
+    /** Evaluates the meshsize along every axis of the local subdomain
+     *
+     * @param meshsize Meshsize to be cached
+     * @param dim Dimension of the problem
+     * @param cellsX Number of cells in x direction, including ghost layers
+     * @param cellsY Number of cells in y direction, including ghost layers
+     * @param cellsZ Number of cells in z direction, including ghost layers. Ignored in 2D
+     */
+    MeshMetrics(const Meshsize& meshsize, int dim, int cellsX, int cellsY, int cellsZ);
+    ~MeshMetrics() = default;
+
+    int getCells(int axis) const { return cells_[axis]; }
+
+    /** Raw arrays of the given axis (0 for x, 1 for y, 2 for z). Valid indices are 0 .. getCells(axis) - 1;
+     *  the spacing arrays hold one more entry, so that i + 1 can be accessed from the last cell.
+     */
+    //@{
+    const FLOAT* getSpacing(int axis) const { ASSERTION(axis < dim_); return spacing_[axis].data(); }
+    const FLOAT* getCentreSpacing(int axis) const { ASSERTION(axis < dim_); return centreSpacing_[axis].data(); }
+    const FLOAT* getInverseSpacing(int axis) const { ASSERTION(axis < dim_); return inverseSpacing_[axis].data(); }
+    const FLOAT* getInverseCentreSpacing(int axis) const { ASSERTION(axis < dim_); return inverseCentreSpacing_[axis].data(); }
+    //@}
+
+    /** Spacing of a single cell, equivalent to Meshsize::getDx(i, j, k) and its siblings
+     */
+    //@{
+    FLOAT getDx(int i) const { ASSERTION((i >= 0) && (i <= cells_[0])); return spacing_[0][i]; }
+    FLOAT getDy(int j) const { ASSERTION((j >= 0) && (j <= cells_[1])); return spacing_[1][j]; }
+    FLOAT getDz(int k) const { ASSERTION((k >= 0) && (k <= cells_[2]) && (dim_ == 3)); return spacing_[2][k]; }
+    //@}
+};
+
+} // namespace NSEOF
+
+#endif // __MESH_METRICS_HPP__
@@ -29,6 +29,12 @@ void MeshsizeFactory::initMeshsize(Parameters& parameters) {
     if (parameters.meshsize == NULL) {
         HANDLE_ERROR(1, "parameters.meshsize == NULL!");
     }
+
+    // Cache the spacings of the local subdomain, including the ghost layers
+    parameters.meshMetrics = new MeshMetrics(*parameters.meshsize, parameters.geometry.dim,
+                                             parameters.parallel.localSize[0] + 3,
+                                             parameters.parallel.localSize[1] + 3,
+                                             parameters.parallel.localSize[2] + 3);
 }
 
 } // namespace NSEOF
@@ -6,8 +6,8 @@
 
 namespace NSEOF {
 
-/** Initialises the meshsize in the Parameters. Must be called after configuring (Configuration and PetscParallelConfiguration).
- *  We therefore make use of the singleton/factory pattern.
+/** Initialises the meshsize and the cached mesh metrics in the Parameters. Must be called after configuring
+ *  (Configuration and PetscParallelConfiguration). We therefore make use of the singleton/factory pattern.
  */
 class MeshsizeFactory {
 private:
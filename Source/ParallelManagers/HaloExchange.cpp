@@ -0,0 +1,61 @@
+#include "HaloExchange.hpp"
+
+namespace NSEOF::ParallelManagers {
+
+    // Tags start at 1, tag 0 is left to PetscParallelManager::sendRecvBuffers
+    static int getTag(int face) {
+        return 1 + face;
+    }
+
+    HaloExchange::HaloExchange(const std::array<int, FACES>& neighbours, const std::array<int, FACES>& sizes,
+                               Stencils::BufferFillStencil& fillStencil, Stencils::BufferReadStencil& readStencil)
+        : fillStencil_(fillStencil)
+        , readStencil_(readStencil) {
+        FLOAT* sendBuffers[FACES];
+        FLOAT* receiveBuffers[FACES];
+
+        for (int face = 0; face < FACES; face++) {
+            const bool active = neighbours[face] != MPI_PROC_NULL && sizes[face] > 0;
+            sendBuffers_[face].assign(active ? sizes[face] : 0, 0.0);
+            receiveBuffers_[face].assign(active ? sizes[face] : 0, 0.0);
+            sendBuffers[face] = sendBuffers_[face].data();
+            receiveBuffers[face] = receiveBuffers_[face].data();
+
+            if (!active) {
+                continue;
+            }
+
+            // What the neighbour sends through the opposite face arrives here
+            const int opposite = face ^ 1;
+            MPI_Request request;
+
+            MPI_Recv_init(receiveBuffers[face], sizes[face], MY_MPI_FLOAT, neighbours[face], getTag(opposite),
+                          MPI_COMM_WORLD, &request);
+            requests_.push_back(request);
+
+            MPI_Send_init(sendBuffers[face], sizes[face], MY_MPI_FLOAT, neighbours[face], getTag(face),
+                          MPI_COMM_WORLD, &request);
+            requests_.push_back(request);
+        }
+
+        fillStencil_.setBuffers(sendBuffers);
+        readStencil_.setBuffers(receiveBuffers);
+    }
+
+    HaloExchange::~HaloExchange() {
+        for (MPI_Request& request : requests_) {
+            MPI_Request_free(&request);
+        }
+    }
+
+    void HaloExchange::exchange() {
+        if (!requests_.empty()) {
+            MPI_Startall((int) requests_.size(), requests_.data());
+            MPI_Waitall((int) requests_.size(), requests_.data(), MPI_STATUSES_IGNORE);
+        }
+
+        fillStencil_.rewind();
+        readStencil_.rewind();
+    }
+
+} // namespace NSEOF::ParallelManagers
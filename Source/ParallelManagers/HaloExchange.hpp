@@ -0,0 +1,57 @@
+#ifndef __PARALLEL_MANAGERS_HALO_EXCHANGE_HPP__
+#define __PARALLEL_MANAGERS_HALO_EXCHANGE_HPP__
+
+#include "Definitions.hpp"
+
+#include "Stencils/BufferFillStencil.hpp"
+#include "Stencils/BufferReadStencil.hpp"
+
+#include <array>
+#include <vector>
+
+namespace NSEOF::ParallelManagers {
+
+/**
+ * Exchange of the buffers of a pair of buffer stencils with the neighbouring processes
+ *
+ * Owns a send and a receive buffer per face, sized once, which the fill stencil writes and the
+ * read stencil reads in place. The sends and receives are persistent requests, so exchange()
+ * only starts all of them at once and waits for them together. A message is tagged with the face
+ * it leaves through, which keeps two faces towards the same process apart, e.g. with two
+ * processes and periodic boundaries.
+ */
+class HaloExchange {
+public:
+    // Order of the buffers of the stencils; faces come in pairs of opposite ones
+    enum Face { LEFT, RIGHT, BOTTOM, TOP, FRONT, BACK, FACES };
+
+private:
+    Stencils::BufferFillStencil& fillStencil_;
+    Stencils::BufferReadStencil& readStencil_;
+
+    std::vector<FLOAT> sendBuffers_[FACES];
+    std::vector<FLOAT> receiveBuffers_[FACES];
+    std::vector<MPI_Request> requests_;
+
+public:
+    /**
+     * @param neighbours Rank to exchange with through each face, MPI_PROC_NULL for none
+     * @param sizes Number of values the fill stencil writes for each face
+     */
+    HaloExchange(const std::array<int, FACES>& neighbours, const std::array<int, FACES>& sizes,
+                 Stencils::BufferFillStencil& fillStencil, Stencils::BufferReadStencil& readStencil);
+    ~HaloExchange();
+
+    HaloExchange(const HaloExchange&) = delete;
+    HaloExchange& operator=(const HaloExchange&) = delete;
+
+    /** Sends the filled buffers and receives the ones to read. Afterwards, the fill stencil
+     *  starts at the beginning of the send buffers again, the read stencil at the beginning of
+     *  the received ones.
+     */
+    void exchange();
+};
+
+} // namespace NSEOF::ParallelManagers
+
+#endif // __PARALLEL_MANAGERS_HALO_EXCHANGE_HPP__
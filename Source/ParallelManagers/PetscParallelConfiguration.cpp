@@ -26,12 +26,7 @@ PetscParallelConfiguration::PetscParallelConfiguration(Parameters& parameters)
     }
 
     if (nproc != nprocFromFile) {
-#if BUILD_WITH_EIGEN
-        // TODO (Parallelization of Eigen Solver): Implement Eigen Solver to also work with multiple processors
-        HANDLE_ERROR(1, "The Eigen Solver currently supports only sequential solving, not parallel");
-#else
         HANDLE_ERROR(1, "The number of processors specified in the configuration file doesn't match the communicator");
-#endif
     }
 }
 
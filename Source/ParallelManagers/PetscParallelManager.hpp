@@ -5,6 +5,7 @@
 #include "Iterators.hpp"
 #include "Parameters.hpp"
 #include "Definitions.hpp"
+#include "HaloExchange.hpp"
 
 #include "Stencils/PressureBufferFillStencil.hpp"
 #include "Stencils/PressureBufferReadStencil.hpp"
@@ -36,9 +37,21 @@ private:
     ParallelBoundaryDiagonalIterator<FlowField> velocityBufferFillDiagonalIterator_;
     ParallelBoundaryDiagonalIterator<FlowField> velocityBufferReadDiagonalIterator_;
 
+    HaloExchange pressureExchange_;
+    HaloExchange velocityExchange_;
+    HaloExchange diagonalVelocityExchange_;
+
 protected:
-    void communicate_(Stencils::BufferFillStencil&, Stencils::BufferReadStencil&) const;
-    void communicateDiagonal_(Stencils::BufferFillStencil&, Stencils::BufferReadStencil&) const;
+    /**
+     * Neighbours of the faces of the subdomain, and the number of values the buffer stencils
+     * write for each face with the given number of values per cell
+     */
+    static std::array<int, HaloExchange::FACES> getFaceNeighbours_(const Parameters&);
+    static std::array<int, HaloExchange::FACES> getFaceSizes_(const Parameters&, const FlowField&, int valuesPerCell);
+    static std::array<int, HaloExchange::FACES> getDiagonalNeighbours_(const Parameters&);
+    static std::array<int, HaloExchange::FACES> getDiagonalSizes_(const Parameters&, const FlowField&);
+
+    static void communicate_(Iterator<FlowField>& fillIterator, HaloExchange& exchange, Iterator<FlowField>& readIterator);
 
 public:
     PetscParallelManager(const Parameters&, FlowField&);
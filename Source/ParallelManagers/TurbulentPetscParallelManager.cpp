@@ -9,12 +9,12 @@ namespace NSEOF::ParallelManagers {
             , viscosityBufferFillIterator_(flowField, parameters, viscosityBufferFillStencil_,
                                           parameters.vtk.whiteRegionLowOffset, parameters.vtk.whiteRegionHighOffset)
             , viscosityBufferReadIterator_(flowField, parameters, viscosityBufferReadStencil_,
-                                          parameters.vtk.whiteRegionLowOffset, parameters.vtk.whiteRegionHighOffset) {}
+                                          parameters.vtk.whiteRegionLowOffset, parameters.vtk.whiteRegionHighOffset)
+            , viscosityExchange_(getFaceNeighbours_(parameters), getFaceSizes_(parameters, flowField, 1),
+                                 viscosityBufferFillStencil_, viscosityBufferReadStencil_) {}
 
     void TurbulentPetscParallelManager::communicateViscosity() {
-        viscosityBufferFillIterator_.iterate();
-        communicate_(viscosityBufferFillStencil_, viscosityBufferReadStencil_);
-        viscosityBufferReadIterator_.iterate();
+        communicate_(viscosityBufferFillIterator_, viscosityExchange_, viscosityBufferReadIterator_);
     }
 
 } // namespace NSEOF::ParallelManagers
@@ -16,6 +16,8 @@ private:
     ParallelBoundaryIterator<FlowField> viscosityBufferFillIterator_;
     ParallelBoundaryIterator<FlowField> viscosityBufferReadIterator_;
 
+    HaloExchange viscosityExchange_;
+
 public:
     TurbulentPetscParallelManager(const Parameters&, FlowField&);
     ~TurbulentPetscParallelManager() override = default;
@@ -2,6 +2,7 @@
 #define __PARAMETERS_HPP__
 
 #include "Meshsize.hpp"
+#include "MeshMetrics.hpp"
 #include "Definitions.hpp"
 
 #include <string>
@@ -47,6 +48,21 @@ class SolverParameters {
 public:
     FLOAT gamma;        //! Donor cell balance coefficient
     int maxIterations;  //! Maximum number of iterations in the linear solver
+
+    std::string type;   //! Pressure solver: "sor", "eigen", "petsc", "multigrid", "fast" or "cg"
+    std::string preconditioner; //! Preconditioner of the Krylov solvers, empty for the solver's default
+    std::string krylov; //! Krylov method: a PETSc KSP type for the petsc solver, "cg" or "pipecg" for the cg solver, empty for the solver's default
+    FLOAT tolerance;    //! Residual at which the solver stops, 0 for the solver's default
+    FLOAT divergenceTolerance; //! RMS of the velocity divergence after the projection, from which the tolerance of every solve is set, 0 to keep the tolerance
+    std::string cycle;  //! Multigrid cycle, "V" or "F"
+    int preSmoothing;   //! Smoothing sweeps before the coarse grid correction
+    int postSmoothing;  //! Smoothing sweeps after the coarse grid correction
+    std::string smoother; //! Relaxation of the SOR and multigrid solvers, "point" or "line"
+    int direct;         //! Factorize the pressure matrix once and solve by substitution (=1, EigenSolver only)
+    std::string factorizationFile; //! File to store and reuse the factorization in, empty to keep it in memory
+    int mixedPrecision; //! Run the inner iterations in single precision, refined in FLOAT precision (=1, multigrid and eigen only)
+    int extrapolationOrder; //! Initial guess from the previous pressures: 0 (none), 1 (linear) or 2 (quadratic)
+    int timing;         //! Print the time per iteration after every solve (=1, cg and petsc only)
 };
 
 class GeometricParameters {
@@ -153,6 +169,16 @@ public:
 #endif
 };
 
+class KernelParameters {
+public:
+    int fuseFGHAndRHS;      //! Compute FGH and the RHS of the pressure equation in a single sweep (=1)
+    int fuseVelocityUpdate; //! Update velocities, obstacle cells and the max. velocity in a single sweep (=1)
+    int tiling;             //! Iterate the FGH and viscosity stencils in x-y tiles in 3D (=1)
+    int tileSizeX;          //! Tile size in x direction, 0 selects it from the cache size
+    int tileSizeY;          //! Tile size in y direction, 0 selects it from the cache size
+    int hugePages;          //! Back the flow field with transparent huge pages (=1)
+};
+
 class BFStepParameters {
 public:
     FLOAT xRatio;
@@ -167,13 +193,18 @@ public:
 class Parameters {
 public:
     inline Parameters()
-        : meshsize(NULL) {}
+        : meshsize(NULL)
+        , meshMetrics(NULL) {}
 
     inline ~Parameters() {
         if (meshsize != NULL) {
             delete meshsize;
             meshsize=NULL;
         }
+        if (meshMetrics != NULL) {
+            delete meshMetrics;
+            meshMetrics = NULL;
+        }
     }
 
     SimulationParameters    simulation;
@@ -188,7 +219,9 @@ public:
     StdOutParameters        stdOut;
     BFStepParameters        bfStep;
     TurbulenceParameters    turbulence;
+    KernelParameters        kernels;
     Meshsize                *meshsize;
+    MeshMetrics             *meshMetrics; //! Cached spacings of the local subdomain, for hot loops
 };
 
 } // namespace NSEOF
@@ -1,8 +1,6 @@
 #include "Simulation.hpp"
 
-#include "Solvers/SORSolver.hpp"
-#include "Solvers/PetscSolver.hpp"
-#include "Solvers/EigenSolver.hpp"
+#include "Solvers/SolverFactory.hpp"
 
 #include <limits>
 
@@ -12,30 +10,34 @@ Simulation::Simulation(Parameters& parameters, FlowField& flowField)
     : parameters_(parameters)
     , flowField_(flowField)
     , maxUStencil_(parameters)
-    , maxUFieldIterator_(flowField_, parameters, maxUStencil_)
+    , maxUFieldIterator_(flowField_, parameters, maxUStencil_, 0, 0, true)
     , maxUBoundaryIterator_(flowField_, parameters, maxUStencil_)
     , globalBoundaryFactory_(parameters)
     , wallVelocityIterator_(globalBoundaryFactory_.getGlobalBoundaryVelocityIterator(flowField_))
     , wallFGHIterator_(globalBoundaryFactory_.getGlobalBoundaryFGHIterator(flowField_))
     , rhsStencil_(parameters)
-    , rhsIterator_(flowField_, parameters, rhsStencil_)
+    , rhsIterator_(flowField_, parameters, rhsStencil_, 0, 0, true)
     , velocityStencil_(parameters)
     , obstacleStencil_(parameters)
-    , velocityIterator_(flowField_, parameters, velocityStencil_)
-    , obstacleIterator_(flowField_, parameters, obstacleStencil_)
+    , velocityIterator_(flowField_, parameters, velocityStencil_, 0, 0, true)
+    , obstacleIterator_(flowField_, parameters, obstacleStencil_, 0, 0, true)
+    , postProjectionIterator_(flowField_, parameters, velocityStencil_, obstacleStencil_, maxUStencil_, true)
+    , maxUShellIterator_(flowField_, parameters, maxUStencil_)
+    , maxUUpToDate_(false)
     , petscParallelManager_(parameters, flowField_)
-#if BUILD_WITH_EIGEN
-    , solver_(std::make_unique<Solvers::EigenSolver>(flowField_, parameters))
-#else
-#ifdef BUILD_WITH_PETSC
-    , solver_(std::make_unique<Solvers::PetscSolver>(flowField_, parameters))
-#else
-    , solver_(std::make_unique<Solvers::SORSolver>(flowField_, parameters))
-#endif
-#endif
+    , solver_(Solvers::SolverFactory::createSolver(flowField_, parameters))
+    , pressureExtrapolation_(flowField_, parameters)
+    , adaptiveTolerance_(flowField_, parameters)
 {
     fghStencil_  = new Stencils::FGHStencil(parameters_);
-    fghIterator_ = new FieldIterator<FlowField>(flowField_, parameters_, *fghStencil_);
+    if (parameters_.kernels.tiling) {
+        fghIterator_ = new TiledFieldIterator<FlowField, Stencils::FGHStencil>(
+            flowField_, parameters_, *fghStencil_, parameters_.kernels.tileSizeX, parameters_.kernels.tileSizeY, true);
+    } else {
+        fghIterator_ = new StaticFieldIterator<FlowField, Stencils::FGHStencil>(flowField_, parameters_, *fghStencil_, 0, 0, true);
+    }
+    fghRHSIterator_ = new FusedFieldIterator<FlowField, Stencils::FGHStencil, Stencils::RHSStencil>(
+        flowField_, parameters_, *fghStencil_, rhsStencil_, wallFGHIterator_, true);
 
     vtkStencil_  = new Stencils::VTKStencil(parameters_,
                                             flowField_.getCellsX(), flowField_.getCellsY(), flowField_.getCellsZ());
@@ -46,6 +48,7 @@ Simulation::Simulation(Parameters& parameters, FlowField& flowField)
 Simulation::~Simulation() {
     delete fghStencil_;
     delete fghIterator_;
+    delete fghRHSIterator_;
 
     delete vtkStencil_;
     delete vtkIterator_;
@@ -110,10 +113,13 @@ void Simulation::setTimestep_() {
     ASSERTION(parameters_.geometry.dim == 2 || parameters_.geometry.dim == 3);
     FLOAT localMin, globalMin;
 
-    // Determine maximum velocity
-    maxUStencil_.reset();
-    maxUFieldIterator_.iterate();
-    maxUBoundaryIterator_.iterate();
+    // Determine maximum velocity, unless the previous timestep did so while updating the velocities
+    if (!maxUUpToDate_) {
+        maxUStencil_.reset();
+        maxUFieldIterator_.iterate();
+        maxUBoundaryIterator_.iterate();
+    }
+    maxUUpToDate_ = false;
 
     if (parameters_.geometry.dim == 2) { // 2D
         parameters_.timestep.dt = 1.0 / maxUStencil_.getMaxValues()[0];
@@ -142,27 +148,48 @@ void Simulation::solveTimestep() {
     // Determine and set max timestep which is allowed in this simulation
     setTimestep_();
 
-    fghIterator_->iterate(); // Compute FGH
-    wallFGHIterator_.iterate(); // Set global boundary values
-    rhsIterator_.iterate(); // Compute the right-hand side (RHS)
+    if (parameters_.kernels.fuseFGHAndRHS) {
+        fghRHSIterator_->iterate(); // Compute FGH, the global boundary values and the RHS in one sweep
+    } else {
+        fghIterator_->iterate(); // Compute FGH
+        wallFGHIterator_.iterate(); // Set global boundary values
+        rhsIterator_.iterate(); // Compute the right-hand side (RHS)
+    }
 
-    // Solve for pressure
+    // Solve for pressure, starting from the pressure extrapolated from the previous timesteps
+    pressureExtrapolation_.predict();
+    if (adaptiveTolerance_.isEnabled()) {
+        solver_->setTolerance(adaptiveTolerance_.update());
+    }
     solver_->solve();
 
-#if not BUILD_WITH_EIGEN
     // Communicate pressure values
     petscParallelManager_.communicatePressure();
-#endif
+    pressureExtrapolation_.store();
 
     // Compute velocity
-    velocityIterator_.iterate();
-    obstacleIterator_.iterate();
+    if (parameters_.kernels.fuseVelocityUpdate) {
+        maxUStencil_.reset();
+        postProjectionIterator_.iterate(); // Also sets the obstacle cells and reduces the max. velocity
+    } else {
+        velocityIterator_.iterate();
+        obstacleIterator_.iterate();
+    }
 
     // Communicate velocity values
     petscParallelManager_.communicateVelocity();
 
     // Iterate for velocities on the boundary
     wallVelocityIterator_.iterate();
+
+    if (parameters_.kernels.fuseVelocityUpdate) {
+        // Reduce the max. velocity on the cells changed by the communication and the boundaries
+        maxUShellIterator_.iterate();
+        maxUBoundaryIterator_.iterate();
+        maxUUpToDate_ = true;
+    }
+
+    adaptiveTolerance_.monitor();
 }
 
 void Simulation::plotVTK(int timestep) {
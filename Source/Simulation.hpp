@@ -24,6 +24,8 @@
 #include "ParallelManagers/PetscParallelManager.hpp"
 
 #include "Solvers/LinearSolver.hpp"
+#include "Solvers/PressureExtrapolation.hpp"
+#include "Solvers/AdaptiveTolerance.hpp"
 
 #include <memory>
 
@@ -35,8 +37,9 @@ protected:
 
     FlowField& flowField_;
 
+    // The field iterators of the stencils applied in every timestep are constructed as threaded
     Stencils::MaxUStencil maxUStencil_;
-    FieldIterator<FlowField> maxUFieldIterator_;
+    StaticFieldIterator<FlowField, Stencils::MaxUStencil> maxUFieldIterator_;
     GlobalBoundaryIterator<FlowField> maxUBoundaryIterator_;
 
     // Set up the boundary conditions
@@ -45,22 +48,31 @@ protected:
     GlobalBoundaryIterator<FlowField> wallFGHIterator_;
 
     Stencils::RHSStencil rhsStencil_;
-    FieldIterator<FlowField> rhsIterator_;
+    StaticFieldIterator<FlowField, Stencils::RHSStencil> rhsIterator_;
 
     Stencils::FGHStencil* fghStencil_;
-    FieldIterator<FlowField>* fghIterator_;
+    Iterator<FlowField>* fghIterator_;
+    Iterator<FlowField>* fghRHSIterator_; //! FGH, global boundary FGH and RHS in one sweep
 
     Stencils::VTKStencil* vtkStencil_;
     FieldIterator<FlowField>* vtkIterator_;
 
     Stencils::VelocityStencil velocityStencil_;
     Stencils::ObstacleStencil obstacleStencil_;
-    FieldIterator<FlowField> velocityIterator_;
-    FieldIterator<FlowField> obstacleIterator_;
+    StaticFieldIterator<FlowField, Stencils::VelocityStencil> velocityIterator_;
+    StaticFieldIterator<FlowField, Stencils::ObstacleStencil> obstacleIterator_;
+
+    //! Velocity, obstacle and max. velocity in one sweep, the remaining max. velocity cells after the boundaries
+    PostProjectionIterator<FlowField, Stencils::VelocityStencil, Stencils::ObstacleStencil, Stencils::MaxUStencil>
+        postProjectionIterator_;
+    ShellFieldIterator<FlowField, Stencils::MaxUStencil> maxUShellIterator_;
+    bool maxUUpToDate_; //! maxUStencil_ already holds the maximum of the current velocity field
 
     ParallelManagers::PetscParallelManager petscParallelManager_;
 
     std::unique_ptr<Solvers::LinearSolver> solver_;
+    Solvers::PressureExtrapolation pressureExtrapolation_;
+    Solvers::AdaptiveTolerance adaptiveTolerance_;
 
     /** Gets the diffusive timestep and uses that to set the timestep before solving */
     virtual FLOAT getDiffusiveTimestep_();
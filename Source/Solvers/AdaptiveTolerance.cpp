@@ -0,0 +1,122 @@
+#include "AdaptiveTolerance.hpp"
+
+#include "ParallelManagers/PetscParallelManager.hpp"
+
+#include <algorithm>
+#include <math.h>
+
+namespace NSEOF {
+namespace Solvers {
+
+// Range of the relative tolerance: every solve gains a digit, but none goes below round-off
+static constexpr FLOAT MIN_RELATIVE_TOLERANCE = 1e-12;
+static constexpr FLOAT MAX_RELATIVE_TOLERANCE = 1e-1;
+
+// Range of the correction from the measured divergence
+static constexpr FLOAT MIN_CORRECTION = 1e-2;
+static constexpr FLOAT MAX_CORRECTION = 1e2;
+
+AdaptiveTolerance::AdaptiveTolerance(FlowField& flowField, const Parameters& parameters)
+    : flowField_(flowField)
+    , parameters_(parameters)
+    , enabled_(parameters.solver.divergenceTolerance > 0)
+    , absolute_(parameters.solver.type == "sor")
+    , limited_(true)
+    , correction_(1.0)
+    , rhsNorm_(0.0)
+    , tolerance_(parameters.solver.tolerance) {}
+
+template <class Value>
+FLOAT AdaptiveTolerance::getNorm_(Value value) {
+    IntScalarField& flags = flowField_.getFlags();
+    const int sizeX = flowField_.getNx(), sizeY = flowField_.getNy();
+    const int sizeZ = parameters_.geometry.dim == 3 ? flowField_.getNz() : 1;
+    const int firstZ = parameters_.geometry.dim == 3 ? 2 : 0;
+
+    FLOAT sum = 0.0, cells = 0.0;
+
+    #pragma omp parallel for collapse(2) schedule(static) reduction(+:sum, cells)
+    for (int k = firstZ; k < firstZ + sizeZ; k++) {
+        for (int j = 2; j < sizeY + 2; j++) {
+            for (int i = 2; i < sizeX + 2; i++) {
+                if ((flags.getValue(i, j, k) & OBSTACLE_SELF) == 0) {
+                    const FLOAT v = value(i, j, k);
+                    sum += v * v;
+                    cells += 1.0;
+                }
+            }
+        }
+    }
+
+    FLOAT local[2] = {sum, cells};
+    FLOAT global[2];
+    MPI_Allreduce(local, global, 2, MY_MPI_FLOAT, MPI_SUM, PETSC_COMM_WORLD);
+
+    return global[1] > 0.0 ? sqrt(global[0] / global[1]) : 0.0;
+}
+
+FLOAT AdaptiveTolerance::update() {
+    if (!enabled_) {
+        return tolerance_;
+    }
+
+    ScalarField& rhs = flowField_.getRHS();
+    rhsNorm_ = getNorm_([&rhs](int i, int j, int k) { return rhs.getScalar(i, j, k); });
+
+    // Residual at which the divergence after the projection meets the target
+    const FLOAT residual = correction_ * parameters_.solver.divergenceTolerance / parameters_.timestep.dt;
+    FLOAT relative = rhsNorm_ > 0.0 ? residual / rhsNorm_ : MAX_RELATIVE_TOLERANCE;
+
+    limited_ = relative < MIN_RELATIVE_TOLERANCE || relative >= MAX_RELATIVE_TOLERANCE;
+    relative = std::min(std::max(relative, MIN_RELATIVE_TOLERANCE), MAX_RELATIVE_TOLERANCE);
+
+    if (!absolute_) {
+        tolerance_ = relative;
+    } else {
+        // A right-hand side of zero is solved by the last pressure already
+        tolerance_ = rhsNorm_ > 0.0 ? relative * rhsNorm_ : MY_FLOAT_MAX;
+    }
+
+    return tolerance_;
+}
+
+FLOAT AdaptiveTolerance::monitor() {
+    if (!enabled_) {
+        return 0.0;
+    }
+
+    const MeshMetrics& metrics = *parameters_.meshMetrics;
+    VectorField& velocity = flowField_.getVelocity();
+    const bool is3D = parameters_.geometry.dim == 3;
+    const FLOAT* const inverseX = metrics.getInverseSpacing(0);
+    const FLOAT* const inverseY = metrics.getInverseSpacing(1);
+    const FLOAT* const inverseZ = is3D ? metrics.getInverseSpacing(2) : NULL;
+
+    // The discrete divergence of the RHSStencil
+    const FLOAT divergence = getNorm_([&](int i, int j, int k) {
+        FLOAT value = (velocity.getComponent(0, i, j, k) - velocity.getComponent(0, i - 1, j, k)) * inverseX[i]
+                    + (velocity.getComponent(1, i, j, k) - velocity.getComponent(1, i, j - 1, k)) * inverseY[j];
+        if (is3D) {
+            value += (velocity.getComponent(2, i, j, k) - velocity.getComponent(2, i, j, k - 1)) * inverseZ[k];
+        }
+        return value;
+    });
+
+    // Only solves that ran to the adapted tolerance say something about it. Solvers that gain
+    // an order of magnitude per iteration overshoot the tolerance by up to that much, so only
+    // half of the ratio is corrected in logarithmic terms, which keeps them from oscillating.
+    const FLOAT target = parameters_.solver.divergenceTolerance;
+    if (!limited_ && divergence > 0.0) {
+        correction_ = std::min(std::max(correction_ * sqrt(target / divergence), MIN_CORRECTION), MAX_CORRECTION);
+    }
+
+    if (parameters_.parallel.rank == 0) {
+        std::cout << "Divergence after the projection: " << divergence << " (target " << target
+                  << "), solver tolerance " << tolerance_ << std::endl;
+    }
+
+    return divergence;
+}
+
+} // namespace Solvers
+} // namespace NSEOF
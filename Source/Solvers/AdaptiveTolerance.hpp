@@ -0,0 +1,56 @@
+#ifndef __SOLVERS_ADAPTIVE_TOLERANCE_HPP__
+#define __SOLVERS_ADAPTIVE_TOLERANCE_HPP__
+
+#include "Definitions.hpp"
+#include "Parameters.hpp"
+#include "FlowField.hpp"
+
+namespace NSEOF {
+namespace Solvers {
+
+/** Tolerance of the pressure solver from the divergence the projection has to reach
+ *
+ * After the projection, the divergence of the velocity in a fluid cell is dt times the residual of
+ * the pressure equation there. A fixed tolerance on the residual over-solves while the right-hand
+ * side is large, e.g. in early transients, and under-solves once it becomes small near a steady
+ * state. Before every solve, update() returns the tolerance for LinearSolver::setTolerance such
+ * that the RMS of the divergence after the projection is about
+ * parameters.solver.divergenceTolerance: the residual
+ * has to drop to target / dt, relative to the RMS of the right-hand side, or in RMS for the
+ * SORSolver. The solvers measure the residual in different norms, so monitor() compares the
+ * divergence after the projection with the target and corrects the following tolerances by the
+ * ratio. With a divergence tolerance of 0, both do nothing and the configured tolerance is kept.
+ */
+class AdaptiveTolerance {
+private:
+    FlowField& flowField_;
+    const Parameters& parameters_;
+
+    bool enabled_;
+    bool absolute_;    //! The solver stops at an RMS residual instead of a relative one
+    bool limited_;     //! The tolerance of the last solve was cut to the range of relative tolerances
+    FLOAT correction_; //! Ratio of the target to the divergences of the previous projections
+    FLOAT rhsNorm_;    //! RMS of the right-hand side of the last solve
+    FLOAT tolerance_;  //! Tolerance of the last solve
+
+    /** RMS of the values over the fluid cells of all processes */
+    template <class Value> FLOAT getNorm_(Value value);
+
+public:
+    AdaptiveTolerance(FlowField& flowField, const Parameters& parameters);
+
+    bool isEnabled() const { return enabled_; }
+
+    /** Returns the tolerance of the next solve from the right-hand side and parameters.timestep.dt */
+    FLOAT update();
+
+    /** Needs the velocities after the projection, including the boundaries. Prints and returns
+     *  the RMS of the divergence, 0 if the tolerance is not adapted.
+     */
+    FLOAT monitor();
+};
+
+} // namespace Solvers
+} // namespace NSEOF
+
+#endif // __SOLVERS_ADAPTIVE_TOLERANCE_HPP__
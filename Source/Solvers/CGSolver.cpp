@@ -0,0 +1,640 @@
+#include "CGSolver.hpp"
+
+#include "Dimension.hpp"
+#include "PressureBoundaries.hpp"
+
+#include <algorithm>
+#include <math.h>
+
+namespace NSEOF {
+namespace Solvers {
+
+static constexpr int DEFAULT_MAX_ITERATIONS = 1000;
+static constexpr FLOAT DEFAULT_TOLERANCE = 1e-6;
+
+// Relaxation factor of the symmetric SOR preconditioner
+static constexpr FLOAT SSOR_OMEGA = 1.0;
+
+// The eigenvalues of the Jacobi-scaled operator lie in [0, 2]; the Chebyshev polynomial of the
+// given degree damps those in [2 / CHEBYSHEV_RATIO, 2]
+static constexpr int CHEBYSHEV_DEGREE = 4;
+static constexpr FLOAT CHEBYSHEV_RATIO = 30.0;
+
+CGSolver::CGSolver(FlowField& flowField, const Parameters& parameters)
+    : LinearSolver(flowField, parameters)
+    , preconditioner_(JACOBI)
+    , maxIterations_(parameters.solver.maxIterations > 0 ? parameters.solver.maxIterations : DEFAULT_MAX_ITERATIONS)
+    , pipelined_(parameters.solver.krylov == "pipecg")
+    , singular_(true) {
+
+    if (parameters.solver.preconditioner == "ssor") {
+        preconditioner_ = SSOR;
+    } else if (parameters.solver.preconditioner == "chebyshev") {
+        preconditioner_ = CHEBYSHEV;
+    } else if (parameters.solver.preconditioner != "" && parameters.solver.preconditioner != "jacobi") {
+        HANDLE_ERROR(1, "The CG solver supports the jacobi, ssor and chebyshev preconditioners");
+    }
+    if (parameters.solver.krylov != "" && parameters.solver.krylov != "cg" && parameters.solver.krylov != "pipecg") {
+        HANDLE_ERROR(1, "The CG solver supports the cg and pipecg methods");
+    }
+
+    for (int d = 0; d < parameters.geometry.dim; d++) {
+        if (getWallType(parameters, d, false) == PERIODIC && parameters.parallel.numProcessors[d] > 1) {
+            HANDLE_ERROR(1, "The CG solver supports periodic boundaries only with a single process in that direction");
+        }
+
+        // An outflow wall fixes the pressure to zero
+        if (getWallType(parameters, d, false) == NEUMANN || getWallType(parameters, d, true) == NEUMANN) {
+            singular_ = false;
+        }
+    }
+
+    setCoefficients_();
+}
+
+void CGSolver::setCoefficients_() {
+    const int dim = parameters_.geometry.dim;
+    ScalarField& pressure = flowField_.getPressure();
+    ScalarField& rhs = flowField_.getRHS();
+    IntScalarField& flags = flowField_.getFlags();
+
+    for (int d = 0; d < 3; d++) {
+        cells_[d] = d < dim ? parameters_.parallel.localSize[d] : 1;
+    }
+
+    if (dim == 3) {
+        pressure_ = &pressure.getScalar(1, 1, 1);
+        rhs_ = &rhs.getScalar(1, 1, 1);
+        flags_ = &flags.getValue(1, 1, 1);
+        strides_[2] = pressure.index2cell(0, 0, 1);
+        flagStrides_[2] = flags.index2cell(0, 0, 1);
+    } else {
+        pressure_ = &pressure.getScalar(1, 1);
+        rhs_ = &rhs.getScalar(1, 1);
+        flags_ = &flags.getValue(1, 1);
+        strides_[2] = 0;
+        flagStrides_[2] = 0;
+    }
+    strides_[0] = flagStrides_[0] = 1;
+    strides_[1] = pressure.index2cell(0, 1, 0);
+    flagStrides_[1] = flags.index2cell(0, 1, 0);
+
+    for (int d = 0; d < 3; d++) {
+        const int cells = cells_[d];
+
+        extent_[d].assign(cells + 2, 1.0);
+        couplingLow_[d].assign(cells + 2, 0.0);
+        couplingHigh_[d].assign(cells + 2, 0.0);
+        diagonalLow_[d].assign(cells + 2, 0.0);
+        diagonalHigh_[d].assign(cells + 2, 0.0);
+
+        if (d >= dim) {
+            continue;
+        }
+
+        // The coefficients of the SORSolver times the extent of the cell, which leaves the
+        // inverse distances of the cell centres
+        const FLOAT* const width = parameters_.meshMetrics->getSpacing(d) + 1;
+        for (int i = 1; i <= cells; i++) {
+            const FLOAT centreLow = 0.5 * (width[i - 1] + width[i]);
+            const FLOAT centreHigh = 0.5 * (width[i] + width[i + 1]);
+
+            extent_[d][i] = 0.5 * (centreLow + centreHigh);
+            couplingLow_[d][i] = diagonalLow_[d][i] = 1.0 / centreLow;
+            couplingHigh_[d][i] = diagonalHigh_[d][i] = 1.0 / centreHigh;
+        }
+
+        // Walls: a velocity condition closes the face, an outflow keeps the pressure at zero on it
+        if (getNeighbour(parameters_, d, false) == MPI_PROC_NULL && !isPeriodic(parameters_, d)) {
+            couplingLow_[d][1] = 0.0;
+            diagonalLow_[d][1] = getWallType(parameters_, d, false) == NEUMANN ? 2.0 * diagonalLow_[d][1] : 0.0;
+        }
+        if (getNeighbour(parameters_, d, true) == MPI_PROC_NULL && !isPeriodic(parameters_, d)) {
+            couplingHigh_[d][cells] = 0.0;
+            diagonalHigh_[d][cells] = getWallType(parameters_, d, true) == NEUMANN ? 2.0 * diagonalHigh_[d][cells] : 0.0;
+        }
+    }
+
+    const int size = index_(cells_[0] + 1, cells_[1] + 1, cells_[2] + 1) + 1;
+    diagonal_.assign(size, 0.0);
+    residual_.assign(size, 0.0);
+    preconditioned_.assign(size, 0.0);
+    direction_.assign(size, 0.0);
+    product_.assign(size, 0.0);
+    chebyshevDirection_.assign(preconditioner_ == CHEBYSHEV ? size : 0, 0.0);
+    chebyshevRemainder_.assign(preconditioner_ == CHEBYSHEV ? size : 0, 0.0);
+    for (int v = 0; v < PIPELINE_VECTORS; v++) {
+        pipeline_[v].assign(pipelined_ ? size : 0, 0.0);
+    }
+
+    // Diagonal of the fluid cells with at least one open face; the other cells are not solved for
+    const int lowBits[3] = {OBSTACLE_LEFT, OBSTACLE_BOTTOM, OBSTACLE_FRONT};
+    const int highBits[3] = {OBSTACLE_RIGHT, OBSTACLE_TOP, OBSTACLE_BACK};
+
+    for (int k = 1; k <= cells_[2]; k++) {
+        for (int j = 1; j <= cells_[1]; j++) {
+            for (int i = 1; i <= cells_[0]; i++) {
+                const int flag = flags_[flagIndex_(i, j, k)];
+                if (flag & OBSTACLE_SELF) {
+                    continue;
+                }
+
+                const int indices[3] = {i, j, k};
+                const FLOAT extents[3] = {extent_[0][i], extent_[1][j], extent_[2][k]};
+
+                FLOAT diagonal = 0.0;
+                for (int d = 0; d < dim; d++) {
+                    const FLOAT weight = extents[(d + 1) % 3] * extents[(d + 2) % 3];
+                    diagonal += weight * (((flag & lowBits[d]) == 0) * diagonalLow_[d][indices[d]] +
+                                          ((flag & highBits[d]) == 0) * diagonalHigh_[d][indices[d]]);
+                }
+                diagonal_[index_(i, j, k)] = diagonal;
+            }
+        }
+    }
+
+    // Buffers for the largest face of the subdomain
+    int faceSize = 1;
+    for (int d = 0; d < 3; d++) {
+        faceSize = std::max(faceSize, cells_[(d + 1) % 3] * cells_[(d + 2) % 3]);
+    }
+    sendBuffer_.assign(faceSize, 0.0);
+    receiveBuffer_.assign(faceSize, 0.0);
+}
+
+template <class D>
+inline FLOAT CGSolver::getNeighbours_(const FLOAT* const values, int c, int flag, int i, int j, int k) const {
+    const int strideY = strides_[1];
+    const FLOAT extentX = extent_[0][i];
+    const FLOAT extentY = extent_[1][j];
+    const FLOAT extentZ = extent_[2][k];
+
+    FLOAT neighbours = extentY * extentZ * (((flag & OBSTACLE_LEFT) == 0) * couplingLow_[0][i] * values[c - 1]
+                                          + ((flag & OBSTACLE_RIGHT) == 0) * couplingHigh_[0][i] * values[c + 1])
+                     + extentX * extentZ * (((flag & OBSTACLE_BOTTOM) == 0) * couplingLow_[1][j] * values[c - strideY]
+                                          + ((flag & OBSTACLE_TOP) == 0) * couplingHigh_[1][j] * values[c + strideY]);
+
+    if constexpr (D::value == 3) {
+        const int strideZ = strides_[2];
+        neighbours += extentX * extentY * (((flag & OBSTACLE_FRONT) == 0) * couplingLow_[2][k] * values[c - strideZ]
+                                         + ((flag & OBSTACLE_BACK) == 0) * couplingHigh_[2][k] * values[c + strideZ]);
+    }
+
+    return neighbours;
+}
+
+template <class D>
+FLOAT CGSolver::applyOperator_(FLOAT* const values, FLOAT* const result) {
+    const FLOAT* const diagonal = diagonal_.data();
+    FLOAT product = 0.0;
+
+    updateGhosts_(values);
+
+    #pragma omp parallel for collapse(2) schedule(static) reduction(+:product)
+    for (int k = 1; k <= cells_[2]; k++) {
+        for (int j = 1; j <= cells_[1]; j++) {
+            for (int i = 1; i <= cells_[0]; i++) {
+                const int c = index_(i, j, k);
+
+                if (diagonal[c] == 0.0) {
+                    result[c] = 0.0;
+                    continue;
+                }
+
+                const int flag = flags_[flagIndex_(i, j, k)];
+                result[c] = diagonal[c] * values[c] - getNeighbours_<D>(values, c, flag, i, j, k);
+                product += values[c] * result[c];
+            }
+        }
+    }
+
+    return product;
+}
+
+void CGSolver::getProducts_(FLOAT& residualNorm, FLOAT& rz) const {
+    const FLOAT* const r = residual_.data();
+    const FLOAT* const z = preconditioned_.data();
+    FLOAT rr = 0.0, product = 0.0;
+
+    #pragma omp parallel for collapse(2) schedule(static) reduction(+:rr, product)
+    for (int k = 1; k <= cells_[2]; k++) {
+        for (int j = 1; j <= cells_[1]; j++) {
+            for (int i = 1; i <= cells_[0]; i++) {
+                const int c = index_(i, j, k);
+                rr += r[c] * r[c];
+                product += r[c] * z[c];
+            }
+        }
+    }
+
+    residualNorm = rr;
+    rz = product;
+}
+
+void CGSolver::removeMean_(FLOAT* const values) const {
+    // The null space of the operator is the constant on the cells solved for
+    const FLOAT* const diagonal = diagonal_.data();
+    FLOAT sum = 0.0, count = 0.0;
+
+    #pragma omp parallel for collapse(2) schedule(static) reduction(+:sum, count)
+    for (int k = 1; k <= cells_[2]; k++) {
+        for (int j = 1; j <= cells_[1]; j++) {
+            for (int i = 1; i <= cells_[0]; i++) {
+                const int c = index_(i, j, k);
+                if (diagonal[c] > 0.0) {
+                    sum += values[c];
+                    count += 1.0;
+                }
+            }
+        }
+    }
+
+    FLOAT local[2] = {sum, count};
+    FLOAT global[2];
+    MPI_Allreduce(local, global, 2, MY_MPI_FLOAT, MPI_SUM, PETSC_COMM_WORLD);
+
+    if (global[1] == 0.0) {
+        return;
+    }
+
+    const FLOAT mean = global[0] / global[1];
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int k = 1; k <= cells_[2]; k++) {
+        for (int j = 1; j <= cells_[1]; j++) {
+            for (int i = 1; i <= cells_[0]; i++) {
+                const int c = index_(i, j, k);
+                if (diagonal[c] > 0.0) {
+                    values[c] -= mean;
+                }
+            }
+        }
+    }
+}
+
+template <class D>
+void CGSolver::relaxSSOR_(const FLOAT* const r, FLOAT* const z, int colour) {
+    const FLOAT* const diagonal = diagonal_.data();
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int k = 1; k <= cells_[2]; k++) {
+        for (int j = 1; j <= cells_[1]; j++) {
+            // Cells with (i + j + k) % 2 == colour
+            const int first = (1 + j + k) % 2 == colour ? 1 : 2;
+
+            for (int i = first; i <= cells_[0]; i += 2) {
+                const int c = index_(i, j, k);
+                if (diagonal[c] == 0.0) {
+                    continue;
+                }
+
+                const int flag = flags_[flagIndex_(i, j, k)];
+                const FLOAT update = (r[c] + getNeighbours_<D>(z, c, flag, i, j, k)) / diagonal[c];
+                z[c] = (1.0 - SSOR_OMEGA) * z[c] + SSOR_OMEGA * update;
+            }
+        }
+    }
+}
+
+template <class D>
+void CGSolver::applyChebyshev_(const FLOAT* const r, FLOAT* const z) {
+    // Chebyshev iteration on M z = r with the Jacobi-scaled operator, starting from z = 0; the
+    // result is a fixed polynomial in the operator applied to r, see Saad, Iterative Methods for
+    // Sparse Linear Systems, Algorithm 12.1
+    const FLOAT upper = 2.0;
+    const FLOAT lower = upper / CHEBYSHEV_RATIO;
+    const FLOAT theta = 0.5 * (upper + lower);
+    const FLOAT delta = 0.5 * (upper - lower);
+    const FLOAT sigma = theta / delta;
+    FLOAT rho = 1.0 / sigma;
+
+    FLOAT* const remainder = chebyshevRemainder_.data();
+    FLOAT* const step = chebyshevDirection_.data();
+    const FLOAT* const diagonal = diagonal_.data();
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int k = 1; k <= cells_[2]; k++) {
+        for (int j = 1; j <= cells_[1]; j++) {
+            for (int i = 1; i <= cells_[0]; i++) {
+                const int c = index_(i, j, k);
+                const FLOAT scaled = diagonal[c] > 0.0 ? r[c] / diagonal[c] : 0.0;
+                remainder[c] = r[c];
+                step[c] = scaled / theta;
+                z[c] = step[c];
+            }
+        }
+    }
+
+    for (int degree = 1; degree < CHEBYSHEV_DEGREE; degree++) {
+        const FLOAT nextRho = 1.0 / (2.0 * sigma - rho);
+        const FLOAT stepFactor = nextRho * rho;
+        const FLOAT remainderFactor = 2.0 * nextRho / delta;
+
+        updateGhosts_(step);
+
+        // Remainder of the current iterate, which depends on the neighbouring steps, so the new
+        // steps are written in a second sweep
+        #pragma omp parallel for collapse(2) schedule(static)
+        for (int k = 1; k <= cells_[2]; k++) {
+            for (int j = 1; j <= cells_[1]; j++) {
+                for (int i = 1; i <= cells_[0]; i++) {
+                    const int c = index_(i, j, k);
+                    if (diagonal[c] > 0.0) {
+                        const int flag = flags_[flagIndex_(i, j, k)];
+                        remainder[c] -= diagonal[c] * step[c] - getNeighbours_<D>(step, c, flag, i, j, k);
+                    }
+                }
+            }
+        }
+
+        #pragma omp parallel for collapse(2) schedule(static)
+        for (int k = 1; k <= cells_[2]; k++) {
+            for (int j = 1; j <= cells_[1]; j++) {
+                for (int i = 1; i <= cells_[0]; i++) {
+                    const int c = index_(i, j, k);
+                    const FLOAT scaled = diagonal[c] > 0.0 ? remainder[c] / diagonal[c] : 0.0;
+                    step[c] = stepFactor * step[c] + remainderFactor * scaled;
+                    z[c] += step[c];
+                }
+            }
+        }
+
+        rho = nextRho;
+    }
+}
+
+template <class D>
+void CGSolver::precondition_(const FLOAT* const r, FLOAT* const z) {
+    const FLOAT* const diagonal = diagonal_.data();
+
+    switch (preconditioner_) {
+    case JACOBI:
+        #pragma omp parallel for collapse(2) schedule(static)
+        for (int k = 1; k <= cells_[2]; k++) {
+            for (int j = 1; j <= cells_[1]; j++) {
+                for (int i = 1; i <= cells_[0]; i++) {
+                    const int c = index_(i, j, k);
+                    z[c] = diagonal[c] > 0.0 ? r[c] / diagonal[c] : 0.0;
+                }
+            }
+        }
+        break;
+
+    case SSOR:
+        // Forward and backward red-black sweeps from zero; the ghost cells of z stay zero, which
+        // decouples the processes and the periodic ends. The black cells only depend on the red
+        // ones, so the black sweeps of both directions coincide and are done once.
+        std::fill(z, z + diagonal_.size(), 0.0);
+        relaxSSOR_<D>(r, z, 0);
+        relaxSSOR_<D>(r, z, 1);
+        relaxSSOR_<D>(r, z, 0);
+        break;
+
+    case CHEBYSHEV:
+        applyChebyshev_<D>(r, z);
+        break;
+    }
+}
+
+template <class D>
+FLOAT CGSolver::setInitialResidual_() {
+    FLOAT* const r = residual_.data();
+    FLOAT* const q = product_.data();
+    const FLOAT* const diagonal = diagonal_.data();
+
+    // The system multiplied by the negated control volumes: M p = f with f = -V rhs
+    FLOAT rhsNorm = 0.0;
+
+    applyOperator_<D>(pressure_, q);
+
+    #pragma omp parallel for collapse(2) schedule(static) reduction(+:rhsNorm)
+    for (int k = 1; k <= cells_[2]; k++) {
+        for (int j = 1; j <= cells_[1]; j++) {
+            for (int i = 1; i <= cells_[0]; i++) {
+                const int c = index_(i, j, k);
+                if (diagonal[c] == 0.0) {
+                    r[c] = 0.0;
+                    continue;
+                }
+
+                const FLOAT f = -extent_[0][i] * extent_[1][j] * extent_[2][k] * rhs_[c];
+                r[c] = f - q[c];
+                rhsNorm += f * f;
+            }
+        }
+    }
+
+    // Without an outflow wall, the pressure is determined up to a constant, and only the part of
+    // the right-hand side orthogonal to it can be satisfied
+    if (singular_) {
+        removeMean_(r);
+    }
+
+    return rhsNorm;
+}
+
+template <class D>
+int CGSolver::iterate_(FLOAT& residualNorm) {
+    FLOAT* const p = pressure_;
+    FLOAT* const r = residual_.data();
+    FLOAT* const z = preconditioned_.data();
+    FLOAT* const d = direction_.data();
+    FLOAT* const q = product_.data();
+
+    FLOAT local[3] = {setInitialResidual_<D>(), 0.0, 0.0};
+    precondition_<D>(r, z);
+    getProducts_(local[1], local[2]);
+
+    FLOAT global[3];
+    MPI_Allreduce(local, global, 3, MY_MPI_FLOAT, MPI_SUM, PETSC_COMM_WORLD);
+
+    // Relative to the right-hand side, or to the initial residual if that is larger, e.g. for a
+    // zero right-hand side, like in the MultigridSolver
+    const FLOAT tolerance = tolerance_ > 0 ? tolerance_ : DEFAULT_TOLERANCE;
+    const FLOAT threshold = tolerance * tolerance * std::max(global[0], global[1]);
+    residualNorm = global[1];
+    FLOAT rz = global[2];
+
+    std::copy(preconditioned_.begin(), preconditioned_.end(), direction_.begin());
+
+    int iterations = 0;
+    while (residualNorm > threshold && iterations < maxIterations_) {
+        FLOAT curvature = applyOperator_<D>(d, q);
+        MPI_Allreduce(MPI_IN_PLACE, &curvature, 1, MY_MPI_FLOAT, MPI_SUM, PETSC_COMM_WORLD);
+
+        if (curvature <= 0.0) {
+            break;
+        }
+        const FLOAT alpha = rz / curvature;
+
+        #pragma omp parallel for collapse(2) schedule(static)
+        for (int k = 1; k <= cells_[2]; k++) {
+            for (int j = 1; j <= cells_[1]; j++) {
+                for (int i = 1; i <= cells_[0]; i++) {
+                    const int c = index_(i, j, k);
+                    p[c] += alpha * d[c];
+                    r[c] -= alpha * q[c];
+                }
+            }
+        }
+
+        // Both products of the residual in one reduction
+        precondition_<D>(r, z);
+        getProducts_(local[0], local[1]);
+        MPI_Allreduce(local, global, 2, MY_MPI_FLOAT, MPI_SUM, PETSC_COMM_WORLD);
+
+        residualNorm = global[0];
+        const FLOAT beta = global[1] / rz;
+        rz = global[1];
+        iterations++;
+
+        #pragma omp parallel for collapse(2) schedule(static)
+        for (int k = 1; k <= cells_[2]; k++) {
+            for (int j = 1; j <= cells_[1]; j++) {
+                for (int i = 1; i <= cells_[0]; i++) {
+                    const int c = index_(i, j, k);
+                    d[c] = z[c] + beta * d[c];
+                }
+            }
+        }
+    }
+
+    return iterations;
+}
+
+template <class D>
+int CGSolver::iteratePipelined_(FLOAT& residualNorm) {
+    // Algorithm 4 of Ghysels and Vanroose, Hiding global synchronization latency in the
+    // preconditioned conjugate gradient algorithm, Parallel Computing 40 (2014). Besides the
+    // residual r, its preconditioned version u and the direction p, the products w = M u,
+    // m = P w, n = M m, s = M p, q = P s and z = M q (P the preconditioner) follow from recurrences.
+    FLOAT* const x = pressure_;
+    FLOAT* const r = residual_.data();
+    FLOAT* const u = preconditioned_.data();
+    FLOAT* const p = direction_.data();
+    FLOAT* const s = product_.data();
+    FLOAT* const w = pipeline_[W].data();
+    FLOAT* const m = pipeline_[M].data();
+    FLOAT* const n = pipeline_[N].data();
+    FLOAT* const q = pipeline_[Q].data();
+    FLOAT* const z = pipeline_[Z].data();
+
+    FLOAT rhsNorm = setInitialResidual_<D>();
+    MPI_Allreduce(MPI_IN_PLACE, &rhsNorm, 1, MY_MPI_FLOAT, MPI_SUM, PETSC_COMM_WORLD);
+    FLOAT threshold = 0.0;
+
+    precondition_<D>(r, u);
+    applyOperator_<D>(u, w);
+
+    FLOAT previousGamma = 0.0;
+    FLOAT previousAlpha = 0.0;
+    int iterations = 0;
+
+    while (true) {
+        // The only reduction of the iteration, which runs while the preconditioner and the
+        // operator are applied
+        FLOAT rr = 0.0, gamma = 0.0, delta = 0.0;
+
+        #pragma omp parallel for collapse(2) schedule(static) reduction(+:rr, gamma, delta)
+        for (int k = 1; k <= cells_[2]; k++) {
+            for (int j = 1; j <= cells_[1]; j++) {
+                for (int i = 1; i <= cells_[0]; i++) {
+                    const int c = index_(i, j, k);
+                    rr += r[c] * r[c];
+                    gamma += r[c] * u[c];
+                    delta += w[c] * u[c];
+                }
+            }
+        }
+
+        FLOAT local[3] = {rr, gamma, delta};
+        FLOAT global[3];
+        MPI_Request request;
+        MPI_Iallreduce(local, global, 3, MY_MPI_FLOAT, MPI_SUM, PETSC_COMM_WORLD, &request);
+
+        precondition_<D>(w, m);
+        applyOperator_<D>(m, n);
+
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+        residualNorm = global[0];
+        if (iterations == 0) {
+            // See iterate_
+            const FLOAT tolerance = tolerance_ > 0 ? tolerance_ : DEFAULT_TOLERANCE;
+            threshold = tolerance * tolerance * std::max(rhsNorm, residualNorm);
+        }
+        if (residualNorm <= threshold || iterations >= maxIterations_) {
+            break;
+        }
+
+        gamma = global[1];
+        delta = global[2];
+        const FLOAT beta = iterations > 0 ? gamma / previousGamma : 0.0;
+        const FLOAT curvature = iterations > 0 ? delta - beta * gamma / previousAlpha : delta;
+
+        if (curvature <= 0.0) {
+            break;
+        }
+        const FLOAT alpha = gamma / curvature;
+
+        #pragma omp parallel for collapse(2) schedule(static)
+        for (int k = 1; k <= cells_[2]; k++) {
+            for (int j = 1; j <= cells_[1]; j++) {
+                for (int i = 1; i <= cells_[0]; i++) {
+                    const int c = index_(i, j, k);
+
+                    z[c] = n[c] + beta * z[c];
+                    q[c] = m[c] + beta * q[c];
+                    s[c] = w[c] + beta * s[c];
+                    p[c] = u[c] + beta * p[c];
+
+                    x[c] += alpha * p[c];
+                    r[c] -= alpha * s[c];
+                    u[c] -= alpha * q[c];
+                    w[c] -= alpha * z[c];
+                }
+            }
+        }
+
+        previousGamma = gamma;
+        previousAlpha = alpha;
+        iterations++;
+    }
+
+    return iterations;
+}
+
+template <class D>
+void CGSolver::solve_() {
+    const double start = MPI_Wtime();
+
+    FLOAT residualNorm = 0.0;
+    const int iterations = pipelined_ ? iteratePipelined_<D>(residualNorm) : iterate_<D>(residualNorm);
+
+    if (parameters_.parallel.rank == 0) {
+        const double time = MPI_Wtime() - start;
+        std::cout << "CGSolver needed " << iterations << " iterations, residual " << sqrt(residualNorm);
+        if (parameters_.solver.timing) {
+            std::cout << ", " << 1e3 * time / std::max(iterations, 1) << " ms per iteration";
+        }
+        std::cout << std::endl;
+    }
+}
+
+void CGSolver::solve() {
+    if (parameters_.geometry.dim == 3) {
+        solve_<Dim<3>>();
+    } else {
+        solve_<Dim<2>>();
+    }
+
+    updateGhosts_(pressure_);
+    setObstaclePressure(parameters_, flowField_.getFlags(), cells_, strides_, pressure_);
+}
+
+void CGSolver::reInitMatrix() {
+    setCoefficients_();
+}
+
+} // namespace Solvers
+} // namespace NSEOF
@@ -0,0 +1,113 @@
+#ifndef __SOLVERS_CG_SOLVER_HPP__
+#define __SOLVERS_CG_SOLVER_HPP__
+
+#include "LinearSolver.hpp"
+#include "PressureBoundaries.hpp"
+
+#include <vector>
+
+namespace NSEOF {
+namespace Solvers {
+
+/** Matrix-free preconditioned conjugate gradient solver for the pressure equation
+ *
+ * Iterates on the pressure and right-hand side of the flow field in place, with work vectors of
+ * the same layout. The operator of the SORSolver is applied on the fly from the cell flags and
+ * 1D coefficients; multiplying every row by the negated control volume of its cell makes it
+ * symmetric and positive (semi-)definite. Faces towards obstacles and walls with a velocity
+ * condition are closed, outflow walls keep the pressure at zero. Preconditioners are Jacobi,
+ * symmetric red-black SOR and a Chebyshev polynomial in the Jacobi-scaled operator; SSOR treats
+ * the neighbouring processes as zero, so it needs no communication.
+ *
+ * The pipelined variant needs a single global reduction per iteration instead of two, and
+ * overlaps it with the application of the preconditioner and the operator. It pays off when the
+ * latency of the reductions dominates, i.e. on many processes; it does more vector updates and is
+ * slightly less accurate otherwise.
+ */
+class CGSolver : public LinearSolver {
+private:
+    enum Preconditioner { JACOBI, SSOR, CHEBYSHEV };
+
+    Preconditioner preconditioner_;
+    int maxIterations_;
+    bool pipelined_;
+    bool singular_; //! No wall fixes the pressure level, so the right-hand side is kept free of a mean value
+
+    // Like in the MultigridSolver, cell (i, j, k) of the flow field is (i - 1, j - 1, k - 1) here,
+    // so the inner cells run from 1 to cells_
+    int cells_[3];        //! Inner cells, 1 beyond the dimension
+    int strides_[3];      //! Strides of the pressure field, 0 beyond the dimension
+    int flagStrides_[3];  //! Strides of the flag field, 0 beyond the dimension
+    FLOAT* pressure_;     //! Pressure of the first ghost cell of the flow field
+    const FLOAT* rhs_;
+    const int* flags_;
+
+    // Indexed like the cells of the flow field in the respective direction; the couplings are
+    // those of the SORSolver, multiplied by the extent of the cell in the direction
+    std::vector<FLOAT> extent_[3];
+    std::vector<FLOAT> couplingLow_[3];  //! Coupling to the lower neighbour, zero at walls
+    std::vector<FLOAT> couplingHigh_[3]; //! Coupling to the upper neighbour, zero at walls
+    std::vector<FLOAT> diagonalLow_[3];  //! Contribution of the lower face to the diagonal
+    std::vector<FLOAT> diagonalHigh_[3]; //! Contribution of the upper face to the diagonal
+
+    // Vectors with the layout of the pressure field
+    std::vector<FLOAT> diagonal_; //! Diagonal of the operator, zero for the cells not solved for
+    std::vector<FLOAT> residual_;
+    std::vector<FLOAT> preconditioned_;
+    std::vector<FLOAT> direction_;
+    std::vector<FLOAT> product_;
+    std::vector<FLOAT> chebyshevDirection_; //! Chebyshev only
+    std::vector<FLOAT> chebyshevRemainder_; //! Chebyshev only
+
+    // Pipelined CG only, see iteratePipelined_
+    enum PipelineVector { W, M, N, Q, Z, PIPELINE_VECTORS };
+    std::vector<FLOAT> pipeline_[PIPELINE_VECTORS];
+
+    std::vector<FLOAT> sendBuffer_;
+    std::vector<FLOAT> receiveBuffer_;
+
+    void setCoefficients_();
+    void updateGhosts_(FLOAT* values) { updateGhosts(parameters_, cells_, strides_, values, sendBuffer_, receiveBuffer_); }
+
+    int index_(int i, int j, int k) const { return i + j * strides_[1] + k * strides_[2]; }
+    int flagIndex_(int i, int j, int k) const { return i + j * flagStrides_[1] + k * flagStrides_[2]; }
+
+    /** Sum of the neighbour terms of the scaled operator in cell c = (i, j, k) with the given flag,
+     *  such that (M values)_c = diagonal_[c] * values[c] - neighbours
+     */
+    template <class D>
+    FLOAT getNeighbours_(const FLOAT* values, int c, int flag, int i, int j, int k) const;
+
+    // result = M values on the cells solved for; returns the local dot product of values and result
+    template <class D> FLOAT applyOperator_(FLOAT* values, FLOAT* result);
+
+    // z = P r for the preconditioner P; r and z must not overlap
+    template <class D> void precondition_(const FLOAT* r, FLOAT* z);
+    template <class D> void relaxSSOR_(const FLOAT* r, FLOAT* z, int colour);
+    template <class D> void applyChebyshev_(const FLOAT* r, FLOAT* z);
+
+    // Sets the residual from the pressure; returns the local squared norm of the right-hand side
+    template <class D> FLOAT setInitialResidual_();
+
+    // Return the number of iterations, and the squared norm of the last residual
+    template <class D> int iterate_(FLOAT& residualNorm);
+    template <class D> int iteratePipelined_(FLOAT& residualNorm);
+
+    template <class D> void solve_();
+
+    // Local products (r, r) and (r, z) of the residual and the preconditioned residual
+    void getProducts_(FLOAT& residualNorm, FLOAT& rz) const;
+    void removeMean_(FLOAT* values) const;
+
+public:
+    CGSolver(FlowField& flowField, const Parameters& parameters);
+    ~CGSolver() override = default;
+
+    void solve() override;
+    void reInitMatrix() override;
+};
+
+} // namespace Solvers
+} // namespace NSEOF
+
+#endif // __SOLVERS_CG_SOLVER_HPP__
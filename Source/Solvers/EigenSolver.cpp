@@ -9,9 +9,9 @@ namespace NSEOF::Solvers {
         : dxLeft(dxLeft), dxRight(dxRight), dyBottom(dyBottom), dyTop(dyTop), dzFront(dzFront), dzBack(dzBack) {}
 
     void EigenSolver::fillCoefficientsVector_() {
-        coefficientsVector_.clear();
-        coefficientsVector_.reserve(dim_);
+        coefficientsVector_.assign(dim_, Coefficients(0.0, 0.0, 0.0, 0.0, 0.0, 0.0));
 
+        #pragma omp parallel for collapse(2) schedule(static)
         for (int k = 0; k < cellsZ_; k++) {
             for (int j = 0; j < cellsY_; j++) {
                 for (int i = 0; i < cellsX_; i++) {
@@ -26,217 +26,294 @@ namespace NSEOF::Solvers {
                     const FLOAT dzFront  = 0.5 * (dz + parameters_.meshsize->getDz(i, j, k - 1));
                     const FLOAT dzBack   = 0.5 * (dz + parameters_.meshsize->getDz(i, j, k + 1));
 
-                    coefficientsVector_.emplace_back(dxLeft, dxRight, dyBottom, dyTop, dzFront, dzBack);
+                    coefficientsVector_[ROW_MAJOR_IDX(i, j, k, cellsX_, cellsY_)] =
+                        Coefficients(dxLeft, dxRight, dyBottom, dyTop, dzFront, dzBack);
                 }
             }
         }
     }
 
-    void EigenSolver::computeStencilRowForFluidCell_(VectorXd& stencilRow, const int i, const int j, const int k = 0) const {
+    void EigenSolver::computeStencilRowForFluidCell_(StencilRow& stencilRow, const int row,
+                                                     const int i, const int j, const int k) const {
         const Coefficients coefficients = coefficientsVector_[ROW_MAJOR_IDX(i, j, k, cellsX_, cellsY_)];
-        const int centerIdx = (parameters_.geometry.dim == 2) ? cellsX_ : cellsX_ * cellsY_;
 
-        /* Bottom */ stencilRow(centerIdx - cellsX_) = 2.0 / (coefficients.dyBottom * (coefficients.dyBottom + coefficients.dyTop));
-        /* Left   */ stencilRow(centerIdx - 1      ) = 2.0 / (coefficients.dxLeft * (coefficients.dxLeft + coefficients.dxRight));
-        /* Center */ stencilRow(centerIdx          ) = 2.0 / (coefficients.dxLeft * coefficients.dxRight) + 2.0 / (coefficients.dyBottom * coefficients.dyTop);
-        /* Right  */ stencilRow(centerIdx + 1      ) = 2.0 / (coefficients.dxRight * (coefficients.dxLeft + coefficients.dxRight));
-        /* Top    */ stencilRow(centerIdx + cellsX_) = 2.0 / (coefficients.dyTop * (coefficients.dyBottom + coefficients.dyTop));
+        FLOAT center = 2.0 / (coefficients.dxLeft * coefficients.dxRight) + 2.0 / (coefficients.dyBottom * coefficients.dyTop);
 
         if (parameters_.geometry.dim == 3) { // 3D
-            /* Front  */ stencilRow(centerIdx - cellsX_ * cellsY_) =  2.0 / (coefficients.dzFront * (coefficients.dzBack + coefficients.dzFront));
-            /* Center */ stencilRow(centerIdx                    ) += 2.0 / (coefficients.dzFront * coefficients.dzBack);
-            /* Back   */ stencilRow(centerIdx + cellsX_ * cellsY_) =  2.0 / (coefficients.dzBack * (coefficients.dzBack + coefficients.dzFront));
+            /* Front  */ stencilRow.add(row - cellsX_ * cellsY_, 2.0 / (coefficients.dzFront * (coefficients.dzBack + coefficients.dzFront)));
+            /* Center */ center += 2.0 / (coefficients.dzFront * coefficients.dzBack);
         }
 
-        /* Center */ stencilRow(centerIdx) *= -1.0;
+        /* Bottom */ stencilRow.add(row - cellsX_, 2.0 / (coefficients.dyBottom * (coefficients.dyBottom + coefficients.dyTop)));
+        /* Left   */ stencilRow.add(row - 1,       2.0 / (coefficients.dxLeft * (coefficients.dxLeft + coefficients.dxRight)));
+        /* Center */ stencilRow.add(row,           -center);
+        /* Right  */ stencilRow.add(row + 1,       2.0 / (coefficients.dxRight * (coefficients.dxLeft + coefficients.dxRight)));
+        /* Top    */ stencilRow.add(row + cellsX_, 2.0 / (coefficients.dyTop * (coefficients.dyBottom + coefficients.dyTop)));
+
+        if (parameters_.geometry.dim == 3) { // 3D
+            /* Back   */ stencilRow.add(row + cellsX_ * cellsY_, 2.0 / (coefficients.dzBack * (coefficients.dzBack + coefficients.dzFront)));
+        }
     }
 
-    void EigenSolver::computeStencilRowForObstacleCellWithFluidAround_(const int obstacle, VectorXd& stencilRow) const {
+    void EigenSolver::computeStencilRowForObstacleCellWithFluidAround_(StencilRow& stencilRow, const int row,
+                                                                       const int obstacle) const {
+        const bool is3D = parameters_.geometry.dim == 3;
+
         const auto bottomFluid = (FLOAT) ((obstacle & OBSTACLE_BOTTOM) == 0);
         const auto leftFluid   = (FLOAT) ((obstacle & OBSTACLE_LEFT)   == 0);
         const auto rightFluid  = (FLOAT) ((obstacle & OBSTACLE_RIGHT)  == 0);
         const auto topFluid    = (FLOAT) ((obstacle & OBSTACLE_TOP)    == 0);
+        const auto frontFluid  = (FLOAT) (is3D && (obstacle & OBSTACLE_FRONT) == 0);
+        const auto backFluid   = (FLOAT) (is3D && (obstacle & OBSTACLE_BACK)  == 0);
 
-        const int centerIdx = (parameters_.geometry.dim == 2) ? cellsX_ : cellsX_ * cellsY_;
+        FLOAT center = bottomFluid + leftFluid + rightFluid + topFluid;
 
-        /* Bottom */ stencilRow(centerIdx - cellsX_) = bottomFluid;
-        /* Left   */ stencilRow(centerIdx - 1      ) = leftFluid;
-        /* Center */ stencilRow(centerIdx          ) = bottomFluid + leftFluid + rightFluid + topFluid;
-        /* Right  */ stencilRow(centerIdx + 1      ) = rightFluid;
-        /* Top    */ stencilRow(centerIdx + cellsX_) = topFluid;
+        if (is3D) { // 3D
+            /* Front  */ stencilRow.add(row - cellsX_ * cellsY_, frontFluid);
+            /* Center */ center += frontFluid + backFluid;
+        }
 
-        if (parameters_.geometry.dim == 3) { // 3D
-            const auto frontFluid = (FLOAT) ((obstacle & OBSTACLE_FRONT) == 0);
-            const auto backFluid  = (FLOAT) ((obstacle & OBSTACLE_BACK)  == 0);
+        /* Bottom */ stencilRow.add(row - cellsX_, bottomFluid);
+        /* Left   */ stencilRow.add(row - 1,       leftFluid);
+        /* Center */ stencilRow.add(row,           -center);
+        /* Right  */ stencilRow.add(row + 1,       rightFluid);
+        /* Top    */ stencilRow.add(row + cellsX_, topFluid);
 
-            /* Front  */ stencilRow(centerIdx - cellsX_ * cellsY_) =  frontFluid;
-            /* Center */ stencilRow(centerIdx                    ) += frontFluid + backFluid;
-            /* Back   */ stencilRow(centerIdx + cellsX_ * cellsY_) =  backFluid;
+        if (is3D) { // 3D
+            /* Back   */ stencilRow.add(row + cellsX_ * cellsY_, backFluid);
         }
+    }
 
-        /* Center */ stencilRow(centerIdx) *= -1.0;
+    void EigenSolver::computeStencilRowForObstacleCell_(StencilRow& stencilRow, const int row) const {
+        /* Center */ stencilRow.add(row, 1.0);
     }
 
-    void EigenSolver::computeStencilRowForObstacleCell_(VectorXd& stencilRow) const {
-        const int centerIdx = (parameters_.geometry.dim == 2) ? cellsX_ : cellsX_ * cellsY_;
+    /**
+     * Computes the row of a cell in the ghost layers, which couples it to the adjacent inner cell
+     *
+     * Cells on edges and corners of the ghost layers are not coupled to any other cell. They get a
+     * unit diagonal, so that the matrix can be factorized; their right-hand side is zero.
+     */
+    void EigenSolver::computeStencilRowOnBoundary_(StencilRow& stencilRow, const int row,
+                                                   const int i, const int j, const int k) const {
+        const bool innerX = i > 0 && i < cellsX_ - 1;
+        const bool innerY = j > 0 && j < cellsY_ - 1;
+        const bool innerZ = parameters_.geometry.dim == 2 || (k > 0 && k < cellsZ_ - 1);
+
+        BoundaryType boundaryType;
+        int offset; // From the ghost cell to the inner cell
+
+        if (innerY && innerZ && (i == 0 || i == cellsX_ - 1)) { // Left and right walls
+            boundaryType = (i == 0) ? parameters_.walls.typeLeft : parameters_.walls.typeRight;
+            offset = (i == 0) ? 1 : -1;
+        } else if (innerX && innerZ && (j == 0 || j == cellsY_ - 1)) { // Bottom and top walls
+            boundaryType = (j == 0) ? parameters_.walls.typeBottom : parameters_.walls.typeTop;
+            offset = (j == 0) ? cellsX_ : -cellsX_;
+        } else if (innerX && innerY && (k == 0 || k == cellsZ_ - 1)) { // Front and back walls
+            boundaryType = (k == 0) ? parameters_.walls.typeFront : parameters_.walls.typeBack;
+            offset = (k == 0) ? cellsX_ * cellsY_ : -cellsX_ * cellsY_;
+        } else {
+            stencilRow.add(row, 1.0);
+            return;
+        }
 
-        /* Bottom */ stencilRow(centerIdx - cellsX_) = 0.0;
-        /* Left   */ stencilRow(centerIdx - 1      ) = 0.0;
-        /* Center */ stencilRow(centerIdx          ) = 1.0;
-        /* Right  */ stencilRow(centerIdx + 1      ) = 0.0;
-        /* Top    */ stencilRow(centerIdx + cellsX_) = 0.0;
+        const FLOAT ghostValue = (boundaryType == DIRICHLET) ? 1.0 : 0.5;
+        const FLOAT innerValue = (boundaryType == DIRICHLET) ? -1.0 : 0.5;
 
-        if (parameters_.geometry.dim == 3) { // 3D
-            /* Front */ stencilRow(centerIdx - cellsX_ * cellsY_) = 0.0;
-            /* Back  */ stencilRow(centerIdx + cellsX_ * cellsY_) = 0.0;
+        if (offset < 0) {
+            stencilRow.add(row + offset, innerValue);
+            stencilRow.add(row, ghostValue);
+        } else {
+            stencilRow.add(row, ghostValue);
+            stencilRow.add(row + offset, innerValue);
+        }
+    }
+
+    void EigenSolver::computeStencilRow_(StencilRow& stencilRow, const int row) const {
+        if (row == pinnedRow_) {
+            stencilRow.add(row, 1.0);
+            return;
+        }
+
+        const int i = row % cellsX_;
+        const int j = (row / cellsX_) % cellsY_;
+        const int k = row / (cellsX_ * cellsY_);
+
+        const bool inner = i > 0 && i < cellsX_ - 1 && j > 0 && j < cellsY_ - 1
+                        && (parameters_.geometry.dim == 2 || (k > 0 && k < cellsZ_ - 1));
+
+        if (!inner) {
+            computeStencilRowOnBoundary_(stencilRow, row, i, j, k);
+            return;
+        }
+
+        const int sumObstacles = (1 << (parameters_.geometry.dim * 2 + 1)) - 1;
+        const int obstacle = (parameters_.geometry.dim == 2) ? flowField_.getFlags().getValue(i + 1, j + 1)
+                                                             : flowField_.getFlags().getValue(i + 1, j + 1, k + 1);
+
+        if ((obstacle & OBSTACLE_SELF) == 0) { // It is a fluid cell
+            computeStencilRowForFluidCell_(stencilRow, row, i, j, k);
+        } else if (obstacle != sumObstacles) { // Not a fluid cell, but fluid is somewhere around
+            computeStencilRowForObstacleCellWithFluidAround_(stencilRow, row, obstacle);
+        } else { // The cell is an obstacle cell surrounded by more obstacle cells
+            computeStencilRowForObstacleCell_(stencilRow, row);
         }
     }
 
     /**
-     * Creates the matrix using the values on the fluid region for both 2D and 3D grids
+     * Assembles the matrix directly in compressed row storage
      *
-     * @param sumObstacles summation of all obstacles
-     * @param k the layer (face) index
+     * Every row is computed independently: a first pass counts the entries per row, so that the
+     * second pass can write each row to its final position.
      */
-    void EigenSolver::computeMatrixOnFluidRegion_(const int sumObstacles, const int k = 0) {
-        int row = cellsX_ + 1;
-        int column = 1;
+    void EigenSolver::computeMatrix_() {
+        sparseMatA_.resize(dim_, dim_);
+        sparseMatA_.makeCompressed();
 
-        if (parameters_.geometry.dim == 3) { // 3D
-            row += k * cellsX_ * cellsY_;
-            column += (k - 1) * (cellsX_ * cellsY_) + cellsX_;
+        int* const outerIndex = sparseMatA_.outerIndexPtr();
+
+        #pragma omp parallel for schedule(static)
+        for (int row = 0; row < dim_; row++) {
+            StencilRow stencilRow;
+            computeStencilRow_(stencilRow, row);
+            outerIndex[row + 1] = stencilRow.size;
         }
 
-        for (int j = 1; j < cellsY_ - 1; j++, row += 2, column += 2) {
-            for (int i = 1; i < cellsX_ - 1; i++, row++, column++) {
-                int obstacle = flowField_.getFlags().getValue(i + 1, j + 1);
-                int stencilRowLength = cellsX_ * 2 + 1;
+        outerIndex[0] = 0;
+        for (int row = 0; row < dim_; row++) {
+            outerIndex[row + 1] += outerIndex[row];
+        }
 
-                if (parameters_.geometry.dim == 3) { // 3D
-                    obstacle = flowField_.getFlags().getValue(i + 1, j + 1, k + 1);
-                    stencilRowLength = cellsX_ * cellsY_ * 2 + 1;
-                }
+        sparseMatA_.resizeNonZeros(outerIndex[dim_]);
 
-                VectorXd stencilRow = VectorXd::Zero(stencilRowLength);
+        int* const innerIndex = sparseMatA_.innerIndexPtr();
+        FLOAT* const values = sparseMatA_.valuePtr();
 
-                if ((obstacle & OBSTACLE_SELF) == 0) { // It is a fluid cell
-                    computeStencilRowForFluidCell_(stencilRow, i, j, k);
-                } else if (obstacle != sumObstacles) { // Not a fluid cell, but fluid is somewhere around
-                    computeStencilRowForObstacleCellWithFluidAround_(obstacle, stencilRow);
-                } else { // The cell is an obstacle cell surrounded by more obstacle cells
-                    computeStencilRowForObstacleCell_(stencilRow);
-                }
+        #pragma omp parallel for schedule(static)
+        for (int row = 0; row < dim_; row++) {
+            StencilRow stencilRow;
+            computeStencilRow_(stencilRow, row);
 
-                matA_.block(row, column, 1, stencilRowLength) = stencilRow.transpose();
+            for (int entry = 0; entry < stencilRow.size; entry++) {
+                innerIndex[outerIndex[row] + entry] = stencilRow.columns[entry];
+                values[outerIndex[row] + entry] = stencilRow.values[entry];
             }
         }
     }
 
-    void EigenSolver::computeMatrixOnBoundariesLeftAndRight_(const unsigned int startIdx = 0) {
-        VectorXd leftWallVector(2), rightWallVector(2);
+    void EigenSolver::initMatrix_() {
+#ifdef OMP
+        initParallel();
 
-        leftWallVector << (parameters_.walls.typeLeft == DIRICHLET ? 1.0 : 0.5),
-                          (parameters_.walls.typeLeft == DIRICHLET ? -1.0 : 0.5);
-        rightWallVector << (parameters_.walls.typeRight == DIRICHLET ? -1.0 : 0.5),
-                           (parameters_.walls.typeRight == DIRICHLET ? 1.0 : 0.5);
+        #pragma omp parallel default(none)
+        #pragma omp master
+        setNbThreads(omp_get_num_threads());
+#endif
 
-        for (int j = 1; j < cellsY_ - 1; j++) {
-            matA_.block(startIdx + j * cellsX_, startIdx + j * cellsX_, 1, 2) = leftWallVector.transpose();
-            matA_.block(startIdx + (j + 1) * cellsX_ - 1, startIdx + (j + 1) * cellsX_ - 2, 1, 2) = rightWallVector.transpose();
+        rhs_ = VectorXd::Zero(dim_);
+        x_ = VectorXd::Zero(dim_);
+
+        fillCoefficientsVector_();
+        setPinnedRow_();
+        computeMatrix_();
+
+        if (parameters_.solver.direct) {
+            factorizationIsCurrent_ = false; // Factorized by the next solve, once the geometry is complete
+            return;
         }
-    }
 
-    void EigenSolver::computeMatrixOnBoundaryBottomOrTop_(BoundaryType boundaryType,
-                                                          const unsigned int startIdx, const int direction) {
-        const MatrixXd identityMatrix = MatrixXd::Identity(cellsX_ - 2, cellsX_ - 2);
+        // A fixed maximum from the configuration replaces the adaptive one
+        currentNumIterations_ = parameters_.solver.maxIterations > 0 ? parameters_.solver.maxIterations
+                                                                     : SOLVER_ITERATIONS_MAX_NUM;
 
-        const MatrixXd diagMat = (boundaryType == DIRICHLET ? 1.0 : 0.5) * identityMatrix;
-        const MatrixXd offDiagMat = (boundaryType == DIRICHLET ? -1.0 : 0.5) * identityMatrix;
+        if (parameters_.solver.mixedPrecision) {
+            singleMatA_ = sparseMatA_.cast<float>();
+            singleSolver_.setTolerance(MIXED_PRECISION_REDUCTION);
+            singleSolver_.setMaxIterations(currentNumIterations_);
+            singleSolver_.compute(singleMatA_);
+            return;
+        }
 
-        matA_.block(startIdx, startIdx, cellsX_ - 2, cellsX_ - 2) = diagMat;
-        matA_.block(startIdx, startIdx + (direction * cellsX_), cellsX_ - 2, cellsX_ - 2) = offDiagMat;
+        std::visit([this](auto& solver) {
+            if (tolerance_ > 0) {
+                solver.setTolerance(tolerance_);
+            }
+            solver.setMaxIterations(currentNumIterations_);
+            solver.compute(sparseMatA_);
+        }, solver_);
     }
 
-    void EigenSolver::computeMatrixOnBoundaryFrontOrBack_(BoundaryType boundaryType,
-                                                          const unsigned int startIdx, const int direction) {
-        const MatrixXd identityMatrix = MatrixXd::Identity(cellsX_ - 2, cellsX_ - 2);
+    /**
+     * If no wall fixes the pressure level, the matrix is singular. The iterative solver copes with
+     * that, but a factorization does not: in direct mode, the first fluid cell is set to zero instead
+     * of solving its equation. The pressure is then only shifted by a constant.
+     */
+    void EigenSolver::setPinnedRow_() {
+        pinnedRow_ = -1;
 
-        const MatrixXd diagMat = (boundaryType == DIRICHLET ? 1.0 : 0.5) * identityMatrix;
-        const MatrixXd offDiagMat = (boundaryType == DIRICHLET ? -1.0 : 0.5) * identityMatrix;
+        if (!parameters_.solver.direct) {
+            return;
+        }
 
-        for (int i = 1; i < cellsY_ - 1; i++) {
-            const unsigned int currentStartIdx = startIdx + i * cellsX_;
-            const unsigned int currentOffDiagColStartIdx = currentStartIdx + (direction * cellsX_ * cellsY_);
+        BoundaryType walls[6] = {parameters_.walls.typeLeft, parameters_.walls.typeRight,
+                                 parameters_.walls.typeBottom, parameters_.walls.typeTop,
+                                 parameters_.walls.typeFront, parameters_.walls.typeBack};
 
-            matA_.block(currentStartIdx, currentStartIdx, cellsX_ - 2, cellsX_ - 2) = diagMat;
-            matA_.block(currentStartIdx, currentOffDiagColStartIdx, cellsX_ - 2, cellsX_ - 2) = offDiagMat;
+        for (int wall = 0; wall < 2 * parameters_.geometry.dim; wall++) {
+            if (walls[wall] != DIRICHLET) {
+                return;
+            }
         }
-    }
-
-    void EigenSolver::computeMatrix_() {
-        const int sumObstacles = pow(2, parameters_.geometry.dim * 2 + 1) - 1;
 
-        // If 3D, use the actual bounds, otherwise, use [0, 1) and iterate on k only once!
         const int kLowerBound = (parameters_.geometry.dim == 3) ? 1 : 0;
         const int kUpperBound = (parameters_.geometry.dim == 3) ? (cellsZ_ - 1) : 1;
 
         for (int k = kLowerBound; k < kUpperBound; k++) {
-            /**
-             * Fill the matrix on white region
-             */
-
-            computeMatrixOnFluidRegion_(sumObstacles, k);
+            for (int j = 1; j < cellsY_ - 1; j++) {
+                for (int i = 1; i < cellsX_ - 1; i++) {
+                    const int obstacle = (parameters_.geometry.dim == 2) ? flowField_.getFlags().getValue(i + 1, j + 1)
+                                                                         : flowField_.getFlags().getValue(i + 1, j + 1, k + 1);
 
-            /**
-             * Fill the matrix on boundary conditions (Left, right, bottom and top walls)
-             */
+                    if ((obstacle & OBSTACLE_SELF) == 0) {
+                        pinnedRow_ = ROW_MAJOR_IDX(i, j, k, cellsX_, cellsY_);
+                        return;
+                    }
+                }
+            }
+        }
+    }
 
-            const int startIdx = k * cellsX_ * cellsY_;
+    /**
+     * Computes the LU factorization of the matrix, or reads it from the factorization file if that
+     * was written for the same matrix.
+     */
+    void EigenSolver::factorize_() {
+        const PersistentSparseLU::MatrixType matrix(sparseMatA_);
+        const std::uint64_t fingerprint = PersistentSparseLU::fingerprint(matrix);
 
-            // Left and right walls
-            computeMatrixOnBoundariesLeftAndRight_(startIdx);
+        const std::string& filename = parameters_.solver.factorizationFile;
 
-            // Bottom and top walls
-            computeMatrixOnBoundaryBottomOrTop_(parameters_.walls.typeBottom, startIdx + 1, 1);
-            computeMatrixOnBoundaryBottomOrTop_(parameters_.walls.typeTop, startIdx + (cellsY_ - 1) * cellsX_ + 1, -1);
+        if (!filename.empty() && directSolver_.load(filename, fingerprint)) {
+            std::cout << "Read the pressure factorization from " << filename << std::endl;
+            factorizationIsCurrent_ = true;
+            return;
         }
 
-        if (parameters_.geometry.dim == 3) { // 3D
-            /**
-             * Fill the matrix on boundary conditions (Front and back walls)
-             */
+        directSolver_.analyzePattern(matrix);
+        directSolver_.factorize(matrix);
 
-            computeMatrixOnBoundaryFrontOrBack_(parameters_.walls.typeFront, 1, 1);
-            computeMatrixOnBoundaryFrontOrBack_(parameters_.walls.typeBack, (cellsZ_ - 1) * (cellsX_ * cellsY_) + 1,-1);
+        if (directSolver_.info() != Success) {
+            HANDLE_ERROR(1, "The pressure matrix could not be factorized");
         }
 
-        /**
-         * Convert the matrix to a sparse matrix
-         */
-
-        sparseMatA_ = matA_.sparseView();
-    }
-
-    void EigenSolver::initMatrix_() {
-#ifdef OMP
-        initParallel();
-
-        #pragma omp parallel default(none)
-        #pragma omp master
-        setNbThreads(omp_get_num_threads());
-#endif
-
-        matA_ = MatrixXd::Zero(dim_, dim_);
-        rhs_ = VectorXd::Zero(dim_);
-        x_ = VectorXd::Zero(dim_);
+        std::cout << "Factorized the pressure matrix, " << directSolver_.nnzL() + directSolver_.nnzU()
+                  << " non-zeros in the factors" << std::endl;
 
-        fillCoefficientsVector_();
-        computeMatrix_();
-
-        currentNumIterations_ = SOLVER_ITERATIONS_MAX_NUM;
+        if (!filename.empty()) {
+            directSolver_.save(filename, fingerprint);
+        }
 
-        solver_.setMaxIterations(currentNumIterations_);
-        solver_.compute(sparseMatA_);
+        factorizationIsCurrent_ = true;
     }
 
     EigenSolver::EigenSolver(FlowField& flowField, const Parameters& parameters)
@@ -245,13 +322,19 @@ namespace NSEOF::Solvers {
         , cellsY_(parameters.parallel.localSize[1] + 2)
         , cellsZ_(parameters.geometry.dim == 3 ? (parameters.parallel.localSize[2] + 2) : 1)
         , dim_(cellsX_ * cellsY_ * cellsZ_) {
+        if (parameters.solver.preconditioner == "ilut") {
+            solver_.emplace<ILUTBiCGSTAB>();
+        } else if (parameters.solver.preconditioner == "none") {
+            solver_.emplace<PlainBiCGSTAB>();
+        }
+
         initMatrix_();
     }
 
     EigenSolver::~EigenSolver() {
         coefficientsVector_.clear();
 
-        matA_.resize(0, 0);
+        sparseMatA_.resize(0, 0);
         rhs_.resize(0);
         x_.resize(0);
     }
@@ -286,6 +369,27 @@ namespace NSEOF::Solvers {
         }
     }
 
+    // Initial guess of the iterative solvers from the pressure field
+    void EigenSolver::getPressure2D_() {
+        #pragma omp parallel for collapse(2) default(none) shared(cellsX_, cellsY_, flowField_, x_)
+        for (int j = 0; j < cellsY_; j++) {
+            for (int i = 0; i < cellsX_; i++) {
+                x_(ROW_MAJOR_IDX(i, j, 0, cellsX_, cellsY_)) = flowField_.getPressure().getScalar(i + 1, j + 1);
+            }
+        }
+    }
+
+    void EigenSolver::getPressure3D_() {
+        #pragma omp parallel for collapse(3) default(none) shared(cellsX_, cellsY_, cellsZ_, flowField_, x_)
+        for (int k = 0; k < cellsZ_; k++) {
+            for (int j = 0; j < cellsY_; j++) {
+                for (int i = 0; i < cellsX_; i++) {
+                    x_(ROW_MAJOR_IDX(i, j, k, cellsX_, cellsY_)) = flowField_.getPressure().getScalar(i + 1, j + 1, k + 1);
+                }
+            }
+        }
+    }
+
     void EigenSolver::setPressure2D_() {
         #pragma omp parallel for collapse(2) default(none) shared(cellsX_, cellsY_, flowField_, x_)
         for (int j = 0; j < cellsY_; j++) {
@@ -307,11 +411,13 @@ namespace NSEOF::Solvers {
     }
 
     void EigenSolver::updateNumIterationsBasedOnError_() {
-        const int stepDirection = (solver_.error() < SOLVER_LOWER_ERROR_THRESHOLD) ? -1 : 1;
-        const int stepValue = stepDirection * (int) (currentNumIterations_ * SOLVER_ITERATIONS_STEP);
+        std::visit([this](auto& solver) {
+            const int stepDirection = (solver.error() < SOLVER_LOWER_ERROR_THRESHOLD) ? -1 : 1;
+            const int stepValue = stepDirection * (int) (currentNumIterations_ * SOLVER_ITERATIONS_STEP);
 
-        currentNumIterations_ += stepValue;
-        solver_.setMaxIterations(currentNumIterations_);
+            currentNumIterations_ += stepValue;
+            solver.setMaxIterations(currentNumIterations_);
+        }, solver_);
     }
 
     void EigenSolver::solve() {
@@ -322,10 +428,55 @@ namespace NSEOF::Solvers {
             computeRHS3D_();
         }
 
-        x_ = solver_.solve(rhs_);
+        if (parameters_.solver.direct) {
+            if (!factorizationIsCurrent_) {
+                factorize_();
+            }
+
+            if (pinnedRow_ >= 0) {
+                rhs_(pinnedRow_) = 0.0;
+            }
+
+            x_ = directSolver_.solve(rhs_);
+        } else if (parameters_.solver.mixedPrecision) {
+            if (parameters_.geometry.dim == 2) { // 2D
+                getPressure2D_();
+            } else { // 3D
+                getPressure3D_();
+            }
+
+            const FLOAT tolerance = tolerance_ > 0 ? tolerance_ : MIXED_PRECISION_TOLERANCE;
+            const FLOAT rhsNorm = rhs_.norm();
+            FLOAT defectNorm;
+
+            innerIterations_ = 0;
+            const int corrections = refine_(tolerance * rhsNorm, MIXED_PRECISION_MAX_CORRECTIONS, defectNorm);
+
+            std::cout << "# of corrections: " << corrections << ", # of iterations: " << innerIterations_ << std::endl;
+            std::cout << "relative defect: " << (rhsNorm > 0.0 ? defectNorm / rhsNorm : 0.0) << std::endl;
+        } else {
+            // Only an extrapolated pressure is worth starting from; otherwise the solve starts from zero
+            const bool warmStart = parameters_.solver.extrapolationOrder > 0;
 
-        std::cout << "# of iterations: " << solver_.iterations() << std::endl;
-        std::cout << "estimated error: " << solver_.error()      << std::endl;
+            if (warmStart) {
+                if (parameters_.geometry.dim == 2) { // 2D
+                    getPressure2D_();
+                } else { // 3D
+                    getPressure3D_();
+                }
+            }
+
+            std::visit([this, warmStart](auto& solver) {
+                if (warmStart) {
+                    x_ = solver.solveWithGuess(rhs_, x_);
+                } else {
+                    x_ = solver.solve(rhs_);
+                }
+
+                std::cout << "# of iterations: " << solver.iterations() << std::endl;
+                std::cout << "estimated error: " << solver.error()      << std::endl;
+            }, solver_);
+        }
 
         if (parameters_.geometry.dim == 2) { // 2D
             setPressure2D_();
@@ -333,10 +484,34 @@ namespace NSEOF::Solvers {
             setPressure3D_();
         }
 
-        updateNumIterationsBasedOnError_();
+        // The adapted tolerance replaces the adaptive iteration limit
+        if (!parameters_.solver.direct && !parameters_.solver.mixedPrecision && parameters_.solver.maxIterations <= 0
+            && parameters_.solver.divergenceTolerance <= 0) {
+            updateNumIterationsBasedOnError_();
+        }
+    }
+
+    FLOAT EigenSolver::computeDefect_() {
+        defect_ = rhs_ - sparseMatA_ * x_;
+        return defect_.norm();
+    }
+
+    void EigenSolver::correctDefect_() {
+        const VectorXf correction = singleSolver_.solve(defect_.cast<float>());
+        x_ += correction.cast<FLOAT>();
+        innerIterations_ += singleSolver_.iterations();
     }
 
     inline void EigenSolver::reInitMatrix() {
         initMatrix_();
     }
+
+    void EigenSolver::setTolerance(FLOAT tolerance) {
+        LinearSolver::setTolerance(tolerance);
+
+        // The mixed precision refinement reads the tolerance when it solves
+        if (tolerance > 0) {
+            std::visit([tolerance](auto& solver) { solver.setTolerance(tolerance); }, solver_);
+        }
+    }
 } // namespace Solvers::NSEOF
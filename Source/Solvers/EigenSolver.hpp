@@ -3,10 +3,12 @@
 
 #include "Definitions.hpp"
 #include "LinearSolver.hpp"
+#include "PersistentSparseLU.hpp"
 #include "FlowField.hpp"
 #include "Parameters.hpp"
 
 #include <cmath>
+#include <variant>
 #include <vector>
 
 #ifdef OMP
@@ -25,6 +27,11 @@
 #define SOLVER_ITERATIONS_STEP 0.02
 #define SOLVER_LOWER_ERROR_THRESHOLD 1e-7
 
+// Mixed precision: default tolerance of the refinement, reduction of the defect per single precision solve
+#define MIXED_PRECISION_TOLERANCE 1e-8
+#define MIXED_PRECISION_REDUCTION 1e-3
+#define MIXED_PRECISION_MAX_CORRECTIONS 20
+
 using namespace Eigen;
 
 namespace NSEOF::Solvers {
@@ -36,8 +43,29 @@ public:
     Coefficients(FLOAT, FLOAT, FLOAT, FLOAT, FLOAT, FLOAT);
 };
 
+// Non-zero entries of one matrix row, in ascending column order
+struct StencilRow {
+public:
+    static constexpr int MAX_ENTRIES = 7;
+
+    int size = 0;
+    int columns[MAX_ENTRIES];
+    FLOAT values[MAX_ENTRIES];
+
+    inline void add(int column, FLOAT value) {
+        if (value != 0.0) {
+            columns[size] = column;
+            values[size] = value;
+            size++;
+        }
+    }
+};
+
 class EigenSolver : public LinearSolver {
 private:
+    // Row-major, so that Eigen splits the matrix-vector products of the solver across threads
+    using SparseMatrixType = SparseMatrix<FLOAT, RowMajor>;
+
     const int cellsX_;
     const int cellsY_;
     const int cellsZ_;
@@ -45,43 +73,67 @@ private:
 
     std::vector<Coefficients> coefficientsVector_;
 
-    MatrixXd matA_;
-    SparseMatrix<FLOAT> sparseMatA_;
+    SparseMatrixType sparseMatA_;
     VectorXd rhs_;
     VectorXd x_;
 
-    BiCGSTAB<SparseMatrix<FLOAT>> solver_;
+    // BiCGSTAB with the preconditioner selected in the configuration
+    using DiagonalBiCGSTAB = BiCGSTAB<SparseMatrixType, DiagonalPreconditioner<FLOAT>>;
+    using ILUTBiCGSTAB = BiCGSTAB<SparseMatrixType, IncompleteLUT<FLOAT>>;
+    using PlainBiCGSTAB = BiCGSTAB<SparseMatrixType, IdentityPreconditioner>;
+
+    std::variant<DiagonalBiCGSTAB, ILUTBiCGSTAB, PlainBiCGSTAB> solver_;
     int currentNumIterations_ = {};
 
-    void fillCoefficientsVector_();
+    // Mixed precision: BiCGSTAB on a single precision copy of the matrix solves for the corrections
+    using SingleMatrixType = SparseMatrix<float, RowMajor>;
+
+    SingleMatrixType singleMatA_;
+    BiCGSTAB<SingleMatrixType, DiagonalPreconditioner<float>> singleSolver_;
+    VectorXd defect_;
+    int innerIterations_ = 0; //! Iterations of the single precision solves of the current timestep
+
+    // Direct mode: the matrix is factorized once, every solve only substitutes
+    PersistentSparseLU directSolver_;
+    bool factorizationIsCurrent_ = false;
+    int pinnedRow_ = -1; //! Row fixing the pressure level of a singular matrix in direct mode, -1 if none
 
-    void computeStencilRowForFluidCell_(VectorXd&, int, int, int) const;
-    void computeStencilRowForObstacleCellWithFluidAround_(int, VectorXd&) const;
-    void computeStencilRowForObstacleCell_(VectorXd&) const;
+    void fillCoefficientsVector_();
 
-    void computeMatrixOnFluidRegion_(int, int);
-    void computeMatrixOnBoundariesLeftAndRight_(unsigned int);
-    void computeMatrixOnBoundaryBottomOrTop_(BoundaryType, unsigned int, int);
-    void computeMatrixOnBoundaryFrontOrBack_(BoundaryType, unsigned int, int);
+    void computeStencilRowForFluidCell_(StencilRow&, int, int, int, int) const;
+    void computeStencilRowForObstacleCellWithFluidAround_(StencilRow&, int, int) const;
+    void computeStencilRowForObstacleCell_(StencilRow&, int) const;
+    void computeStencilRowOnBoundary_(StencilRow&, int, int, int, int) const;
+    void computeStencilRow_(StencilRow&, int) const;
 
     void computeMatrix_();
     void initMatrix_();
 
+    void setPinnedRow_();
+    void factorize_();
+
     FLOAT getScalarRHS_(int, int, int, int);
     void computeRHS2D_();
     void computeRHS3D_();
 
+    void getPressure2D_();
+    void getPressure3D_();
     void setPressure2D_();
     void setPressure3D_();
 
     void updateNumIterationsBasedOnError_();
 
+protected:
+    FLOAT computeDefect_() override;
+    void correctDefect_() override;
+
 public:
     EigenSolver(FlowField&, const Parameters&);
     ~EigenSolver() override;
 
     void solve() override;
     inline void reInitMatrix() override;
+    void setTolerance(FLOAT tolerance) override;
 };
 
 } // namespace Solvers::NSEOF
@@ -0,0 +1,490 @@
+#include "FastPoissonSolver.hpp"
+
+#include "Meshsize.hpp"
+#include "PressureBoundaries.hpp"
+
+#include <algorithm>
+
+namespace NSEOF {
+namespace Solvers {
+
+FastPoissonSolver::FastPoissonSolver(FlowField& flowField, const Parameters& parameters)
+    : LinearSolver(flowField, parameters)
+    , tridiagonal_(-1)
+    , singular_(false) {
+    const int dim = parameters.geometry.dim;
+    const int globalSizes[3] = {parameters.geometry.sizeX, parameters.geometry.sizeY, parameters.geometry.sizeZ};
+    const int stretch[3] = {parameters.geometry.stretchX, parameters.geometry.stretchY, parameters.geometry.stretchZ};
+
+    int stretched = -1;
+
+    for (int d = 0; d < 3; d++) {
+        cells_[d] = d < dim ? parameters.parallel.localSize[d] : 1;
+        globalCells_[d] = d < dim ? globalSizes[d] : 1;
+        firstCell_[d] = d < dim ? parameters.parallel.firstCorner[d] : 0;
+
+        if (d >= dim) {
+            continue;
+        }
+
+        if (getWallType(parameters, d, false) == PERIODIC && parameters.parallel.numProcessors[d] > 1) {
+            HANDLE_ERROR(1, "The fast Poisson solver supports periodic boundaries only with a single process in that direction");
+        }
+
+        if (parameters.geometry.meshsizeType == TanhStretching && stretch[d]) {
+            if (stretched >= 0) {
+                HANDLE_ERROR(1, "The fast Poisson solver needs a mesh that is stretched in one direction at most");
+            }
+            if (getWallType(parameters, d, false) == PERIODIC) {
+                HANDLE_ERROR(1, "The fast Poisson solver does not support a stretched periodic direction");
+            }
+            stretched = d;
+        }
+    }
+
+    strides_[0] = 1;
+    strides_[1] = cells_[0];
+    strides_[2] = cells_[0] * cells_[1];
+
+    // The stretched direction, otherwise the last one with walls, is solved by tridiagonal systems
+    tridiagonal_ = stretched;
+    for (int d = dim - 1; d >= 0 && tridiagonal_ < 0; d--) {
+        if (getWallType(parameters, d, false) != PERIODIC) {
+            tridiagonal_ = d;
+        }
+    }
+
+    for (int d = 0; d < dim; d++) {
+        if (d == tridiagonal_) {
+            continue;
+        }
+
+        transformed_.push_back(d);
+        transforms_[d] = RealTransform(globalCells_[d], getWallType(parameters, d, false), getWallType(parameters, d, true));
+
+        const FLOAT width = getGlobalWidth_(d, 0);
+        eigenvalues_[d].resize(globalCells_[d]);
+        for (int m = 0; m < globalCells_[d]; m++) {
+            eigenvalues_[d][m] = transforms_[d].getEigenvalue(m) / (width * width);
+        }
+    }
+
+    if (tridiagonal_ >= 0) {
+        setTridiagonalOperator_();
+    }
+
+    // Processes with the same position in the other directions share the lines of a direction
+    for (int d = 0; d < 3; d++) {
+        const int e = (d + 1) % 3, f = (d + 2) % 3;
+        const int colour = parameters.parallel.indices[e] + parameters.parallel.indices[f] * parameters.parallel.numProcessors[e];
+        const int position = d < dim ? parameters.parallel.indices[d] : 0;
+
+        MPI_Comm_split(PETSC_COMM_WORLD, colour, position, &lineCommunicator_[d]);
+        MPI_Comm_rank(lineCommunicator_[d], &lineRank_[d]);
+
+        int processes;
+        MPI_Comm_size(lineCommunicator_[d], &processes);
+        lineFirstCell_[d].resize(processes + 1);
+        MPI_Allgather(&firstCell_[d], 1, MPI_INT, lineFirstCell_[d].data(), 1, MPI_INT, lineCommunicator_[d]);
+        lineFirstCell_[d][processes] = globalCells_[d];
+    }
+
+    values_.assign(cells_[0] * cells_[1] * cells_[2], 0.0);
+}
+
+FastPoissonSolver::~FastPoissonSolver() {
+    for (int d = 0; d < 3; d++) {
+        MPI_Comm_free(&lineCommunicator_[d]);
+    }
+}
+
+FLOAT FastPoissonSolver::getGlobalWidth_(int d, int cell) const {
+    // The meshsize takes local indices, with the first inner cell at 2
+    const int local = cell - firstCell_[d] + 2;
+    const Meshsize& meshsize = *parameters_.meshsize;
+
+    if (parameters_.geometry.dim == 2) {
+        return d == 0 ? meshsize.getDx(local, 2) : meshsize.getDy(2, local);
+    }
+    return d == 0 ? meshsize.getDx(local, 2, 2) : (d == 1 ? meshsize.getDy(2, local, 2) : meshsize.getDz(2, 2, local));
+}
+
+void FastPoissonSolver::setTridiagonalOperator_() {
+    const int d = tridiagonal_;
+    const int n = globalCells_[d];
+
+    lower_.resize(n);
+    upper_.resize(n);
+    diagonal_.resize(n);
+    extent_.resize(n);
+
+    // Same coefficients as in the SORSolver
+    for (int i = 0; i < n; i++) {
+        const FLOAT width = getGlobalWidth_(d, i);
+        const FLOAT centreLow = 0.5 * (getGlobalWidth_(d, i - 1) + width);
+        const FLOAT centreHigh = 0.5 * (width + getGlobalWidth_(d, i + 1));
+
+        extent_[i] = 0.5 * (centreLow + centreHigh);
+        lower_[i] = 1.0 / (centreLow * extent_[i]);
+        upper_[i] = 1.0 / (centreHigh * extent_[i]);
+        diagonal_[i] = -lower_[i] - upper_[i];
+    }
+
+    // A velocity condition mirrors the pressure into the ghost cell, an outflow negates it
+    const bool outflowLow = getWallType(parameters_, d, false) == NEUMANN;
+    const bool outflowHigh = getWallType(parameters_, d, true) == NEUMANN;
+
+    diagonal_[0] += outflowLow ? -lower_[0] : lower_[0];
+    diagonal_[n - 1] += outflowHigh ? -upper_[n - 1] : upper_[n - 1];
+    lower_[0] = 0.0;
+    upper_[n - 1] = 0.0;
+
+    singular_ = !outflowLow && !outflowHigh;
+}
+
+int FastPoissonSolver::getFirstLine_(int d, int r) const {
+    const int processes = lineFirstCell_[d].size() - 1;
+    return (int) ((long) countLines_(d) * r / processes);
+}
+
+int FastPoissonSolver::getLineOffset_(int d, int line) const {
+    const int e = (d + 1) % 3, f = (d + 2) % 3;
+    return (line % cells_[e]) * strides_[e] + (line / cells_[e]) * strides_[f];
+}
+
+/** Gathers complete lines of direction d in pencil_. Every process of the line communicator
+ *  solves an equal share of the local lines, and receives the pieces of them from all others.
+ */
+void FastPoissonSolver::toPencil_(int d) {
+    const int processes = lineFirstCell_[d].size() - 1;
+    const int me = lineRank_[d];
+    const int n = globalCells_[d];
+    const int firstLine = getFirstLine_(d, me);
+    const int lines = getFirstLine_(d, me + 1) - firstLine;
+
+    pencil_.resize((size_t) lines * n);
+
+    if (processes == 1) {
+        #pragma omp parallel for schedule(static)
+        for (int line = 0; line < lines; line++) {
+            const FLOAT* const source = values_.data() + getLineOffset_(d, line);
+            for (int i = 0; i < n; i++) {
+                pencil_[(size_t) line * n + i] = source[i * strides_[d]];
+            }
+        }
+        return;
+    }
+
+    std::vector<int> sendCounts(processes), sendOffsets(processes + 1, 0);
+    std::vector<int> receiveCounts(processes), receiveOffsets(processes + 1, 0);
+
+    for (int r = 0; r < processes; r++) {
+        sendCounts[r] = (getFirstLine_(d, r + 1) - getFirstLine_(d, r)) * cells_[d];
+        receiveCounts[r] = lines * (lineFirstCell_[d][r + 1] - lineFirstCell_[d][r]);
+        sendOffsets[r + 1] = sendOffsets[r] + sendCounts[r];
+        receiveOffsets[r + 1] = receiveOffsets[r] + receiveCounts[r];
+    }
+
+    sendBuffer_.resize(sendOffsets[processes]);
+    receiveBuffer_.resize(receiveOffsets[processes]);
+
+    // Lines are sent in the order of their index, and so are sent back by fromPencil_
+    #pragma omp parallel for schedule(static)
+    for (int line = 0; line < countLines_(d); line++) {
+        const FLOAT* const source = values_.data() + getLineOffset_(d, line);
+        FLOAT* const target = sendBuffer_.data() + (size_t) line * cells_[d];
+        for (int i = 0; i < cells_[d]; i++) {
+            target[i] = source[i * strides_[d]];
+        }
+    }
+
+    MPI_Alltoallv(sendBuffer_.data(), sendCounts.data(), sendOffsets.data(), MY_MPI_FLOAT,
+                  receiveBuffer_.data(), receiveCounts.data(), receiveOffsets.data(), MY_MPI_FLOAT,
+                  lineCommunicator_[d]);
+
+    for (int s = 0; s < processes; s++) {
+        const int first = lineFirstCell_[d][s];
+        const int piece = lineFirstCell_[d][s + 1] - first;
+
+        #pragma omp parallel for schedule(static)
+        for (int line = 0; line < lines; line++) {
+            const FLOAT* const source = receiveBuffer_.data() + receiveOffsets[s] + (size_t) line * piece;
+            std::copy(source, source + piece, pencil_.data() + (size_t) line * n + first);
+        }
+    }
+}
+
+// Inverse of toPencil_
+void FastPoissonSolver::fromPencil_(int d) {
+    const int processes = lineFirstCell_[d].size() - 1;
+    const int me = lineRank_[d];
+    const int n = globalCells_[d];
+    const int firstLine = getFirstLine_(d, me);
+    const int lines = getFirstLine_(d, me + 1) - firstLine;
+
+    if (processes == 1) {
+        #pragma omp parallel for schedule(static)
+        for (int line = 0; line < lines; line++) {
+            FLOAT* const target = values_.data() + getLineOffset_(d, line);
+            for (int i = 0; i < n; i++) {
+                target[i * strides_[d]] = pencil_[(size_t) line * n + i];
+            }
+        }
+        return;
+    }
+
+    std::vector<int> sendCounts(processes), sendOffsets(processes + 1, 0);
+    std::vector<int> receiveCounts(processes), receiveOffsets(processes + 1, 0);
+
+    for (int r = 0; r < processes; r++) {
+        sendCounts[r] = lines * (lineFirstCell_[d][r + 1] - lineFirstCell_[d][r]);
+        receiveCounts[r] = (getFirstLine_(d, r + 1) - getFirstLine_(d, r)) * cells_[d];
+        sendOffsets[r + 1] = sendOffsets[r] + sendCounts[r];
+        receiveOffsets[r + 1] = receiveOffsets[r] + receiveCounts[r];
+    }
+
+    sendBuffer_.resize(sendOffsets[processes]);
+    receiveBuffer_.resize(receiveOffsets[processes]);
+
+    for (int s = 0; s < processes; s++) {
+        const int first = lineFirstCell_[d][s];
+        const int piece = lineFirstCell_[d][s + 1] - first;
+
+        #pragma omp parallel for schedule(static)
+        for (int line = 0; line < lines; line++) {
+            const FLOAT* const source = pencil_.data() + (size_t) line * n + first;
+            std::copy(source, source + piece, sendBuffer_.data() + sendOffsets[s] + (size_t) line * piece);
+        }
+    }
+
+    MPI_Alltoallv(sendBuffer_.data(), sendCounts.data(), sendOffsets.data(), MY_MPI_FLOAT,
+                  receiveBuffer_.data(), receiveCounts.data(), receiveOffsets.data(), MY_MPI_FLOAT,
+                  lineCommunicator_[d]);
+
+    #pragma omp parallel for schedule(static)
+    for (int line = 0; line < countLines_(d); line++) {
+        const FLOAT* const source = receiveBuffer_.data() + (size_t) line * cells_[d];
+        FLOAT* const target = values_.data() + getLineOffset_(d, line);
+        for (int i = 0; i < cells_[d]; i++) {
+            target[i * strides_[d]] = source[i];
+        }
+    }
+}
+
+void FastPoissonSolver::transformLines_(int d, bool inverse) {
+    toPencil_(d);
+
+    const int n = globalCells_[d];
+    const int lines = pencil_.size() / n;
+    const RealTransform& transform = transforms_[d];
+
+    #pragma omp parallel
+    {
+        std::vector<Complex> buffer(transform.getBufferSize());
+
+        #pragma omp for schedule(static)
+        for (int line = 0; line < lines; line++) {
+            if (inverse) {
+                transform.inverse(pencil_.data() + (size_t) line * n, buffer.data());
+            } else {
+                transform.forward(pencil_.data() + (size_t) line * n, buffer.data());
+            }
+        }
+    }
+
+    fromPencil_(d);
+}
+
+void FastPoissonSolver::solveLines_() {
+    const int d = tridiagonal_;
+    toPencil_(d);
+
+    const int n = globalCells_[d];
+    const int lines = pencil_.size() / n;
+    const int firstLine = getFirstLine_(d, lineRank_[d]);
+    const int e = (d + 1) % 3, f = (d + 2) % 3;
+
+    FLOAT volume = 0.0;
+    for (int i = 0; i < n; i++) {
+        volume += extent_[i];
+    }
+
+    #pragma omp parallel
+    {
+        std::vector<FLOAT> factors(n);
+
+        #pragma omp for schedule(static)
+        for (int line = 0; line < lines; line++) {
+            FLOAT* const x = pencil_.data() + (size_t) line * n;
+
+            // Eigenvalues of the transformed directions, which shift the diagonal of this line
+            const int local = firstLine + line;
+            int slot[3] = {0, 0, 0};
+            slot[e] = firstCell_[e] + local % cells_[e];
+            slot[f] = firstCell_[f] + local / cells_[e];
+
+            FLOAT shift = 0.0;
+            for (const int t : transformed_) {
+                shift += eigenvalues_[t][slot[t]];
+            }
+
+            // The constant mode of a closed domain: remove the inconsistent part of the right-hand
+            // side and fix the pressure level in the first cell
+            const bool pinned = singular_ && shift == 0.0;
+            if (pinned) {
+                FLOAT mean = 0.0;
+                for (int i = 0; i < n; i++) {
+                    mean += extent_[i] * x[i];
+                }
+                mean /= volume;
+                for (int i = 0; i < n; i++) {
+                    x[i] -= mean;
+                }
+                x[0] = 0.0;
+            }
+
+            // Thomas algorithm
+            FLOAT pivot = pinned ? 1.0 : diagonal_[0] + shift;
+            factors[0] = pinned ? 0.0 : upper_[0] / pivot;
+            x[0] /= pivot;
+
+            for (int i = 1; i < n; i++) {
+                pivot = diagonal_[i] + shift - lower_[i] * factors[i - 1];
+                factors[i] = upper_[i] / pivot;
+                x[i] = (x[i] - lower_[i] * x[i - 1]) / pivot;
+            }
+
+            for (int i = n - 2; i >= 0; i--) {
+                x[i] -= factors[i] * x[i + 1];
+            }
+        }
+    }
+
+    fromPencil_(d);
+}
+
+void FastPoissonSolver::divideByEigenvalues_() {
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int k = 0; k < cells_[2]; k++) {
+        for (int j = 0; j < cells_[1]; j++) {
+            for (int i = 0; i < cells_[0]; i++) {
+                const int slot[3] = {firstCell_[0] + i, firstCell_[1] + j, firstCell_[2] + k};
+
+                FLOAT eigenvalue = 0.0;
+                for (const int t : transformed_) {
+                    eigenvalue += eigenvalues_[t][slot[t]];
+                }
+
+                // The mean of a periodic domain is arbitrary
+                FLOAT& value = values_[i + j * strides_[1] + k * strides_[2]];
+                value = eigenvalue != 0.0 ? value / eigenvalue : 0.0;
+            }
+        }
+    }
+}
+
+void FastPoissonSolver::copyRHS_() {
+    ScalarField& rhs = flowField_.getRHS();
+    const bool is3D = parameters_.geometry.dim == 3;
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int k = 0; k < cells_[2]; k++) {
+        for (int j = 0; j < cells_[1]; j++) {
+            for (int i = 0; i < cells_[0]; i++) {
+                values_[i + j * strides_[1] + k * strides_[2]] = is3D ? rhs.getScalar(i + 2, j + 2, k + 2) : rhs.getScalar(i + 2, j + 2);
+            }
+        }
+    }
+}
+
+void FastPoissonSolver::setPressure_() {
+    ScalarField& pressure = flowField_.getPressure();
+    const int dim = parameters_.geometry.dim;
+    FLOAT* const p = &pressure.getScalar(0, 0);
+    const int strides[3] = {1, pressure.index2cell(0, 1), dim == 3 ? pressure.index2cell(0, 0, 1) : 0};
+    const int firstK = dim == 3 ? 2 : 0;
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int k = 0; k < cells_[2]; k++) {
+        for (int j = 0; j < cells_[1]; j++) {
+            for (int i = 0; i < cells_[0]; i++) {
+                p[(i + 2) + (j + 2) * strides[1] + (k + firstK) * strides[2]] = values_[i + j * strides_[1] + k * strides_[2]];
+            }
+        }
+    }
+
+    // Ghost cells at walls and periodic boundaries; the others are exchanged after the solve
+    for (int d = 0; d < dim; d++) {
+        const int e = (d + 1) % 3, f = (d + 2) % 3;
+        const bool periodic = getWallType(parameters_, d, false) == PERIODIC;
+
+        for (int high = 0; high < 2; high++) {
+            if (getNeighbour(parameters_, d, high) != MPI_PROC_NULL && !periodic) {
+                continue;
+            }
+
+            const FLOAT sign = getWallType(parameters_, d, high) == NEUMANN ? -1.0 : 1.0;
+            const int ghost = high ? cells_[d] + 2 : 1;
+            const int source = periodic ? (high ? 2 : cells_[d] + 1) : (high ? cells_[d] + 1 : 2);
+
+            for (int b = 0; b < cells_[f]; b++) {
+                for (int a = 0; a < cells_[e]; a++) {
+                    int position[3] = {0, 0, 0};
+                    position[e] = a + 2;
+                    position[f] = b + 2;
+
+                    position[d] = ghost;
+                    const int target = position[0] * strides[0] + position[1] * strides[1] + position[2] * strides[2];
+                    position[d] = source;
+                    const int origin = position[0] * strides[0] + position[1] * strides[1] + position[2] * strides[2];
+
+                    p[target] = periodic ? p[origin] : sign * p[origin];
+                }
+            }
+        }
+    }
+}
+
+void FastPoissonSolver::solve() {
+    copyRHS_();
+
+    for (const int d : transformed_) {
+        transformLines_(d, false);
+    }
+
+    if (tridiagonal_ >= 0) {
+        solveLines_();
+    } else {
+        divideByEigenvalues_();
+    }
+
+    for (auto d = transformed_.rbegin(); d != transformed_.rend(); d++) {
+        transformLines_(*d, true);
+    }
+
+    setPressure_();
+}
+
+void FastPoissonSolver::reInitMatrix() {
+    // The transforms only hold for a domain without obstacles
+    IntScalarField& flags = flowField_.getFlags();
+    const bool is3D = parameters_.geometry.dim == 3;
+    int obstacles = 0;
+
+    for (int k = 0; k < cells_[2]; k++) {
+        for (int j = 0; j < cells_[1]; j++) {
+            for (int i = 0; i < cells_[0]; i++) {
+                const int flag = is3D ? flags.getValue(i + 2, j + 2, k + 2) : flags.getValue(i + 2, j + 2);
+                obstacles += flag & OBSTACLE_SELF;
+            }
+        }
+    }
+
+    MPI_Allreduce(MPI_IN_PLACE, &obstacles, 1, MPI_INT, MPI_SUM, PETSC_COMM_WORLD);
+    if (obstacles > 0) {
+        HANDLE_ERROR(1, "The fast Poisson solver does not support obstacles, select another solver");
+    }
+}
+
+} // namespace Solvers
+} // namespace NSEOF
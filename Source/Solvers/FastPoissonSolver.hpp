@@ -0,0 +1,82 @@
+#ifndef __SOLVERS_FAST_POISSON_SOLVER_HPP__
+#define __SOLVERS_FAST_POISSON_SOLVER_HPP__
+
+#include "LinearSolver.hpp"
+#include "FastTransforms.hpp"
+
+#include <vector>
+
+namespace NSEOF {
+namespace Solvers {
+
+/** Direct solver for the pressure equation on meshes without obstacles that are uniform in all
+ *  directions but at most one
+ *
+ * The operator (the one of the SORSolver) is then separable. Every uniform direction is
+ * diagonalised by a real transform, see RealTransform, which leaves independent tridiagonal
+ * systems along the remaining direction. If all directions are uniform, the last one that is not
+ * periodic is solved by the tridiagonal systems anyway; if all are periodic, the transformed
+ * values are divided by the eigenvalues. Transforms and tridiagonal systems need complete lines,
+ * which the processes sharing a line exchange in an all-to-all (a pencil transpose), so any
+ * process grid works. Periodic directions must not be split across processes.
+ */
+class FastPoissonSolver : public LinearSolver {
+private:
+    int cells_[3];       //! Local inner cells per direction, 1 beyond the dimension
+    int globalCells_[3];
+    int firstCell_[3];   //! Global index of the first local cell
+    int strides_[3];     //! Strides of values_
+
+    std::vector<int> transformed_;      //! Directions diagonalised by a transform
+    RealTransform transforms_[3];
+    std::vector<FLOAT> eigenvalues_[3]; //! Eigenvalues of the transformed directions, by global slot
+
+    int tridiagonal_; //! Direction solved by tridiagonal systems, -1 if none
+    bool singular_;   //! No outflow wall along the tridiagonal direction, so the shift of zero is singular
+
+    // Operator along the tridiagonal direction, by global cell
+    std::vector<FLOAT> lower_;
+    std::vector<FLOAT> upper_;
+    std::vector<FLOAT> diagonal_;
+    std::vector<FLOAT> extent_; //! Left null vector of the operator if it is singular
+
+    // Processes that share the lines of each direction, ordered along it
+    MPI_Comm lineCommunicator_[3];
+    int lineRank_[3];
+    std::vector<int> lineFirstCell_[3]; //! First global cell of every process, and the total at the end
+
+    std::vector<FLOAT> values_; //! Local inner cells, x fastest
+    std::vector<FLOAT> pencil_; //! Complete lines of one direction, one after the other
+    std::vector<FLOAT> sendBuffer_;
+    std::vector<FLOAT> receiveBuffer_;
+
+    FLOAT getGlobalWidth_(int d, int cell) const;
+    void setTridiagonalOperator_();
+
+    // Local lines of direction d, and the first of them that process r of the line solves
+    int countLines_(int d) const { return cells_[(d + 1) % 3] * cells_[(d + 2) % 3]; }
+    int getFirstLine_(int d, int r) const;
+    int getLineOffset_(int d, int line) const;
+
+    void toPencil_(int d);
+    void fromPencil_(int d);
+
+    void transformLines_(int d, bool inverse);
+    void solveLines_();
+    void divideByEigenvalues_();
+
+    void copyRHS_();
+    void setPressure_();
+
+public:
+    FastPoissonSolver(FlowField& flowField, const Parameters& parameters);
+    ~FastPoissonSolver() override;
+
+    void solve() override;
+    void reInitMatrix() override;
+};
+
+} // namespace Solvers
+} // namespace NSEOF
+
+#endif // __SOLVERS_FAST_POISSON_SOLVER_HPP__
@@ -0,0 +1,208 @@
+#include "FastTransforms.hpp"
+
+#include <algorithm>
+#include <math.h>
+
+namespace NSEOF {
+namespace Solvers {
+
+FourierTransform::FourierTransform(int length)
+    : length_(length)
+    , maxRadix_(1) {
+    ASSERTION(length > 0);
+
+    // Factors of two first, so that the odd factors end up in the innermost stages
+    int remaining = length;
+    for (int radix = 2; remaining > 1; radix++) {
+        if (radix * radix > remaining) {
+            radix = remaining;
+        }
+        while (remaining % radix == 0) {
+            remaining /= radix;
+            factors_.push_back(radix);
+            factors_.push_back(remaining);
+            maxRadix_ = std::max(maxRadix_, radix);
+        }
+    }
+    if (factors_.empty()) {
+        factors_ = {1, 1};
+    }
+
+    twiddles_.resize(length);
+    for (int k = 0; k < length; k++) {
+        const FLOAT angle = -2.0 * M_PI * k / length;
+        twiddles_[k] = Complex(cos(angle), sin(angle));
+    }
+}
+
+void FourierTransform::transform_(Complex* out, const Complex* in, int stride, const int* factors, Complex* scratch) const {
+    const int radix = factors[0];
+    const int m = factors[1];
+
+    // Transforms of the radix interleaved subsequences, stored one after the other
+    if (m == 1) {
+        for (int q = 0; q < radix; q++) {
+            out[q] = in[q * stride];
+        }
+    } else {
+        for (int q = 0; q < radix; q++) {
+            transform_(out + q * m, in + q * stride, stride * radix, factors + 2, scratch);
+        }
+    }
+
+    // Combine them with butterflies of the radix
+    if (radix == 2) {
+        for (int u = 0; u < m; u++) {
+            const Complex t = out[u + m] * twiddles_[u * stride];
+            out[u + m] = out[u] - t;
+            out[u] += t;
+        }
+        return;
+    }
+
+    for (int u = 0; u < m; u++) {
+        for (int q = 0; q < radix; q++) {
+            scratch[q] = out[u + q * m];
+        }
+
+        for (int q = 0; q < radix; q++) {
+            const int k = u + q * m;
+            int twiddle = 0;
+            Complex sum = scratch[0];
+
+            for (int r = 1; r < radix; r++) {
+                twiddle += stride * k;
+                if (twiddle >= length_) {
+                    twiddle %= length_;
+                }
+                sum += scratch[r] * twiddles_[twiddle];
+            }
+            out[k] = sum;
+        }
+    }
+}
+
+void FourierTransform::forward(const Complex* in, Complex* out, Complex* scratch) const {
+    transform_(out, in, 1, factors_.data(), scratch);
+}
+
+RealTransform::RealTransform(int cells, BoundaryType low, BoundaryType high)
+    : cells_(cells)
+    , periodic_(low == PERIODIC)
+    , sine_(low == NEUMANN)
+    , fourier_(low == PERIODIC ? cells : 2 * cells) {
+    const int n = cells;
+    eigenvalues_.resize(n);
+
+    if (periodic_) {
+        // Slot 0 holds the mean, slots 2k - 1 and 2k the real and imaginary part of wave number k
+        for (int m = 0; m < n; m++) {
+            const int waveNumber = (m + 1) / 2;
+            const FLOAT s = sin(M_PI * waveNumber / n);
+            eigenvalues_[m] = -4.0 * s * s;
+        }
+        return;
+    }
+
+    // The eigenvectors are cos or sin(pi (m + shift) (i + 1/2) / n), with shift 0 for two
+    // mirroring ends, 1 for two negating ones and 1/2 for mixed ones
+    const FLOAT shift = (low == NEUMANN) == (high == NEUMANN) ? (low == NEUMANN ? 1.0 : 0.0) : 0.5;
+
+    preTwiddles_.resize(n);
+    postTwiddles_.resize(n);
+    weights_.assign(n, 2.0 / n);
+
+    for (int m = 0; m < n; m++) {
+        const FLOAT pre = -M_PI * shift * (2 * m + 1) / (2 * n);
+        const FLOAT post = -M_PI * m / (2 * n);
+        preTwiddles_[m] = Complex(cos(pre), sin(pre));
+        postTwiddles_[m] = Complex(cos(post), sin(post));
+
+        const FLOAT s = sin(M_PI * (m + shift) / (2 * n));
+        eigenvalues_[m] = -4.0 * s * s;
+    }
+
+    // The eigenvector with a constant or alternating sign has twice the norm of the others
+    if (shift == 0.0) {
+        weights_[0] = 1.0 / n;
+    } else if (shift == 1.0) {
+        weights_[n - 1] = 1.0 / n;
+    }
+}
+
+void RealTransform::forward(FLOAT* line, Complex* buffer) const {
+    const int n = cells_;
+    const int length = fourier_.getLength();
+    Complex* const in = buffer;
+    Complex* const out = buffer + length;
+    Complex* const scratch = buffer + 2 * length;
+
+    if (periodic_) {
+        for (int j = 0; j < n; j++) {
+            in[j] = line[j];
+        }
+        fourier_.forward(in, out, scratch);
+
+        line[0] = out[0].real();
+        for (int k = 1; 2 * k < n; k++) {
+            line[2 * k - 1] = out[k].real();
+            line[2 * k] = out[k].imag();
+        }
+        if (n % 2 == 0 && n > 1) {
+            line[n - 1] = out[n / 2].real();
+        }
+        return;
+    }
+
+    // sum_i x_i exp(-i pi (m + shift) (2i + 1) / 2n), split into twiddles and a zero-padded DFT
+    for (int i = 0; i < n; i++) {
+        in[i] = line[i] * preTwiddles_[i];
+    }
+    std::fill(in + n, in + length, Complex(0.0, 0.0));
+    fourier_.forward(in, out, scratch);
+
+    for (int m = 0; m < n; m++) {
+        const Complex value = out[m] * postTwiddles_[m];
+        line[m] = sine_ ? -value.imag() : value.real();
+    }
+}
+
+void RealTransform::inverse(FLOAT* line, Complex* buffer) const {
+    const int n = cells_;
+    const int length = fourier_.getLength();
+    Complex* const in = buffer;
+    Complex* const out = buffer + length;
+    Complex* const scratch = buffer + 2 * length;
+
+    if (periodic_) {
+        // Conjugated Hermitian spectrum, its forward transform is the conjugated inverse
+        in[0] = line[0];
+        for (int k = 1; 2 * k < n; k++) {
+            in[k] = Complex(line[2 * k - 1], -line[2 * k]);
+            in[n - k] = Complex(line[2 * k - 1], line[2 * k]);
+        }
+        if (n % 2 == 0 && n > 1) {
+            in[n / 2] = line[n - 1];
+        }
+        fourier_.forward(in, out, scratch);
+
+        for (int j = 0; j < n; j++) {
+            line[j] = out[j].real() / n;
+        }
+        return;
+    }
+
+    for (int m = 0; m < n; m++) {
+        in[m] = weights_[m] * line[m] * postTwiddles_[m];
+    }
+    std::fill(in + n, in + length, Complex(0.0, 0.0));
+    fourier_.forward(in, out, scratch);
+
+    for (int i = 0; i < n; i++) {
+        const Complex value = out[i] * preTwiddles_[i];
+        line[i] = sine_ ? -value.imag() : value.real();
+    }
+}
+
+} // namespace Solvers
+} // namespace NSEOF
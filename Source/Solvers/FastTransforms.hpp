@@ -0,0 +1,80 @@
+#ifndef __SOLVERS_FAST_TRANSFORMS_HPP__
+#define __SOLVERS_FAST_TRANSFORMS_HPP__
+
+#include "Definitions.hpp"
+
+#include <complex>
+#include <vector>
+
+namespace NSEOF {
+namespace Solvers {
+
+using Complex = std::complex<FLOAT>;
+
+/** Complex discrete Fourier transform of a fixed length
+ *
+ * Mixed-radix Cooley-Tukey recursion over the prime factors of the length. Factors of two use a
+ * dedicated butterfly, all others the generic one, which costs O(p) per value for a factor p.
+ */
+class FourierTransform {
+private:
+    int length_;
+    int maxRadix_;
+    std::vector<int> factors_;       //! Pairs of radix and remaining length, from the outermost stage
+    std::vector<Complex> twiddles_;  //! exp(-2 pi i k / length)
+
+    void transform_(Complex* out, const Complex* in, int stride, const int* factors, Complex* scratch) const;
+
+public:
+    explicit FourierTransform(int length = 1);
+
+    int getLength() const { return length_; }
+    int getScratchSize() const { return maxRadix_; }
+
+    /** out[k] = sum_j in[j] exp(-2 pi i j k / length). out must not overlap in; scratch holds
+     *  getScratchSize() values.
+     */
+    void forward(const Complex* in, Complex* out, Complex* scratch) const;
+};
+
+/** Real transform that diagonalises the second difference of n cells with constant width
+ *
+ * The conditions at both ends are those of the pressure: a wall with a velocity condition mirrors
+ * the pressure into the ghost cell, an outflow wall negates it, and periodic walls wrap around.
+ * Depending on the combination, this is a DCT-II, DST-II, DCT-IV or DST-IV, all evaluated with a
+ * Fourier transform of length 2n, or a real DFT of length n. After forward, slot m of the line
+ * holds the coefficient of the eigenvector with eigenvalue getEigenvalue(m); inverse is the exact
+ * inverse of forward.
+ */
+class RealTransform {
+private:
+    int cells_;
+    bool periodic_;
+    bool sine_;
+    FourierTransform fourier_;
+
+    std::vector<Complex> preTwiddles_;
+    std::vector<Complex> postTwiddles_;
+    std::vector<FLOAT> weights_;     //! Inverse of the squared norm of the eigenvectors
+    std::vector<FLOAT> eigenvalues_;
+
+public:
+    RealTransform() = default;
+    RealTransform(int cells, BoundaryType low, BoundaryType high);
+
+    int getCells() const { return cells_; }
+
+    // Number of values the buffer passed to forward and inverse must hold
+    int getBufferSize() const { return 2 * fourier_.getLength() + fourier_.getScratchSize(); }
+
+    // Eigenvalue of slot m for unit cell width
+    FLOAT getEigenvalue(int m) const { return eigenvalues_[m]; }
+
+    void forward(FLOAT* line, Complex* buffer) const;
+    void inverse(FLOAT* line, Complex* buffer) const;
+};
+
+} // namespace Solvers
+} // namespace NSEOF
+
+#endif // __SOLVERS_FAST_TRANSFORMS_HPP__
@@ -0,0 +1,51 @@
+#ifndef __SOLVERS_LINE_RELAXATION_HPP__
+#define __SOLVERS_LINE_RELAXATION_HPP__
+
+#include "Definitions.hpp"
+
+namespace NSEOF {
+namespace Solvers {
+
+/** Solves a batch of tridiagonal systems of the same length with the Thomas algorithm
+ *
+ * Row l of system b is stored at l * lines + b, so every step of the elimination runs over all
+ * systems at once in a loop without dependencies, which the compiler vectorises. Row l reads
+ * lower[l] x[l - 1] + diagonal[l] x[l] + upper[l] x[l + 1] = values[l]; lower[0] and
+ * upper[length - 1] are ignored. The systems must not need pivoting, e.g. be diagonally
+ * dominant. diagonal is overwritten, values holds the right-hand sides on entry and the
+ * solutions on exit.
+ */
+template <class Real>
+inline void solveTridiagonalLines(int length, int lines, const Real* const lower, Real* const diagonal,
+                                  const Real* const upper, Real* const values) {
+    for (int l = 1; l < length; l++) {
+        const int row = l * lines;
+        const int previous = row - lines;
+
+        for (int b = 0; b < lines; b++) {
+            const Real factor = lower[row + b] / diagonal[previous + b];
+            diagonal[row + b] -= factor * upper[previous + b];
+            values[row + b] -= factor * values[previous + b];
+        }
+    }
+
+    const int last = (length - 1) * lines;
+
+    for (int b = 0; b < lines; b++) {
+        values[last + b] /= diagonal[last + b];
+    }
+
+    for (int l = length - 2; l >= 0; l--) {
+        const int row = l * lines;
+        const int next = row + lines;
+
+        for (int b = 0; b < lines; b++) {
+            values[row + b] = (values[row + b] - upper[row + b] * values[next + b]) / diagonal[row + b];
+        }
+    }
+}
+
+} // namespace Solvers
+} // namespace NSEOF
+
+#endif // __SOLVERS_LINE_RELAXATION_HPP__
@@ -5,7 +5,30 @@ namespace Solvers {
 
 LinearSolver::LinearSolver(FlowField& flowField, const Parameters& parameters)
     : flowField_(flowField)
-    , parameters_(parameters) {}
+    , parameters_(parameters)
+    , tolerance_(parameters.solver.tolerance) {}
+
+int LinearSolver::refine_(FLOAT threshold, int maxCorrections, FLOAT& defectNorm) {
+    int corrections = 0;
+
+    defectNorm = computeDefect_();
+    while (defectNorm > threshold && corrections < maxCorrections) {
+        correctDefect_();
+        defectNorm = computeDefect_();
+        corrections++;
+    }
+
+    return corrections;
+}
+
+FLOAT LinearSolver::computeDefect_() {
+    HANDLE_ERROR(1, "The pressure solver does not support mixed precision");
+    return 0.0;
+}
+
+void LinearSolver::correctDefect_() {
+    HANDLE_ERROR(1, "The pressure solver does not support mixed precision");
+}
 
 } // namespace Solvers
 } // namespace NSEOF
@@ -14,12 +14,30 @@ protected:
     FlowField& flowField_;
     const Parameters& parameters_;
 
+    FLOAT tolerance_; //! Residual at which the solver stops, 0 for the solver's default
+
+    /** Mixed-precision iterative refinement: alternates computeDefect_, which computes the defect
+     *  b - Ax of the current pressure in FLOAT precision and returns its norm, and correctDefect_,
+     *  which solves for the correction in single precision and adds it to the pressure. Stops once
+     *  the norm is at most threshold or after maxCorrections corrections.
+     *
+     * @param defectNorm Norm of the last defect
+     * @return Number of corrections
+     */
+    int refine_(FLOAT threshold, int maxCorrections, FLOAT& defectNorm);
+
+    virtual FLOAT computeDefect_();
+    virtual void correctDefect_();
+
 public:
     LinearSolver(FlowField& flowField, const Parameters& parameters);
     virtual ~LinearSolver() = default;
 
     virtual void solve() = 0;
     virtual inline void reInitMatrix() {}
+
+    // Tolerance of the following solves, parameters.solver.tolerance until set, see AdaptiveTolerance
+    virtual void setTolerance(FLOAT tolerance) { tolerance_ = tolerance; }
 };
 
 } // namespace Solvers
@@ -0,0 +1,982 @@
+#include "MultigridSolver.hpp"
+
+#include "Dimension.hpp"
+#include "LineRelaxation.hpp"
+#include "PressureBoundaries.hpp"
+#include "ParallelManagers/PetscParallelManager.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <math.h>
+
+namespace NSEOF {
+namespace Solvers {
+
+// Grids are coarsened until no process has more cells than this in any direction
+static constexpr int COARSEST_CELLS = 2;
+
+static constexpr int DEFAULT_MAX_CYCLES = 100;
+static constexpr FLOAT DEFAULT_TOLERANCE = 1e-6;
+static constexpr int MIN_COARSEST_SWEEPS = 16;
+
+MultigridSolver::MultigridSolver(FlowField& flowField, const Parameters& parameters)
+    : LinearSolver(flowField, parameters)
+    , cycle_(parameters.solver.cycle == "F" ? F_CYCLE : V_CYCLE)
+    , maxCycles_(parameters.solver.maxIterations > 0 ? parameters.solver.maxIterations : DEFAULT_MAX_CYCLES)
+    , preSmoothing_(parameters.solver.preSmoothing)
+    , postSmoothing_(parameters.solver.postSmoothing)
+    , coarsestSweeps_(MIN_COARSEST_SWEEPS)
+    , singular_(true)
+    , mixedPrecision_(parameters.solver.mixedPrecision)
+    , lineSmoother_(parameters.solver.smoother == "line") {
+
+    for (int d = 0; d < parameters.geometry.dim; d++) {
+        if (getWallType(parameters, d, false) == PERIODIC && parameters.parallel.numProcessors[d] > 1) {
+            HANDLE_ERROR(1, "The multigrid solver supports periodic boundaries only with a single process in that direction");
+        }
+
+        // An outflow wall fixes the pressure to zero
+        if (getWallType(parameters, d, false) == NEUMANN || getWallType(parameters, d, true) == NEUMANN) {
+            singular_ = false;
+        }
+
+        // Gauss-Seidel needs about n^2 sweeps on n cells
+        const int coarsestCells = COARSEST_CELLS * parameters.parallel.numProcessors[d];
+        coarsestSweeps_ = std::max(coarsestSweeps_, 2 * coarsestCells * coarsestCells);
+    }
+
+    createLevels_();
+}
+
+void MultigridSolver::createLevels_() {
+    const int dim = parameters_.geometry.dim;
+
+    levels_.clear();
+    levels_.emplace_back();
+
+    // The finest level works on the storage of the flow field, shifted by one cell
+    Level<FLOAT>& fine = levels_[0];
+    ScalarField& pressure = flowField_.getPressure();
+    ScalarField& rhs = flowField_.getRHS();
+
+    for (int d = 0; d < 3; d++) {
+        fine.cells[d] = d < dim ? parameters_.parallel.localSize[d] : 1;
+        fine.ratio[d] = 1;
+    }
+
+    if (dim == 3) {
+        fine.pressure = &pressure.getScalar(1, 1, 1);
+        fine.rhs = &rhs.getScalar(1, 1, 1);
+        fine.strideY = pressure.index2cell(0, 1, 0);
+        fine.strideZ = pressure.index2cell(0, 0, 1);
+    } else {
+        fine.pressure = &pressure.getScalar(1, 1);
+        fine.rhs = &rhs.getScalar(1, 1);
+        fine.strideY = pressure.index2cell(0, 1);
+        fine.strideZ = 0;
+    }
+
+    fine.residual.assign(fine.size(), 0.0);
+    fine.correction.assign(fine.size(), 0.0);
+
+    for (int d = 0; d < 3; d++) {
+        if (d < dim) {
+            const FLOAT* const spacing = parameters_.meshMetrics->getSpacing(d);
+            fine.width[d].assign(spacing + 1, spacing + fine.cells[d] + 3);
+        } else {
+            fine.width[d].assign(3, 1.0);
+        }
+    }
+
+    setFineOpenness_();
+    setCoefficients_(fine);
+
+    int ratio[3];
+    while (selectCoarsening_(levels_.back(), ratio)) {
+        levels_.emplace_back();
+        Level<FLOAT>& coarse = levels_.back();
+        std::copy(ratio, ratio + 3, coarse.ratio);
+
+        coarsen_(levels_[levels_.size() - 2], coarse);
+        setCoefficients_(coarse);
+    }
+
+    setFirstCells_();
+
+    // In mixed precision, the cycles run on a single precision copy; the finest grid in FLOAT
+    // precision only computes the defects
+    singleLevels_.clear();
+    if (mixedPrecision_) {
+        singleLevels_.resize(levels_.size());
+        for (size_t level = 0; level < levels_.size(); level++) {
+            copyToSingle_(levels_[level], singleLevels_[level]);
+        }
+        levels_.resize(1);
+    }
+}
+
+void MultigridSolver::copyToSingle_(const Level<FLOAT>& level, Level<float>& single) {
+    std::copy(level.cells, level.cells + 3, single.cells);
+    std::copy(level.ratio, level.ratio + 3, single.ratio);
+    std::copy(level.firstCell, level.firstCell + 3, single.firstCell);
+    single.strideY = level.strideY;
+    single.strideZ = level.strideZ;
+    single.lineDirection = level.lineDirection;
+
+    single.pressureStorage.assign(level.size(), 0.0f);
+    single.rhsStorage.assign(level.size(), 0.0f);
+    single.residual.assign(level.size(), 0.0f);
+    single.correction.assign(level.size(), 0.0f);
+    single.pressure = single.pressureStorage.data();
+    single.rhs = single.rhsStorage.data();
+    single.volume.assign(level.volume.begin(), level.volume.end());
+
+    for (int d = 0; d < 3; d++) {
+        single.openness[d].assign(level.openness[d].begin(), level.openness[d].end());
+
+        single.width[d] = level.width[d];
+        single.extent[d] = level.extent[d];
+        single.coefficientLow[d].assign(level.coefficientLow[d].begin(), level.coefficientLow[d].end());
+        single.coefficientHigh[d].assign(level.coefficientHigh[d].begin(), level.coefficientHigh[d].end());
+        single.diagonalLow[d].assign(level.diagonalLow[d].begin(), level.diagonalLow[d].end());
+        single.diagonalHigh[d].assign(level.diagonalHigh[d].begin(), level.diagonalHigh[d].end());
+        single.side[d] = level.side[d];
+        single.weight[d].assign(level.weight[d].begin(), level.weight[d].end());
+    }
+
+    single.sendBuffer = level.sendBuffer;
+    single.receiveBuffer = level.receiveBuffer;
+}
+
+bool MultigridSolver::selectCoarsening_(const Level<FLOAT>& level, int ratio[3]) const {
+    const int dim = parameters_.geometry.dim;
+
+    // The processes have to agree on the hierarchy, so the decision is based on global mean widths
+    FLOAT local[6];
+    for (int d = 0; d < 3; d++) {
+        local[d] = d < dim ? std::accumulate(level.width[d].begin() + 1, level.width[d].end() - 1, 0.0) : 0.0;
+        local[3 + d] = d < dim ? level.cells[d] : 0;
+    }
+
+    FLOAT global[6];
+    MPI_Allreduce(local, global, 6, MY_MPI_FLOAT, MPI_SUM, PETSC_COMM_WORLD);
+
+    int localCells[3] = {level.cells[0], level.cells[1], level.cells[2]};
+    int maxCells[3];
+    MPI_Allreduce(localCells, maxCells, 3, MPI_INT, MPI_MAX, PETSC_COMM_WORLD);
+
+    FLOAT meanWidth[3];
+    for (int d = 0; d < 3; d++) {
+        meanWidth[d] = global[3 + d] > 0.0 ? global[d] / global[3 + d] : 0.0;
+    }
+
+    FLOAT smallest = 0.0;
+    bool coarsen = false;
+    for (int d = 0; d < dim; d++) {
+        if (maxCells[d] > COARSEST_CELLS && (!coarsen || meanWidth[d] < smallest)) {
+            smallest = meanWidth[d];
+            coarsen = true;
+        }
+    }
+
+    // Point smoothers leave errors that are smooth along strongly coupled directions, i.e. the ones
+    // of the smallest widths. These are coarsened first, until the cells are about as wide as in the
+    // others.
+    for (int d = 0; d < 3; d++) {
+        ratio[d] = coarsen && d < dim && maxCells[d] > COARSEST_CELLS && meanWidth[d] <= 2.0 * smallest ? 2 : 1;
+    }
+
+    return coarsen;
+}
+
+void MultigridSolver::setFirstCells_() {
+    const ParallelParameters& parallel = parameters_.parallel;
+
+    // The processes of a row along each direction, ordered by their position in it. The first cell
+    // is the number of cells of the processes before, which on the finest grid is firstCorner.
+    for (int d = 0; d < 3; d++) {
+        const int e = (d + 1) % 3;
+        const int f = (d + 2) % 3;
+
+        MPI_Comm row;
+        MPI_Comm_split(PETSC_COMM_WORLD, parallel.indices[e] * parallel.numProcessors[f] + parallel.indices[f],
+                       parallel.indices[d], &row);
+
+        for (Level<FLOAT>& level : levels_) {
+            int first = 0;
+            MPI_Exscan(&level.cells[d], &first, 1, MPI_INT, MPI_SUM, row);
+            level.firstCell[d] = parallel.indices[d] > 0 ? first : 0;
+        }
+
+        MPI_Comm_free(&row);
+    }
+}
+
+void MultigridSolver::setFineOpenness_() {
+    Level<FLOAT>& fine = levels_[0];
+    IntScalarField& flags = flowField_.getFlags();
+    const int dim = parameters_.geometry.dim;
+
+    auto isFluid = [&](int i, int j, int k) {
+        const int flag = dim == 3 ? flags.getValue(i + 1, j + 1, k + 1) : flags.getValue(i + 1, j + 1);
+        return (flag & OBSTACLE_SELF) == 0;
+    };
+
+    for (int d = 0; d < 3; d++) {
+        fine.openness[d].assign(d < dim ? fine.size() : 0, 0.0);
+    }
+
+    // Faces between a cell and its lower neighbour, up to the upper faces of the last cells
+    const int lastK = dim == 3 ? fine.cells[2] + 1 : 1;
+    for (int k = 1; k <= lastK; k++) {
+        for (int j = 1; j <= fine.cells[1] + 1; j++) {
+            for (int i = 1; i <= fine.cells[0] + 1; i++) {
+                const int cell = fine.index(i, j, k);
+                const bool fluid = isFluid(i, j, k);
+
+                if (j <= fine.cells[1] && k <= fine.cells[2]) {
+                    fine.openness[0][cell] = fluid && isFluid(i - 1, j, k);
+                }
+                if (i <= fine.cells[0] && k <= fine.cells[2]) {
+                    fine.openness[1][cell] = fluid && isFluid(i, j - 1, k);
+                }
+                if (dim == 3 && i <= fine.cells[0] && j <= fine.cells[1]) {
+                    fine.openness[2][cell] = fluid && isFluid(i, j, k - 1);
+                }
+            }
+        }
+    }
+}
+
+void MultigridSolver::coarsen_(const Level<FLOAT>& fine, Level<FLOAT>& coarse) const {
+    const int dim = parameters_.geometry.dim;
+
+    for (int d = 0; d < 3; d++) {
+        coarse.cells[d] = (fine.cells[d] + coarse.ratio[d] - 1) / coarse.ratio[d];
+    }
+
+    coarse.strideY = coarse.cells[0] + 2;
+    coarse.strideZ = dim == 3 ? coarse.strideY * (coarse.cells[1] + 2) : 0;
+
+    coarse.pressureStorage.assign(coarse.size(), 0.0);
+    coarse.rhsStorage.assign(coarse.size(), 0.0);
+    coarse.residual.assign(coarse.size(), 0.0);
+    coarse.correction.assign(coarse.size(), 0.0);
+    coarse.pressure = coarse.pressureStorage.data();
+    coarse.rhs = coarse.rhsStorage.data();
+
+    // A coarse cell merges the fine cells 2I - 1 and 2I, the latter only if it exists, in the
+    // directions that are coarsened
+    for (int d = 0; d < 3; d++) {
+        if (d < dim) {
+            const int cells = coarse.cells[d];
+            coarse.width[d].assign(cells + 2, 0.0);
+
+            for (int I = 1; I <= cells; I++) {
+                for (int i = coarse.firstChild(d, I); i <= coarse.lastChild(d, I, fine.cells[d]); i++) {
+                    coarse.width[d][I] += fine.width[d][i];
+                }
+            }
+            coarse.width[d][0] = coarse.width[d][1];
+            coarse.width[d][cells + 1] = coarse.width[d][cells];
+        } else {
+            coarse.width[d].assign(3, 1.0);
+        }
+    }
+
+    exchangeWidths_(coarse);
+
+    // Linear interpolation of the correction: each fine cell takes the value of its coarse cell
+    // plus a share of the difference towards the coarse neighbour on its side
+    for (int d = 0; d < 3; d++) {
+        coarse.side[d].assign(fine.cells[d] + 2, 0);
+        coarse.weight[d].assign(fine.cells[d] + 2, 0.0);
+
+        if (coarse.ratio[d] == 1) {
+            continue;
+        }
+
+        for (int I = 1; I <= coarse.cells[d]; I++) {
+            FLOAT position = 0.0;
+            for (int i = coarse.firstChild(d, I); i <= coarse.lastChild(d, I, fine.cells[d]); i++) {
+                const FLOAT offset = position + 0.5 * fine.width[d][i] - 0.5 * coarse.width[d][I];
+                position += fine.width[d][i];
+
+                if (offset != 0.0) {
+                    const int side = offset > 0.0 ? 1 : -1;
+                    coarse.side[d][i] = side;
+                    coarse.weight[d][i] = fabs(offset) / (0.5 * (coarse.width[d][I] + coarse.width[d][I + side]));
+                }
+            }
+        }
+    }
+
+    // Summing the extents keeps the restricted right-hand side consistent on stretched meshes
+    for (int d = 0; d < 3; d++) {
+        coarse.extent[d].assign(coarse.cells[d] + 2, 1.0);
+
+        for (int I = 1; I <= coarse.cells[d]; I++) {
+            coarse.extent[d][I] = 0.0;
+            for (int i = coarse.firstChild(d, I); i <= coarse.lastChild(d, I, fine.cells[d]); i++) {
+                coarse.extent[d][I] += fine.extent[d][i];
+            }
+        }
+    }
+
+    // The openness of a coarse face is the mean of the fine faces it consists of
+    for (int d = 0; d < 3; d++) {
+        coarse.openness[d].assign(d < dim ? coarse.size() : 0, 0.0);
+    }
+
+    for (int d = 0; d < dim; d++) {
+        const int last[3] = {coarse.cells[0] + (d == 0), coarse.cells[1] + (d == 1), coarse.cells[2] + (d == 2)};
+
+        for (int K = 1; K <= last[2]; K++) {
+            for (int J = 1; J <= last[1]; J++) {
+                for (int I = 1; I <= last[0]; I++) {
+                    const int coarseIndex[3] = {I, J, K};
+                    int firstChild[3], lastChild[3];
+
+                    for (int e = 0; e < 3; e++) {
+                        if (e == d) {
+                            firstChild[e] = std::min(coarse.firstChild(e, coarseIndex[e]), fine.cells[e] + 1);
+                            lastChild[e] = firstChild[e];
+                        } else {
+                            firstChild[e] = coarse.firstChild(e, coarseIndex[e]);
+                            lastChild[e] = coarse.lastChild(e, coarseIndex[e], fine.cells[e]);
+                        }
+                    }
+
+                    FLOAT sum = 0.0;
+                    int faces = 0;
+                    for (int k = firstChild[2]; k <= lastChild[2]; k++) {
+                        for (int j = firstChild[1]; j <= lastChild[1]; j++) {
+                            for (int i = firstChild[0]; i <= lastChild[0]; i++) {
+                                sum += fine.openness[d][fine.index(i, j, k)];
+                                faces++;
+                            }
+                        }
+                    }
+
+                    coarse.openness[d][coarse.index(I, J, K)] = sum / faces;
+                }
+            }
+        }
+    }
+}
+
+void MultigridSolver::exchangeWidths_(Level<FLOAT>& level) const {
+    for (int d = 0; d < parameters_.geometry.dim; d++) {
+        std::vector<FLOAT>& width = level.width[d];
+        const int cells = level.cells[d];
+
+        if (isPeriodic(parameters_, d)) {
+            width[0] = width[cells];
+            width[cells + 1] = width[1];
+            continue;
+        }
+
+        const int low = getNeighbour(parameters_, d, false);
+        const int high = getNeighbour(parameters_, d, true);
+
+        std::vector<FLOAT> sent(1, width[1]), received(1, width[cells + 1]);
+        ParallelManagers::PetscParallelManager::sendRecvBuffers(sent, low, received, high);
+        width[cells + 1] = received[0];
+
+        sent[0] = width[cells];
+        received[0] = width[0];
+        ParallelManagers::PetscParallelManager::sendRecvBuffers(sent, high, received, low);
+        width[0] = received[0];
+    }
+}
+
+void MultigridSolver::setCoefficients_(Level<FLOAT>& level) const {
+    const int dim = parameters_.geometry.dim;
+
+    for (int d = 0; d < 3; d++) {
+        const int cells = level.cells[d];
+
+        // Coarse grids inherit the summed extents of the cells they merge, see coarsen_
+        const bool merged = !level.extent[d].empty();
+        if (!merged) {
+            level.extent[d].assign(cells + 2, 1.0);
+        }
+        level.coefficientLow[d].assign(cells + 2, 0.0);
+        level.coefficientHigh[d].assign(cells + 2, 0.0);
+        level.diagonalLow[d].assign(cells + 2, 0.0);
+        level.diagonalHigh[d].assign(cells + 2, 0.0);
+
+        if (d >= dim) {
+            continue;
+        }
+
+        // Same coefficients as in the SORSolver, expressed with the distances of the cell centres
+        const std::vector<FLOAT>& width = level.width[d];
+        for (int i = 1; i <= cells; i++) {
+            const FLOAT centreLow = 0.5 * (width[i - 1] + width[i]);
+            const FLOAT centreHigh = 0.5 * (width[i] + width[i + 1]);
+
+            if (!merged) {
+                level.extent[d][i] = 0.5 * (centreLow + centreHigh);
+            }
+            level.coefficientLow[d][i] = level.diagonalLow[d][i] = 1.0 / (centreLow * level.extent[d][i]);
+            level.coefficientHigh[d][i] = level.diagonalHigh[d][i] = 1.0 / (centreHigh * level.extent[d][i]);
+        }
+
+        // Walls: a velocity condition closes the face, an outflow keeps the pressure at zero on it
+        if (getNeighbour(parameters_, d, false) == MPI_PROC_NULL && !isPeriodic(parameters_, d)) {
+            level.coefficientLow[d][1] = 0.0;
+            level.diagonalLow[d][1] = getWallType(parameters_, d, false) == NEUMANN ? 2.0 * level.diagonalLow[d][1] : 0.0;
+        }
+        if (getNeighbour(parameters_, d, true) == MPI_PROC_NULL && !isPeriodic(parameters_, d)) {
+            level.coefficientHigh[d][cells] = 0.0;
+            level.diagonalHigh[d][cells] = getWallType(parameters_, d, true) == NEUMANN ? 2.0 * level.diagonalHigh[d][cells] : 0.0;
+        }
+    }
+
+    // Control volumes of the cells solved for, i.e. with at least one open face
+    level.volume.assign(level.size(), 0.0);
+
+    for (int k = 1; k <= level.cells[2]; k++) {
+        for (int j = 1; j <= level.cells[1]; j++) {
+            for (int i = 1; i <= level.cells[0]; i++) {
+                const int cell = level.index(i, j, k);
+                const int indices[3] = {i, j, k};
+                const int strides[3] = {1, level.strideY, level.strideZ};
+
+                FLOAT diagonal = 0.0;
+                for (int d = 0; d < dim; d++) {
+                    diagonal += level.openness[d][cell] * level.diagonalLow[d][indices[d]] +
+                                level.openness[d][cell + strides[d]] * level.diagonalHigh[d][indices[d]];
+                }
+
+                if (diagonal > 0.0) {
+                    level.volume[cell] = level.extent[0][i] * level.extent[1][j] * level.extent[2][k];
+                }
+            }
+        }
+    }
+
+    // Buffers for the largest face of the subdomain
+    int faceSize = 1;
+    for (int d = 0; d < 3; d++) {
+        faceSize = std::max(faceSize, level.cells[(d + 1) % 3] * level.cells[(d + 2) % 3]);
+    }
+    level.sendBuffer.assign(faceSize, 0.0);
+    level.receiveBuffer.assign(faceSize, 0.0);
+
+    level.lineDirection = lineSmoother_ ? selectLineDirection_(level) : -1;
+}
+
+int MultigridSolver::selectLineDirection_(const Level<FLOAT>& level) const {
+    // The strongest coupling, i.e. the thinnest cells, over all processes
+    FLOAT local[3] = {0.0, 0.0, 0.0};
+    for (int d = 0; d < parameters_.geometry.dim; d++) {
+        for (int i = 1; i <= level.cells[d]; i++) {
+            local[d] = std::max(local[d], std::max(level.coefficientLow[d][i], level.coefficientHigh[d][i]));
+        }
+    }
+
+    FLOAT global[3];
+    MPI_Allreduce(local, global, 3, MY_MPI_FLOAT, MPI_MAX, PETSC_COMM_WORLD);
+
+    return std::max_element(global, global + parameters_.geometry.dim) - global;
+}
+
+template <class Real>
+void MultigridSolver::updateGhosts_(Level<Real>& level, Real* const values) const {
+    const int strides[3] = {1, level.strideY, level.strideZ};
+    updateGhosts(parameters_, level.cells, strides, values, level.sendBuffer, level.receiveBuffer);
+}
+
+template <class D, class Real>
+inline void MultigridSolver::getStencil_(const Level<Real>& level, const Real* const values, int c, int i, int j, int k,
+                                         Real& diagonal, Real& neighbours) {
+    const int strideY = level.strideY;
+    const Real* const openX = level.openness[0].data();
+    const Real* const openY = level.openness[1].data();
+
+    diagonal = openX[c] * level.diagonalLow[0][i] + openX[c + 1] * level.diagonalHigh[0][i]
+             + openY[c] * level.diagonalLow[1][j] + openY[c + strideY] * level.diagonalHigh[1][j];
+    neighbours = openX[c] * level.coefficientLow[0][i] * values[c - 1] + openX[c + 1] * level.coefficientHigh[0][i] * values[c + 1]
+               + openY[c] * level.coefficientLow[1][j] * values[c - strideY]
+               + openY[c + strideY] * level.coefficientHigh[1][j] * values[c + strideY];
+
+    if constexpr (D::value == 3) {
+        const int strideZ = level.strideZ;
+        const Real* const openZ = level.openness[2].data();
+
+        diagonal += openZ[c] * level.diagonalLow[2][k] + openZ[c + strideZ] * level.diagonalHigh[2][k];
+        neighbours += openZ[c] * level.coefficientLow[2][k] * values[c - strideZ]
+                    + openZ[c + strideZ] * level.coefficientHigh[2][k] * values[c + strideZ];
+    }
+}
+
+template <class D, class Real>
+void MultigridSolver::smooth_(Level<Real>& level, int sweeps) {
+    Real* const p = level.pressure;
+    const Real* const rhs = level.rhs;
+
+    // The colours follow the global indices of the cells, like in the SORSolver, so that
+    // neighbouring cells on different processes are not relaxed at the same time
+    const int shift = (level.firstCell[0] + level.firstCell[1] + level.firstCell[2]) % 2;
+
+    for (int sweep = 0; sweep < sweeps; sweep++) {
+        for (int colour = 0; colour < 2; colour++) {
+            updateGhosts_(level, p);
+
+            if (level.lineDirection >= 0) {
+                relaxLines_<D>(level, colour);
+                continue;
+            }
+
+            #pragma omp parallel for collapse(2) schedule(static)
+            for (int k = 1; k <= level.cells[2]; k++) {
+                for (int j = 1; j <= level.cells[1]; j++) {
+                    // Cells with (i + j + k + shift) % 2 == colour
+                    const int first = (1 + j + k + shift) % 2 == colour ? 1 : 2;
+
+                    for (int i = first; i <= level.cells[0]; i += 2) {
+                        const int c = level.index(i, j, k);
+
+                        Real diagonal, neighbours;
+                        getStencil_<D>(level, p, c, i, j, k, diagonal, neighbours);
+
+                        if (diagonal > 0.0) {
+                            p[c] = (neighbours - rhs[c]) / diagonal;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <class D, class Real>
+void MultigridSolver::relaxLines_(Level<Real>& level, int colour) {
+    // Lines along d, batched along e, one batch per colour and layer along f
+    const int d = level.lineDirection;
+    const int e = d == 0 ? 1 : 0;
+    const int f = 3 - d - e;
+    const int strides[3] = {1, level.strideY, level.strideZ};
+    const int length = level.cells[d];
+    const int maxLines = (level.cells[e] + 1) / 2;
+
+    // The pieces of a line on neighbouring processes take turns, and the lines are coloured by
+    // their global indices, see SORSolver
+    const int shift = (parameters_.parallel.indices[d] + level.firstCell[e] + level.firstCell[f]) % 2;
+
+    Real* const p = level.pressure;
+    const Real* const rhs = level.rhs;
+    const Real* const open = level.openness[d].data();
+    const Real* const coefficientLow = level.coefficientLow[d].data();
+    const Real* const coefficientHigh = level.coefficientHigh[d].data();
+
+    #pragma omp parallel
+    {
+        std::vector<Real> lower(length * maxLines);
+        std::vector<Real> diagonal(length * maxLines);
+        std::vector<Real> upper(length * maxLines);
+        std::vector<Real> values(length * maxLines);
+
+        #pragma omp for schedule(static)
+        for (int b = 1; b <= level.cells[f]; b++) {
+            // Lines with (a + b + shift) % 2 == colour
+            const int first = (1 + b + shift) % 2 == colour ? 1 : 2;
+            const int lines = first <= level.cells[e] ? (level.cells[e] - first) / 2 + 1 : 0;
+
+            for (int l = 1; l <= length; l++) {
+                for (int n = 0; n < lines; n++) {
+                    int index[3];
+                    index[d] = l;
+                    index[e] = first + 2 * n;
+                    index[f] = b;
+                    const int c = level.index(index[0], index[1], index[2]);
+                    const int row = (l - 1) * lines + n;
+
+                    Real centre, neighbours;
+                    getStencil_<D>(level, p, c, index[0], index[1], index[2], centre, neighbours);
+
+                    // Cells not solved for keep their value
+                    if (centre == 0.0) {
+                        lower[row] = upper[row] = 0.0;
+                        diagonal[row] = 1.0;
+                        values[row] = p[c];
+                        continue;
+                    }
+
+                    // The neighbours along the line are unknowns, except the ghost cells at its ends
+                    Real low = open[c] * coefficientLow[l];
+                    Real high = open[c + strides[d]] * coefficientHigh[l];
+                    if (l > 1) {
+                        neighbours -= low * p[c - strides[d]];
+                    } else {
+                        low = 0.0;
+                    }
+                    if (l < length) {
+                        neighbours -= high * p[c + strides[d]];
+                    } else {
+                        high = 0.0;
+                    }
+
+                    lower[row] = -low;
+                    upper[row] = -high;
+                    diagonal[row] = centre;
+                    values[row] = neighbours - rhs[c];
+                }
+            }
+
+            solveTridiagonalLines(length, lines, lower.data(), diagonal.data(), upper.data(), values.data());
+
+            for (int l = 1; l <= length; l++) {
+                for (int n = 0; n < lines; n++) {
+                    const int c = l * strides[d] + (first + 2 * n) * strides[e] + b * strides[f];
+                    p[c] = values[(l - 1) * lines + n];
+                }
+            }
+        }
+    }
+}
+
+template <class D, class Real>
+FLOAT MultigridSolver::computeResidual_(Level<Real>& level) {
+    const int cellsX = level.cells[0];
+    const int cellsY = level.cells[1];
+    const int cellsZ = level.cells[2];
+
+    Real* const p = level.pressure;
+    const Real* const rhs = level.rhs;
+    Real* const residual = level.residual.data();
+    const Real* const volume = level.volume.data();
+
+    updateGhosts_(level, p);
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int k = 1; k <= cellsZ; k++) {
+        for (int j = 1; j <= cellsY; j++) {
+            for (int i = 1; i <= cellsX; i++) {
+                const int c = level.index(i, j, k);
+
+                if (volume[c] == 0.0) {
+                    residual[c] = 0.0;
+                    continue;
+                }
+
+                Real diagonal, neighbours;
+                getStencil_<D>(level, p, c, i, j, k, diagonal, neighbours);
+                residual[c] = rhs[c] - (neighbours - diagonal * p[c]);
+            }
+        }
+    }
+
+    if (singular_) {
+        removeMean_(level, level.residual);
+    }
+
+    // Root mean square over the cells solved for
+    FLOAT local[2] = {0.0, 0.0};
+    FLOAT sum = 0.0, count = 0.0;
+
+    #pragma omp parallel for collapse(2) schedule(static) reduction(+:sum, count)
+    for (int k = 1; k <= cellsZ; k++) {
+        for (int j = 1; j <= cellsY; j++) {
+            for (int i = 1; i <= cellsX; i++) {
+                const int c = level.index(i, j, k);
+                if (volume[c] > 0.0) {
+                    sum += residual[c] * residual[c];
+                    count += 1.0;
+                }
+            }
+        }
+    }
+
+    local[0] = sum;
+    local[1] = count;
+
+    FLOAT global[2];
+    MPI_Allreduce(local, global, 2, MY_MPI_FLOAT, MPI_SUM, PETSC_COMM_WORLD);
+
+    return global[1] > 0.0 ? sqrt(global[0] / global[1]) : 0.0;
+}
+
+template <class Real>
+void MultigridSolver::removeMean_(const Level<Real>& level, std::vector<Real>& values) const {
+    const Real* const volume = level.volume.data();
+    FLOAT weighted = 0.0, total = 0.0;
+
+    #pragma omp parallel for collapse(2) schedule(static) reduction(+:weighted, total)
+    for (int k = 1; k <= level.cells[2]; k++) {
+        for (int j = 1; j <= level.cells[1]; j++) {
+            for (int i = 1; i <= level.cells[0]; i++) {
+                const int c = level.index(i, j, k);
+                weighted += volume[c] * values[c];
+                total += volume[c];
+            }
+        }
+    }
+
+    FLOAT local[2] = {weighted, total};
+    FLOAT global[2];
+    MPI_Allreduce(local, global, 2, MY_MPI_FLOAT, MPI_SUM, PETSC_COMM_WORLD);
+
+    if (global[1] == 0.0) {
+        return;
+    }
+
+    const FLOAT mean = global[0] / global[1];
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int k = 1; k <= level.cells[2]; k++) {
+        for (int j = 1; j <= level.cells[1]; j++) {
+            for (int i = 1; i <= level.cells[0]; i++) {
+                const int c = level.index(i, j, k);
+                if (volume[c] > 0.0) {
+                    values[c] -= mean;
+                }
+            }
+        }
+    }
+}
+
+template <class D, class Real>
+void MultigridSolver::restrict_(const Level<Real>& fine, Level<Real>& coarse) {
+    std::fill(coarse.pressureStorage.begin(), coarse.pressureStorage.end(), 0.0);
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int K = 1; K <= coarse.cells[2]; K++) {
+        for (int J = 1; J <= coarse.cells[1]; J++) {
+            for (int I = 1; I <= coarse.cells[0]; I++) {
+                FLOAT sum = 0.0;
+                for (int k = coarse.firstChild(2, K); k <= coarse.lastChild(2, K, fine.cells[2]); k++) {
+                    for (int j = coarse.firstChild(1, J); j <= coarse.lastChild(1, J, fine.cells[1]); j++) {
+                        for (int i = coarse.firstChild(0, I); i <= coarse.lastChild(0, I, fine.cells[0]); i++) {
+                            const int c = fine.index(i, j, k);
+                            sum += fine.volume[c] * fine.residual[c];
+                        }
+                    }
+                }
+
+                coarse.rhs[coarse.index(I, J, K)] = sum / (coarse.extent[0][I] * coarse.extent[1][J] * coarse.extent[2][K]);
+            }
+        }
+    }
+}
+
+template <class D, class Real>
+void MultigridSolver::prolongate_(Level<Real>& coarse, Level<Real>& fine) {
+    Real* const correction = fine.correction.data();
+    const Real* const residual = fine.residual.data();
+    const Real* const volume = fine.volume.data();
+    const Real* const values = coarse.pressure;
+    const int strides[3] = {1, coarse.strideY, coarse.strideZ};
+
+    updateGhosts_(coarse, coarse.pressure);
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int k = 1; k <= fine.cells[2]; k++) {
+        for (int j = 1; j <= fine.cells[1]; j++) {
+            for (int i = 1; i <= fine.cells[0]; i++) {
+                const int c = fine.index(i, j, k);
+                if (volume[c] == 0.0) {
+                    correction[c] = 0.0;
+                    continue;
+                }
+
+                const int fineIndex[3] = {i, j, k};
+                const int coarseIndex[3] = {coarse.parent(0, i), coarse.parent(1, j), coarse.parent(2, k)};
+                const int C = coarse.index(coarseIndex[0], coarseIndex[1], coarseIndex[2]);
+
+                Real value = values[C];
+                for (int d = 0; d < D::value; d++) {
+                    const int side = coarse.side[d][fineIndex[d]];
+                    if (side == 0) {
+                        continue;
+                    }
+
+                    // Closed faces keep the value of the coarse cell; at outflow walls, where the
+                    // correction vanishes on the face, the ghost value is the negated one
+                    const int I = coarseIndex[d];
+                    const int neighbour = C + side * strides[d];
+                    const Real open = coarse.openness[d][side > 0 ? neighbour : C];
+                    const Real coefficient = side > 0 ? coarse.coefficientHigh[d][I] : coarse.coefficientLow[d][I];
+                    const Real diagonal = side > 0 ? coarse.diagonalHigh[d][I] : coarse.diagonalLow[d][I];
+
+                    if (open > 0.0 && coefficient > 0.0) {
+                        value += coarse.weight[d][fineIndex[d]] * (values[neighbour] - values[C]);
+                    } else if (open > 0.0 && diagonal > 0.0) {
+                        value -= 2.0 * coarse.weight[d][fineIndex[d]] * values[C];
+                    }
+                }
+
+                correction[c] = value;
+            }
+        }
+    }
+
+    updateGhosts_(fine, correction);
+
+    // The correction is scaled to minimize the error in the energy norm, so that the coarse grid
+    // correction never increases the error, even where the coarse operator is a poor fit.
+    FLOAT projection = 0.0, energy = 0.0;
+
+    #pragma omp parallel for collapse(2) schedule(static) reduction(+:projection, energy)
+    for (int k = 1; k <= fine.cells[2]; k++) {
+        for (int j = 1; j <= fine.cells[1]; j++) {
+            for (int i = 1; i <= fine.cells[0]; i++) {
+                const int c = fine.index(i, j, k);
+                if (volume[c] == 0.0) {
+                    continue;
+                }
+
+                Real diagonal, neighbours;
+                getStencil_<D>(fine, correction, c, i, j, k, diagonal, neighbours);
+
+                projection += volume[c] * correction[c] * residual[c];
+                energy += volume[c] * correction[c] * (neighbours - diagonal * correction[c]);
+            }
+        }
+    }
+
+    FLOAT local[2] = {projection, energy};
+    FLOAT global[2];
+    MPI_Allreduce(local, global, 2, MY_MPI_FLOAT, MPI_SUM, PETSC_COMM_WORLD);
+
+    // The operator is negative definite, apart from constants in singular problems
+    const FLOAT step = global[1] < 0.0 ? global[0] / global[1] : 0.0;
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int k = 1; k <= fine.cells[2]; k++) {
+        for (int j = 1; j <= fine.cells[1]; j++) {
+            for (int i = 1; i <= fine.cells[0]; i++) {
+                const int c = fine.index(i, j, k);
+                fine.pressure[c] += step * correction[c];
+            }
+        }
+    }
+}
+
+template <class D, class Real>
+void MultigridSolver::runCycle_(std::vector<Level<Real>>& levels, int level, Cycle cycle) {
+    Level<Real>& fine = levels[level];
+
+    if (level == static_cast<int>(levels.size()) - 1) {
+        smooth_<D>(fine, coarsestSweeps_);
+        return;
+    }
+
+    Level<Real>& coarse = levels[level + 1];
+
+    smooth_<D>(fine, preSmoothing_);
+    computeResidual_<D>(fine);
+    restrict_<D>(fine, coarse);
+
+    // The F-cycle solves the coarse problem with an F-cycle followed by a V-cycle
+    if (cycle == F_CYCLE) {
+        runCycle_<D>(levels, level + 1, F_CYCLE);
+    }
+    runCycle_<D>(levels, level + 1, V_CYCLE);
+
+    prolongate_<D>(coarse, fine);
+    smooth_<D>(fine, postSmoothing_);
+}
+
+template <class D>
+void MultigridSolver::solve_() {
+    Level<FLOAT>& fine = levels_[0];
+
+    // Scale of the right-hand side over the cells solved for
+    FLOAT local[2] = {0.0, 0.0};
+    for (int k = 1; k <= fine.cells[2]; k++) {
+        for (int j = 1; j <= fine.cells[1]; j++) {
+            for (int i = 1; i <= fine.cells[0]; i++) {
+                const int c = fine.index(i, j, k);
+                if (fine.volume[c] > 0.0) {
+                    local[0] += fine.rhs[c] * fine.rhs[c];
+                    local[1] += 1.0;
+                }
+            }
+        }
+    }
+
+    FLOAT global[2];
+    MPI_Allreduce(local, global, 2, MY_MPI_FLOAT, MPI_SUM, PETSC_COMM_WORLD);
+    const FLOAT rhsNorm = global[1] > 0.0 ? sqrt(global[0] / global[1]) : 0.0;
+
+    FLOAT residualNorm = computeResidual_<D>(fine);
+    const FLOAT threshold = (tolerance_ > 0 ? tolerance_ : DEFAULT_TOLERANCE) * std::max(rhsNorm, residualNorm);
+
+    int cycles = 0;
+    if (mixedPrecision_) {
+        cycles = refine_(threshold, maxCycles_, residualNorm);
+    } else {
+        while (residualNorm > threshold && cycles < maxCycles_) {
+            runCycle_<D>(levels_, 0, cycle_);
+            residualNorm = computeResidual_<D>(fine);
+            cycles++;
+        }
+    }
+
+    if (parameters_.parallel.rank == 0) {
+        std::cout << "MultigridSolver needed " << cycles << " cycles, residual " << residualNorm << std::endl;
+    }
+}
+
+FLOAT MultigridSolver::computeDefect_() {
+    if (parameters_.geometry.dim == 3) {
+        return computeResidual_<Dim<3>>(levels_[0]);
+    }
+    return computeResidual_<Dim<2>>(levels_[0]);
+}
+
+void MultigridSolver::correctDefect_() {
+    Level<FLOAT>& fine = levels_[0];
+    Level<float>& single = singleLevels_[0];
+
+    // One cycle on the defect equation, starting from a zero correction
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int k = 1; k <= fine.cells[2]; k++) {
+        for (int j = 1; j <= fine.cells[1]; j++) {
+            for (int i = 1; i <= fine.cells[0]; i++) {
+                const int c = fine.index(i, j, k);
+                single.rhs[c] = fine.residual[c];
+            }
+        }
+    }
+    std::fill(single.pressureStorage.begin(), single.pressureStorage.end(), 0.0f);
+
+    if (parameters_.geometry.dim == 3) {
+        runCycle_<Dim<3>>(singleLevels_, 0, cycle_);
+    } else {
+        runCycle_<Dim<2>>(singleLevels_, 0, cycle_);
+    }
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int k = 1; k <= fine.cells[2]; k++) {
+        for (int j = 1; j <= fine.cells[1]; j++) {
+            for (int i = 1; i <= fine.cells[0]; i++) {
+                const int c = fine.index(i, j, k);
+                fine.pressure[c] += single.pressure[c];
+            }
+        }
+    }
+}
+
+void MultigridSolver::solve() {
+    if (parameters_.geometry.dim == 3) {
+        solve_<Dim<3>>();
+    } else {
+        solve_<Dim<2>>();
+    }
+
+    // The parallel and periodic ghost cells are up to date after the last residual
+    Level<FLOAT>& fine = levels_[0];
+    const int strides[3] = {1, fine.strideY, fine.strideZ};
+    setObstaclePressure(parameters_, flowField_.getFlags(), fine.cells, strides, fine.pressure);
+}
+
+void MultigridSolver::reInitMatrix() {
+    createLevels_();
+}
+
+} // namespace Solvers
+} // namespace NSEOF
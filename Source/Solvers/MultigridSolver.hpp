@@ -0,0 +1,141 @@
+#ifndef __SOLVERS_MULTIGRID_SOLVER_HPP__
+#define __SOLVERS_MULTIGRID_SOLVER_HPP__
+
+#include "LinearSolver.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace NSEOF {
+namespace Solvers {
+
+/** Matrix-free geometric multigrid solver for the pressure equation
+ *
+ * Works on the pressure and right-hand side of the flow field with the 7-point (5-point in 2D)
+ * stencil of the SORSolver, on stretched meshes as well. Only fluid cells are solved for; faces
+ * towards obstacles and walls with a velocity condition are closed, i.e. the normal pressure
+ * derivative vanishes there, and outflow walls keep the pressure at zero. Coarse grids merge two
+ * cells in the directions where the cells are not much wider than in the others (a single one at
+ * the end of odd sizes) and open every face by the fraction of the merged fine faces that are
+ * open, so thin obstacles are retained. Residuals are restricted with volume weights; corrections
+ * are interpolated linearly between the coarse centres and scaled to minimise the error in the
+ * energy norm. Red-black Gauss-Seidel sweeps are used for smoothing and to solve on the coarsest
+ * grid; between the colours the ghost layers are exchanged with the neighbouring processes. The
+ * line smoother instead relaxes whole lines along the most strongly coupled direction of each grid
+ * with tridiagonal solves, in zebra order, which keeps the convergence independent of the aspect
+ * ratio of the cells. Lines end at the process boundaries.
+ *
+ * With mixedPrecision, the cycles run on a copy of the hierarchy in single precision. They solve
+ * for the correction of the defect, which is computed on the pressure in double precision, see
+ * LinearSolver::refine_.
+ */
+class MultigridSolver : public LinearSolver {
+private:
+    enum Cycle { V_CYCLE, F_CYCLE };
+
+    /** One grid of the hierarchy. Indices run from 0 to cells + 1 per direction, where 0 and
+     *  cells + 1 are ghost layers. In 2D, there is a single layer k = 1 and strideZ is zero.
+     *  Real is the type of the values and coefficients the cycles work with; the geometry used to
+     *  set up the hierarchy is always FLOAT.
+     */
+    template <class Real>
+    struct Level {
+        int cells[3];
+        int ratio[3]; //! Cells of the next finer grid merged per direction, 1 or 2
+        int firstCell[3]; //! Global index of the first inner cell, which fixes the colours of the smoothers
+        int strideY;
+        int strideZ;
+        int lineDirection; //! Direction of the lines of the line smoother, -1 for point smoothing
+
+        Real* pressure; //! Pressure on the finest grid, correction on the others
+        Real* rhs;
+        std::vector<Real> pressureStorage; //! Unless the flow field holds the values
+        std::vector<Real> rhsStorage;      //! Unless the flow field holds the values
+        std::vector<Real> residual;
+        std::vector<Real> correction; //! Prolongated correction from the next coarser grid
+        std::vector<Real> volume; //! Control volume of the cells solved for, zero for the others
+
+        std::vector<Real> openness[3]; //! Open fraction of the face between a cell and its lower neighbour
+        std::vector<FLOAT> sendBuffer;
+        std::vector<FLOAT> receiveBuffer;
+
+        // 1D arrays per direction, indexed like the cells
+        std::vector<FLOAT> width[3];           //! Cell widths, including the ghost layers
+        std::vector<FLOAT> extent[3];          //! Distance of the centres of the lower and upper neighbour, halved
+        std::vector<Real> coefficientLow[3];  //! Coupling to the lower neighbour, zero at walls
+        std::vector<Real> coefficientHigh[3]; //! Coupling to the upper neighbour, zero at walls
+        std::vector<Real> diagonalLow[3];     //! Contribution of the lower face to the diagonal
+        std::vector<Real> diagonalHigh[3];    //! Contribution of the upper face to the diagonal
+
+        // Interpolation to the next finer grid, indexed like its cells
+        std::vector<int> side[3];    //! Direction of the coarse neighbour to interpolate with, -1, 0 or 1
+        std::vector<Real> weight[3]; //! Share of the difference to that neighbour
+
+        int index(int i, int j, int k) const { return i + j * strideY + k * strideZ; }
+        int size() const { return index(cells[0] + 1, cells[1] + 1, cells[2] + 1) + 1; }
+
+        // Cells of the next finer grid that make up cell I in direction d, and the inverse
+        int firstChild(int d, int I) const { return ratio[d] * (I - 1) + 1; }
+        int lastChild(int d, int I, int fineCells) const { return std::min(ratio[d] * I, fineCells); }
+        int parent(int d, int i) const { return (i + ratio[d] - 1) / ratio[d]; }
+    };
+
+    std::vector<Level<FLOAT>> levels_;
+    std::vector<Level<float>> singleLevels_; //! Hierarchy of the cycles in mixed precision, empty otherwise
+
+    Cycle cycle_;
+    int maxCycles_;
+    int preSmoothing_;
+    int postSmoothing_;
+    int coarsestSweeps_;
+
+    bool singular_; //! No wall fixes the pressure level, so the residuals are kept free of a mean value
+    bool mixedPrecision_;
+    bool lineSmoother_;
+
+    void createLevels_();
+    bool selectCoarsening_(const Level<FLOAT>& level, int ratio[3]) const;
+    void coarsen_(const Level<FLOAT>& fine, Level<FLOAT>& coarse) const;
+    void setCoefficients_(Level<FLOAT>& level) const;
+    int selectLineDirection_(const Level<FLOAT>& level) const;
+    void setFineOpenness_();
+    void exchangeWidths_(Level<FLOAT>& level) const;
+    void setFirstCells_();
+    static void copyToSingle_(const Level<FLOAT>& level, Level<float>& single);
+
+    template <class Real> void updateGhosts_(Level<Real>& level, Real* values) const;
+
+    /** Diagonal and sum of the neighbour terms of the operator in cell c = (i, j, k), such that
+     *  (A values)_c = neighbours - diagonal * values[c]
+     */
+    template <class D, class Real>
+    static void getStencil_(const Level<Real>& level, const Real* values, int c, int i, int j, int k,
+                            Real& diagonal, Real& neighbours);
+
+    template <class D, class Real> void smooth_(Level<Real>& level, int sweeps);
+    template <class D, class Real> void relaxLines_(Level<Real>& level, int colour);
+    template <class D, class Real> FLOAT computeResidual_(Level<Real>& level);
+    template <class D, class Real> void restrict_(const Level<Real>& fine, Level<Real>& coarse);
+    template <class D, class Real> void prolongate_(Level<Real>& coarse, Level<Real>& fine);
+
+    template <class D, class Real> void runCycle_(std::vector<Level<Real>>& levels, int level, Cycle cycle);
+    template <class D> void solve_();
+
+    template <class Real> void removeMean_(const Level<Real>& level, std::vector<Real>& values) const;
+
+protected:
+    FLOAT computeDefect_() override;
+    void correctDefect_() override;
+
+public:
+    MultigridSolver(FlowField& flowField, const Parameters& parameters);
+    ~MultigridSolver() override = default;
+
+    void solve() override;
+    void reInitMatrix() override;
+};
+
+} // namespace Solvers
+} // namespace NSEOF
+
+#endif // __SOLVERS_MULTIGRID_SOLVER_HPP__
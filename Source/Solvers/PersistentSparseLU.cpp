@@ -0,0 +1,141 @@
+#include "PersistentSparseLU.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <new>
+
+namespace NSEOF::Solvers {
+
+static const char FILE_TAG[8] = {'N', 'S', 'E', 'O', 'F', 'L', 'U', '1'};
+
+static void hashBytes(std::uint64_t& hash, const void* data, std::size_t size) {
+    // FNV-1a
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+}
+
+template <class T>
+static void writeValue(std::ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+static bool readValue(std::ifstream& file, T& value) {
+    return (bool) file.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+template <class Vector>
+static void writeVector(std::ofstream& file, const Vector& vector) {
+    const std::int64_t size = vector.size();
+    writeValue(file, size);
+    file.write(reinterpret_cast<const char*>(vector.data()), size * sizeof(typename Vector::Scalar));
+}
+
+template <class Vector>
+static bool readVector(std::ifstream& file, Vector& vector) {
+    std::int64_t size;
+    if (!readValue(file, size) || size < 0) {
+        return false;
+    }
+
+    vector.resize(size);
+    return (bool) file.read(reinterpret_cast<char*>(vector.data()), size * sizeof(typename Vector::Scalar));
+}
+
+std::uint64_t PersistentSparseLU::fingerprint(const MatrixType& matrix) {
+    ASSERTION(matrix.isCompressed());
+
+    std::uint64_t hash = 14695981039346656037ULL;
+    const std::int64_t sizes[3] = {matrix.rows(), matrix.cols(), matrix.nonZeros()};
+
+    hashBytes(hash, sizes, sizeof(sizes));
+    hashBytes(hash, matrix.outerIndexPtr(), (matrix.outerSize() + 1) * sizeof(int));
+    hashBytes(hash, matrix.innerIndexPtr(), matrix.nonZeros() * sizeof(int));
+    hashBytes(hash, matrix.valuePtr(), matrix.nonZeros() * sizeof(FLOAT));
+
+    return hash;
+}
+
+void PersistentSparseLU::save(const std::string& filename, std::uint64_t fingerprint) const {
+    ASSERTION(m_factorizationIsOk);
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) {
+        HANDLE_ERROR(1, "Could not write the factorization file");
+    }
+
+    file.write(FILE_TAG, sizeof(FILE_TAG));
+    writeValue(file, (std::int32_t) sizeof(FLOAT));
+    writeValue(file, fingerprint);
+
+    const std::int64_t counts[5] = {m_perm_c.size(), m_nnzL, m_nnzU, m_detPermR, m_detPermC};
+    writeValue(file, counts);
+
+    writeVector(file, m_perm_c.indices());
+    writeVector(file, m_perm_r.indices());
+
+    writeVector(file, m_glu.xsup);
+    writeVector(file, m_glu.supno);
+    writeVector(file, m_glu.lusup);
+    writeVector(file, m_glu.lsub);
+    writeVector(file, m_glu.xlusup);
+    writeVector(file, m_glu.xlsub);
+    writeVector(file, m_glu.ucol);
+    writeVector(file, m_glu.usub);
+    writeVector(file, m_glu.xusub);
+
+    if (!file) {
+        HANDLE_ERROR(1, "Could not write the factorization file");
+    }
+}
+
+bool PersistentSparseLU::load(const std::string& filename, std::uint64_t fingerprint) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    char tag[sizeof(FILE_TAG)];
+    std::int32_t floatSize;
+    std::uint64_t fileFingerprint;
+    std::int64_t counts[5];
+
+    if (!file.read(tag, sizeof(tag)) || memcmp(tag, FILE_TAG, sizeof(tag)) != 0
+        || !readValue(file, floatSize) || floatSize != (std::int32_t) sizeof(FLOAT)
+        || !readValue(file, fileFingerprint) || fileFingerprint != fingerprint
+        || !readValue(file, counts)) {
+        return false;
+    }
+
+    const bool complete = readVector(file, m_perm_c.indices()) && readVector(file, m_perm_r.indices())
+                       && readVector(file, m_glu.xsup) && readVector(file, m_glu.supno)
+                       && readVector(file, m_glu.lusup) && readVector(file, m_glu.lsub)
+                       && readVector(file, m_glu.xlusup) && readVector(file, m_glu.xlsub)
+                       && readVector(file, m_glu.ucol) && readVector(file, m_glu.usub)
+                       && readVector(file, m_glu.xusub);
+    if (!complete) {
+        return false;
+    }
+
+    // Same state as at the end of SparseLU::factorize
+    const Eigen::Index n = counts[0];
+    m_nnzL = counts[1];
+    m_nnzU = counts[2];
+    m_detPermR = counts[3];
+    m_detPermC = counts[4];
+
+    m_Lstore.setInfos(n, n, m_glu.lusup, m_glu.xlusup, m_glu.lsub, m_glu.xlsub, m_glu.supno, m_glu.xsup);
+    new (&m_Ustore) Eigen::MappedSparseMatrix<FLOAT, Eigen::ColMajor, int>(
+        n, n, m_nnzU, m_glu.xusub.data(), m_glu.usub.data(), m_glu.ucol.data());
+
+    m_info = Eigen::Success;
+    m_analysisIsOk = true;
+    m_factorizationIsOk = true;
+    m_isInitialized = true;
+
+    return true;
+}
+
+} // namespace NSEOF::Solvers
@@ -0,0 +1,37 @@
+#ifndef __SOLVERS_PERSISTENT_SPARSE_LU_HPP__
+#define __SOLVERS_PERSISTENT_SPARSE_LU_HPP__
+
+#include "Definitions.hpp"
+
+#include <cstdint>
+#include <string>
+
+#include <Eigen/Sparse>
+#include <Eigen/SparseLU>
+
+namespace NSEOF::Solvers {
+
+/** Sparse LU factorization with a fill-reducing column ordering, which can be written to a file
+ *  and read back, so that runs on the same geometry skip the factorization
+ *
+ * Eigen does not serialize its factorizations, so this class stores the supernodal factors and
+ * the permutations from the internals of Eigen::SparseLU (Eigen 3.4 layout). A file is only
+ * accepted if it was written for a matrix with the same fingerprint and floating point type.
+ */
+class PersistentSparseLU : public Eigen::SparseLU<Eigen::SparseMatrix<FLOAT>, Eigen::COLAMDOrdering<int>> {
+public:
+    using MatrixType = Eigen::SparseMatrix<FLOAT>;
+
+    // Hash over the size, the pattern and the values of the matrix
+    static std::uint64_t fingerprint(const MatrixType& matrix);
+
+    // Writes the factorization, which has to be computed already
+    void save(const std::string& filename, std::uint64_t fingerprint) const;
+
+    // Restores a factorization written by save. Returns false if the file does not exist or belongs to another matrix
+    bool load(const std::string& filename, std::uint64_t fingerprint);
+};
+
+} // namespace NSEOF::Solvers
+
+#endif // __SOLVERS_PERSISTENT_SPARSE_LU_HPP__
@@ -2,6 +2,8 @@
 
 #include "PetscSolver.hpp"
 
+#include <algorithm>
+
 namespace NSEOF {
 namespace Solvers {
 
@@ -67,6 +69,139 @@ void createLimits(Parameters& parameters, DM& da, int* limitsX, int* limitsY, in
     }
 }
 
+// The edge rows and the null space below are only set up for the multigrid preconditioners; with
+// the others, the operator is assembled as before, with the constant vector as null space
+static bool usesMultigrid(const Parameters& parameters) {
+    return parameters.solver.preconditioner == "mg" || parameters.solver.preconditioner == "gamg";
+}
+
+// Number of coordinates of a cell of the PETSc grid that lie in the boundary layer
+static int countBoundaryCoordinates(const Parameters& parameters, PetscInt i, PetscInt j, PetscInt k) {
+    int count = (i == 0 || i == parameters.geometry.sizeX + 1) + (j == 0 || j == parameters.geometry.sizeY + 1);
+    if (parameters.geometry.dim == 3) {
+        count += (k == 0 || k == parameters.geometry.sizeZ + 1);
+    }
+    return count;
+}
+
+// The edges and corners of the boundary layer belong to no equation. They get a unit diagonal,
+// so that the matrix has no empty rows, which the smoothers of the multigrid preconditioners
+// cannot deal with.
+static void setEdgeRows(DM da, Mat A, const Parameters& parameters) {
+    PetscInt firstX, firstY, firstZ, lengthX, lengthY, lengthZ;
+    DMDAGetCorners(da, &firstX, &firstY, &firstZ, &lengthX, &lengthY, &lengthZ);
+
+    const PetscScalar one = 1.0;
+    MatStencil row;
+    row.c = 0;
+
+    for (PetscInt k = firstZ; k < firstZ + lengthZ; k++) {
+        for (PetscInt j = firstY; j < firstY + lengthY; j++) {
+            for (PetscInt i = firstX; i < firstX + lengthX; i++) {
+                if (countBoundaryCoordinates(parameters, i, j, k) >= 2) {
+                    row.i = i; row.j = j; row.k = k;
+                    MatSetValuesStencil(A, 1, &row, 1, &row, &one, INSERT_VALUES);
+                }
+            }
+        }
+    }
+}
+
+// Unless an outflow wall fixes the pressure level, the pressure is only determined up to a
+// constant on the cells that take part in the flow. That vector is attached as null space, which
+// keeps the Krylov solver consistent and gives the algebraic multigrid its coarse space. Cells
+// inside obstacles and on the edges of the boundary layer have equations of their own and are
+// zero in it.
+static void setNullSpace(DM da, Mat A, PetscUserCtx* context) {
+    Parameters& parameters = context->getParameters();
+    IntScalarField& flags = context->getFlowField().getFlags();
+    const int dim = parameters.geometry.dim;
+
+    const BoundaryType walls[6] = {parameters.walls.typeLeft, parameters.walls.typeRight,
+                                   parameters.walls.typeBottom, parameters.walls.typeTop,
+                                   parameters.walls.typeFront, parameters.walls.typeBack};
+    for (int wall = 0; wall < 2 * dim; wall++) {
+        if (walls[wall] == NEUMANN) {
+            return;
+        }
+    }
+
+    // Flags of the obstacle cells that get an equation of their own, see computeMatrix2D/3D
+    const int enclosed = dim == 2 ? OBSTACLE_SELF + OBSTACLE_LEFT + OBSTACLE_RIGHT + OBSTACLE_TOP + OBSTACLE_BOTTOM : 127;
+
+    int* limitsX, * limitsY, * limitsZ;
+    context->getLimits(&limitsX, &limitsY, &limitsZ);
+
+    PetscInt firstX, firstY, firstZ, lengthX, lengthY, lengthZ;
+    DMDAGetCorners(da, &firstX, &firstY, &firstZ, &lengthX, &lengthY, &lengthZ);
+
+    Vec constant;
+    PetscScalar* values;
+    DMCreateGlobalVector(da, &constant);
+    VecGetArray(constant, &values);
+
+    PetscInt index = 0;
+    for (PetscInt k = firstZ; k < firstZ + lengthZ; k++) {
+        for (PetscInt j = firstY; j < firstY + lengthY; j++) {
+            for (PetscInt i = firstX; i < firstX + lengthX; i++) {
+                PetscScalar value = 1.0;
+
+                const bool inner = i >= limitsX[0] && i < limitsX[1] && j >= limitsY[0] && j < limitsY[1]
+                                && (dim == 2 || (k >= limitsZ[0] && k < limitsZ[1]));
+
+                if (countBoundaryCoordinates(parameters, i, j, k) >= 2) {
+                    value = 0.0;
+                } else if (inner) {
+                    const int cellIndexX = i - limitsX[0] + 2;
+                    const int cellIndexY = j - limitsY[0] + 2;
+                    const int obstacle = dim == 2 ? flags.getValue(cellIndexX, cellIndexY)
+                                                  : flags.getValue(cellIndexX, cellIndexY, k - limitsZ[0] + 2);
+                    if (obstacle == enclosed) {
+                        value = 0.0;
+                    }
+                }
+
+                values[index++] = value;
+            }
+        }
+    }
+
+    VecRestoreArray(constant, &values);
+    VecNormalize(constant, NULL);
+
+    MatNullSpace nullspace;
+    MatNullSpaceCreate(PETSC_COMM_WORLD, PETSC_FALSE, 1, &constant, &nullspace);
+    MatSetNullSpace(A, nullspace);
+    MatSetNearNullSpace(A, nullspace);
+    MatNullSpaceDestroy(&nullspace);
+    VecDestroy(&constant);
+}
+
+// Levels of the DMDA hierarchy for PCMG. With cell-centred transfer operators, every coarsening
+// halves the number of cells in each direction, boundary layer included. The coarsest level keeps
+// at least two cells per process and direction.
+static int countMultigridLevels(const Parameters& parameters) {
+    const int sizes[3] = {parameters.geometry.sizeX, parameters.geometry.sizeY, parameters.geometry.sizeZ};
+    int levels = 1;
+
+    for (;;) {
+        const int factor = 1 << levels;
+
+        for (int d = 0; d < parameters.geometry.dim; d++) {
+            if ((sizes[d] + 2) % factor != 0) {
+                return levels;
+            }
+            for (int p = 0; p < parameters.parallel.numProcessors[d]; p++) {
+                if (parameters.parallel.sizes[d][p] < 2 * factor) {
+                    return levels;
+                }
+            }
+        }
+
+        levels++;
+    }
+}
+
 PetscUserCtx::PetscUserCtx(Parameters& parameters, FlowField& flowField)
     : parameters_(parameters)
     , flowField_(flowField) {}
@@ -105,10 +240,7 @@ PetscSolver::PetscSolver(FlowField& flowField, Parameters& parameters)
     KSPCreate(PETSC_COMM_WORLD, &ksp_);
     PCCreate(PETSC_COMM_WORLD, &pc_);
 
-    PetscErrorCode (*computeMatrix)(KSP, Mat, Mat, void*) = NULL;
-
     if (parameters_.geometry.dim == 2) {
-        computeMatrix = computeMatrix2D;
         DMDACreate2d(PETSC_COMM_WORLD, bx, by, DMDA_STENCIL_STAR,
             parameters_.geometry.sizeX + 2, parameters.geometry.sizeY + 2,
             parameters_.parallel.numProcessors[0],
@@ -118,7 +250,6 @@ PetscSolver::PetscSolver(FlowField& flowField, Parameters& parameters)
             parameters_.parallel.sizes[1],
             &da_);
     } else if (parameters_.geometry.dim == 3) {
-        computeMatrix = computeMatrix3D;
         DMDACreate3d(PETSC_COMM_WORLD, bx, by, bz, DMDA_STENCIL_STAR,
             parameters_.geometry.sizeX + 2, parameters.geometry.sizeY + 2,
             parameters_.geometry.sizeZ + 2,
@@ -226,15 +357,51 @@ PetscSolver::PetscSolver(FlowField& flowField, Parameters& parameters)
     }
 
     DMCreateGlobalVector(da_, &x_);
+    DMCreateGlobalVector(da_, &b_);
+    DMCreateMatrix(da_, &A_);
+
+    // The DM only provides the grid to the builder functions and the hierarchy to PCMG. The operator
+    // is assembled here and by reInitMatrix, the right-hand side before every solve.
     KSPSetDM(ksp_, da_);
-    KSPSetComputeOperators(ksp_, computeMatrix, &ctx_);
+    KSPSetDMActive(ksp_, PETSC_FALSE);
+    assembleMatrix_();
 
-    KSPSetType(ksp_, KSPFGMRES);
+    // Pipelined methods like pipefgmres or pgmres overlap their reductions with the operator and
+    // the preconditioner
+    KSPSetType(ksp_, parameters.solver.krylov.empty() ? KSPFGMRES : parameters.solver.krylov.c_str());
 
     int commSize;
     MPI_Comm_size(PETSC_COMM_WORLD, &commSize);
 
-    if (commSize == 1) {
+    if (parameters.solver.preconditioner == "mg") {
+        // Geometric multigrid on the DMDA hierarchy. The coarse operators are Galerkin products, so
+        // they carry the obstacles, and the transfer operators are cell-centred like the pressure.
+        const int levels = countMultigridLevels(parameters);
+        if (levels < 2) {
+            HANDLE_ERROR(1, "The grid cannot be coarsened for the mg preconditioner, use gamg instead");
+        }
+
+        DMDASetInterpolationType(da_, DMDA_Q0);
+        PCSetType(pc_, PCMG);
+        PCSetDM(pc_, da_);
+        PCMGSetLevels(pc_, levels, NULL);
+        PCMGSetGalerkin(pc_, PC_MG_GALERKIN_BOTH);
+
+        // A direct coarse solve would break down on the singular operator of closed domains
+        KSP coarseKsp;
+        PC coarsePc;
+        PCMGGetCoarseSolve(pc_, &coarseKsp);
+        KSPSetType(coarseKsp, KSPGMRES);
+        KSPSetTolerances(coarseKsp, 1e-3, PETSC_DEFAULT, PETSC_DEFAULT, 50);
+        KSPGetPC(coarseKsp, &coarsePc);
+        PCSetType(coarsePc, PCSOR);
+
+        KSPSetPC(ksp_, pc_);
+    } else if (parameters.solver.preconditioner != "") {
+        // Any other PETSc preconditioner type, e.g. "gamg", "jacobi", "asm" or "none"
+        PCSetType(pc_, parameters.solver.preconditioner.c_str());
+        KSPSetPC(ksp_, pc_);
+    } else if (commSize == 1) {
         // If serial
         PCSetType(pc_, PCILU);
         PCFactorSetLevels(pc_, 1);
@@ -245,6 +412,11 @@ PetscSolver::PetscSolver(FlowField& flowField, Parameters& parameters)
         KSPSetPC(ksp_, pc_);
     }
 
+    KSPSetTolerances(ksp_,
+        tolerance_ > 0 ? tolerance_ : PETSC_DEFAULT,
+        PETSC_DEFAULT, PETSC_DEFAULT,
+        parameters.solver.maxIterations > 0 ? parameters.solver.maxIterations : PETSC_DEFAULT);
+
     KSPSetFromOptions(ksp_);
     KSPSetInitialGuessNonzero(ksp_, PETSC_TRUE);
     KSPSetUp(ksp_);
@@ -253,7 +425,10 @@ PetscSolver::PetscSolver(FlowField& flowField, Parameters& parameters)
     // that has to be done after setup. The other solvers above
     // can be changed before setup with KSPSetFromOptions.
 
-    if (commSize > 1) {
+    PetscBool isASM;
+    PetscObjectTypeCompare((PetscObject) pc_, PCASM, &isASM);
+
+    if (isASM) {
         KSP* subksp;
         PC subpc;
 
@@ -273,14 +448,33 @@ PetscSolver::PetscSolver(FlowField& flowField, Parameters& parameters)
 
 void PetscSolver::solve() {
     ScalarField& pressure = flowField_.getPressure();
+    double start = 0.0, time = 0.0;
+
+    // With an extrapolated pressure, that is the initial guess; otherwise the solve starts from the
+    // last solution, which x_ still holds
+    const bool warmStart = parameters_.solver.extrapolationOrder > 0;
 
     if (parameters_.geometry.dim == 2) {
-        KSPSetComputeRHS(ksp_, computeRHS2D, &ctx_);
-        KSPSetComputeOperators(ksp_, computeMatrix2D, &ctx_);
-        KSPSolve(ksp_, PETSC_NULL, x_);
+        PetscScalar** array;
+
+        if (warmStart) {
+            DMDAVecGetArray(da_, x_, &array);
+
+            for (int j = firstY_; j < firstY_ + lengthY_; j++) {
+                for (int i = firstX_; i < firstX_ + lengthX_; i++) {
+                    array[j][i] = pressure.getScalar(i - firstX_ + offsetX_, j - firstY_ + offsetY_);
+                }
+            }
+            DMDAVecRestoreArray(da_, x_, &array);
+        }
+
+        computeRHS2D(ksp_, b_, &ctx_);
+
+        start = MPI_Wtime();
+        KSPSolve(ksp_, b_, x_);
+        time = MPI_Wtime() - start;
 
         // Then extract the information
-        PetscScalar** array;
         DMDAVecGetArray(da_, x_, &array);
 
         for (int j = firstY_; j < firstY_ + lengthY_; j++) {
@@ -290,12 +484,28 @@ void PetscSolver::solve() {
         }
         DMDAVecRestoreArray(da_, x_, &array);
     } else if (parameters_.geometry.dim == 3){
-        KSPSetComputeRHS(ksp_, computeRHS3D, &ctx_);
-        KSPSetComputeOperators(ksp_, computeMatrix3D, &ctx_);
-        KSPSolve(ksp_, PETSC_NULL, x_);
+        PetscScalar*** array;
+
+        if (warmStart) {
+            DMDAVecGetArray(da_, x_, &array);
+
+            for (int k = firstZ_; k < firstZ_ + lengthZ_; k++) {
+                for (int j = firstY_; j < firstY_ + lengthY_; j++) {
+                    for (int i = firstX_; i < firstX_ + lengthX_; i++) {
+                        array[k][j][i] = pressure.getScalar(i - firstX_ + offsetX_, j - firstY_ + offsetY_, k - firstZ_ + offsetZ_);
+                    }
+                }
+            }
+            DMDAVecRestoreArray(da_, x_, &array);
+        }
+
+        computeRHS3D(ksp_, b_, &ctx_);
+
+        start = MPI_Wtime();
+        KSPSolve(ksp_, b_, x_);
+        time = MPI_Wtime() - start;
 
         // Then extract the information
-        PetscScalar*** array;
         DMDAVecGetArray(da_, x_, &array);
 
         for (int k = firstZ_; k < firstZ_ + lengthZ_; k++) {
@@ -307,9 +517,30 @@ void PetscSolver::solve() {
         }
         DMDAVecRestoreArray(da_, x_, &array);
     }
+
+    PetscInt iterations;
+    KSPGetIterationNumber(ksp_, &iterations);
+    if (parameters_.parallel.rank == 0) {
+        std::cout << "PetscSolver needed " << iterations << " iterations";
+        if (parameters_.solver.timing) {
+            std::cout << ", " << 1e3 * time / std::max((int) iterations, 1) << " ms per iteration";
+        }
+        std::cout << std::endl;
+    }
+}
+
+void PetscSolver::setTolerance(FLOAT tolerance) {
+    LinearSolver::setTolerance(tolerance);
+
+    // Only the relative tolerance is replaced, also if it was given with -ksp_rtol; the other
+    // tolerances and the iteration limit stay as set up in the constructor
+    PetscReal absoluteTolerance, divergenceTolerance;
+    PetscInt maxIterations;
+    KSPGetTolerances(ksp_, NULL, &absoluteTolerance, &divergenceTolerance, &maxIterations);
+    KSPSetTolerances(ksp_, tolerance, absoluteTolerance, divergenceTolerance, maxIterations);
 }
 
-PetscErrorCode computeMatrix2D([[maybe_unused]] KSP ksp, Mat A, [[maybe_unused]] Mat pc, void* ctx) {
+PetscErrorCode computeMatrix2D(KSP ksp, Mat A, [[maybe_unused]] Mat pc, void* ctx) {
     PetscUserCtx* context = (PetscUserCtx*)ctx;
     Parameters& parameters = context->getParameters();
 
@@ -507,18 +738,30 @@ PetscErrorCode computeMatrix2D([[maybe_unused]] KSP ksp, Mat A, [[maybe_unused]]
         }
     }
 
+    DM da;
+    KSPGetDM(ksp, &da);
+
+    const bool multigrid = usesMultigrid(parameters);
+    if (multigrid) {
+        setEdgeRows(da, A, parameters);
+    }
+
     MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY);
     MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY);
 
-    MatNullSpace nullspace;
-    MatNullSpaceCreate(PETSC_COMM_WORLD, PETSC_TRUE, 0, 0, &nullspace);
-    MatSetNullSpace(A, nullspace);
-    MatNullSpaceDestroy(&nullspace);
+    if (multigrid) {
+        setNullSpace(da, A, context);
+    } else {
+        MatNullSpace nullspace;
+        MatNullSpaceCreate(PETSC_COMM_WORLD, PETSC_TRUE, 0, 0, &nullspace);
+        MatSetNullSpace(A, nullspace);
+        MatNullSpaceDestroy(&nullspace);
+    }
 
     return 0;
 }
 
-PetscErrorCode computeMatrix3D([[maybe_unused]] KSP ksp, Mat A, [[maybe_unused]] Mat pc, void* ctx) {
+PetscErrorCode computeMatrix3D(KSP ksp, Mat A, [[maybe_unused]] Mat pc, void* ctx) {
     PetscUserCtx* context = (PetscUserCtx*)ctx;
     Parameters& parameters = context->getParameters();
 
@@ -793,13 +1036,25 @@ PetscErrorCode computeMatrix3D([[maybe_unused]] KSP ksp, Mat A, [[maybe_unused]]
         }
     }
 
+    DM da;
+    KSPGetDM(ksp, &da);
+
+    const bool multigrid = usesMultigrid(parameters);
+    if (multigrid) {
+        setEdgeRows(da, A, parameters);
+    }
+
     MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY);
     MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY);
 
-    MatNullSpace nullspace;
-    MatNullSpaceCreate(PETSC_COMM_WORLD, PETSC_TRUE, 0, 0, &nullspace);
-    MatSetNullSpace(A, nullspace);
-    MatNullSpaceDestroy(&nullspace);
+    if (multigrid) {
+        setNullSpace(da, A, context);
+    } else {
+        MatNullSpace nullspace;
+        MatNullSpaceCreate(PETSC_COMM_WORLD, PETSC_TRUE, 0, 0, &nullspace);
+        MatSetNullSpace(A, nullspace);
+        MatNullSpaceDestroy(&nullspace);
+    }
 
     return 0;
 }
@@ -1015,11 +1270,24 @@ int PetscUserCtx::getRank() const {
 
 void PetscSolver::reInitMatrix() {
     std::cout << "Reinit the matrix" << std::endl;
+
+    // The preconditioner is rebuilt right away; PETSc keeps it for all following solves, since
+    // the operator does not change until the next call
+    assembleMatrix_();
+    KSPSetUp(ksp_);
+}
+
+void PetscSolver::assembleMatrix_() {
+    // Entries of a previous assembly, e.g. around obstacles that have gone, must not remain
+    MatZeroEntries(A_);
+
     if (parameters_.geometry.dim == 2) {
-        KSPSetComputeOperators(ksp_, computeMatrix2D, &ctx_);
+        computeMatrix2D(ksp_, A_, A_, &ctx_);
     } else {
-        KSPSetComputeOperators(ksp_, computeMatrix3D, &ctx_);
+        computeMatrix3D(ksp_, A_, A_, &ctx_);
     }
+
+    KSPSetOperators(ksp_, A_, A_);
 }
 
 } // namespace Solvers
@@ -45,7 +45,8 @@ public:
 
 class PetscSolver : public LinearSolver{
 private:
-    Vec x_;     //! Petsc vectors for solution and RHS
+    Vec x_, b_; //! Petsc vectors for solution and RHS
+    Mat A_;     //! Operator
     DM da_;     //! Topology manager
     KSP ksp_;   //! Solver context
     PC pc_;     //! Preconditioner
@@ -60,6 +61,9 @@ private:
     // Additional variables used to determine where to write back the results
     int offsetX_, offsetY_, offsetZ_;
 
+    // Assembles the operator with the current flags and hands it to the KSP
+    void assembleMatrix_();
+
 public:
     PetscSolver(FlowField& flowField, Parameters& parameters);
     ~PetscSolver() override = default;
@@ -69,6 +73,9 @@ public:
     // Reinit the matrix so that it uses the right flag field
     void reInitMatrix() override;
 
+    // Replaces the relative tolerance of the KSP, also one given with -ksp_rtol
+    void setTolerance(FLOAT tolerance) override;
+
     const DM& getGrid() const;
 };
 
@@ -0,0 +1,154 @@
+#include "PressureBoundaries.hpp"
+
+#include "ParallelManagers/PetscParallelManager.hpp"
+
+namespace NSEOF {
+namespace Solvers {
+
+int getNeighbour(const Parameters& parameters, int direction, bool high) {
+    const ParallelParameters& parallel = parameters.parallel;
+    const int neighbours[2][3] = {{parallel.leftNb, parallel.bottomNb, parallel.frontNb},
+                                  {parallel.rightNb, parallel.topNb, parallel.backNb}};
+    return neighbours[high][direction];
+}
+
+BoundaryType getWallType(const Parameters& parameters, int direction, bool high) {
+    const WallParameters& walls = parameters.walls;
+    const BoundaryType types[2][3] = {{walls.typeLeft, walls.typeBottom, walls.typeFront},
+                                      {walls.typeRight, walls.typeTop, walls.typeBack}};
+    return types[high][direction];
+}
+
+bool isPeriodic(const Parameters& parameters, int direction) {
+    return getWallType(parameters, direction, false) == PERIODIC && getNeighbour(parameters, direction, false) == MPI_PROC_NULL;
+}
+
+template <class Real>
+void updateGhosts(const Parameters& parameters, const int cells[3], const int strides[3], Real* const values,
+                  std::vector<FLOAT>& sendBuffer, std::vector<FLOAT>& receiveBuffer) {
+    for (int d = 0; d < parameters.geometry.dim; d++) {
+        const int low = getNeighbour(parameters, d, false);
+        const int high = getNeighbour(parameters, d, true);
+        const bool periodic = isPeriodic(parameters, d);
+
+        if (low == MPI_PROC_NULL && high == MPI_PROC_NULL && !periodic) {
+            continue;
+        }
+
+        // The face is spanned by the directions e and f
+        const int e = (d + 1) % 3;
+        const int f = (d + 2) % 3;
+        const int layers = cells[d];
+        const int faceSize = cells[e] * cells[f];
+
+        auto offset = [&](int layer, int a, int b) {
+            return layer * strides[d] + a * strides[e] + b * strides[f];
+        };
+
+        if (periodic) {
+            for (int b = 1; b <= cells[f]; b++) {
+                for (int a = 1; a <= cells[e]; a++) {
+                    values[offset(0, a, b)] = values[offset(layers, a, b)];
+                    values[offset(layers + 1, a, b)] = values[offset(1, a, b)];
+                }
+            }
+            continue;
+        }
+
+        sendBuffer.resize(faceSize);
+        receiveBuffer.resize(faceSize);
+
+        // Send the lowest layer down, receive the upper ghost layer
+        for (int b = 1, n = 0; b <= cells[f]; b++) {
+            for (int a = 1; a <= cells[e]; a++, n++) {
+                sendBuffer[n] = values[offset(1, a, b)];
+            }
+        }
+        ParallelManagers::PetscParallelManager::sendRecvBuffers(sendBuffer, low, receiveBuffer, high);
+        if (high != MPI_PROC_NULL) {
+            for (int b = 1, n = 0; b <= cells[f]; b++) {
+                for (int a = 1; a <= cells[e]; a++, n++) {
+                    values[offset(layers + 1, a, b)] = receiveBuffer[n];
+                }
+            }
+        }
+
+        // Send the highest layer up, receive the lower ghost layer
+        for (int b = 1, n = 0; b <= cells[f]; b++) {
+            for (int a = 1; a <= cells[e]; a++, n++) {
+                sendBuffer[n] = values[offset(layers, a, b)];
+            }
+        }
+        ParallelManagers::PetscParallelManager::sendRecvBuffers(sendBuffer, high, receiveBuffer, low);
+        if (low != MPI_PROC_NULL) {
+            for (int b = 1, n = 0; b <= cells[f]; b++) {
+                for (int a = 1; a <= cells[e]; a++, n++) {
+                    values[offset(0, a, b)] = receiveBuffer[n];
+                }
+            }
+        }
+    }
+}
+
+// The multigrid solver also works on single precision levels
+template void updateGhosts<float>(const Parameters&, const int[3], const int[3], float*, std::vector<FLOAT>&, std::vector<FLOAT>&);
+template void updateGhosts<double>(const Parameters&, const int[3], const int[3], double*, std::vector<FLOAT>&, std::vector<FLOAT>&);
+
+void setObstaclePressure(const Parameters& parameters, IntScalarField& flags, const int cells[3], const int strides[3],
+                         FLOAT* const pressure) {
+    const int dim = parameters.geometry.dim;
+
+    // Walls
+    for (int d = 0; d < dim; d++) {
+        const int e = (d + 1) % 3;
+        const int f = (d + 2) % 3;
+
+        for (int high = 0; high < 2; high++) {
+            if (getNeighbour(parameters, d, high) != MPI_PROC_NULL || isPeriodic(parameters, d)) {
+                continue;
+            }
+
+            const FLOAT sign = getWallType(parameters, d, high) == NEUMANN ? -1.0 : 1.0;
+            const int ghost = high ? cells[d] + 1 : 0;
+            const int inner = high ? cells[d] : 1;
+
+            for (int b = 1; b <= cells[f]; b++) {
+                for (int a = 1; a <= cells[e]; a++) {
+                    const int offset = a * strides[e] + b * strides[f];
+                    pressure[ghost * strides[d] + offset] = sign * pressure[inner * strides[d] + offset];
+                }
+            }
+        }
+    }
+
+    // Obstacles
+    const int neighbourBits[6] = {OBSTACLE_LEFT, OBSTACLE_RIGHT, OBSTACLE_BOTTOM, OBSTACLE_TOP, OBSTACLE_FRONT, OBSTACLE_BACK};
+    const int neighbourOffsets[6] = {-strides[0], strides[0], -strides[1], strides[1], -strides[2], strides[2]};
+
+    for (int k = 1; k <= cells[2]; k++) {
+        for (int j = 1; j <= cells[1]; j++) {
+            for (int i = 1; i <= cells[0]; i++) {
+                const int flag = dim == 3 ? flags.getValue(i + 1, j + 1, k + 1) : flags.getValue(i + 1, j + 1);
+                if ((flag & OBSTACLE_SELF) == 0) {
+                    continue;
+                }
+
+                const int c = i * strides[0] + j * strides[1] + k * strides[2];
+                FLOAT sum = 0.0;
+                int fluidNeighbours = 0;
+
+                for (int n = 0; n < 2 * dim; n++) {
+                    if ((flag & neighbourBits[n]) == 0) {
+                        sum += pressure[c + neighbourOffsets[n]];
+                        fluidNeighbours++;
+                    }
+                }
+
+                pressure[c] = fluidNeighbours > 0 ? sum / fluidNeighbours : 0.0;
+            }
+        }
+    }
+}
+
+} // namespace Solvers
+} // namespace NSEOF
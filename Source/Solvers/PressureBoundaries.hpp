@@ -0,0 +1,46 @@
+#ifndef __SOLVERS_PRESSURE_BOUNDARIES_HPP__
+#define __SOLVERS_PRESSURE_BOUNDARIES_HPP__
+
+#include "Definitions.hpp"
+#include "Parameters.hpp"
+#include "DataStructures.hpp"
+
+#include <vector>
+
+namespace NSEOF {
+namespace Solvers {
+
+/** Boundary handling shared by the pressure solvers that work on their own copy of the grid
+ *
+ * The fields are described by the number of inner cells and the strides in each direction; the
+ * inner cells run from 1 to cells[d], surrounded by one layer of ghost cells. Beyond the dimension
+ * of the problem, cells[d] is 1 and strides[d] is 0.
+ */
+
+// Rank of the neighbouring process below (high = false) or above (high = true) in the given direction
+int getNeighbour(const Parameters& parameters, int direction, bool high);
+
+BoundaryType getWallType(const Parameters& parameters, int direction, bool high);
+
+// A direction is wrapped locally if it is periodic and a single process spans it
+bool isPeriodic(const Parameters& parameters, int direction);
+
+/** Fills the ghost layers towards the neighbouring processes and across locally periodic
+ *  directions; those at walls are left as they are. The buffers are resized to a face as needed.
+ */
+template <class Real>
+void updateGhosts(const Parameters& parameters, const int cells[3], const int strides[3], Real* values,
+                  std::vector<FLOAT>& sendBuffer, std::vector<FLOAT>& receiveBuffer);
+
+/** Sets the ghost cells at walls like the boundary stencils do, i.e. zero pressure on outflow
+ *  walls and zero gradient otherwise, and the pressure in obstacle cells to the mean of their
+ *  fluid neighbours, like in the EigenSolver. The ghost cells towards other processes and across
+ *  periodic directions must be up to date.
+ */
+void setObstaclePressure(const Parameters& parameters, IntScalarField& flags, const int cells[3], const int strides[3],
+                         FLOAT* pressure);
+
+} // namespace Solvers
+} // namespace NSEOF
+
+#endif // __SOLVERS_PRESSURE_BOUNDARIES_HPP__
@@ -0,0 +1,91 @@
+#include "PressureExtrapolation.hpp"
+
+#include <algorithm>
+
+namespace NSEOF {
+namespace Solvers {
+
+PressureExtrapolation::PressureExtrapolation(FlowField& flowField, const Parameters& parameters)
+    : flowField_(flowField)
+    , parameters_(parameters)
+    , order_(parameters.solver.extrapolationOrder)
+    , stored_(0) {
+    ASSERTION(order_ >= 0 && order_ <= 2);
+
+    ScalarField& pressure = flowField_.getPressure();
+    const int cells = pressure.getNx() * pressure.getNy() * pressure.getNz();
+
+    history_.resize(order_ > 0 ? order_ + 1 : 0);
+    for (std::vector<FLOAT>& entry : history_) {
+        entry.resize(cells);
+    }
+    timesteps_.resize(history_.size());
+}
+
+void PressureExtrapolation::predict() {
+    const int order = std::min(order_, stored_ - 1);
+    if (order <= 0) {
+        return;
+    }
+
+    // Lagrange weights for the times 0, -dt_0 and -dt_0 - dt_1 of the stored pressures,
+    // evaluated at the end of the current timestep
+    const FLOAT t = parameters_.timestep.dt;
+    FLOAT weights[3];
+
+    if (order == 1) {
+        weights[0] = 1.0 + t / timesteps_[0];
+        weights[1] = -t / timesteps_[0];
+    } else {
+        const FLOAT t1 = -timesteps_[0];
+        const FLOAT t2 = -timesteps_[0] - timesteps_[1];
+        weights[0] = (t - t1) * (t - t2) / (t1 * t2);
+        weights[1] = t * (t - t2) / (t1 * (t1 - t2));
+        weights[2] = t * (t - t1) / (t2 * (t2 - t1));
+    }
+
+    ScalarField& pressure = flowField_.getPressure();
+    const int sizeX = pressure.getNx(), sizeY = pressure.getNy(), sizeZ = pressure.getNz();
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int k = 0; k < sizeZ; k++) {
+        for (int j = 0; j < sizeY; j++) {
+            for (int i = 0; i < sizeX; i++) {
+                const int cell = i + sizeX * (j + sizeY * k);
+                FLOAT value = 0.0;
+                for (int n = 0; n <= order; n++) {
+                    value += weights[n] * history_[n][cell];
+                }
+                pressure.getScalar(i, j, k) = value;
+            }
+        }
+    }
+}
+
+void PressureExtrapolation::store() {
+    if (history_.empty()) {
+        return;
+    }
+
+    // Recycle the oldest entry for the newest pressure
+    std::rotate(history_.rbegin(), history_.rbegin() + 1, history_.rend());
+    std::rotate(timesteps_.rbegin(), timesteps_.rbegin() + 1, timesteps_.rend());
+    stored_ = std::min(stored_ + 1, (int) history_.size());
+
+    ScalarField& pressure = flowField_.getPressure();
+    const int sizeX = pressure.getNx(), sizeY = pressure.getNy(), sizeZ = pressure.getNz();
+    std::vector<FLOAT>& entry = history_[0];
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int k = 0; k < sizeZ; k++) {
+        for (int j = 0; j < sizeY; j++) {
+            for (int i = 0; i < sizeX; i++) {
+                entry[i + sizeX * (j + sizeY * k)] = pressure.getScalar(i, j, k);
+            }
+        }
+    }
+    timesteps_[0] = parameters_.timestep.dt;
+}
+
+} // namespace Solvers
+} // namespace NSEOF
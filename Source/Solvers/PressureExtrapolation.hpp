@@ -0,0 +1,46 @@
+#ifndef __SOLVERS_PRESSURE_EXTRAPOLATION_HPP__
+#define __SOLVERS_PRESSURE_EXTRAPOLATION_HPP__
+
+#include "Definitions.hpp"
+#include "Parameters.hpp"
+#include "FlowField.hpp"
+
+#include <vector>
+
+namespace NSEOF {
+namespace Solvers {
+
+/** Initial guess for the pressure solver from the pressure of the previous timesteps
+ *
+ * Keeps the solutions of the last order + 1 timesteps together with their timestep sizes, and
+ * replaces the pressure before a solve by the polynomial through them, evaluated at the end of
+ * the current timestep. Order 1 extrapolates linearly, order 2 quadratically; order 0 keeps no
+ * history, so the solvers start from the last pressure as before. Until enough timesteps are
+ * stored, the highest order that is available is used.
+ */
+class PressureExtrapolation {
+private:
+    FlowField& flowField_;
+    const Parameters& parameters_;
+
+    int order_;
+    int stored_;                             //! Number of valid entries in the history
+    std::vector<std::vector<FLOAT>> history_; //! Pressure with ghost cells, the newest first
+    std::vector<FLOAT> timesteps_;           //! Size of the timestep that computed each entry
+
+public:
+    PressureExtrapolation(FlowField& flowField, const Parameters& parameters);
+
+    /** Writes the extrapolated pressure into the flow field. Needs parameters.timestep.dt of the
+     *  current timestep.
+     */
+    void predict();
+
+    /** Adds the pressure of the flow field, as computed with parameters.timestep.dt, to the history */
+    void store();
+};
+
+} // namespace Solvers
+} // namespace NSEOF
+
+#endif // __SOLVERS_PRESSURE_EXTRAPOLATION_HPP__
@@ -1,202 +1,369 @@
 #include "SORSolver.hpp"
 
-#include <float.h> // To get the max double
+#include "Dimension.hpp"
+#include "LineRelaxation.hpp"
+
+#include <algorithm>
 #include <math.h>
 
 namespace NSEOF {
 namespace Solvers {
 
+static constexpr FLOAT SOR_TOLERANCE = 1e-4;
+static constexpr FLOAT SOR_OMEGA = 1.7;
+
 SORSolver::SORSolver(FlowField& flowField, const Parameters& parameters)
-    : LinearSolver(flowField, parameters) {}
+    : LinearSolver(flowField, parameters)
+    , parallelManager_(parameters, flowField) {
+    setCoefficients_();
+}
 
-void SORSolver::solve() {
-    FLOAT resnorm = DBL_MAX, tol = 1e-4;
+void SORSolver::setCoefficients_() {
+    const int dim = parameters_.geometry.dim;
+    const int sizes[3] = {flowField_.getNx(), flowField_.getNy(), flowField_.getNz()};
 
-    double omg = 1.7;
-    int iterations = -1;
-    int it = 0;
+    firstColour_ = 0;
+
+    for (int d = 0; d < dim; d++) {
+        // Distances between neighbouring cell centres, dx_W = centre[i-1] and dx_E = centre[i]
+        const FLOAT* const centre = parameters_.meshMetrics->getCentreSpacing(d);
+        const int cells = sizes[d] + 3;
+
+        coefficientLow_[d].assign(cells, 0.0);
+        coefficientHigh_[d].assign(cells, 0.0);
+        diagonal_[d].assign(cells, 0.0);
+
+        for (int i = 2; i < sizes[d] + 2; i++) {
+            const FLOAT dx_W = centre[i - 1];
+            const FLOAT dx_E = centre[i];
+
+            coefficientLow_[d][i] = 2.0 / (dx_W * (dx_W + dx_E));
+            coefficientHigh_[d][i] = 2.0 / (dx_E * (dx_W + dx_E));
+            diagonal_[d][i] = -2.0 / (dx_E * dx_W);
+        }
+
+        firstColour_ += parameters_.parallel.firstCorner[d];
+    }
 
-    int nx = flowField_.getNx(), ny = flowField_.getNy(), nz = flowField_.getNz();
+    firstColour_ %= 2;
+
+    // Lines along the strongest coupling, i.e. the thinnest cells, over all processes
+    lineDirection_ = -1;
+    firstLineColour_ = 0;
+
+    if (parameters_.solver.smoother == "line") {
+        FLOAT local[3] = {0.0, 0.0, 0.0};
+        for (int d = 0; d < dim; d++) {
+            for (int i = 2; i < sizes[d] + 2; i++) {
+                local[d] = std::max(local[d], std::max(coefficientLow_[d][i], coefficientHigh_[d][i]));
+            }
+        }
+
+        FLOAT global[3];
+        MPI_Allreduce(local, global, 3, MY_MPI_FLOAT, MPI_MAX, PETSC_COMM_WORLD);
+        lineDirection_ = std::max_element(global, global + dim) - global;
+
+        // The pieces of a line on neighbouring processes get different colours, so that each one
+        // sees the other one updated; solving both at once would be a Jacobi step along the line,
+        // which diverges with over-relaxation
+        for (int d = 0; d < dim; d++) {
+            firstLineColour_ += d == lineDirection_ ? parameters_.parallel.indices[d] : parameters_.parallel.firstCorner[d];
+        }
+        firstLineColour_ %= 2;
+    }
+}
+
+void SORSolver::updateGhosts_() {
+    parallelManager_.communicatePressure();
+
+    // Walls without a neighbouring process copy the pressure of the inner cells
+    const int nx = flowField_.getNx(), ny = flowField_.getNy(), nz = flowField_.getNz();
     ScalarField& P = flowField_.getPressure();
+
     if (parameters_.geometry.dim == 3) {
-        do {
-            for (int k = 2; k < nz + 2; k++) {
-                for (int j = 2; j < ny + 2; j++) {
-                    for (int i = 2; i < nx + 2; i++) {
-                        const FLOAT dx_0  = parameters_.meshsize->getDx(i  ,j  ,k  );
-                        const FLOAT dx_M1 = parameters_.meshsize->getDx(i-1,j  ,k  );
-                        const FLOAT dx_P1 = parameters_.meshsize->getDx(i+1,j  ,k  );
-                        const FLOAT dy_0  = parameters_.meshsize->getDy(i  ,j  ,k  );
-                        const FLOAT dy_M1 = parameters_.meshsize->getDy(i  ,j-1,k  );
-                        const FLOAT dy_P1 = parameters_.meshsize->getDy(i  ,j+1,k  );
-                        const FLOAT dz_0  = parameters_.meshsize->getDz(i  ,j  ,k  );
-                        const FLOAT dz_M1 = parameters_.meshsize->getDz(i  ,j  ,k-1);
-                        const FLOAT dz_P1 = parameters_.meshsize->getDz(i  ,j  ,k+1);
-
-                        const FLOAT dx_W = 0.5*(dx_0+dx_M1);
-                        const FLOAT dx_E = 0.5*(dx_0+dx_P1);
-                        const FLOAT dx_S = 0.5*(dy_0+dy_M1);
-                        const FLOAT dx_N = 0.5*(dy_0+dy_P1);
-                        const FLOAT dx_B = 0.5*(dz_0+dz_M1);
-                        const FLOAT dx_T = 0.5*(dz_0+dz_P1);
-
-                        const FLOAT a_W  =  2.0/(dx_W*(dx_W+dx_E));
-                        const FLOAT a_E  =  2.0/(dx_E*(dx_W+dx_E));
-                        const FLOAT a_N  =  2.0/(dx_N*(dx_N+dx_S));
-                        const FLOAT a_S  =  2.0/(dx_S*(dx_N+dx_S));
-                        const FLOAT a_T  =  2.0/(dx_T*(dx_T+dx_B));
-                        const FLOAT a_B  =  2.0/(dx_B*(dx_T+dx_B));
-                        const FLOAT a_C  = -2.0/(dx_E*dx_W)-2.0/(dx_N*dx_S)-2.0/(dx_B*dx_T);
-
-                        P.getScalar(i,j,k) = omg/a_C*(flowField_.getRHS().getScalar(i,j,k)
-                                               - a_W*P.getScalar(i-1,j,k) - a_E*P.getScalar(i+1,j,k)
-                                               - a_S*P.getScalar(i,j-1,k) - a_N*P.getScalar(i,j+1,k)
-                                               - a_B*P.getScalar(i,j,k-1) - a_T*P.getScalar(i,j,k+1))
-                                           + (1.0-omg) * P.getScalar(i,j,k);
-                    }
+        for (int k = 2; k < nz + 2; k++) {
+            for (int j = 2; j < ny + 2; j++) {
+                if (parameters_.parallel.leftNb == MPI_PROC_NULL) {
+                    P.getScalar(1, j, k) = P.getScalar(2, j, k);
+                }
+                if (parameters_.parallel.rightNb == MPI_PROC_NULL) {
+                    P.getScalar(nx + 2, j, k) = P.getScalar(nx + 1, j, k);
                 }
             }
 
-            for (int j = 2; j < ny + 2; j++) {
-                for (int k = 2; k < nz + 2; k++) {
-                    P.getScalar(1,j,k) = P.getScalar(2,j,k);
-                    P.getScalar(nx+2,j,k) = P.getScalar(nx+1,j,k);
+            for (int i = 2; i < nx + 2; i++) {
+                if (parameters_.parallel.bottomNb == MPI_PROC_NULL) {
+                    P.getScalar(i, 1, k) = P.getScalar(i, 2, k);
+                }
+                if (parameters_.parallel.topNb == MPI_PROC_NULL) {
+                    P.getScalar(i, ny + 2, k) = P.getScalar(i, ny + 1, k);
                 }
             }
+        }
 
+        for (int j = 2; j < ny + 2; j++) {
             for (int i = 2; i < nx + 2; i++) {
-                for (int k = 2; k < nz + 2; k++) {
-                    P.getScalar(i,1,k) = P.getScalar(i,2,k);
-                    P.getScalar(i,ny+2,k) = P.getScalar(i,ny+1,k);
+                if (parameters_.parallel.frontNb == MPI_PROC_NULL) {
+                    P.getScalar(i, j, 1) = P.getScalar(i, j, 2);
+                }
+                if (parameters_.parallel.backNb == MPI_PROC_NULL) {
+                    P.getScalar(i, j, nz + 2) = P.getScalar(i, j, nz + 1);
                 }
             }
+        }
+    } else {
+        for (int j = 2; j < ny + 2; j++) {
+            if (parameters_.parallel.leftNb == MPI_PROC_NULL) {
+                P.getScalar(1, j) = P.getScalar(2, j);
+            }
+            if (parameters_.parallel.rightNb == MPI_PROC_NULL) {
+                P.getScalar(nx + 2, j) = P.getScalar(nx + 1, j);
+            }
+        }
 
-            for (int i = 2; i < nx + 2; i++) {
-                for (int j = 2; j < ny + 2; j++) {
-                    P.getScalar(i,j,1) = P.getScalar(i,j,2);
-                    P.getScalar(i,j,nz+2) = P.getScalar(i,j,nz+1);
+        for (int i = 2; i < nx + 2; i++) {
+            if (parameters_.parallel.bottomNb == MPI_PROC_NULL) {
+                P.getScalar(i, 1) = P.getScalar(i, 2);
+            }
+            if (parameters_.parallel.topNb == MPI_PROC_NULL) {
+                P.getScalar(i, ny + 2) = P.getScalar(i, ny + 1);
+            }
+        }
+    }
+}
+
+template <class D>
+void SORSolver::relax_(int colour, FLOAT omega) {
+    constexpr bool is3D = D::value == 3;
+
+    const int nx = flowField_.getNx(), ny = flowField_.getNy();
+    const int lastK = is3D ? flowField_.getNz() + 1 : 0;
+    const int firstK = is3D ? 2 : 0;
+
+    ScalarField& pressure = flowField_.getPressure();
+    FLOAT* const p = &pressure.getScalar(0, 0);
+    const FLOAT* const rhs = &flowField_.getRHS().getScalar(0, 0);
+    const int strideY = pressure.index2cell(0, 1);
+    const int strideZ = is3D ? pressure.index2cell(0, 0, 1) : 0;
+
+    const FLOAT* const lowX = coefficientLow_[0].data();
+    const FLOAT* const highX = coefficientHigh_[0].data();
+    const FLOAT* const diagonalX = diagonal_[0].data();
+    const FLOAT* const lowY = coefficientLow_[1].data();
+    const FLOAT* const highY = coefficientHigh_[1].data();
+    const FLOAT* const diagonalY = diagonal_[1].data();
+    const FLOAT* const lowZ = coefficientLow_[2].data();
+    const FLOAT* const highZ = coefficientHigh_[2].data();
+    const FLOAT* const diagonalZ = diagonal_[2].data();
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int k = firstK; k <= lastK; k++) {
+        for (int j = 2; j < ny + 2; j++) {
+            // First cell of the row with the requested parity of i + j + k in global indices
+            const int firstI = 2 + (((j + k + firstColour_) & 1) ^ colour);
+
+            for (int i = firstI; i < nx + 2; i += 2) {
+                const int c = i + j * strideY + k * strideZ;
+
+                FLOAT a_C = diagonalX[i] + diagonalY[j];
+                FLOAT neighbours = lowX[i] * p[c - 1] + highX[i] * p[c + 1]
+                                 + lowY[j] * p[c - strideY] + highY[j] * p[c + strideY];
+                if (is3D) {
+                    a_C += diagonalZ[k];
+                    neighbours += lowZ[k] * p[c - strideZ] + highZ[k] * p[c + strideZ];
                 }
+
+                p[c] = omega / a_C * (rhs[c] - neighbours) + (1.0 - omega) * p[c];
             }
+        }
+    }
+}
+
+template <class D>
+void SORSolver::relaxLines_(int colour, FLOAT omega) {
+    constexpr bool is3D = D::value == 3;
+
+    ScalarField& pressure = flowField_.getPressure();
+    FLOAT* const p = &pressure.getScalar(0, 0);
+    const FLOAT* const rhs = &flowField_.getRHS().getScalar(0, 0);
+    const int strides[3] = {1, pressure.index2cell(0, 1), is3D ? pressure.index2cell(0, 0, 1) : 0};
+
+    // Inner cells per direction; in 2D, the only layer is k = 0
+    const int firstCell[3] = {2, 2, is3D ? 2 : 0};
+    const int lastCell[3] = {flowField_.getNx() + 1, flowField_.getNy() + 1, is3D ? flowField_.getNz() + 1 : 0};
+
+    // Lines along d, batched along e, one batch per colour and layer along f
+    const int d = lineDirection_;
+    const int e = d == 0 ? 1 : 0;
+    const int f = 3 - d - e;
+    const int length = lastCell[d] - firstCell[d] + 1;
+    const int maxLines = (lastCell[e] - firstCell[e] + 2) / 2;
+
+    // A wall without a neighbouring process copies the pressure of the inner cell into the ghost
+    // cell, see updateGhosts_, which folds its coupling into the diagonal
+    const int neighbours[2][3] = {{parameters_.parallel.leftNb, parameters_.parallel.bottomNb, parameters_.parallel.frontNb},
+                                  {parameters_.parallel.rightNb, parameters_.parallel.topNb, parameters_.parallel.backNb}};
+    const bool lowWall = neighbours[0][d] == MPI_PROC_NULL;
+    const bool highWall = neighbours[1][d] == MPI_PROC_NULL;
+
+    #pragma omp parallel
+    {
+        std::vector<FLOAT> lower(length * maxLines);
+        std::vector<FLOAT> diagonal(length * maxLines);
+        std::vector<FLOAT> upper(length * maxLines);
+        std::vector<FLOAT> values(length * maxLines);
+
+        #pragma omp for schedule(static)
+        for (int b = firstCell[f]; b <= lastCell[f]; b++) {
+            // First line with the requested parity of a + b in global indices
+            const int first = firstCell[e] + (((firstCell[e] + b + firstLineColour_) & 1) ^ colour);
+            const int lines = first <= lastCell[e] ? (lastCell[e] - first) / 2 + 1 : 0;
+
+            for (int l = 0; l < length; l++) {
+                for (int n = 0; n < lines; n++) {
+                    int index[3];
+                    index[d] = firstCell[d] + l;
+                    index[e] = first + 2 * n;
+                    index[f] = b;
+                    const int c = index[0] * strides[0] + index[1] * strides[1] + index[2] * strides[2];
+                    const int row = l * lines + n;
+
+                    FLOAT a_C = 0.0;
+                    FLOAT others = 0.0;
+                    for (int direction = 0; direction < D::value; direction++) {
+                        const int i = index[direction];
+                        a_C += diagonal_[direction][i];
+                        if (direction != d) {
+                            others += coefficientLow_[direction][i] * p[c - strides[direction]]
+                                    + coefficientHigh_[direction][i] * p[c + strides[direction]];
+                        }
+                    }
 
-            resnorm = 0;
-            for (int k = 2; k < nz + 2; k++) {
-                for (int j = 2; j < ny + 2; j++) {
-                    for (int i = 2; i < nx + 2; i++) {
-                        const FLOAT dx_0  = parameters_.meshsize->getDx(i  ,j  ,k  );
-                        const FLOAT dx_M1 = parameters_.meshsize->getDx(i-1,j  ,k  );
-                        const FLOAT dx_P1 = parameters_.meshsize->getDx(i+1,j  ,k  );
-                        const FLOAT dy_0  = parameters_.meshsize->getDy(i  ,j  ,k  );
-                        const FLOAT dy_M1 = parameters_.meshsize->getDy(i  ,j-1,k  );
-                        const FLOAT dy_P1 = parameters_.meshsize->getDy(i  ,j+1,k  );
-                        const FLOAT dz_0  = parameters_.meshsize->getDz(i  ,j  ,k  );
-                        const FLOAT dz_M1 = parameters_.meshsize->getDz(i  ,j  ,k-1);
-                        const FLOAT dz_P1 = parameters_.meshsize->getDz(i  ,j  ,k+1);
-
-                        const FLOAT dx_W = 0.5*(dx_0+dx_M1);
-                        const FLOAT dx_E = 0.5*(dx_0+dx_P1);
-                        const FLOAT dx_S = 0.5*(dy_0+dy_M1);
-                        const FLOAT dx_N = 0.5*(dy_0+dy_P1);
-                        const FLOAT dx_B = 0.5*(dz_0+dz_M1);
-                        const FLOAT dx_T = 0.5*(dz_0+dz_P1);
-
-                        const FLOAT a_W  =  2.0/(dx_W*(dx_W+dx_E));
-                        const FLOAT a_E  =  2.0/(dx_E*(dx_W+dx_E));
-                        const FLOAT a_N  =  2.0/(dx_N*(dx_N+dx_S));
-                        const FLOAT a_S  =  2.0/(dx_S*(dx_N+dx_S));
-                        const FLOAT a_T  =  2.0/(dx_T*(dx_T+dx_B));
-                        const FLOAT a_B  =  2.0/(dx_B*(dx_T+dx_B));
-                        const FLOAT a_C  = -2.0/(dx_E*dx_W)-2.0/(dx_N*dx_S)-2.0/(dx_B*dx_T);
-
-                        resnorm += pow((flowField_.getRHS().getScalar(i,j,k)
-                                     - a_W*P.getScalar(i-1,j,k) - a_E*P.getScalar(i+1,j,k)
-                                     - a_S*P.getScalar(i,j-1,k) - a_N*P.getScalar(i,j+1,k)
-                                     - a_B*P.getScalar(i,j,k-1) - a_T*P.getScalar(i,j,k+1)
-                                     - a_C*P.getScalar(i,j,k)), 2);
+                    // The neighbours along the line are unknowns, except the ghost cells at its ends
+                    const int i = index[d];
+                    FLOAT low = coefficientLow_[d][i];
+                    FLOAT high = coefficientHigh_[d][i];
+                    if (l == 0) {
+                        if (lowWall) {
+                            a_C += low;
+                        } else {
+                            others += low * p[c - strides[d]];
+                        }
+                        low = 0.0;
                     }
+                    if (l == length - 1) {
+                        if (highWall) {
+                            a_C += high;
+                        } else {
+                            others += high * p[c + strides[d]];
+                        }
+                        high = 0.0;
+                    }
+
+                    lower[row] = low;
+                    upper[row] = high;
+                    diagonal[row] = a_C;
+                    values[row] = rhs[c] - others;
                 }
             }
-            resnorm = sqrt (resnorm / (nx * ny * nz));
-            //std::cout << "Residual norm: " << resnorm << std::endl;
-
-            it++;
-            iterations--;
-        } while (resnorm > tol && iterations);
-    } if (parameters_.geometry.dim == 2) {
-        do {
-            for (int j = 2; j < ny + 2; j++) {
-                for (int i = 2; i < nx + 2; i++) {
-                    const FLOAT dx_0  = parameters_.meshsize->getDx(i  ,j  );
-                    const FLOAT dx_M1 = parameters_.meshsize->getDx(i-1,j  );
-                    const FLOAT dx_P1 = parameters_.meshsize->getDx(i+1,j  );
-                    const FLOAT dy_0  = parameters_.meshsize->getDy(i  ,j  );
-                    const FLOAT dy_M1 = parameters_.meshsize->getDy(i  ,j-1);
-                    const FLOAT dy_P1 = parameters_.meshsize->getDy(i  ,j+1);
-
-                    const FLOAT dx_W = 0.5*(dx_0+dx_M1);
-                    const FLOAT dx_E = 0.5*(dx_0+dx_P1);
-                    const FLOAT dx_S = 0.5*(dy_0+dy_M1);
-                    const FLOAT dx_N = 0.5*(dy_0+dy_P1);
-
-                    const FLOAT a_W  =  2.0/(dx_W*(dx_W+dx_E));
-                    const FLOAT a_E  =  2.0/(dx_E*(dx_W+dx_E));
-                    const FLOAT a_N  =  2.0/(dx_N*(dx_N+dx_S));
-                    const FLOAT a_S  =  2.0/(dx_S*(dx_N+dx_S));
-                    const FLOAT a_C  = -2.0/(dx_E*dx_W)-2.0/(dx_N*dx_S);
-
-                    const FLOAT gaussSeidel = 1.0/a_C*(flowField_.getRHS().getScalar(i,j)
-                                            - a_W*P.getScalar(i-1,j) - a_E*P.getScalar(i+1,j)
-                                            - a_S*P.getScalar(i,j-1) - a_N*P.getScalar(i,j+1));
-                    P.getScalar(i,j) = omg * gaussSeidel + (1.0-omg) * P.getScalar(i,j);
+
+            solveTridiagonalLines(length, lines, lower.data(), diagonal.data(), upper.data(), values.data());
+
+            for (int l = 0; l < length; l++) {
+                for (int n = 0; n < lines; n++) {
+                    const int c = (firstCell[d] + l) * strides[d] + (first + 2 * n) * strides[e] + b * strides[f];
+                    p[c] = omega * values[l * lines + n] + (1.0 - omega) * p[c];
                 }
             }
+        }
+    }
+}
 
-            resnorm = 0.0;
-            for (int j = 2; j < ny + 2; j++) {
-                for (int i = 2; i < nx + 2; i++) {
-                    const FLOAT dx_0  = parameters_.meshsize->getDx(i  ,j  );
-                    const FLOAT dx_M1 = parameters_.meshsize->getDx(i-1,j  );
-                    const FLOAT dx_P1 = parameters_.meshsize->getDx(i+1,j  );
-                    const FLOAT dy_0  = parameters_.meshsize->getDy(i  ,j  );
-                    const FLOAT dy_M1 = parameters_.meshsize->getDy(i  ,j-1);
-                    const FLOAT dy_P1 = parameters_.meshsize->getDy(i  ,j+1);
-
-                    const FLOAT dx_W = 0.5*(dx_0+dx_M1);
-                    const FLOAT dx_E = 0.5*(dx_0+dx_P1);
-                    const FLOAT dx_S = 0.5*(dy_0+dy_M1);
-                    const FLOAT dx_N = 0.5*(dy_0+dy_P1);
-
-                    const FLOAT a_W  =  2.0/(dx_W*(dx_W+dx_E));
-                    const FLOAT a_E  =  2.0/(dx_E*(dx_W+dx_E));
-                    const FLOAT a_N  =  2.0/(dx_N*(dx_N+dx_S));
-                    const FLOAT a_S  =  2.0/(dx_S*(dx_N+dx_S));
-                    const FLOAT a_C  = -2.0/(dx_E*dx_W)-2.0/(dx_N*dx_S);
-
-                    const FLOAT residual = flowField_.getRHS().getScalar(i,j)
-                                         - a_W*P.getScalar(i-1,j) - a_E*P.getScalar(i+1,j)
-                                         - a_S*P.getScalar(i,j-1) - a_N*P.getScalar(i,j+1)
-                                         - a_C*P.getScalar(i,j);
-                    resnorm += residual * residual;
+template <class D>
+FLOAT SORSolver::computeResidual_() const {
+    constexpr bool is3D = D::value == 3;
+
+    const int nx = flowField_.getNx(), ny = flowField_.getNy();
+    const int lastK = is3D ? flowField_.getNz() + 1 : 0;
+    const int firstK = is3D ? 2 : 0;
+
+    ScalarField& pressure = flowField_.getPressure();
+    const FLOAT* const p = &pressure.getScalar(0, 0);
+    const FLOAT* const rhs = &flowField_.getRHS().getScalar(0, 0);
+    const int strideY = pressure.index2cell(0, 1);
+    const int strideZ = is3D ? pressure.index2cell(0, 0, 1) : 0;
+
+    FLOAT sum = 0.0;
+
+    #pragma omp parallel for collapse(2) schedule(static) reduction(+:sum)
+    for (int k = firstK; k <= lastK; k++) {
+        for (int j = 2; j < ny + 2; j++) {
+            for (int i = 2; i < nx + 2; i++) {
+                const int c = i + j * strideY + k * strideZ;
+
+                FLOAT residual = rhs[c]
+                               - coefficientLow_[0][i] * p[c - 1] - coefficientHigh_[0][i] * p[c + 1]
+                               - coefficientLow_[1][j] * p[c - strideY] - coefficientHigh_[1][j] * p[c + strideY]
+                               - (diagonal_[0][i] + diagonal_[1][j]) * p[c];
+                if (is3D) {
+                    residual -= coefficientLow_[2][k] * p[c - strideZ] + coefficientHigh_[2][k] * p[c + strideZ]
+                              + diagonal_[2][k] * p[c];
                 }
-            }
-            resnorm = sqrt (resnorm / (nx * ny));
 
-            for (int j = 2; j < ny + 2; j++) {
-                P.getScalar(1,j) = P.getScalar(2,j);
-                P.getScalar(nx+2,j) = P.getScalar(nx+1,j);
+                sum += residual * residual;
             }
+        }
+    }
 
-            for (int i = 2; i < nx + 2; i++) {
-                P.getScalar(i,1) = P.getScalar(i,2);
-                P.getScalar(i,ny+2) = P.getScalar(i,ny+1);
+    return sum;
+}
+
+template <class D>
+void SORSolver::solve_() {
+    const FLOAT cells = (FLOAT) parameters_.geometry.sizeX * parameters_.geometry.sizeY
+                      * (D::value == 3 ? parameters_.geometry.sizeZ : 1);
+
+    const FLOAT tolerance = tolerance_ > 0 ? tolerance_ : SOR_TOLERANCE;
+
+    // A non-positive maximum lets the solver iterate until it converges
+    int iterations = parameters_.solver.maxIterations > 0 ? parameters_.solver.maxIterations : -1;
+    int it = 0;
+    FLOAT resnorm;
+
+    do {
+        for (int colour = 0; colour < 2; colour++) {
+            if (lineDirection_ >= 0) {
+                relaxLines_<D>(colour, SOR_OMEGA);
+            } else {
+                relax_<D>(colour, SOR_OMEGA);
             }
+            updateGhosts_();
+        }
+
+        const FLOAT localSum = computeResidual_<D>();
+        FLOAT globalSum;
+        MPI_Allreduce(&localSum, &globalSum, 1, MY_MPI_FLOAT, MPI_SUM, PETSC_COMM_WORLD);
+        resnorm = sqrt(globalSum / cells);
+
+        it++;
+        iterations--;
+    } while (resnorm > tolerance && iterations);
+
+    if (parameters_.parallel.rank == 0) {
+        std::cout << "SORSolver needed " << it << " iterations" << std::endl;
+    }
+}
 
-            //std::cout << "Residual norm: " << resnorm << std::endl;
-            iterations--;
-            it++;
-        } while (resnorm > tol && iterations);
+void SORSolver::solve() {
+    if (parameters_.geometry.dim == 3) {
+        solve_<Dim<3>>();
+    } else {
+        solve_<Dim<2>>();
     }
+}
 
-    std::cout << "SORSolver needed " << it << " iterations" << std::endl;
+void SORSolver::reInitMatrix() {
+    setCoefficients_();
 }
 
 } // namespace Solvers
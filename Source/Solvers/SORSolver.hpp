@@ -3,15 +3,53 @@
 
 #include "LinearSolver.hpp"
 
+#include "ParallelManagers/PetscParallelManager.hpp"
+
+#include <vector>
+
 namespace NSEOF {
 namespace Solvers {
 
+/** Red-black SOR solver for the pressure equation
+ *
+ * The cells are coloured by the parity of their global index, so that all cells of one colour
+ * only depend on cells of the other one. Each colour is updated by all threads at once, and the
+ * pressure ghost layers are exchanged with the neighbouring processes before the next colour.
+ * The stencil coefficients only depend on the position along each direction; they are kept in
+ * 1D arrays, rebuilt by reInitMatrix.
+ *
+ * With the line smoother, whole lines along the most strongly coupled direction are relaxed at
+ * once by tridiagonal solves, coloured like a zebra by the parity of the other two indices. This
+ * removes the slow convergence on cells with large aspect ratios, e.g. at the walls of stretched
+ * meshes. Lines end at the process boundaries; the colour alternates between the pieces of a line.
+ */
 class SORSolver : public LinearSolver {
+private:
+    ParallelManagers::PetscParallelManager parallelManager_;
+
+    // Indexed like the cells of the flow field in the respective direction
+    std::vector<FLOAT> coefficientLow_[3];  //! Coupling to the lower neighbour
+    std::vector<FLOAT> coefficientHigh_[3]; //! Coupling to the upper neighbour
+    std::vector<FLOAT> diagonal_[3];        //! Contribution of the direction to the diagonal
+
+    int firstColour_; //! Parity of the global index of the first inner cell of the process
+    int lineDirection_; //! Direction of the relaxed lines, -1 for point relaxation
+    int firstLineColour_; //! Parity of the global indices across the lines of the first inner cell and of the process index along them
+
+    void setCoefficients_();
+    void updateGhosts_();
+
+    template <class D> void relax_(int colour, FLOAT omega);
+    template <class D> void relaxLines_(int colour, FLOAT omega);
+    template <class D> FLOAT computeResidual_() const;
+    template <class D> void solve_();
+
 public:
     SORSolver(FlowField& flowField, const Parameters& parameters);
     ~SORSolver() override = default;
 
     void solve() override;
+    void reInitMatrix() override;
 };
 
 } // namespace Solvers
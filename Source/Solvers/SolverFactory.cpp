@@ -0,0 +1,55 @@
+#include "SolverFactory.hpp"
+
+#include "SORSolver.hpp"
+#include "PetscSolver.hpp"
+#include "EigenSolver.hpp"
+#include "MultigridSolver.hpp"
+#include "FastPoissonSolver.hpp"
+#include "CGSolver.hpp"
+
+namespace NSEOF {
+namespace Solvers {
+
+std::unique_ptr<LinearSolver> SolverFactory::createSolver(FlowField& flowField, Parameters& parameters) {
+    const std::string& type = parameters.solver.type;
+
+    if (type == "sor") {
+        return std::make_unique<SORSolver>(flowField, parameters);
+    }
+
+    if (type == "multigrid") {
+        return std::make_unique<MultigridSolver>(flowField, parameters);
+    }
+
+    if (type == "fast") {
+        return std::make_unique<FastPoissonSolver>(flowField, parameters);
+    }
+
+    if (type == "cg") {
+        return std::make_unique<CGSolver>(flowField, parameters);
+    }
+
+    if (type == "eigen") {
+        int nproc;
+        MPI_Comm_size(PETSC_COMM_WORLD, &nproc);
+        if (nproc > 1) {
+            HANDLE_ERROR(1, "The Eigen solver only supports sequential runs, select the sor, petsc or multigrid solver");
+        }
+
+        return std::make_unique<EigenSolver>(flowField, parameters);
+    }
+
+    if (type == "petsc") {
+#ifdef BUILD_WITH_PETSC
+        return std::make_unique<PetscSolver>(flowField, parameters);
+#else
+        HANDLE_ERROR(1, "The petsc solver is not available, the code was built without PETSc");
+#endif
+    }
+
+    HANDLE_ERROR(1, "Unknown solver type");
+    return nullptr;
+}
+
+} // namespace Solvers
+} // namespace NSEOF
@@ -0,0 +1,22 @@
+#ifndef __SOLVERS_SOLVER_FACTORY_HPP__
+#define __SOLVERS_SOLVER_FACTORY_HPP__
+
+#include "LinearSolver.hpp"
+
+#include <memory>
+
+namespace NSEOF {
+namespace Solvers {
+
+/** Creates the pressure solver selected by the type attribute of the solver element.
+ *  All solvers are part of every build, except for PETSc, which needs BUILD_WITH_PETSC.
+ */
+class SolverFactory {
+public:
+    static std::unique_ptr<LinearSolver> createSolver(FlowField& flowField, Parameters& parameters);
+};
+
+} // namespace Solvers
+} // namespace NSEOF
+
+#endif // __SOLVERS_SOLVER_FACTORY_HPP__
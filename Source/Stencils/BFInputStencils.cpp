@@ -80,8 +80,8 @@ BFInputVelocityStencil::BFInputVelocityStencil(const Parameters& parameters)
 }
 
 void BFInputVelocityStencil::applyLeftWall(FlowField& flowField, int i, int j) {
-    flowField.getVelocity().getVector(i, j)[0] = computeVelocity2D(i, j, stepSize_, parameters_);
-    flowField.getVelocity().getVector(i, j)[1] = -flowField.getVelocity().getVector(i + 1,j)[1];
+    flowField.getVelocity().getComponent(0, i, j) = computeVelocity2D(i, j, stepSize_, parameters_);
+    flowField.getVelocity().getComponent(1, i, j) = -flowField.getVelocity().getComponent(1, i + 1,j);
 }
 
 // Most of the functions are empty, and they shouldn't be called, assuming that the input is always located at the left.
@@ -90,9 +90,9 @@ void BFInputVelocityStencil::applyBottomWall([[maybe_unused]] FlowField& flowFie
 void BFInputVelocityStencil::applyTopWall([[maybe_unused]] FlowField& flowField, [[maybe_unused]] int i, [[maybe_unused]] int j) {}
 
 void BFInputVelocityStencil::applyLeftWall(FlowField& flowField, int i, int j, int k) {
-    flowField.getVelocity().getVector(i,j,k)[0] = computeVelocity3D(i, j, k, stepSize_, parameters_);
-    flowField.getVelocity().getVector(i,j,k)[1] = -flowField.getVelocity().getVector(i + 1, j, k)[1];
-    flowField.getVelocity().getVector(i,j,k)[2] = -flowField.getVelocity().getVector(i + 1, j, k)[2];
+    flowField.getVelocity().getComponent(0, i,j,k) = computeVelocity3D(i, j, k, stepSize_, parameters_);
+    flowField.getVelocity().getComponent(1, i,j,k) = -flowField.getVelocity().getComponent(1, i + 1, j, k);
+    flowField.getVelocity().getComponent(2, i,j,k) = -flowField.getVelocity().getComponent(2, i + 1, j, k);
 }
 
 void BFInputVelocityStencil::applyRightWall([[maybe_unused]] FlowField& flowField, [[maybe_unused]] int i, [[maybe_unused]] int j, [[maybe_unused]] int k) {}
@@ -106,7 +106,7 @@ BFInputFGHStencil::BFInputFGHStencil(const Parameters& parameters)
     , stepSize_(parameters.bfStep.yRatio > 0.0 ? parameters.bfStep.yRatio * parameters.geometry.lengthY : 0.0) {}
 
 void BFInputFGHStencil::applyLeftWall(FlowField & flowField, int i, int j) {
-    flowField.getFGH().getVector(i,j)[0] = computeVelocity2D(i, j, stepSize_, parameters_);
+    flowField.getFGH().getComponent(0, i,j) = computeVelocity2D(i, j, stepSize_, parameters_);
 }
 
 void BFInputFGHStencil::applyRightWall([[maybe_unused]] FlowField& flowField, [[maybe_unused]] int i, [[maybe_unused]] int j) {}
@@ -114,7 +114,7 @@ void BFInputFGHStencil::applyBottomWall([[maybe_unused]] FlowField& flowField, [
 void BFInputFGHStencil::applyTopWall([[maybe_unused]] FlowField& flowField, [[maybe_unused]] int i, [[maybe_unused]] int j) {}
 
 void BFInputFGHStencil::applyLeftWall(FlowField& flowField, int i, int j, int k) {
-    flowField.getFGH().getVector(i,j,k)[0] = computeVelocity3D(i, j, k, stepSize_, parameters_);
+    flowField.getFGH().getComponent(0, i,j,k) = computeVelocity3D(i, j, k, stepSize_, parameters_);
 }
 
 void BFInputFGHStencil::applyRightWall([[maybe_unused]] FlowField& flowField, [[maybe_unused]] [[maybe_unused]] int i, [[maybe_unused]] int j, [[maybe_unused]] int k) {}
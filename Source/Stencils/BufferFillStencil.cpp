@@ -3,30 +3,32 @@
 namespace NSEOF::Stencils {
 
     BufferFillStencil::BufferFillStencil(const Parameters& parameters)
-        : BoundaryStencil<FlowField>(parameters) {}
+        : BoundaryStencil<FlowField>(parameters)
+        , buffers_{}
+        , positions_{} {}
 
-    void BufferFillStencil::clearBuffers() {
-        bufferLeft_.clear();
-        bufferRight_.clear();
-        bufferBottom_.clear();
-        bufferTop_.clear();
-        bufferFront_.clear();
-        bufferBack_.clear();
+    void BufferFillStencil::setBuffers(FLOAT* const buffers[6]) {
+        for (int face = 0; face < 6; face++) {
+            buffers_[face] = buffers[face];
+        }
+        rewind();
     }
 
-    BufferFillStencil::~BufferFillStencil() {
-        clearBuffers();
+    void BufferFillStencil::rewind() {
+        for (int face = 0; face < 6; face++) {
+            positions_[face] = buffers_[face];
+        }
     }
 
     /**
-     * Getters for buffers
+     * Sets the next value in the buffer and increments
      */
 
-    std::vector<FLOAT>& BufferFillStencil::getBufferLeft  () { return bufferLeft_;   }
-    std::vector<FLOAT>& BufferFillStencil::getBufferRight () { return bufferRight_;  }
-    std::vector<FLOAT>& BufferFillStencil::getBufferBottom() { return bufferBottom_; }
-    std::vector<FLOAT>& BufferFillStencil::getBufferTop   () { return bufferTop_;    }
-    std::vector<FLOAT>& BufferFillStencil::getBufferFront () { return bufferFront_;  }
-    std::vector<FLOAT>& BufferFillStencil::getBufferBack  () { return bufferBack_;   }
+    void BufferFillStencil::setNextInBufferLeft  (FLOAT value) { *(positions_[0]++) = value; }
+    void BufferFillStencil::setNextInBufferRight (FLOAT value) { *(positions_[1]++) = value; }
+    void BufferFillStencil::setNextInBufferBottom(FLOAT value) { *(positions_[2]++) = value; }
+    void BufferFillStencil::setNextInBufferTop   (FLOAT value) { *(positions_[3]++) = value; }
+    void BufferFillStencil::setNextInBufferFront (FLOAT value) { *(positions_[4]++) = value; }
+    void BufferFillStencil::setNextInBufferBack  (FLOAT value) { *(positions_[5]++) = value; }
 
 } // namespace NSEOF::Stencils
@@ -6,8 +6,6 @@
 #include "Parameters.hpp"
 #include "Definitions.hpp"
 
-#include <vector>
-
 namespace NSEOF::Stencils {
 
 /**
@@ -15,28 +13,34 @@ namespace NSEOF::Stencils {
  */
 class BufferFillStencil : public BoundaryStencil<FlowField> {
 private:
-    std::vector<FLOAT> bufferLeft_;
-    std::vector<FLOAT> bufferRight_;
-    std::vector<FLOAT> bufferBottom_;
-    std::vector<FLOAT> bufferTop_;
-    std::vector<FLOAT> bufferFront_;
-    std::vector<FLOAT> bufferBack_;
+    // Buffers of the left, right, bottom, top, front and back face, which are not owned, and the
+    // next element to fill in each
+    FLOAT* buffers_[6];
+    FLOAT* positions_[6];
 
 public:
     explicit BufferFillStencil(const Parameters&);
+    ~BufferFillStencil() override = default;
+
+    /**
+     * Sets the buffers in the order left, right, bottom, top, front, back and starts at their beginning
+     */
+    void setBuffers(FLOAT* const buffers[6]);
 
-    void clearBuffers();
-    ~BufferFillStencil() override;
+    /**
+     * Starts at the beginning of the buffers again
+     */
+    void rewind();
 
     /**
-     * Getters for velocity buffers
+     * Sets the next value in the buffer and increments
      */
-    std::vector<FLOAT>& getBufferLeft  ();
-    std::vector<FLOAT>& getBufferRight ();
-    std::vector<FLOAT>& getBufferBottom();
-    std::vector<FLOAT>& getBufferTop   ();
-    std::vector<FLOAT>& getBufferFront ();
-    std::vector<FLOAT>& getBufferBack  ();
+    void setNextInBufferLeft  (FLOAT);
+    void setNextInBufferRight (FLOAT);
+    void setNextInBufferBottom(FLOAT);
+    void setNextInBufferTop   (FLOAT);
+    void setNextInBufferFront (FLOAT);
+    void setNextInBufferBack  (FLOAT);
 };
 
 } // namespace NSEOF::Stencils
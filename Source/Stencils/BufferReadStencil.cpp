@@ -3,99 +3,32 @@
 namespace NSEOF::Stencils {
 
     BufferReadStencil::BufferReadStencil(const Parameters& parameters)
-        : BoundaryStencil<FlowField>(parameters) {}
+        : BoundaryStencil<FlowField>(parameters)
+        , buffers_{}
+        , positions_{} {}
 
-    void BufferReadStencil::clearBuffers() {
-        bufferLeftIterator_ = bufferLeft_.end();
-        bufferRightIterator_ = bufferRight_.end();
-        bufferBottomIterator_ = bufferBottom_.end();
-        bufferTopIterator_ = bufferTop_.end();
-        bufferFrontIterator_ = bufferFront_.end();
-        bufferBackIterator_ = bufferBack_.end();
-
-        bufferLeft_.clear();
-        bufferRight_.clear();
-        bufferBottom_.clear();
-        bufferTop_.clear();
-        bufferFront_.clear();
-        bufferBack_.clear();
+    void BufferReadStencil::setBuffers(const FLOAT* const buffers[6]) {
+        for (int face = 0; face < 6; face++) {
+            buffers_[face] = buffers[face];
+        }
+        rewind();
     }
 
-    BufferReadStencil::~BufferReadStencil() {
-        clearBuffers();
+    void BufferReadStencil::rewind() {
+        for (int face = 0; face < 6; face++) {
+            positions_[face] = buffers_[face];
+        }
     }
 
     /**
-     * Gets the next value in the iterator and increments
-     */
-
-    FLOAT BufferReadStencil::getNextInBufferLeft  () { return *(bufferLeftIterator_++);   }
-    FLOAT BufferReadStencil::getNextInBufferRight () { return *(bufferRightIterator_++);  }
-    FLOAT BufferReadStencil::getNextInBufferBottom() { return *(bufferBottomIterator_++); }
-    FLOAT BufferReadStencil::getNextInBufferTop   () { return *(bufferTopIterator_++);    }
-    FLOAT BufferReadStencil::getNextInBufferFront () { return *(bufferFrontIterator_++);  }
-    FLOAT BufferReadStencil::getNextInBufferBack  () { return *(bufferBackIterator_++);   }
-
-    /**
-     * Setters for buffers and their iterators
+     * Gets the next value in the buffer and increments
      */
 
-    void BufferReadStencil::setBufferLeftIterator(std::vector<FLOAT>& bufferLeft) {
-        bufferLeft_.assign(bufferLeft.begin(), bufferLeft.end()); // Copy
-        bufferLeftIterator_ = bufferLeft_.begin();
-    }
-
-    void BufferReadStencil::setBufferRightIterator(std::vector<FLOAT>& bufferRight) {
-        bufferRight_.assign(bufferRight.begin(), bufferRight.end()); // Copy
-        bufferRightIterator_ = bufferRight_.begin();
-    }
-
-    void BufferReadStencil::setBufferBottomIterator(std::vector<FLOAT>& bufferBottom) {
-        bufferBottom_.assign(bufferBottom.begin(), bufferBottom.end()); // Copy
-        bufferBottomIterator_ = bufferBottom_.begin();
-    }
-
-    void BufferReadStencil::setBufferTopIterator(std::vector<FLOAT>& bufferTop) {
-        bufferTop_.assign(bufferTop.begin(), bufferTop.end()); // Copy
-        bufferTopIterator_ = bufferTop_.begin();
-    }
-
-    void BufferReadStencil::setBufferFrontIterator(std::vector<FLOAT>& bufferFront) {
-        bufferFront_.assign(bufferFront.begin(), bufferFront.end()); // Copy
-        bufferFrontIterator_ = bufferFront_.begin();
-    }
-
-    void BufferReadStencil::setBufferBackIterator(std::vector<FLOAT>& bufferBack) {
-        bufferBack_.assign(bufferBack.begin(), bufferBack.end()); // Copy
-        bufferBackIterator_ = bufferBack_.begin();
-    }
-
-    /**
-     * Setters for single elements in the buffers
-     */
-
-    void BufferReadStencil::setBufferLeftElement(int idx, FLOAT element) {
-        bufferLeft_[idx]= element;
-    }
-
-    void BufferReadStencil::setBufferRightElement(int idx, FLOAT element) {
-        bufferRight_[idx]= element;
-    }
-
-    void BufferReadStencil::setBufferBottomElement(int idx, FLOAT element) {
-        bufferBottom_[idx]= element;
-    }
-
-    void BufferReadStencil::setBufferTopElement(int idx, FLOAT element) {
-        bufferTop_[idx]= element;
-    }
-
-    void BufferReadStencil::setBufferFrontElement(int idx, FLOAT element) {
-        bufferFront_[idx]= element;
-    }
-
-    void BufferReadStencil::setBufferBackElement(int idx, FLOAT element) {
-        bufferBack_[idx]= element;
-    }
+    FLOAT BufferReadStencil::getNextInBufferLeft  () { return *(positions_[0]++); }
+    FLOAT BufferReadStencil::getNextInBufferRight () { return *(positions_[1]++); }
+    FLOAT BufferReadStencil::getNextInBufferBottom() { return *(positions_[2]++); }
+    FLOAT BufferReadStencil::getNextInBufferTop   () { return *(positions_[3]++); }
+    FLOAT BufferReadStencil::getNextInBufferFront () { return *(positions_[4]++); }
+    FLOAT BufferReadStencil::getNextInBufferBack  () { return *(positions_[5]++); }
 
 } // namespace NSEOF::Stencils
@@ -6,9 +6,6 @@
 #include "Parameters.hpp"
 #include "Definitions.hpp"
 
-#include <vector>
-#include <utility>
-
 namespace NSEOF::Stencils {
 
 /**
@@ -16,28 +13,27 @@ namespace NSEOF::Stencils {
  */
 class BufferReadStencil : public BoundaryStencil<FlowField> {
 private:
-    std::vector<FLOAT> bufferLeft_;
-    std::vector<FLOAT> bufferRight_;
-    std::vector<FLOAT> bufferBottom_;
-    std::vector<FLOAT> bufferTop_;
-    std::vector<FLOAT> bufferFront_;
-    std::vector<FLOAT> bufferBack_;
-
-    std::vector<FLOAT>::iterator bufferLeftIterator_;
-    std::vector<FLOAT>::iterator bufferRightIterator_;
-    std::vector<FLOAT>::iterator bufferBottomIterator_;
-    std::vector<FLOAT>::iterator bufferTopIterator_;
-    std::vector<FLOAT>::iterator bufferFrontIterator_;
-    std::vector<FLOAT>::iterator bufferBackIterator_;
+    // Buffers of the left, right, bottom, top, front and back face, which are not owned, and the
+    // next element to read in each
+    const FLOAT* buffers_[6];
+    const FLOAT* positions_[6];
 
 public:
     explicit BufferReadStencil(const Parameters&);
+    ~BufferReadStencil() override = default;
 
-    void clearBuffers();
-    ~BufferReadStencil() override;
+    /**
+     * Sets the buffers in the order left, right, bottom, top, front, back and starts at their beginning
+     */
+    void setBuffers(const FLOAT* const buffers[6]);
+
+    /**
+     * Starts at the beginning of the buffers again
+     */
+    void rewind();
 
     /**
-     * Gets the next value in the iterator and increments
+     * Gets the next value in the buffer and increments
      */
     FLOAT getNextInBufferLeft  ();
     FLOAT getNextInBufferRight ();
@@ -45,26 +41,6 @@ public:
     FLOAT getNextInBufferTop   ();
     FLOAT getNextInBufferFront ();
     FLOAT getNextInBufferBack  ();
-
-    /**
-     * Setters for buffers and their iterators
-     */
-    void setBufferLeftIterator  (std::vector<FLOAT>&);
-    void setBufferRightIterator (std::vector<FLOAT>&);
-    void setBufferBottomIterator(std::vector<FLOAT>&);
-    void setBufferTopIterator   (std::vector<FLOAT>&);
-    void setBufferFrontIterator (std::vector<FLOAT>&);
-    void setBufferBackIterator  (std::vector<FLOAT>&);
-
-    /**
-     * Setters for single elements in the buffers
-     */
-    void setBufferLeftElement  (int, FLOAT);
-    void setBufferRightElement (int, FLOAT);
-    void setBufferBottomElement(int, FLOAT);
-    void setBufferTopElement   (int, FLOAT);
-    void setBufferFrontElement (int, FLOAT);
-    void setBufferBackElement  (int, FLOAT);
 };
 
 } // namespace NSEOF::Stencils
@@ -5,37 +5,44 @@ namespace NSEOF::Stencils {
 FGHStencil::FGHStencil(const Parameters& parameters)
     : FieldStencil<FlowField>(parameters) {}
 
-void FGHStencil::computeValues_(FlowField& flowField, int i, int j) {
-    FLOAT* values = flowField.getFGH().getVector(i, j);
+void FGHStencil::computeValues_(FlowField& flowField, const FLOAT* localVelocity, const FLOAT* localMeshsize, int i, int j) {
+    VectorField& values = flowField.getFGH();
 
     // Now the localVelocity array should contain lexicographically ordered elements around the given index
-    values[0] = computeF2D(localVelocity_, localMeshsize_, parameters_, parameters_.timestep.dt);
-    values[1] = computeG2D(localVelocity_, localMeshsize_, parameters_, parameters_.timestep.dt);
+    values.getComponent(0, i, j) = computeF2D(localVelocity, localMeshsize, parameters_, parameters_.timestep.dt);
+    values.getComponent(1, i, j) = computeG2D(localVelocity, localMeshsize, parameters_, parameters_.timestep.dt);
 }
 
-void FGHStencil::computeValues_(FlowField& flowField, int i, int j, int k, const int obstacle) {
-    FLOAT* values = flowField.getFGH().getVector(i, j, k);
+template <class W>
+void FGHStencil::computeValues_(FlowField& flowField, const FLOAT* localVelocity, const FLOAT* localMeshsize,
+                                int i, int j, int k, const int obstacle) {
+    VectorField& values = flowField.getFGH();
 
     if ((obstacle & OBSTACLE_RIGHT) == 0) {
-        values[0] = computeF3D(localVelocity_, localMeshsize_, parameters_, parameters_.timestep.dt);
+        values.getComponent(0, i, j, k) = computeF3D<W>(localVelocity, localMeshsize, parameters_, parameters_.timestep.dt);
     }
 
     if ((obstacle & OBSTACLE_TOP) == 0) {
-        values[1] = computeG3D(localVelocity_, localMeshsize_, parameters_, parameters_.timestep.dt);
+        values.getComponent(1, i, j, k) = computeG3D<W>(localVelocity, localMeshsize, parameters_, parameters_.timestep.dt);
     }
 
     if ((obstacle & OBSTACLE_BACK) == 0) {
-        values[2] = computeH3D(localVelocity_, localMeshsize_, parameters_, parameters_.timestep.dt);
+        values.getComponent(2, i, j, k) = computeH3D<W>(localVelocity, localMeshsize, parameters_, parameters_.timestep.dt);
     }
 }
 
 void FGHStencil::apply(FlowField& flowField, int i, int j) {
+    // Local arrays used to approximate derivatives. Size matches the 3D case, but they can be
+    // used for 2D as well.
+    FLOAT localVelocity[VALUES_DIMENSION]{};
+    FLOAT localMeshsize[VALUES_DIMENSION]{};
+
     // Load local velocities into the center layer of the local array
-    loadLocalVelocity2D(flowField, localVelocity_, i, j);
-    loadLocalMeshsize2D(parameters_, localMeshsize_, i, j);
+    loadLocalVelocity2D(flowField, localVelocity, i, j);
+    loadLocalMeshsize2D(parameters_, localMeshsize, i, j);
 
     // Computes FGH values
-    computeValues_(flowField, i, j);
+    FGHStencil::computeValues_(flowField, localVelocity, localMeshsize, i, j);
 }
 
 void FGHStencil::apply(FlowField& flowField, int i, int j, int k) {
@@ -43,20 +50,49 @@ void FGHStencil::apply(FlowField& flowField, int i, int j, int k) {
     const int obstacle = flowField.getFlags().getValue(i, j, k);
 
     if ((obstacle & OBSTACLE_SELF) == 0) { // If the cell is fluid
-        loadLocalVelocity3D(flowField, localVelocity_, i, j, k);
-        loadLocalMeshsize3D(parameters_, localMeshsize_, i, j, k);
+        // All entries are overwritten by the loaders
+        FLOAT localVelocity[VALUES_DIMENSION];
+        FLOAT localMeshsize[VALUES_DIMENSION];
+
+        loadLocalVelocity3D(flowField, localVelocity, i, j, k);
+        loadLocalMeshsize3D(parameters_, localMeshsize, i, j, k);
 
         // Computes FGH values
-        computeValues_(flowField, i, j, k, obstacle);
+        FGHStencil::computeValues_(flowField, localVelocity, localMeshsize, i, j, k, obstacle);
     }
 }
 
-FLOAT* FGHStencil::getLocalVelocity_() {
-    return localVelocity_;
-}
+void FGHStencil::applyRow(FlowField& flowField, int firstI, int lastI, int j, int k) {
+    // One block of cells plus the neighbours on either side
+    using RowWindow = Window<ROW_BLOCK + 2>;
+
+    FLOAT windowVelocity[RowWindow::SIZE];
+    FLOAT windowMeshsize[RowWindow::SIZE];
+
+    IntScalarField& flags = flowField.getFlags();
 
-FLOAT* FGHStencil::getLocalMeshsize_() {
-    return localMeshsize_;
+    for (int blockI = firstI; blockI <= lastI; blockI += ROW_BLOCK) {
+        const int cells = std::min(ROW_BLOCK, lastI - blockI + 1);
+
+        // Only the columns loaded here are read below
+        loadWindowVelocity3D<RowWindow>(flowField, windowVelocity, blockI - 1, cells + 2, j, k);
+        loadWindowMeshsize3D<RowWindow>(parameters_, windowMeshsize, blockI - 1, cells + 2, j, k);
+
+        for (int cell = 0; cell < cells; cell++) {
+            const int obstacle = flags.getValue(blockI + cell, j, k);
+
+            if ((obstacle & OBSTACLE_SELF) == 0) { // If the cell is fluid
+                FGHStencil::computeValues_<RowWindow>(flowField, windowVelocity + 3 * cell, windowMeshsize + 3 * cell,
+                                                      blockI + cell, j, k, obstacle);
+            }
+        }
+    }
 }
 
 } // namespace NSEOF::Stencils
+
+namespace NSEOF {
+template class StaticFieldIterator<FlowField, Stencils::FGHStencil>;
+template class TiledFieldIterator<FlowField, Stencils::FGHStencil>;
+template class FusedFieldIterator<FlowField, Stencils::FGHStencil, Stencils::RHSStencil>;
+} // namespace NSEOF
@@ -5,6 +5,8 @@
 #include "FlowField.hpp"
 #include "Parameters.hpp"
 #include "Definitions.hpp"
+#include "Iterators.hpp"
+#include "RHSStencil.hpp"
 
 #include "StencilFunctions.hpp"
 
@@ -13,27 +15,43 @@
 namespace NSEOF::Stencils {
 
 class FGHStencil : public FieldStencil<FlowField> {
-private:
-    // A local velocity variable that will be used to approximate derivatives.
-    // Size matches 3D case, but can be used for 2D as well.
-    FLOAT localVelocity_[VALUES_DIMENSION]{};
-    FLOAT localMeshsize_[VALUES_DIMENSION]{};
-
 protected:
-    virtual void computeValues_(FlowField&, int, int);
-    virtual void computeValues_(FlowField&, int, int, int, int);
-
-    [[nodiscard]] FLOAT* getLocalVelocity_();
-    [[nodiscard]] FLOAT* getLocalMeshsize_();
+    // Not virtual, so that apply needs no indirect call per cell. Derived stencils that
+    // provide their own computeValues_ have to override apply as well.
+    // The local velocity and meshsize arrays are loaded by apply. They are kept on the stack
+    // rather than in the stencil, so that threads sharing the stencil do not overwrite them.
+    void computeValues_(FlowField&, const FLOAT*, const FLOAT*, int, int);
+    template <class W = Cube>
+    void computeValues_(FlowField&, const FLOAT*, const FLOAT*, int, int, int, int);
 
 public:
+    //! Number of cells of a row the row kernel computes from one window of loaded values
+    static constexpr int ROW_BLOCK = 16;
+
     explicit FGHStencil(const Parameters& parameters);
     ~FGHStencil() override = default;
 
     void apply(FlowField&, int, int) override;
     void apply(FlowField&, int, int, int) override;
+
+    /** Row kernel for 3D, see HasRowKernel. Loads the velocities and meshsizes of ROW_BLOCK cells
+     *  and their neighbours once, and slides the cube of the derivative functions along them,
+     *  instead of loading a full cube for every cell. Computes the laminar FGH values; derived
+     *  stencils do not use it.
+     */
+    void applyRow(FlowField&, int firstI, int lastI, int j, int k);
 };
 
 } // namespace NSEOF::Stencils
 
+namespace NSEOF {
+template <>
+struct HasRowKernel<Stencils::FGHStencil> : std::true_type {};
+
+// Instantiated in FGHStencil.cpp, where the stencil body can be inlined into the loops
+extern template class StaticFieldIterator<FlowField, Stencils::FGHStencil>;
+extern template class TiledFieldIterator<FlowField, Stencils::FGHStencil>;
+extern template class FusedFieldIterator<FlowField, Stencils::FGHStencil, Stencils::RHSStencil>;
+} // namespace NSEOF
+
 #endif // __STENCILS_FGH_STENCIL_HPP__
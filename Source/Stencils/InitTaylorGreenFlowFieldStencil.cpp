@@ -16,25 +16,25 @@ InitTaylorGreenFlowFieldStencil::~InitTaylorGreenFlowFieldStencil() {
 
 void InitTaylorGreenFlowFieldStencil::apply(FlowField& flowField, int i, int j) {
     FLOAT coords[3] = { 0.0, 0.0, 0.0 };
-    FLOAT* const velocity = flowField.getVelocity().getVector(i, j);
+    VectorField& velocity = flowField.getVelocity();
     computeGlobalCoordinates(coords, i, j);
     // Initialize velocities
-    velocity[0] = sin(pi2_ * (coords[0] + 0.5 * parameters_.meshsize->getDx(i, j)) / domainSize_[0]) * sin(pi2_ * coords[1] / domainSize_[1]);
-    velocity[1] = cos(pi2_ * coords[0] / domainSize_[0]) * cos(pi2_ * (coords[1] + 0.5 * parameters_.meshsize->getDy(i, j)) / domainSize_[1]);
+    velocity.getComponent(0, i, j) = sin(pi2_ * (coords[0] + 0.5 * parameters_.meshsize->getDx(i, j)) / domainSize_[0]) * sin(pi2_ * coords[1] / domainSize_[1]);
+    velocity.getComponent(1, i, j) = cos(pi2_ * coords[0] / domainSize_[0]) * cos(pi2_ * (coords[1] + 0.5 * parameters_.meshsize->getDy(i, j)) / domainSize_[1]);
 }
 
 void InitTaylorGreenFlowFieldStencil::apply(FlowField& flowField, int i, int j, int k) {
     FLOAT coords[3] = { 0.0, 0.0, 0.0 };
-    FLOAT* const velocity = flowField.getVelocity().getVector(i, j, k);
+    VectorField& velocity = flowField.getVelocity();
     computeGlobalCoordinates(coords, i, j, k);
     // Initialize velocities
-    velocity[0] = cos(pi2_ * (coords[0] + 0.5 * parameters_.meshsize->getDx(i, j, k)) / domainSize_[0]) *
+    velocity.getComponent(0, i, j, k) = cos(pi2_ * (coords[0] + 0.5 * parameters_.meshsize->getDx(i, j, k)) / domainSize_[0]) *
         sin(pi2_ * coords[1] / domainSize_[1]) *
         sin(pi2_ * coords[2] / domainSize_[2]);
-    velocity[1] = sin(pi2_ * coords[0] / domainSize_[0]) *
+    velocity.getComponent(1, i, j, k) = sin(pi2_ * coords[0] / domainSize_[0]) *
         cos(pi2_ * (coords[1] + 0.5 * parameters_.meshsize->getDy(i, j, k)) / domainSize_[1]) *
         sin(pi2_ * coords[2] / domainSize_[2]);
-    velocity[2] = sin(pi2_ * coords[0] / domainSize_[0]) *
+    velocity.getComponent(2, i, j, k) = sin(pi2_ * coords[0] / domainSize_[0]) *
         sin(pi2_ * coords[1] / domainSize_[1]) *
         cos(pi2_ * (coords[2] + 0.5 * parameters_.meshsize->getDz(i, j, k)) / domainSize_[2]);
 }
@@ -62,42 +62,60 @@ void MaxUStencil::applyBackWall(FlowField& flowField, int i, int j, int k) {
 }
 
 void MaxUStencil::cellMaxValue(FlowField& flowField, int i, int j) {
-    FLOAT* velocity = flowField.getVelocity().getVector(i, j);
-    const FLOAT dx = FieldStencil<FlowField>::parameters_.meshsize->getDx(i, j);
-    const FLOAT dy = FieldStencil<FlowField>::parameters_.meshsize->getDy(i, j);
-    if (fabs(velocity[0]) / dx > maxValues_[0]) {
-        maxValues_[0] = fabs(velocity[0]) / dx;
+    VectorField& velocity = flowField.getVelocity();
+    const MeshMetrics& metrics = *FieldStencil<FlowField>::parameters_.meshMetrics;
+    const FLOAT u = fabs(velocity.getComponent(0, i, j)) * metrics.getInverseSpacing(0)[i];
+    const FLOAT v = fabs(velocity.getComponent(1, i, j)) * metrics.getInverseSpacing(1)[j];
+    FLOAT* const maxValues = threadMaxValues_[getThreadNum()].values;
+    if (u > maxValues[0]) {
+        maxValues[0] = u;
     }
-    if (fabs(velocity[1]) / dy > maxValues_[1]) {
-        maxValues_[1] = fabs(velocity[1]) / dy;
+    if (v > maxValues[1]) {
+        maxValues[1] = v;
     }
 }
 
 void MaxUStencil::cellMaxValue(FlowField& flowField, int i, int j, int k) {
-    FLOAT* velocity = flowField.getVelocity().getVector(i, j, k);
-    const FLOAT dx = FieldStencil<FlowField>::parameters_.meshsize->getDx(i, j, k);
-    const FLOAT dy = FieldStencil<FlowField>::parameters_.meshsize->getDy(i, j, k);
-    const FLOAT dz = FieldStencil<FlowField>::parameters_.meshsize->getDz(i, j, k);
-    if (fabs(velocity[0]) / dx > maxValues_[0]) {
-        maxValues_[0] = fabs(velocity[0]) / dx;
+    VectorField& velocity = flowField.getVelocity();
+    const MeshMetrics& metrics = *FieldStencil<FlowField>::parameters_.meshMetrics;
+    const FLOAT u = fabs(velocity.getComponent(0, i, j, k)) * metrics.getInverseSpacing(0)[i];
+    const FLOAT v = fabs(velocity.getComponent(1, i, j, k)) * metrics.getInverseSpacing(1)[j];
+    const FLOAT w = fabs(velocity.getComponent(2, i, j, k)) * metrics.getInverseSpacing(2)[k];
+    FLOAT* const maxValues = threadMaxValues_[getThreadNum()].values;
+    if (u > maxValues[0]) {
+        maxValues[0] = u;
     }
-    if (fabs(velocity[1]) / dy > maxValues_[1]) {
-        maxValues_[1] = fabs(velocity[1]) / dy;
+    if (v > maxValues[1]) {
+        maxValues[1] = v;
     }
-    if (fabs(velocity[2]) / dz > maxValues_[2]) {
-        maxValues_[2] = fabs(velocity[2]) / dz;
+    if (w > maxValues[2]) {
+        maxValues[2] = w;
     }
 }
 
 void MaxUStencil::reset() {
+    // Sized here rather than in the constructor, in case the number of threads has changed since
+    threadMaxValues_.assign(getMaxThreads(), ThreadMaxValues{{0, 0, 0}});
+}
+
+const FLOAT* MaxUStencil::getMaxValues() const {
     maxValues_[0] = 0;
     maxValues_[1] = 0;
     maxValues_[2] = 0;
-}
 
-const FLOAT* MaxUStencil::getMaxValues() const {
+    for (const ThreadMaxValues& thread : threadMaxValues_) {
+        for (int component = 0; component < 3; component++) {
+            maxValues_[component] = std::max(maxValues_[component], thread.values[component]);
+        }
+    }
+
     return maxValues_;
 }
 
 } // namespace Stencils
 } // namespace NSEOF
+
+namespace NSEOF {
+template class StaticFieldIterator<FlowField, Stencils::MaxUStencil>;
+template class ShellFieldIterator<FlowField, Stencils::MaxUStencil>;
+} // namespace NSEOF
@@ -4,6 +4,10 @@
 #include "Stencil.hpp"
 #include "FlowField.hpp"
 #include "Parameters.hpp"
+#include "Iterators.hpp"
+#include "Threading.hpp"
+
+#include <vector>
 
 namespace NSEOF {
 namespace Stencils {
@@ -14,9 +18,16 @@ namespace Stencils {
  *  the meshsize may be different for every grid cell. We therefore determine the max(velocity)/meshsize
  *  and synchronise this value over whole computational domain.
  */
-class MaxUStencil : public FieldStencil<FlowField>, public BoundaryStencil<FlowField> {
+class MaxUStencil final : public FieldStencil<FlowField>, public BoundaryStencil<FlowField> {
 private:
-    FLOAT maxValues_[3]; //! Stores the maximum module of every component
+    //! Maximum modules of every component found by one thread. Padded to a cache line, so that
+    //! threads sweeping different parts of the domain do not share one.
+    struct alignas(CACHE_LINE_SIZE) ThreadMaxValues {
+        FLOAT values[3];
+    };
+
+    std::vector<ThreadMaxValues> threadMaxValues_; //! One slot per thread, indexed by the thread number
+    mutable FLOAT maxValues_[3];                   //! Maximum over all threads, merged on request
 
     /** Sets the maximum value arrays to the value of the cell if it surpasses the current one.
      *
@@ -61,7 +72,8 @@ public:
     void reset();
 
     /** Returns the array with the maximum modules of the components of the velocity,
-     *  divided by the respective local meshsize.
+     *  divided by the respective local meshsize. Merges the values found by the threads, so it
+     *  must not be called while an iteration is running.
      */
     const FLOAT* getMaxValues() const;
 };
@@ -69,4 +81,10 @@ public:
 } // namespace Stencils
 } // namespace NSEOF
 
+namespace NSEOF {
+// Instantiated in MaxUStencil.cpp, where the stencil body can be inlined into the loops
+extern template class StaticFieldIterator<FlowField, Stencils::MaxUStencil>;
+extern template class ShellFieldIterator<FlowField, Stencils::MaxUStencil>;
+} // namespace NSEOF
+
 #endif // __STENCILS_MAX_U_STENCIL_HPP__
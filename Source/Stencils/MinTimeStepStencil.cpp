@@ -7,13 +7,14 @@ MinTimeStepStencil::MinTimeStepStencil(const Parameters& parameters)
         reset();
 }
 
-void MinTimeStepStencil::apply(FlowField& flowField, int i, int j, int k) {
-    const FLOAT dx = FieldStencil<FlowField>::parameters_.meshsize->getDx(i, j, k);
-    const FLOAT dy = FieldStencil<FlowField>::parameters_.meshsize->getDy(i, j, k);
+template <class D>
+void MinTimeStepStencil::apply_(FlowField& flowField, int i, int j, int k) {
+    const FLOAT dx = FieldStencil<FlowField>::parameters_.meshMetrics->getDx(i);
+    const FLOAT dy = FieldStencil<FlowField>::parameters_.meshMetrics->getDy(j);
     FLOAT dz = 0;
 
-    if (parameters_.geometry.dim == 3) { // 3D
-        dz = FieldStencil<FlowField>::parameters_.meshsize->getDz(i, j, k);
+    if constexpr (D::value == 3) {
+        dz = FieldStencil<FlowField>::parameters_.meshMetrics->getDz(k);
     }
 
     const FLOAT eddyViscosity = flowField.getEddyViscosity().getScalar(i, j, k);
@@ -26,7 +27,7 @@ void MinTimeStepStencil::apply(FlowField& flowField, int i, int j, int k) {
     FLOAT factor1 = 1.0 / (dx * dx) + 1.0 / (dy * dy);
     FLOAT factor2 = 1.0 / (dx * dx) + 1.0 / (dy * dy) + 1 / (dx * dy);
 
-    if (parameters_.geometry.dim == 3) { // 3D
+    if constexpr (D::value == 3) {
         factor1 += 1.0 / (dz * dz); // TODO: Remove this unused factor1 and rename factor2 as factor!
         factor2 += 1 / (dx * dz) + 1 / (dy * dz) + 1.0 / (dz * dz);
     }
@@ -34,23 +35,38 @@ void MinTimeStepStencil::apply(FlowField& flowField, int i, int j, int k) {
     // Timestep minimum in current cell
     FLOAT cellTimeStep = reynoldsNew / (2 * factor2);
 
-    if (std::abs(cellTimeStep) < diffusiveTimeStep_) {
-        diffusiveTimeStep_ = cellTimeStep;
+    FLOAT& diffusiveTimeStep = threadTimeSteps_[getThreadNum()].value;
+    if (std::abs(cellTimeStep) < diffusiveTimeStep) {
+        diffusiveTimeStep = cellTimeStep;
     }
 }
 
+void MinTimeStepStencil::apply(FlowField& flowField, int i, int j, int k) {
+    apply_<Dim<3>>(flowField, i, j, k);
+}
+
 void MinTimeStepStencil::apply(FlowField& flowField, int i, int j) {
-    apply(flowField, i, j, 0);
+    apply_<Dim<2>>(flowField, i, j, 0);
 }
 
 void MinTimeStepStencil::reset() {
 	// Initially set diffusive timestep to the given one from the user
 	// Hard coded, because parameters_.timestep.dt is changed during the simulation
-    diffusiveTimeStep_ = 1.; // FieldStencil<FlowField>::parameters_.timestep.dt;
+    threadTimeSteps_.assign(getMaxThreads(), ThreadTimeStep{1.}); // FieldStencil<FlowField>::parameters_.timestep.dt;
 }
 
 FLOAT MinTimeStepStencil::getDiffusiveTimeStep() const {
-    return diffusiveTimeStep_;
+    FLOAT diffusiveTimeStep = threadTimeSteps_[0].value;
+
+    for (const ThreadTimeStep& thread : threadTimeSteps_) {
+        diffusiveTimeStep = std::min(diffusiveTimeStep, thread.value);
+    }
+
+    return diffusiveTimeStep;
 }
 
 } // namespace NSEOF::Stencils
+
+namespace NSEOF {
+template class StaticFieldIterator<FlowField, Stencils::MinTimeStepStencil>;
+} // namespace NSEOF
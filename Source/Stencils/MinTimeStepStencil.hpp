@@ -4,8 +4,12 @@
 #include "Stencil.hpp"
 #include "FlowField.hpp"
 #include "Parameters.hpp"
+#include "Threading.hpp"
+#include "Dimension.hpp"
+#include "Iterators.hpp"
 
 #include <algorithm>
+#include <vector>
 #include <math.h>
 
 namespace NSEOF::Stencils {
@@ -15,7 +19,16 @@ namespace NSEOF::Stencils {
  */
 class MinTimeStepStencil : public FieldStencil<FlowField> {
 private:
-    FLOAT diffusiveTimeStep_; // Stores the minimum diffusive timestep
+    // Minimum diffusive timestep found by one thread, padded to a cache line
+    struct alignas(CACHE_LINE_SIZE) ThreadTimeStep {
+        FLOAT value;
+    };
+
+    std::vector<ThreadTimeStep> threadTimeSteps_; // One slot per thread, indexed by the thread number
+
+    // The body of the 2D and 3D apply, see Dim
+    template <class D>
+    void apply_(FlowField& flowField, int i, int j, int k);
 
 public:
     explicit MinTimeStepStencil(const Parameters& parameters);
@@ -27,10 +40,15 @@ public:
     // Resets the minimum value to zero before computing the timestep.
     void reset();
 
-    // Returns the minimum timestep over the whole geometry,
+    // Returns the minimum timestep over the whole geometry, merging the values of all threads
     [[nodiscard]] FLOAT getDiffusiveTimeStep() const;
 };
 
 } // namespace NSEOF::Stencils
 
+namespace NSEOF {
+// Instantiated in MinTimeStepStencil.cpp, where the stencil body can be inlined into the loops
+extern template class StaticFieldIterator<FlowField, Stencils::MinTimeStepStencil>;
+} // namespace NSEOF
+
 #endif // __STENCILS_MIN_TIME_STEP_STENCIL_HPP__
@@ -7,59 +7,59 @@ NeumannVelocityBoundaryStencil::NeumannVelocityBoundaryStencil(const Parameters&
     : BoundaryStencil<FlowField>(parameters) {}
 
 void NeumannVelocityBoundaryStencil::applyLeftWall(FlowField& flowField, int i, int j) {
-    flowField.getVelocity().getVector(i - 1, j)[0] = flowField.getVelocity().getVector(i, j)[0];
-    flowField.getVelocity().getVector(i, j)[1] = flowField.getVelocity().getVector(i + 1, j)[1];
+    flowField.getVelocity().getComponent(0, i - 1, j) = flowField.getVelocity().getComponent(0, i, j);
+    flowField.getVelocity().getComponent(1, i, j) = flowField.getVelocity().getComponent(1, i + 1, j);
 }
 
 void NeumannVelocityBoundaryStencil::applyRightWall(FlowField& flowField, int i, int j) {
-    flowField.getVelocity().getVector(i, j)[0] = flowField.getVelocity().getVector(i - 1, j)[0];
-    flowField.getVelocity().getVector(i, j)[1] = flowField.getVelocity().getVector(i - 1, j)[1];
+    flowField.getVelocity().getComponent(0, i, j) = flowField.getVelocity().getComponent(0, i - 1, j);
+    flowField.getVelocity().getComponent(1, i, j) = flowField.getVelocity().getComponent(1, i - 1, j);
 }
 
 void NeumannVelocityBoundaryStencil::applyBottomWall(FlowField& flowField, int i, int j) {
-    flowField.getVelocity().getVector(i, j)[0] = flowField.getVelocity().getVector(i, j + 1)[0];
-    flowField.getVelocity().getVector(i, j - 1)[1] = flowField.getVelocity().getVector(i, j)[1];
+    flowField.getVelocity().getComponent(0, i, j) = flowField.getVelocity().getComponent(0, i, j + 1);
+    flowField.getVelocity().getComponent(1, i, j - 1) = flowField.getVelocity().getComponent(1, i, j);
 }
 
 void NeumannVelocityBoundaryStencil::applyTopWall(FlowField& flowField, int i, int j) {
-    flowField.getVelocity().getVector(i, j)[0] = flowField.getVelocity().getVector(i, j - 1)[0];
-    flowField.getVelocity().getVector(i, j)[1] = flowField.getVelocity().getVector(i, j - 1)[1];
+    flowField.getVelocity().getComponent(0, i, j) = flowField.getVelocity().getComponent(0, i, j - 1);
+    flowField.getVelocity().getComponent(1, i, j) = flowField.getVelocity().getComponent(1, i, j - 1);
 }
 
 void NeumannVelocityBoundaryStencil::applyLeftWall(FlowField& flowField, int i, int j, int k) {
-    flowField.getVelocity().getVector(i - 1, j, k)[0] = flowField.getVelocity().getVector(i, j, k)[0];
-    flowField.getVelocity().getVector(i, j, k)[1] = flowField.getVelocity().getVector(i + 1, j, k)[1];
-    flowField.getVelocity().getVector(i, j, k)[2] = flowField.getVelocity().getVector(i + 1, j, k)[2];
+    flowField.getVelocity().getComponent(0, i - 1, j, k) = flowField.getVelocity().getComponent(0, i, j, k);
+    flowField.getVelocity().getComponent(1, i, j, k) = flowField.getVelocity().getComponent(1, i + 1, j, k);
+    flowField.getVelocity().getComponent(2, i, j, k) = flowField.getVelocity().getComponent(2, i + 1, j, k);
 }
 
 void NeumannVelocityBoundaryStencil::applyRightWall(FlowField& flowField, int i, int j, int k) {
-    flowField.getVelocity().getVector(i, j, k)[0] = flowField.getVelocity().getVector(i - 1, j, k)[0];
-    flowField.getVelocity().getVector(i, j, k)[1] = flowField.getVelocity().getVector(i - 1, j, k)[1];
-    flowField.getVelocity().getVector(i, j, k)[2] = flowField.getVelocity().getVector(i - 1, j, k)[2];
+    flowField.getVelocity().getComponent(0, i, j, k) = flowField.getVelocity().getComponent(0, i - 1, j, k);
+    flowField.getVelocity().getComponent(1, i, j, k) = flowField.getVelocity().getComponent(1, i - 1, j, k);
+    flowField.getVelocity().getComponent(2, i, j, k) = flowField.getVelocity().getComponent(2, i - 1, j, k);
 }
 
 void NeumannVelocityBoundaryStencil::applyBottomWall(FlowField& flowField, int i, int j, int k) {
-    flowField.getVelocity().getVector(i, j, k)[0] = flowField.getVelocity().getVector(i, j + 1, k)[0];
-    flowField.getVelocity().getVector(i, j - 1, k)[1] = flowField.getVelocity().getVector(i, j, k)[1];
-    flowField.getVelocity().getVector(i, j, k)[2] = flowField.getVelocity().getVector(i, j + 1, k)[2];
+    flowField.getVelocity().getComponent(0, i, j, k) = flowField.getVelocity().getComponent(0, i, j + 1, k);
+    flowField.getVelocity().getComponent(1, i, j - 1, k) = flowField.getVelocity().getComponent(1, i, j, k);
+    flowField.getVelocity().getComponent(2, i, j, k) = flowField.getVelocity().getComponent(2, i, j + 1, k);
 }
 
 void NeumannVelocityBoundaryStencil::applyTopWall(FlowField& flowField, int i, int j, int k) {
-    flowField.getVelocity().getVector(i, j, k)[0] = flowField.getVelocity().getVector(i, j - 1, k)[0];
-    flowField.getVelocity().getVector(i, j, k)[1] = flowField.getVelocity().getVector(i, j - 1, k)[1];
-    flowField.getVelocity().getVector(i, j, k)[2] = flowField.getVelocity().getVector(i, j - 1, k)[2];
+    flowField.getVelocity().getComponent(0, i, j, k) = flowField.getVelocity().getComponent(0, i, j - 1, k);
+    flowField.getVelocity().getComponent(1, i, j, k) = flowField.getVelocity().getComponent(1, i, j - 1, k);
+    flowField.getVelocity().getComponent(2, i, j, k) = flowField.getVelocity().getComponent(2, i, j - 1, k);
 }
 
 void NeumannVelocityBoundaryStencil::applyFrontWall(FlowField& flowField, int i, int j, int k) {
-    flowField.getVelocity().getVector(i, j, k)[0] = flowField.getVelocity().getVector(i, j, k + 1)[0];
-    flowField.getVelocity().getVector(i, j, k)[1] = flowField.getVelocity().getVector(i, j, k + 1)[1];
-    flowField.getVelocity().getVector(i, j, k - 1)[2] = flowField.getVelocity().getVector(i, j, k)[2];
+    flowField.getVelocity().getComponent(0, i, j, k) = flowField.getVelocity().getComponent(0, i, j, k + 1);
+    flowField.getVelocity().getComponent(1, i, j, k) = flowField.getVelocity().getComponent(1, i, j, k + 1);
+    flowField.getVelocity().getComponent(2, i, j, k - 1) = flowField.getVelocity().getComponent(2, i, j, k);
 }
 
 void NeumannVelocityBoundaryStencil::applyBackWall(FlowField& flowField, int i, int j, int k) {
-    flowField.getVelocity().getVector(i, j, k)[0] = flowField.getVelocity().getVector(i, j, k - 1)[0];
-    flowField.getVelocity().getVector(i, j, k)[1] = flowField.getVelocity().getVector(i, j, k - 1)[1];
-    flowField.getVelocity().getVector(i, j, k)[2] = flowField.getVelocity().getVector(i, j, k - 1)[2];
+    flowField.getVelocity().getComponent(0, i, j, k) = flowField.getVelocity().getComponent(0, i, j, k - 1);
+    flowField.getVelocity().getComponent(1, i, j, k) = flowField.getVelocity().getComponent(1, i, j, k - 1);
+    flowField.getVelocity().getComponent(2, i, j, k) = flowField.getVelocity().getComponent(2, i, j, k - 1);
 }
 
 NeumannFGHBoundaryStencil::NeumannFGHBoundaryStencil(const Parameters& parameters)
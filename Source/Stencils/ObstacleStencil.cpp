@@ -14,101 +14,105 @@ void ObstacleStencil::apply(FlowField& flowField, int i, int j) {
     if ((obstacle & OBSTACLE_SELF) == 1) {
         // If top cell is fluid, then the no-slip boundary has to be enforced
         if ((obstacle & OBSTACLE_TOP) == 0) {
-            const FLOAT dy_t = parameters_.meshsize->getDy(i, j + 1);
-            const FLOAT dy = parameters_.meshsize->getDy(i, j);
-            velocity.getVector(i, j)[0] = -dy / dy_t * velocity.getVector(i, j + 1)[0];
+            const FLOAT dy_t = parameters_.meshMetrics->getDy(j + 1);
+            const FLOAT dy = parameters_.meshMetrics->getDy(j);
+            velocity.getComponent(0, i, j) = -dy / dy_t * velocity.getComponent(0, i, j + 1);
         }
         // Same for bottom
         if ((obstacle & OBSTACLE_BOTTOM) == 0) {
-            const FLOAT dy_b = parameters_.meshsize->getDy(i, j - 1);
-            const FLOAT dy = parameters_.meshsize->getDy(i, j);
-            velocity.getVector(i, j)[0] = -dy / dy_b * velocity.getVector(i, j - 1)[0];
+            const FLOAT dy_b = parameters_.meshMetrics->getDy(j - 1);
+            const FLOAT dy = parameters_.meshMetrics->getDy(j);
+            velocity.getComponent(0, i, j) = -dy / dy_b * velocity.getComponent(0, i, j - 1);
         }
         // If right cell is fluid, then the no-slip boundary has to be enforced
         if ((obstacle & OBSTACLE_RIGHT) == 0) {
-            const FLOAT dx_r = parameters_.meshsize->getDx(i + 1, j);
-            const FLOAT dx = parameters_.meshsize->getDx(i, j);
-            velocity.getVector(i, j)[1] = -dx / dx_r * velocity.getVector(i + 1, j)[1];
+            const FLOAT dx_r = parameters_.meshMetrics->getDx(i + 1);
+            const FLOAT dx = parameters_.meshMetrics->getDx(i);
+            velocity.getComponent(1, i, j) = -dx / dx_r * velocity.getComponent(1, i + 1, j);
         }
         // Same for left
         if ((obstacle & OBSTACLE_LEFT) == 0) {
-            const FLOAT dx_l = parameters_.meshsize->getDx(i - 1, j);
-            const FLOAT dx = parameters_.meshsize->getDx(i, j);
-            velocity.getVector(i, j)[1] = -dx / dx_l * velocity.getVector(i - 1, j)[1];
+            const FLOAT dx_l = parameters_.meshMetrics->getDx(i - 1);
+            const FLOAT dx = parameters_.meshMetrics->getDx(i);
+            velocity.getComponent(1, i, j) = -dx / dx_l * velocity.getComponent(1, i - 1, j);
         }
 
         // Set normal velocity to zero if right neighbour is not obstacle
         if ((obstacle & OBSTACLE_RIGHT) == 0) {
-            velocity.getVector(i, j)[0] = 0.0;
+            velocity.getComponent(0, i, j) = 0.0;
         }
 
         // Set normal velocity to zero if top neighbour is not obstacle
         if ((obstacle & OBSTACLE_TOP) == 0) {
-            velocity.getVector(i, j)[1] = 0.0;
+            velocity.getComponent(1, i, j) = 0.0;
         }
     }
 }
 
 void ObstacleStencil::apply(FlowField& flowField, int i, int j, int k) {
-    const int obstacle = flowField.getFlags().getValue(i, j);
+    const int obstacle = flowField.getFlags().getValue(i, j, k);
     VectorField& velocity = flowField.getVelocity();
 
     // Check if current cell is obstacle cell
     if ((obstacle & OBSTACLE_SELF) == 1) {
         // If top cell is fluid: two velocities have to be set: direction 0 and 2.
         if ((obstacle & OBSTACLE_TOP) == 0) {
-            const FLOAT dy_t = parameters_.meshsize->getDy(i, j + 1, k);
-            const FLOAT dy = parameters_.meshsize->getDy(i, j, k);
-            velocity.getVector(i, j, k)[0] = -dy / dy_t * velocity.getVector(i, j + 1, k)[0];
-            velocity.getVector(i, j, k)[2] = -dy / dy_t * velocity.getVector(i, j + 1, k)[2];
+            const FLOAT dy_t = parameters_.meshMetrics->getDy(j + 1);
+            const FLOAT dy = parameters_.meshMetrics->getDy(j);
+            velocity.getComponent(0, i, j, k) = -dy / dy_t * velocity.getComponent(0, i, j + 1, k);
+            velocity.getComponent(2, i, j, k) = -dy / dy_t * velocity.getComponent(2, i, j + 1, k);
         }
         if ((obstacle & OBSTACLE_BOTTOM) == 0) {
-            const FLOAT dy_b = parameters_.meshsize->getDy(i, j - 1, k);
-            const FLOAT dy = parameters_.meshsize->getDy(i, j, k);
-            velocity.getVector(i, j, k)[0] = -dy / dy_b * velocity.getVector(i, j - 1, k)[0];
-            velocity.getVector(i, j, k)[2] = -dy / dy_b * velocity.getVector(i, j - 1, k)[2];
+            const FLOAT dy_b = parameters_.meshMetrics->getDy(j - 1);
+            const FLOAT dy = parameters_.meshMetrics->getDy(j);
+            velocity.getComponent(0, i, j, k) = -dy / dy_b * velocity.getComponent(0, i, j - 1, k);
+            velocity.getComponent(2, i, j, k) = -dy / dy_b * velocity.getComponent(2, i, j - 1, k);
         }
 
         // If right cell is fluid: two velocities have to be set: direction 1 and 2.
         if ((obstacle & OBSTACLE_RIGHT) == 0) {
-            const FLOAT dx_r = parameters_.meshsize->getDx(i + 1, j, k);
-            const FLOAT dx = parameters_.meshsize->getDx(i, j, k);
-            velocity.getVector(i, j, k)[1] = -dx / dx_r * velocity.getVector(i + 1, j, k)[1];
-            velocity.getVector(i, j, k)[2] = -dx / dx_r * velocity.getVector(i + 1, j, k)[2];
+            const FLOAT dx_r = parameters_.meshMetrics->getDx(i + 1);
+            const FLOAT dx = parameters_.meshMetrics->getDx(i);
+            velocity.getComponent(1, i, j, k) = -dx / dx_r * velocity.getComponent(1, i + 1, j, k);
+            velocity.getComponent(2, i, j, k) = -dx / dx_r * velocity.getComponent(2, i + 1, j, k);
         }
         if ((obstacle & OBSTACLE_LEFT) == 0) {
-            const FLOAT dx_l = parameters_.meshsize->getDx(i - 1, j, k);
-            const FLOAT dx = parameters_.meshsize->getDx(i, j, k);
-            velocity.getVector(i, j, k)[1] = -dx / dx_l * velocity.getVector(i - 1, j, k)[1];
-            velocity.getVector(i, j, k)[2] = -dx / dx_l * velocity.getVector(i - 1, j, k)[2];
+            const FLOAT dx_l = parameters_.meshMetrics->getDx(i - 1);
+            const FLOAT dx = parameters_.meshMetrics->getDx(i);
+            velocity.getComponent(1, i, j, k) = -dx / dx_l * velocity.getComponent(1, i - 1, j, k);
+            velocity.getComponent(2, i, j, k) = -dx / dx_l * velocity.getComponent(2, i - 1, j, k);
         }
 
         // Same for fluid cell in front
         if ((obstacle & OBSTACLE_BACK) == 0) {
-            const FLOAT dz_f = parameters_.meshsize->getDx(i, j, k + 1);
-            const FLOAT dz = parameters_.meshsize->getDx(i, j, k);
-            velocity.getVector(i, j, k)[1] = -dz / dz_f * velocity.getVector(i, j, k + 1)[1];
-            velocity.getVector(i, j, k)[0] = -dz / dz_f * velocity.getVector(i, j, k + 1)[0];
+            const FLOAT dz_f = parameters_.meshMetrics->getDz(k + 1);
+            const FLOAT dz = parameters_.meshMetrics->getDz(k);
+            velocity.getComponent(1, i, j, k) = -dz / dz_f * velocity.getComponent(1, i, j, k + 1);
+            velocity.getComponent(0, i, j, k) = -dz / dz_f * velocity.getComponent(0, i, j, k + 1);
         }
         if ((obstacle & OBSTACLE_FRONT) == 0) {
-            const FLOAT dz_b = parameters_.meshsize->getDx(i, j, k - 1);
-            const FLOAT dz = parameters_.meshsize->getDx(i, j, k);
-            velocity.getVector(i, j, k)[1] = -dz / dz_b * velocity.getVector(i, j, k - 1)[1];
-            velocity.getVector(i, j, k)[0] = -dz / dz_b * velocity.getVector(i, j, k - 1)[0];
+            const FLOAT dz_b = parameters_.meshMetrics->getDz(k - 1);
+            const FLOAT dz = parameters_.meshMetrics->getDz(k);
+            velocity.getComponent(1, i, j, k) = -dz / dz_b * velocity.getComponent(1, i, j, k - 1);
+            velocity.getComponent(0, i, j, k) = -dz / dz_b * velocity.getComponent(0, i, j, k - 1);
         }
 
         // Now the normal velocities need to be set to zero to ensure no flow at interfaces between solid and fluid.
         if ((obstacle & OBSTACLE_RIGHT) == 0) {
-            velocity.getVector(i, j, k)[0] = 0.0;
+            velocity.getComponent(0, i, j, k) = 0.0;
         }
         if ((obstacle & OBSTACLE_TOP) == 0) {
-            velocity.getVector(i, j, k)[1] = 0.0;
+            velocity.getComponent(1, i, j, k) = 0.0;
         }
         if ((obstacle & OBSTACLE_BACK) == 0) {
-            velocity.getVector(i, j, k)[2] = 0.0;
+            velocity.getComponent(2, i, j, k) = 0.0;
         }
     }
 }
 
 } // namespace Stencils
 } // namespace NSEOF
+
+namespace NSEOF {
+template class StaticFieldIterator<FlowField, Stencils::ObstacleStencil>;
+} // namespace NSEOF
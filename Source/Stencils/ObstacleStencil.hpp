@@ -4,13 +4,14 @@
 #include "Stencil.hpp"
 #include "FlowField.hpp"
 #include "Parameters.hpp"
+#include "Iterators.hpp"
 
 namespace NSEOF {
 namespace Stencils {
 
 /** Compute all velocities on obstacle cells
  */
-class ObstacleStencil : public FieldStencil<FlowField> {
+class ObstacleStencil final : public FieldStencil<FlowField> {
 public:
     ObstacleStencil(const Parameters& parameters);
     ~ObstacleStencil() override = default;
@@ -22,4 +23,9 @@ public:
 } // namespace Stencils
 } // namespace NSEOF
 
+namespace NSEOF {
+// Instantiated in ObstacleStencil.cpp, where the stencil body can be inlined into the loops
+extern template class StaticFieldIterator<FlowField, Stencils::ObstacleStencil>;
+} // namespace NSEOF
+
 #endif
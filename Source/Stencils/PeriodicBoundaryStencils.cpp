@@ -7,59 +7,59 @@ PeriodicBoundaryVelocityStencil::PeriodicBoundaryVelocityStencil(const Parameter
     : BoundaryStencil<FlowField>(parameters) {}
 
 void PeriodicBoundaryVelocityStencil::applyLeftWall(FlowField& flowField, [[maybe_unused]] int i, int j) {
-    flowField.getVelocity().getVector(0, j)[0] = flowField.getVelocity().getVector(flowField.getNx(), j)[0];
-    flowField.getVelocity().getVector(1, j)[1] = flowField.getVelocity().getVector(flowField.getNx() + 1, j)[1];
+    flowField.getVelocity().getComponent(0, 0, j) = flowField.getVelocity().getComponent(0, flowField.getNx(), j);
+    flowField.getVelocity().getComponent(1, 1, j) = flowField.getVelocity().getComponent(1, flowField.getNx() + 1, j);
 }
 
 void PeriodicBoundaryVelocityStencil::applyRightWall(FlowField& flowField, [[maybe_unused]] int i, int j) {
-    flowField.getVelocity().getVector(flowField.getNx() + 2, j)[0] = flowField.getVelocity().getVector(2, j)[0];
-    flowField.getVelocity().getVector(flowField.getNx() + 2, j)[1] = flowField.getVelocity().getVector(2, j)[1];
+    flowField.getVelocity().getComponent(0, flowField.getNx() + 2, j) = flowField.getVelocity().getComponent(0, 2, j);
+    flowField.getVelocity().getComponent(1, flowField.getNx() + 2, j) = flowField.getVelocity().getComponent(1, 2, j);
 }
 
 void PeriodicBoundaryVelocityStencil::applyBottomWall(FlowField& flowField, int i, [[maybe_unused]] int j) {
-    flowField.getVelocity().getVector(i, 0)[1] = flowField.getVelocity().getVector(i, flowField.getNy())[1];
-    flowField.getVelocity().getVector(i, 1)[0] = flowField.getVelocity().getVector(i, flowField.getNy() + 1)[0];
+    flowField.getVelocity().getComponent(1, i, 0) = flowField.getVelocity().getComponent(1, i, flowField.getNy());
+    flowField.getVelocity().getComponent(0, i, 1) = flowField.getVelocity().getComponent(0, i, flowField.getNy() + 1);
 }
 
 void PeriodicBoundaryVelocityStencil::applyTopWall(FlowField& flowField, int i, [[maybe_unused]] int j) {
-    flowField.getVelocity().getVector(i, flowField.getNy() + 2)[1] = flowField.getVelocity().getVector(i, 2)[1];
-    flowField.getVelocity().getVector(i, flowField.getNy() + 2)[0] = flowField.getVelocity().getVector(i, 2)[0];
+    flowField.getVelocity().getComponent(1, i, flowField.getNy() + 2) = flowField.getVelocity().getComponent(1, i, 2);
+    flowField.getVelocity().getComponent(0, i, flowField.getNy() + 2) = flowField.getVelocity().getComponent(0, i, 2);
 }
 
 void PeriodicBoundaryVelocityStencil::applyLeftWall(FlowField& flowField, [[maybe_unused]] int i, int j, int k) {
-    flowField.getVelocity().getVector(0, j, k)[0] = flowField.getVelocity().getVector(flowField.getNx(), j, k)[0];
-    flowField.getVelocity().getVector(1, j, k)[1] = flowField.getVelocity().getVector(flowField.getNx() + 1, j, k)[1];
-    flowField.getVelocity().getVector(1, j, k)[2] = flowField.getVelocity().getVector(flowField.getNx() + 1, j, k)[2];
+    flowField.getVelocity().getComponent(0, 0, j, k) = flowField.getVelocity().getComponent(0, flowField.getNx(), j, k);
+    flowField.getVelocity().getComponent(1, 1, j, k) = flowField.getVelocity().getComponent(1, flowField.getNx() + 1, j, k);
+    flowField.getVelocity().getComponent(2, 1, j, k) = flowField.getVelocity().getComponent(2, flowField.getNx() + 1, j, k);
 }
 
 void PeriodicBoundaryVelocityStencil::applyRightWall(FlowField& flowField, [[maybe_unused]] int i, int j, int k) {
-    flowField.getVelocity().getVector(flowField.getNx() + 2, j, k)[0] = flowField.getVelocity().getVector(2, j, k)[0];
-    flowField.getVelocity().getVector(flowField.getNx() + 2, j, k)[1] = flowField.getVelocity().getVector(2, j, k)[1];
-    flowField.getVelocity().getVector(flowField.getNx() + 2, j, k)[2] = flowField.getVelocity().getVector(2, j, k)[2];
+    flowField.getVelocity().getComponent(0, flowField.getNx() + 2, j, k) = flowField.getVelocity().getComponent(0, 2, j, k);
+    flowField.getVelocity().getComponent(1, flowField.getNx() + 2, j, k) = flowField.getVelocity().getComponent(1, 2, j, k);
+    flowField.getVelocity().getComponent(2, flowField.getNx() + 2, j, k) = flowField.getVelocity().getComponent(2, 2, j, k);
 }
 
 void PeriodicBoundaryVelocityStencil::applyBottomWall(FlowField& flowField, int i, [[maybe_unused]] int j, int k) {
-    flowField.getVelocity().getVector(i, 1, k)[0] = flowField.getVelocity().getVector(i, flowField.getNy() + 1, k)[0];
-    flowField.getVelocity().getVector(i, 0, k)[1] = flowField.getVelocity().getVector(i, flowField.getNy(), k)[1];
-    flowField.getVelocity().getVector(i, 1, k)[2] = flowField.getVelocity().getVector(i, flowField.getNy() + 1, k)[2];
+    flowField.getVelocity().getComponent(0, i, 1, k) = flowField.getVelocity().getComponent(0, i, flowField.getNy() + 1, k);
+    flowField.getVelocity().getComponent(1, i, 0, k) = flowField.getVelocity().getComponent(1, i, flowField.getNy(), k);
+    flowField.getVelocity().getComponent(2, i, 1, k) = flowField.getVelocity().getComponent(2, i, flowField.getNy() + 1, k);
 }
 
 void PeriodicBoundaryVelocityStencil::applyTopWall(FlowField& flowField, int i, [[maybe_unused]] int j, int k) {
-    flowField.getVelocity().getVector(i, flowField.getNy() + 2, k)[0] = flowField.getVelocity().getVector(i, 2, k)[0];
-    flowField.getVelocity().getVector(i, flowField.getNy() + 2, k)[1] = flowField.getVelocity().getVector(i, 2, k)[1];
-    flowField.getVelocity().getVector(i, flowField.getNy() + 2, k)[2] = flowField.getVelocity().getVector(i, 2, k)[2];
+    flowField.getVelocity().getComponent(0, i, flowField.getNy() + 2, k) = flowField.getVelocity().getComponent(0, i, 2, k);
+    flowField.getVelocity().getComponent(1, i, flowField.getNy() + 2, k) = flowField.getVelocity().getComponent(1, i, 2, k);
+    flowField.getVelocity().getComponent(2, i, flowField.getNy() + 2, k) = flowField.getVelocity().getComponent(2, i, 2, k);
 }
 
 void PeriodicBoundaryVelocityStencil::applyFrontWall(FlowField& flowField, int i, int j, [[maybe_unused]] int k) {
-    flowField.getVelocity().getVector(i, j, 1)[0] = flowField.getVelocity().getVector(i, j, flowField.getNz() + 1)[0];
-    flowField.getVelocity().getVector(i, j, 1)[1] = flowField.getVelocity().getVector(i, j, flowField.getNz() + 1)[1];
-    flowField.getVelocity().getVector(i, j, 0)[2] = flowField.getVelocity().getVector(i, j, flowField.getNz())[2];
+    flowField.getVelocity().getComponent(0, i, j, 1) = flowField.getVelocity().getComponent(0, i, j, flowField.getNz() + 1);
+    flowField.getVelocity().getComponent(1, i, j, 1) = flowField.getVelocity().getComponent(1, i, j, flowField.getNz() + 1);
+    flowField.getVelocity().getComponent(2, i, j, 0) = flowField.getVelocity().getComponent(2, i, j, flowField.getNz());
 }
 
 void PeriodicBoundaryVelocityStencil::applyBackWall(FlowField& flowField, int i, int j, [[maybe_unused]] int k) {
-    flowField.getVelocity().getVector(i, j, flowField.getNz() + 2)[0] = flowField.getVelocity().getVector(i, j, 2)[0];
-    flowField.getVelocity().getVector(i, j, flowField.getNz() + 2)[1] = flowField.getVelocity().getVector(i, j, 2)[1];
-    flowField.getVelocity().getVector(i, j, flowField.getNz() + 2)[2] = flowField.getVelocity().getVector(i, j, 2)[2];
+    flowField.getVelocity().getComponent(0, i, j, flowField.getNz() + 2) = flowField.getVelocity().getComponent(0, i, j, 2);
+    flowField.getVelocity().getComponent(1, i, j, flowField.getNz() + 2) = flowField.getVelocity().getComponent(1, i, j, 2);
+    flowField.getVelocity().getComponent(2, i, j, flowField.getNz() + 2) = flowField.getVelocity().getComponent(2, i, j, 2);
 }
 
 PeriodicBoundaryFGHStencil::PeriodicBoundaryFGHStencil(const Parameters& parameters)
@@ -10,27 +10,27 @@ namespace NSEOF::Stencils {
      */
 
     void PressureBufferFillStencil::applyLeftWall(FlowField& flowField, int i, int j, int k) {
-        getBufferLeft().push_back(flowField.getPressure().getScalar(i + 1, j, k));
+        setNextInBufferLeft(flowField.getPressure().getScalar(i + 1, j, k));
     }
 
     void PressureBufferFillStencil::applyRightWall(FlowField& flowField, int i, int j, int k) {
-        getBufferRight().push_back(flowField.getPressure().getScalar(i - 1, j, k));
+        setNextInBufferRight(flowField.getPressure().getScalar(i - 1, j, k));
     }
 
     void PressureBufferFillStencil::applyBottomWall(FlowField& flowField, int i, int j, int k) {
-        getBufferBottom().push_back(flowField.getPressure().getScalar(i, j + 1, k));
+        setNextInBufferBottom(flowField.getPressure().getScalar(i, j + 1, k));
     }
 
     void PressureBufferFillStencil::applyTopWall(FlowField& flowField, int i, int j, int k) {
-        getBufferTop().push_back(flowField.getPressure().getScalar(i, j - 1, k));
+        setNextInBufferTop(flowField.getPressure().getScalar(i, j - 1, k));
     }
 
     void PressureBufferFillStencil::applyFrontWall(FlowField& flowField, int i, int j, int k) {
-        getBufferFront().push_back(flowField.getPressure().getScalar(i, j, k + 1));
+        setNextInBufferFront(flowField.getPressure().getScalar(i, j, k + 1));
     }
 
     void PressureBufferFillStencil::applyBackWall(FlowField& flowField, int i, int j, int k) {
-        getBufferBack().push_back(flowField.getPressure().getScalar(i, j, k - 1));
+        setNextInBufferBack(flowField.getPressure().getScalar(i, j, k - 1));
     }
 
     /**
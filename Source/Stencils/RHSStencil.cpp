@@ -7,17 +7,27 @@ RHSStencil::RHSStencil(const Parameters& parameters)
     : FieldStencil<FlowField>(parameters) {}
 
 void RHSStencil::apply(FlowField& flowField, int i, int j) {
+    const MeshMetrics& metrics = *parameters_.meshMetrics;
+    VectorField& FGH = flowField.getFGH();
+
     flowField.getRHS().getScalar(i, j) = 1.0 / parameters_.timestep.dt *
-        ((flowField.getFGH().getVector(i, j)[0] - flowField.getFGH().getVector(i - 1, j)[0]) / parameters_.meshsize->getDx(i, j) +
-         (flowField.getFGH().getVector(i, j)[1] - flowField.getFGH().getVector(i, j - 1)[1]) / parameters_.meshsize->getDy(i, j));
+        ((FGH.getComponent(0, i, j) - FGH.getComponent(0, i - 1, j)) * metrics.getInverseSpacing(0)[i] +
+         (FGH.getComponent(1, i, j) - FGH.getComponent(1, i, j - 1)) * metrics.getInverseSpacing(1)[j]);
 }
 
 void RHSStencil::apply(FlowField& flowField, int i, int j, int k) {
+    const MeshMetrics& metrics = *parameters_.meshMetrics;
+    VectorField& FGH = flowField.getFGH();
+
     flowField.getRHS().getScalar(i, j, k) = 1.0 / parameters_.timestep.dt *
-        ((flowField.getFGH().getVector(i, j, k)[0] - flowField.getFGH().getVector(i - 1, j, k)[0]) / parameters_.meshsize->getDx(i, j, k) +
-         (flowField.getFGH().getVector(i, j, k)[1] - flowField.getFGH().getVector(i, j - 1, k)[1]) / parameters_.meshsize->getDy(i, j, k) +
-         (flowField.getFGH().getVector(i, j, k)[2] - flowField.getFGH().getVector(i, j, k - 1)[2]) / parameters_.meshsize->getDz(i, j, k));
+        ((FGH.getComponent(0, i, j, k) - FGH.getComponent(0, i - 1, j, k)) * metrics.getInverseSpacing(0)[i] +
+         (FGH.getComponent(1, i, j, k) - FGH.getComponent(1, i, j - 1, k)) * metrics.getInverseSpacing(1)[j] +
+         (FGH.getComponent(2, i, j, k) - FGH.getComponent(2, i, j, k - 1)) * metrics.getInverseSpacing(2)[k]);
 }
 
 } // namespace Stencils
 } // namespace NSEOF
+
+namespace NSEOF {
+template class StaticFieldIterator<FlowField, Stencils::RHSStencil>;
+} // namespace NSEOF
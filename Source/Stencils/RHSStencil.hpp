@@ -4,13 +4,14 @@
 #include "Stencil.hpp"
 #include "FlowField.hpp"
 #include "Parameters.hpp"
+#include "Iterators.hpp"
 
 namespace NSEOF {
 namespace Stencils {
 
 /** Field stencil to compute the right hand side of the pressure equation.
  */
-class RHSStencil : public FieldStencil<FlowField> {
+class RHSStencil final : public FieldStencil<FlowField> {
 public:
     RHSStencil(const Parameters& parameters);
     ~RHSStencil() override = default;
@@ -22,4 +23,9 @@ public:
 } // namespace Stencils
 } // namespace NSEOF
 
+namespace NSEOF {
+// Instantiated in RHSStencil.cpp, where the stencil body can be inlined into the loops
+extern template class StaticFieldIterator<FlowField, Stencils::RHSStencil>;
+} // namespace NSEOF
+
 #endif // __STENCILS_RHS_STENCIL_HPP__
@@ -8,51 +8,79 @@
 
 namespace NSEOF::Stencils {
 
+/** Layout of a window of 3 x 3 rows of Columns cells around the cell of interest, holding the
+ *  values lexicographically by layer (k), row (j), column (i) and component.
+ *
+ * The derivative functions below read the values they need relative to a pointer to the first
+ * value of the 3 x 3 x 3 cube around the cell of interest. The per-cell stencils load the Cube
+ * around every cell; row kernels load a wider window once and slide the pointer along it, so
+ * that the values shared by neighbouring cells in x are loaded only once.
+ */
+template <int Columns>
+struct Window {
+    static constexpr int COLUMNS = Columns;
+    static constexpr int ROW = 3 * Columns;
+    static constexpr int LAYER = 3 * ROW;
+    static constexpr int SIZE = 3 * LAYER;
+    static constexpr int CENTER = LAYER + ROW + 3;
+};
+
+using Cube = Window<3>;
+
 // Load the local velocity cube with relevant velocities of the 2D plane
 inline void loadLocalVelocity2D(FlowField& flowField, FLOAT* const localVelocity, int i, int j) {
+    VectorField& velocity = flowField.getVelocity();
+
     for (int row = -1; row <= 1; row++) {
         for (int column = -1; column <= 1; column ++) {
-            const FLOAT* const point = flowField.getVelocity().getVector(i + column, j + row);
-
-            localVelocity[39 + 9 * row + 3 * column]     = point[0]; // x-component
-            localVelocity[39 + 9 * row + 3 * column + 1] = point[1]; // y-component
+            localVelocity[39 + 9 * row + 3 * column]     = velocity.getComponent(0, i + column, j + row); // x-component
+            localVelocity[39 + 9 * row + 3 * column + 1] = velocity.getComponent(1, i + column, j + row); // y-component
         }
     }
 }
 
 // Load the local velocity cube with surrounding velocities
 inline void loadLocalVelocity3D(FlowField& flowField, FLOAT* const localVelocity, int i, int j, int k) {
-    for (int layer = -1; layer <= 1; layer ++) {
-        for (int row = -1; row <= 1; row++) {
-            for (int column = -1; column <= 1; column++) {
-                const FLOAT* const point = flowField.getVelocity().getVector(i + column, j + row, k + layer);
-
-                localVelocity[39 + 27 * layer + 9 * row + 3 * column    ] = point[0]; // x-component
-                localVelocity[39 + 27 * layer + 9 * row + 3 * column + 1] = point[1]; // y-component
-                localVelocity[39 + 27 * layer + 9 * row + 3 * column + 2] = point[2]; // z-component
+    VectorField& velocity = flowField.getVelocity();
+
+    // One component at a time, so that every pass streams through a single array
+    for (int component = 0; component < 3; component++) {
+        for (int layer = -1; layer <= 1; layer ++) {
+            for (int row = -1; row <= 1; row++) {
+                for (int column = -1; column <= 1; column++) {
+                    localVelocity[39 + 27 * layer + 9 * row + 3 * column + component] =
+                        velocity.getComponent(component, i + column, j + row, k + layer);
+                }
             }
         }
     }
 }
 
-// Load local meshsize for 2D -> same as loadLocalVelocity2D, but invoking call to meshsize-ptr
+// Load local meshsize for 2D -> same as loadLocalVelocity2D, but reading the cached mesh metrics
 inline void loadLocalMeshsize2D(const Parameters& parameters, FLOAT* const localMeshsize, int i, int j) {
+    const FLOAT* const dx = parameters.meshMetrics->getSpacing(0);
+    const FLOAT* const dy = parameters.meshMetrics->getSpacing(1);
+
     for (int row = -1; row <= 1; row++) {
         for (int column = -1; column <= 1; column++) {
-            localMeshsize[39 + 9 * row + 3 * column]     = parameters.meshsize->getDx(i + column, j + row);
-            localMeshsize[39 + 9 * row + 3 * column + 1] = parameters.meshsize->getDy(i + column, j + row);
+            localMeshsize[39 + 9 * row + 3 * column]     = dx[i + column];
+            localMeshsize[39 + 9 * row + 3 * column + 1] = dy[j + row];
         }
     }
 }
 
 // Load local meshsize for 3D
 inline void loadLocalMeshsize3D(const Parameters& parameters, FLOAT* const localMeshsize, int i, int j, int k) {
+    const FLOAT* const dx = parameters.meshMetrics->getSpacing(0);
+    const FLOAT* const dy = parameters.meshMetrics->getSpacing(1);
+    const FLOAT* const dz = parameters.meshMetrics->getSpacing(2);
+
     for (int layer = -1; layer <= 1; layer++) {
         for (int row = -1; row <= 1; row++) {
             for (int column = -1; column <= 1; column++) {
-                localMeshsize[39 + 27 * layer + 9 * row + 3 * column    ] = parameters.meshsize->getDx(i + column, j + row, k + layer);
-                localMeshsize[39 + 27 * layer + 9 * row + 3 * column + 1] = parameters.meshsize->getDy(i + column, j + row, k + layer);
-                localMeshsize[39 + 27 * layer + 9 * row + 3 * column + 2] = parameters.meshsize->getDz(i + column, j + row, k + layer);
+                localMeshsize[39 + 27 * layer + 9 * row + 3 * column    ] = dx[i + column];
+                localMeshsize[39 + 27 * layer + 9 * row + 3 * column + 1] = dy[j + row];
+                localMeshsize[39 + 27 * layer + 9 * row + 3 * column + 2] = dz[k + layer];
             }
         }
     }
@@ -89,44 +117,88 @@ inline void loadLocalViscosity3D(const Parameters& parameters, FlowField& flowFi
         }
     }
 }
-// Maps an index and a component to the corresponding value in the cube.
+// Maps an index and a component to the corresponding value in the window, the cube by default.
+template <class W = Cube>
 inline int mapd(int i, int j, int k, int component) {
-    return 39 + 27 * k + 9 * j + 3 * i + component;
+    return W::CENTER + W::LAYER * k + W::ROW * j + 3 * i + component;
+}
+
+// Load the velocities of columns cells, starting at firstI, in the 3 x 3 rows around row j of
+// plane k into a window, for the row kernels.
+template <class W>
+inline void loadWindowVelocity3D(FlowField& flowField, FLOAT* const window, int firstI, int columns, int j, int k) {
+    VectorField& velocity = flowField.getVelocity();
+
+    for (int component = 0; component < 3; component++) {
+        for (int layer = -1; layer <= 1; layer++) {
+            for (int row = -1; row <= 1; row++) {
+                FLOAT* const windowRow = window + W::LAYER * (layer + 1) + W::ROW * (row + 1) + component;
+
+                for (int column = 0; column < columns; column++) {
+                    windowRow[3 * column] = velocity.getComponent(component, firstI + column, j + row, k + layer);
+                }
+            }
+        }
+    }
+}
+
+// Load the meshsizes into a window, see loadWindowVelocity3D
+template <class W>
+inline void loadWindowMeshsize3D(const Parameters& parameters, FLOAT* const window, int firstI, int columns, int j, int k) {
+    const FLOAT* const dx = parameters.meshMetrics->getSpacing(0);
+    const FLOAT* const dy = parameters.meshMetrics->getSpacing(1);
+    const FLOAT* const dz = parameters.meshMetrics->getSpacing(2);
+
+    for (int layer = -1; layer <= 1; layer++) {
+        for (int row = -1; row <= 1; row++) {
+            FLOAT* const windowRow = window + W::LAYER * (layer + 1) + W::ROW * (row + 1);
+
+            for (int column = 0; column < columns; column++) {
+                windowRow[3 * column    ] = dx[firstI + column];
+                windowRow[3 * column + 1] = dy[j + row];
+                windowRow[3 * column + 2] = dz[k + layer];
+            }
+        }
+    }
 }
 
-// Derivative functions. They are applied to a cube of 3x3x3 cells. lv stands for the local velocity, lm represents the local mesh sizes
+// Derivative functions. They are applied to a cube of 3x3x3 cells, or to a wider window (see Window). lv stands for the local velocity, lm represents the local mesh sizes
 // dudx <-> first derivative of u-component of velocity field w.r.t. x-direction.
+template <class W = Cube>
 inline FLOAT dudx(const FLOAT* const lv, const FLOAT* const lm) {
     // Evaluate dudx in the cell center by a central difference
-    const int index0 = mapd(0, 0, 0, 0);
-    const int index1 = mapd(-1, 0, 0, 0);
+    const int index0 = mapd<W>(0, 0, 0, 0);
+    const int index1 = mapd<W>(-1, 0, 0, 0);
 
     return (lv[index0] - lv[index1]) / lm[index0];
 }
 
+template <class W = Cube>
 inline FLOAT dvdy(const FLOAT* const lv, const FLOAT* const lm) {
-    const int index0 = mapd(0, 0, 0, 1);
-    const int index1 = mapd(0, -1, 0, 1);
+    const int index0 = mapd<W>(0, 0, 0, 1);
+    const int index1 = mapd<W>(0, -1, 0, 1);
 
     return (lv[index0] - lv[index1]) / lm[index0];
 }
 
+template <class W = Cube>
 inline FLOAT dwdz(const FLOAT* const lv, const FLOAT* const lm) {
-    const int index0 = mapd(0, 0, 0, 2);
-    const int index1 = mapd(0, 0, -1, 2);
+    const int index0 = mapd<W>(0, 0, 0, 2);
+    const int index1 = mapd<W>(0, 0, -1, 2);
 
     return (lv[index0] - lv[index1]) / lm[index0];
 }
 
 // Second derivative of u-component w.r.t. x-direction, evaluated at the location of the u-component.
+template <class W = Cube>
 inline FLOAT d2udx2(const FLOAT* const lv, const FLOAT* const lm) {
     // Evaluate the second derivative at the location of the u-component of the velocity field;
     // we therefore use the two neighbouring u-components and assume arbitrary mesh sizes in both
     // directions -> the formula arises from a straight-forward taylor expansion
     // -> for equal meshsizes, we obtain the usual [1 -2 1]-like stencil.
-    const int indexM1 = mapd(-1, 0, 0, 0);
-    const int index0 = mapd(0, 0, 0, 0);
-    const int indexP1 = mapd(1, 0, 0, 0);
+    const int indexM1 = mapd<W>(-1, 0, 0, 0);
+    const int index0 = mapd<W>(0, 0, 0, 0);
+    const int indexP1 = mapd<W>(1, 0, 0, 0);
 
     const FLOAT dx0 = lm[index0];
     const FLOAT dx1 = lm[indexP1];
@@ -135,45 +207,49 @@ inline FLOAT d2udx2(const FLOAT* const lv, const FLOAT* const lm) {
     return 2.0 * (lv[indexP1] / (dx1 * dxSum) - lv[index0] / (dx1 * dx0) + lv[indexM1] / (dx0 * dxSum));
 }
 
+template <class W = Cube>
 inline FLOAT d2udy2(const FLOAT* const lv, const FLOAT* const lm) {
     // Average mesh sizes, since the component u is located in the middle of the cell's face.
-    const FLOAT dy_M1 = lm[mapd(0, -1, 0, 1)];
-    const FLOAT dy_0  = lm[mapd(0, 0, 0, 1)];
-    const FLOAT dy_P1 = lm[mapd(0, 1, 0, 1)];
+    const FLOAT dy_M1 = lm[mapd<W>(0, -1, 0, 1)];
+    const FLOAT dy_0  = lm[mapd<W>(0, 0, 0, 1)];
+    const FLOAT dy_P1 = lm[mapd<W>(0, 1, 0, 1)];
     const FLOAT dy0 = 0.5 * (dy_0 + dy_M1);
     const FLOAT dy1 = 0.5 * (dy_0 + dy_P1);
     const FLOAT dySum = dy0 + dy1;
 
-    return 2.0 * (lv[mapd(0, 1, 0, 0)] / (dy1 * dySum) - lv[mapd(0, 0, 0, 0)] / (dy1 * dy0) + lv[mapd(0, -1, 0, 0)] / (dy0 * dySum));
+    return 2.0 * (lv[mapd<W>(0, 1, 0, 0)] / (dy1 * dySum) - lv[mapd<W>(0, 0, 0, 0)] / (dy1 * dy0) + lv[mapd<W>(0, -1, 0, 0)] / (dy0 * dySum));
 }
 
+template <class W = Cube>
 inline FLOAT d2udz2(const FLOAT* const lv, const FLOAT* const lm) {
-    const FLOAT dz_M1 = lm[mapd(0, 0, -1, 2)];
-    const FLOAT dz_0  = lm[mapd(0, 0, 0, 2)];
-    const FLOAT dz_P1 = lm[mapd(0, 0, 1, 2)];
+    const FLOAT dz_M1 = lm[mapd<W>(0, 0, -1, 2)];
+    const FLOAT dz_0  = lm[mapd<W>(0, 0, 0, 2)];
+    const FLOAT dz_P1 = lm[mapd<W>(0, 0, 1, 2)];
     const FLOAT dz0 = 0.5 * (dz_0 + dz_M1);
     const FLOAT dz1 = 0.5 * (dz_0 + dz_P1);
     const FLOAT dzSum = dz0 + dz1;
 
-    return 2.0 * (lv[mapd(0, 0, 1, 0)] / (dz1 * dzSum) - lv[mapd(0,0,0,0)] / (dz1 * dz0) + lv[mapd(0, 0, -1, 0)] / (dz0 * dzSum));
+    return 2.0 * (lv[mapd<W>(0, 0, 1, 0)] / (dz1 * dzSum) - lv[mapd<W>(0,0,0,0)] / (dz1 * dz0) + lv[mapd<W>(0, 0, -1, 0)] / (dz0 * dzSum));
 }
 
 // Second derivative of the v-component, evaluated at the location of the v-component.
+template <class W = Cube>
 inline FLOAT d2vdx2(const FLOAT* const lv, const FLOAT* const lm) {
-    const FLOAT dx_M1 = lm[mapd(-1, 0, 0, 0)];
-    const FLOAT dx_0  = lm[mapd(0, 0, 0, 0)];
-    const FLOAT dx_P1 = lm[mapd(1, 0, 0, 0)];
+    const FLOAT dx_M1 = lm[mapd<W>(-1, 0, 0, 0)];
+    const FLOAT dx_0  = lm[mapd<W>(0, 0, 0, 0)];
+    const FLOAT dx_P1 = lm[mapd<W>(1, 0, 0, 0)];
     const FLOAT dx0 = 0.5 * (dx_0 + dx_M1);
     const FLOAT dx1 = 0.5 * (dx_0 + dx_P1);
     const FLOAT dxSum = dx0 + dx1;
 
-    return 2.0 * (lv[mapd(1, 0, 0, 1)] / (dx1 * dxSum) - lv[mapd(0, 0, 0, 1)] / (dx1 * dx0) + lv[mapd(-1, 0, 0, 1)] / (dx0 * dxSum));
+    return 2.0 * (lv[mapd<W>(1, 0, 0, 1)] / (dx1 * dxSum) - lv[mapd<W>(0, 0, 0, 1)] / (dx1 * dx0) + lv[mapd<W>(-1, 0, 0, 1)] / (dx0 * dxSum));
 }
 
-inline FLOAT d2vdy2 (const FLOAT* const lv, const FLOAT* const lm) {
-    const int indexM1 = mapd(0, -1, 0, 1);
-    const int index0 = mapd(0, 0, 0, 1);
-    const int indexP1 = mapd(0, 1, 0, 1);
+template <class W = Cube>
+inline FLOAT d2vdy2(const FLOAT* const lv, const FLOAT* const lm) {
+    const int indexM1 = mapd<W>(0, -1, 0, 1);
+    const int index0 = mapd<W>(0, 0, 0, 1);
+    const int indexP1 = mapd<W>(0, 1, 0, 1);
 
     const FLOAT dy0 = lm[index0];
     const FLOAT dy1 = lm[indexP1];
@@ -182,44 +258,48 @@ inline FLOAT d2vdy2 (const FLOAT* const lv, const FLOAT* const lm) {
     return 2.0 * (lv[indexP1] / (dy1 * dySum) - lv[index0] / (dy1 * dy0) + lv[indexM1] / (dy0 * dySum));
 }
 
+template <class W = Cube>
 inline FLOAT d2vdz2(const FLOAT* const lv, const FLOAT* const lm) {
-    const FLOAT dz_M1 = lm[mapd(0, 0, -1, 2)];
-    const FLOAT dz_0  = lm[mapd(0, 0, 0, 2)];
-    const FLOAT dz_P1 = lm[mapd(0, 0, 1, 2)];
+    const FLOAT dz_M1 = lm[mapd<W>(0, 0, -1, 2)];
+    const FLOAT dz_0  = lm[mapd<W>(0, 0, 0, 2)];
+    const FLOAT dz_P1 = lm[mapd<W>(0, 0, 1, 2)];
     const FLOAT dz0 = 0.5 * (dz_0 + dz_M1);
     const FLOAT dz1 = 0.5 * (dz_0 + dz_P1);
     const FLOAT dzSum = dz0 + dz1;
 
-    return 2.0 * (lv[mapd(0, 0, 1, 1)] / (dz1 * dzSum) - lv[mapd(0, 0, 0, 1)] / (dz1 * dz0) + lv[mapd(0, 0, -1, 1)] / (dz0 * dzSum));
+    return 2.0 * (lv[mapd<W>(0, 0, 1, 1)] / (dz1 * dzSum) - lv[mapd<W>(0, 0, 0, 1)] / (dz1 * dz0) + lv[mapd<W>(0, 0, -1, 1)] / (dz0 * dzSum));
 }
 
 // Second derivative of the w-component, evaluated at the location of the w-component.
+template <class W = Cube>
 inline FLOAT d2wdx2(const FLOAT* const lv, const FLOAT* const lm) {
-    const FLOAT dx_M1 = lm[mapd(-1, 0, 0, 0)];
-    const FLOAT dx_0 = lm[mapd(0, 0, 0, 0)];
-    const FLOAT dx_P1 = lm[mapd(1, 0, 0, 0)];
+    const FLOAT dx_M1 = lm[mapd<W>(-1, 0, 0, 0)];
+    const FLOAT dx_0 = lm[mapd<W>(0, 0, 0, 0)];
+    const FLOAT dx_P1 = lm[mapd<W>(1, 0, 0, 0)];
     const FLOAT dx0 = 0.5 * (dx_0 + dx_M1);
     const FLOAT dx1 = 0.5 * (dx_0 + dx_P1);
     const FLOAT dxSum = dx0 + dx1;
 
-    return 2.0 * (lv[mapd(1, 0, 0, 2)] / (dx1 * dxSum) - lv[mapd(0, 0, 0, 2)] / (dx1 * dx0) + lv[mapd(-1, 0, 0, 2)] / (dx0 * dxSum));
+    return 2.0 * (lv[mapd<W>(1, 0, 0, 2)] / (dx1 * dxSum) - lv[mapd<W>(0, 0, 0, 2)] / (dx1 * dx0) + lv[mapd<W>(-1, 0, 0, 2)] / (dx0 * dxSum));
 }
 
+template <class W = Cube>
 inline FLOAT d2wdy2(const FLOAT* const lv, const FLOAT* const lm) {
-    const FLOAT dy_M1 = lm[mapd(0, -1, 0, 1)];
-    const FLOAT dy_0 = lm[mapd(0, 0, 0, 1)];
-    const FLOAT dy_P1 = lm[mapd(0, 1, 0, 1)];
+    const FLOAT dy_M1 = lm[mapd<W>(0, -1, 0, 1)];
+    const FLOAT dy_0 = lm[mapd<W>(0, 0, 0, 1)];
+    const FLOAT dy_P1 = lm[mapd<W>(0, 1, 0, 1)];
     const FLOAT dy0 = 0.5 * (dy_0 + dy_M1);
     const FLOAT dy1 = 0.5 * (dy_0 + dy_P1);
     const FLOAT dySum = dy0 + dy1;
 
-    return 2.0 * (lv[mapd(0, 1, 0, 2)] / (dy1 * dySum) - lv[mapd(0, 0, 0, 2)] / (dy1 * dy0) + lv[mapd(0, -1, 0, 2)] / (dy0 * dySum));
+    return 2.0 * (lv[mapd<W>(0, 1, 0, 2)] / (dy1 * dySum) - lv[mapd<W>(0, 0, 0, 2)] / (dy1 * dy0) + lv[mapd<W>(0, -1, 0, 2)] / (dy0 * dySum));
 }
 
+template <class W = Cube>
 inline FLOAT d2wdz2(const FLOAT* const lv, const FLOAT* const lm) {
-    const int index_M1 = mapd(0, 0, -1, 2);
-    const int index_0 = mapd(0, 0, 0, 2);
-    const int index_P1 = mapd(0, 0, 1, 2);
+    const int index_M1 = mapd<W>(0, 0, -1, 2);
+    const int index_0 = mapd<W>(0, 0, 0, 2);
+    const int index_P1 = mapd<W>(0, 0, 1, 2);
 
     const FLOAT dz0 = lm[index_0];
     const FLOAT dz1 = lm[index_P1];
@@ -229,33 +309,34 @@ inline FLOAT d2wdz2(const FLOAT* const lv, const FLOAT* const lm) {
 }
 
 // First derivative of product (u*v), evaluated at the location of the v-component.
+template <class W = Cube>
 inline FLOAT duvdx(const FLOAT* const lv, const Parameters& parameters, const FLOAT* const lm) {
 #ifndef NDEBUG
-    const FLOAT tmp1 = 1.0 / 4.0 * ((((lv[mapd(0, 0, 0, 0)] + lv[mapd(0, 1, 0, 0)]) *
-        (lv[mapd(0, 0, 0, 1)] + lv[mapd(1, 0, 0, 1)])) -
-        ((lv[mapd(-1, 0, 0, 0)] + lv[mapd(-1, 1, 0, 0)]) *
-            (lv[mapd(-1, 0, 0, 1)] + lv[mapd(0, 0, 0, 1)])))
-        + parameters.solver.gamma * ((fabs(lv[mapd(0, 0, 0, 0)] + lv[mapd(0, 1, 0, 0)]) *
-            (lv[mapd(0, 0, 0, 1)] - lv[mapd(1, 0, 0, 1)])) -
-            (fabs(lv[mapd(-1, 0, 0, 0)] + lv[mapd(-1, 1, 0, 0)]) *
-                (lv[mapd(-1, 0, 0, 1)] - lv[mapd(0, 0, 0, 1)])))
-        ) / lm[mapd(0, 0, 0, 0)];
+    const FLOAT tmp1 = 1.0 / 4.0 * ((((lv[mapd<W>(0, 0, 0, 0)] + lv[mapd<W>(0, 1, 0, 0)]) *
+        (lv[mapd<W>(0, 0, 0, 1)] + lv[mapd<W>(1, 0, 0, 1)])) -
+        ((lv[mapd<W>(-1, 0, 0, 0)] + lv[mapd<W>(-1, 1, 0, 0)]) *
+            (lv[mapd<W>(-1, 0, 0, 1)] + lv[mapd<W>(0, 0, 0, 1)])))
+        + parameters.solver.gamma * ((fabs(lv[mapd<W>(0, 0, 0, 0)] + lv[mapd<W>(0, 1, 0, 0)]) *
+            (lv[mapd<W>(0, 0, 0, 1)] - lv[mapd<W>(1, 0, 0, 1)])) -
+            (fabs(lv[mapd<W>(-1, 0, 0, 0)] + lv[mapd<W>(-1, 1, 0, 0)]) *
+                (lv[mapd<W>(-1, 0, 0, 1)] - lv[mapd<W>(0, 0, 0, 1)])))
+        ) / lm[mapd<W>(0, 0, 0, 0)];
 #endif
 
-    const FLOAT hxShort = 0.5 * lm[mapd(0, 0, 0, 0)];                           // Distance of corner points in x-direction from center v-value
-    const FLOAT hxLong0 = 0.5 * (lm[mapd(0, 0, 0, 0)] + lm[mapd(-1, 0, 0, 0)]); // Distance between center and west v-value
-    const FLOAT hxLong1 = 0.5 * (lm[mapd(0, 0, 0, 0)] + lm[mapd(1, 0, 0, 0)]);  // Distance between center and east v-value
-    const FLOAT hyShort = 0.5 * lm[mapd(0, 0, 0, 1)];                           // Distance of center u-value from upper edge of cell
-    const FLOAT hyLong = 0.5 * (lm[mapd(0, 0, 0, 1)] + lm[mapd(0, 1, 0, 1)]);   // Distance of north and center u-value
+    const FLOAT hxShort = 0.5 * lm[mapd<W>(0, 0, 0, 0)];                           // Distance of corner points in x-direction from center v-value
+    const FLOAT hxLong0 = 0.5 * (lm[mapd<W>(0, 0, 0, 0)] + lm[mapd<W>(-1, 0, 0, 0)]); // Distance between center and west v-value
+    const FLOAT hxLong1 = 0.5 * (lm[mapd<W>(0, 0, 0, 0)] + lm[mapd<W>(1, 0, 0, 0)]);  // Distance between center and east v-value
+    const FLOAT hyShort = 0.5 * lm[mapd<W>(0, 0, 0, 1)];                           // Distance of center u-value from upper edge of cell
+    const FLOAT hyLong = 0.5 * (lm[mapd<W>(0, 0, 0, 1)] + lm[mapd<W>(0, 1, 0, 1)]);   // Distance of north and center u-value
 
-    const FLOAT u00 = lv[mapd(0, 0, 0, 0)];
-    const FLOAT u01 = lv[mapd(0, 1, 0, 0)];
-    const FLOAT v00 = lv[mapd(0, 0, 0, 1)];
-    const FLOAT v10 = lv[mapd(1, 0, 0, 1)];
+    const FLOAT u00 = lv[mapd<W>(0, 0, 0, 0)];
+    const FLOAT u01 = lv[mapd<W>(0, 1, 0, 0)];
+    const FLOAT v00 = lv[mapd<W>(0, 0, 0, 1)];
+    const FLOAT v10 = lv[mapd<W>(1, 0, 0, 1)];
 
-    const FLOAT uM10 = lv[mapd(-1, 0, 0, 0)];
-    const FLOAT uM11 = lv[mapd(-1, 1, 0, 0)];
-    const FLOAT vM10 = lv[mapd(-1, 0, 0, 1)];
+    const FLOAT uM10 = lv[mapd<W>(-1, 0, 0, 0)];
+    const FLOAT uM11 = lv[mapd<W>(-1, 1, 0, 0)];
+    const FLOAT vM10 = lv[mapd<W>(-1, 0, 0, 1)];
 
     // This a central difference expression for the first-derivative. We therefore linearly interpolate u*v onto the surface of the
     // current cell (in 2D: upper left and upper right corner) and then take the central difference.
@@ -284,33 +365,34 @@ inline FLOAT duvdx(const FLOAT* const lv, const Parameters& parameters, const FL
 }
 
 // Evaluates first derivative w.r.t. y for u*v at location of u-component. For details on implementation, see duvdx.
+template <class W = Cube>
 inline FLOAT duvdy(const FLOAT* const lv, const Parameters& parameters, const FLOAT* const lm) {
 #ifndef NDEBUG
-    const FLOAT tmp1 = 1.0 / 4.0 * ((((lv[mapd(0, 0, 0, 1)] + lv[mapd(1, 0, 0, 1)]) *
-        (lv[mapd(0, 0, 0, 0)] + lv[mapd(0, 1, 0, 0)])) -
-        ((lv[mapd(0, -1, 0, 1)] + lv[mapd(1, -1, 0, 1)]) *
-            (lv[mapd(0, -1, 0, 0)] + lv[mapd(0, 0, 0, 0)]))) +
-        parameters.solver.gamma * ((fabs(lv[mapd(0, 0, 0, 1)] + lv[mapd(1, 0, 0, 1)]) *
-            (lv[mapd(0, 0, 0, 0)] - lv[mapd(0, 1, 0, 0)])) -
-            (fabs(lv[mapd(0, -1, 0, 1)] + lv[mapd(1, -1, 0, 1)]) *
-                (lv[mapd(0, -1, 0, 0)] - lv[mapd(0, 0, 0, 0)])))) /
-        lm[mapd(0, 0, 0, 1)];
+    const FLOAT tmp1 = 1.0 / 4.0 * ((((lv[mapd<W>(0, 0, 0, 1)] + lv[mapd<W>(1, 0, 0, 1)]) *
+        (lv[mapd<W>(0, 0, 0, 0)] + lv[mapd<W>(0, 1, 0, 0)])) -
+        ((lv[mapd<W>(0, -1, 0, 1)] + lv[mapd<W>(1, -1, 0, 1)]) *
+            (lv[mapd<W>(0, -1, 0, 0)] + lv[mapd<W>(0, 0, 0, 0)]))) +
+        parameters.solver.gamma * ((fabs(lv[mapd<W>(0, 0, 0, 1)] + lv[mapd<W>(1, 0, 0, 1)]) *
+            (lv[mapd<W>(0, 0, 0, 0)] - lv[mapd<W>(0, 1, 0, 0)])) -
+            (fabs(lv[mapd<W>(0, -1, 0, 1)] + lv[mapd<W>(1, -1, 0, 1)]) *
+                (lv[mapd<W>(0, -1, 0, 0)] - lv[mapd<W>(0, 0, 0, 0)])))) /
+        lm[mapd<W>(0, 0, 0, 1)];
 #endif
 
-    const FLOAT hyShort = 0.5 * lm[mapd(0, 0, 0, 1)];                           // Distance of corner points in x-direction from center v-value
-    const FLOAT hyLong0 = 0.5 * (lm[mapd(0, 0, 0, 1)] + lm[mapd(0, -1, 0, 1)]); // Distance between center and west v-value
-    const FLOAT hyLong1 = 0.5 * (lm[mapd(0, 0, 0, 1)] + lm[mapd(0, 1, 0, 1)]);  // Distance between center and east v-value
-    const FLOAT hxShort = 0.5 * lm[mapd(0, 0, 0, 0)];                           // Distance of center u-value from upper edge of cell
-    const FLOAT hxLong = 0.5 * (lm[mapd(0, 0, 0, 0)] + lm[mapd(1, 0, 0, 0)]);   // Distance of north and center u-value
+    const FLOAT hyShort = 0.5 * lm[mapd<W>(0, 0, 0, 1)];                           // Distance of corner points in x-direction from center v-value
+    const FLOAT hyLong0 = 0.5 * (lm[mapd<W>(0, 0, 0, 1)] + lm[mapd<W>(0, -1, 0, 1)]); // Distance between center and west v-value
+    const FLOAT hyLong1 = 0.5 * (lm[mapd<W>(0, 0, 0, 1)] + lm[mapd<W>(0, 1, 0, 1)]);  // Distance between center and east v-value
+    const FLOAT hxShort = 0.5 * lm[mapd<W>(0, 0, 0, 0)];                           // Distance of center u-value from upper edge of cell
+    const FLOAT hxLong = 0.5 * (lm[mapd<W>(0, 0, 0, 0)] + lm[mapd<W>(1, 0, 0, 0)]);   // Distance of north and center u-value
 
-    const FLOAT v00 = lv[mapd(0, 0, 0, 1)];
-    const FLOAT v10 = lv[mapd(1, 0, 0, 1)];
-    const FLOAT u00 = lv[mapd(0, 0, 0, 0)];
-    const FLOAT u01 = lv[mapd(0, 1, 0, 0)];
+    const FLOAT v00 = lv[mapd<W>(0, 0, 0, 1)];
+    const FLOAT v10 = lv[mapd<W>(1, 0, 0, 1)];
+    const FLOAT u00 = lv[mapd<W>(0, 0, 0, 0)];
+    const FLOAT u01 = lv[mapd<W>(0, 1, 0, 0)];
 
-    const FLOAT v0M1 = lv[mapd(0, -1, 0, 1)];
-    const FLOAT v1M1 = lv[mapd(1, -1, 0, 1)];
-    const FLOAT u0M1 = lv[mapd(0, -1, 0, 0)];
+    const FLOAT v0M1 = lv[mapd<W>(0, -1, 0, 1)];
+    const FLOAT v1M1 = lv[mapd<W>(1, -1, 0, 1)];
+    const FLOAT u0M1 = lv[mapd<W>(0, -1, 0, 0)];
 
     const FLOAT secondOrder = (((hxLong - hxShort) / hxLong * v00 + hxShort / hxLong * v10) * ((hyLong1 - hyShort) / hyLong1 * u00 + hyShort / hyLong1 * u01)
         - ((hxLong - hxShort) / hxLong * v0M1 + hxShort / hxLong * v1M1) * ((hyLong0 - hyShort) / hyLong0 * u00 + hyShort / hyLong0 * u0M1)) / (2.0 * hyShort);
@@ -333,33 +415,34 @@ inline FLOAT duvdy(const FLOAT* const lv, const Parameters& parameters, const FL
 }
 
 // Evaluates first derivative w.r.t. x for u*w at location of w-component. For details on implementation, see duvdx.
+template <class W = Cube>
 inline FLOAT duwdx(const FLOAT* const lv, const Parameters& parameters, const FLOAT* const lm) {
 #ifndef NDEBUG
-    const FLOAT tmp1 = 1.0 / 4.0 * ((((lv[mapd(0, 0, 0, 0)] + lv[mapd(0, 0, 1, 0)]) *
-        (lv[mapd(0, 0, 0, 2)] + lv[mapd(1, 0, 0, 2)])) -
-        ((lv[mapd(-1, 0, 0, 0)] + lv[mapd(-1, 0, 1, 0)]) *
-            (lv[mapd(-1, 0, 0, 2)] + lv[mapd(0, 0, 0, 2)]))) +
-        parameters.solver.gamma * ((fabs(lv[mapd(0, 0, 0, 0)] + lv[mapd(0, 0, 1, 0)]) *
-            (lv[mapd(0, 0, 0, 2)] - lv[mapd(1, 0, 0, 2)])) -
-            (fabs(lv[mapd(-1, 0, 0, 0)] + lv[mapd(-1, 0, 1, 0)]) *
-                (lv[mapd(-1, 0, 0, 2)] - lv[mapd(0, 0, 0, 2)])))) /
-        lm[mapd(0, 0, 0, 0)];
+    const FLOAT tmp1 = 1.0 / 4.0 * ((((lv[mapd<W>(0, 0, 0, 0)] + lv[mapd<W>(0, 0, 1, 0)]) *
+        (lv[mapd<W>(0, 0, 0, 2)] + lv[mapd<W>(1, 0, 0, 2)])) -
+        ((lv[mapd<W>(-1, 0, 0, 0)] + lv[mapd<W>(-1, 0, 1, 0)]) *
+            (lv[mapd<W>(-1, 0, 0, 2)] + lv[mapd<W>(0, 0, 0, 2)]))) +
+        parameters.solver.gamma * ((fabs(lv[mapd<W>(0, 0, 0, 0)] + lv[mapd<W>(0, 0, 1, 0)]) *
+            (lv[mapd<W>(0, 0, 0, 2)] - lv[mapd<W>(1, 0, 0, 2)])) -
+            (fabs(lv[mapd<W>(-1, 0, 0, 0)] + lv[mapd<W>(-1, 0, 1, 0)]) *
+                (lv[mapd<W>(-1, 0, 0, 2)] - lv[mapd<W>(0, 0, 0, 2)])))) /
+        lm[mapd<W>(0, 0, 0, 0)];
 #endif
 
-    const FLOAT hxShort = 0.5 * lm[mapd(0, 0, 0, 0)];                           // Distance of corner points in x-direction from center v-value
-    const FLOAT hxLong0 = 0.5 * (lm[mapd(0, 0, 0, 0)] + lm[mapd(-1, 0, 0, 0)]); // Distance between center and west v-value
-    const FLOAT hxLong1 = 0.5 * (lm[mapd(0, 0, 0, 0)] + lm[mapd(1, 0, 0, 0)]);  // Distance between center and east v-value
-    const FLOAT hzShort = 0.5 * lm[mapd(0, 0, 0, 2)];                           // Distance of center u-value from upper edge of cell
-    const FLOAT hzLong = 0.5 * (lm[mapd(0, 0, 0, 2)] + lm[mapd(0, 0, 1, 2)]);   // Distance of north and center u-value
+    const FLOAT hxShort = 0.5 * lm[mapd<W>(0, 0, 0, 0)];                           // Distance of corner points in x-direction from center v-value
+    const FLOAT hxLong0 = 0.5 * (lm[mapd<W>(0, 0, 0, 0)] + lm[mapd<W>(-1, 0, 0, 0)]); // Distance between center and west v-value
+    const FLOAT hxLong1 = 0.5 * (lm[mapd<W>(0, 0, 0, 0)] + lm[mapd<W>(1, 0, 0, 0)]);  // Distance between center and east v-value
+    const FLOAT hzShort = 0.5 * lm[mapd<W>(0, 0, 0, 2)];                           // Distance of center u-value from upper edge of cell
+    const FLOAT hzLong = 0.5 * (lm[mapd<W>(0, 0, 0, 2)] + lm[mapd<W>(0, 0, 1, 2)]);   // Distance of north and center u-value
 
-    const FLOAT u00 = lv[mapd(0, 0, 0, 0)];
-    const FLOAT u01 = lv[mapd(0, 0, 1, 0)];
-    const FLOAT w00 = lv[mapd(0, 0, 0, 2)];
-    const FLOAT w10 = lv[mapd(1, 0, 0, 2)];
+    const FLOAT u00 = lv[mapd<W>(0, 0, 0, 0)];
+    const FLOAT u01 = lv[mapd<W>(0, 0, 1, 0)];
+    const FLOAT w00 = lv[mapd<W>(0, 0, 0, 2)];
+    const FLOAT w10 = lv[mapd<W>(1, 0, 0, 2)];
 
-    const FLOAT uM10 = lv[mapd(-1, 0, 0, 0)];
-    const FLOAT uM11 = lv[mapd(-1, 0, 1, 0)];
-    const FLOAT wM10 = lv[mapd(-1, 0, 0, 2)];
+    const FLOAT uM10 = lv[mapd<W>(-1, 0, 0, 0)];
+    const FLOAT uM11 = lv[mapd<W>(-1, 0, 1, 0)];
+    const FLOAT wM10 = lv[mapd<W>(-1, 0, 0, 2)];
 
     const FLOAT secondOrder = (((hzLong - hzShort) / hzLong * u00 + hzShort / hzLong * u01) * ((hxLong1 - hxShort) / hxLong1 * w00 + hxShort / hxLong1 * w10)
         - ((hzLong - hzShort) / hzLong * uM10 + hzShort / hzLong * uM11) * ((hxLong0 - hxShort) / hxLong0 * w00 + hxShort / hxLong0 * wM10)) / (2.0 * hxShort);
@@ -382,33 +465,34 @@ inline FLOAT duwdx(const FLOAT* const lv, const Parameters& parameters, const FL
 }
 
 // Evaluates first derivative w.r.t. z for u*w at location of u-component. For details on implementation, see duvdx.
+template <class W = Cube>
 inline FLOAT duwdz(const FLOAT* const lv, const Parameters& parameters, const FLOAT* const lm) {
 #ifndef NDEBUG
-    const FLOAT tmp1 = 1.0 / 4.0 * ((((lv[mapd(0, 0, 0, 2)] + lv[mapd(1, 0, 0, 2)]) *
-        (lv[mapd(0, 0, 0, 0)] + lv[mapd(0, 0, 1, 0)])) -
-        ((lv[mapd(0, 0, -1, 2)] + lv[mapd(1, 0, -1, 2)]) *
-            (lv[mapd(0, 0, -1, 0)] + lv[mapd(0, 0, 0, 0)]))) +
-        parameters.solver.gamma * ((fabs(lv[mapd(0, 0, 0, 2)] + lv[mapd(1, 0, 0, 2)]) *
-            (lv[mapd(0, 0, 0, 0)] - lv[mapd(0, 0, 1, 0)])) -
-            (fabs(lv[mapd(0, 0, -1, 2)] + lv[mapd(1, 0, -1, 2)]) *
-                (lv[mapd(0, 0, -1, 0)] - lv[mapd(0, 0, 0, 0)])))) /
-        lm[mapd(0, 0, 0, 2)];
+    const FLOAT tmp1 = 1.0 / 4.0 * ((((lv[mapd<W>(0, 0, 0, 2)] + lv[mapd<W>(1, 0, 0, 2)]) *
+        (lv[mapd<W>(0, 0, 0, 0)] + lv[mapd<W>(0, 0, 1, 0)])) -
+        ((lv[mapd<W>(0, 0, -1, 2)] + lv[mapd<W>(1, 0, -1, 2)]) *
+            (lv[mapd<W>(0, 0, -1, 0)] + lv[mapd<W>(0, 0, 0, 0)]))) +
+        parameters.solver.gamma * ((fabs(lv[mapd<W>(0, 0, 0, 2)] + lv[mapd<W>(1, 0, 0, 2)]) *
+            (lv[mapd<W>(0, 0, 0, 0)] - lv[mapd<W>(0, 0, 1, 0)])) -
+            (fabs(lv[mapd<W>(0, 0, -1, 2)] + lv[mapd<W>(1, 0, -1, 2)]) *
+                (lv[mapd<W>(0, 0, -1, 0)] - lv[mapd<W>(0, 0, 0, 0)])))) /
+        lm[mapd<W>(0, 0, 0, 2)];
 #endif
 
-    const FLOAT hzShort = 0.5 * lm[mapd(0, 0, 0, 2)];                           // Distance of corner points in x-direction from center v-value
-    const FLOAT hzLong0 = 0.5 * (lm[mapd(0, 0, 0, 2)] + lm[mapd(0, 0, -1, 2)]); // Distance between center and west v-value
-    const FLOAT hzLong1 = 0.5 * (lm[mapd(0, 0, 0, 2)] + lm[mapd(0, 0, 1, 2)]);  // Distance between center and east v-value
-    const FLOAT hxShort = 0.5 * lm[mapd(0, 0, 0, 0)];                           // Distance of center u-value from upper edge of cell
-    const FLOAT hxLong = 0.5 * (lm[mapd(0, 0, 0, 0)] + lm[mapd(1, 0, 0, 0)]);   // Distance of north and center u-value
+    const FLOAT hzShort = 0.5 * lm[mapd<W>(0, 0, 0, 2)];                           // Distance of corner points in x-direction from center v-value
+    const FLOAT hzLong0 = 0.5 * (lm[mapd<W>(0, 0, 0, 2)] + lm[mapd<W>(0, 0, -1, 2)]); // Distance between center and west v-value
+    const FLOAT hzLong1 = 0.5 * (lm[mapd<W>(0, 0, 0, 2)] + lm[mapd<W>(0, 0, 1, 2)]);  // Distance between center and east v-value
+    const FLOAT hxShort = 0.5 * lm[mapd<W>(0, 0, 0, 0)];                           // Distance of center u-value from upper edge of cell
+    const FLOAT hxLong = 0.5 * (lm[mapd<W>(0, 0, 0, 0)] + lm[mapd<W>(1, 0, 0, 0)]);   // Distance of north and center u-value
 
-    const FLOAT w00 = lv[mapd(0, 0, 0, 2)];
-    const FLOAT w10 = lv[mapd(1, 0, 0, 2)];
-    const FLOAT u00 = lv[mapd(0, 0, 0, 0)];
-    const FLOAT u01 = lv[mapd(0, 0, 1, 0)];
+    const FLOAT w00 = lv[mapd<W>(0, 0, 0, 2)];
+    const FLOAT w10 = lv[mapd<W>(1, 0, 0, 2)];
+    const FLOAT u00 = lv[mapd<W>(0, 0, 0, 0)];
+    const FLOAT u01 = lv[mapd<W>(0, 0, 1, 0)];
 
-    const FLOAT w0M1 = lv[mapd(0, 0, -1, 2)];
-    const FLOAT w1M1 = lv[mapd(1, 0, -1, 2)];
-    const FLOAT u0M1 = lv[mapd(0, 0, -1, 0)];
+    const FLOAT w0M1 = lv[mapd<W>(0, 0, -1, 2)];
+    const FLOAT w1M1 = lv[mapd<W>(1, 0, -1, 2)];
+    const FLOAT u0M1 = lv[mapd<W>(0, 0, -1, 0)];
 
     const FLOAT secondOrder = (((hxLong - hxShort) / hxLong * w00 + hxShort / hxLong * w10) * ((hzLong1 - hzShort) / hzLong1 * u00 + hzShort / hzLong1 * u01)
         - ((hxLong - hxShort) / hxLong * w0M1 + hxShort / hxLong * w1M1) * ((hzLong0 - hzShort) / hzLong0 * u00 + hzShort / hzLong0 * u0M1)) / (2.0 * hzShort);
@@ -431,33 +515,34 @@ inline FLOAT duwdz(const FLOAT* const lv, const Parameters& parameters, const FL
 }
 
 // Evaluates first derivative w.r.t. y for v*w at location of w-component. For details on implementation, see duvdx.
+template <class W = Cube>
 inline FLOAT dvwdy(const FLOAT* const lv, const Parameters& parameters, const FLOAT* const lm) {
 #ifndef NDEBUG
-    const FLOAT tmp1 = 1.0 / 4.0 * ((((lv[mapd(0, 0, 0, 1)] + lv[mapd(0, 0, 1, 1)]) *
-        (lv[mapd(0, 0, 0, 2)] + lv[mapd(0, 1, 0, 2)])) -
-        ((lv[mapd(0, -1, 0, 1)] + lv[mapd(0, -1, 1, 1)]) *
-            (lv[mapd(0, -1, 0, 2)] + lv[mapd(0, 0, 0, 2)]))) +
-        parameters.solver.gamma * ((fabs(lv[mapd(0, 0, 0, 1)] + lv[mapd(0, 0, 1, 1)]) *
-            (lv[mapd(0, 0, 0, 2)] - lv[mapd(0, 1, 0, 2)])) -
-            (fabs(lv[mapd(0, -1, 0, 1)] + lv[mapd(0, -1, 1, 1)]) *
-                (lv[mapd(0, -1, 0, 2)] - lv[mapd(0, 0, 0, 2)])))) /
-        lm[mapd(0, 0, 0, 1)];
+    const FLOAT tmp1 = 1.0 / 4.0 * ((((lv[mapd<W>(0, 0, 0, 1)] + lv[mapd<W>(0, 0, 1, 1)]) *
+        (lv[mapd<W>(0, 0, 0, 2)] + lv[mapd<W>(0, 1, 0, 2)])) -
+        ((lv[mapd<W>(0, -1, 0, 1)] + lv[mapd<W>(0, -1, 1, 1)]) *
+            (lv[mapd<W>(0, -1, 0, 2)] + lv[mapd<W>(0, 0, 0, 2)]))) +
+        parameters.solver.gamma * ((fabs(lv[mapd<W>(0, 0, 0, 1)] + lv[mapd<W>(0, 0, 1, 1)]) *
+            (lv[mapd<W>(0, 0, 0, 2)] - lv[mapd<W>(0, 1, 0, 2)])) -
+            (fabs(lv[mapd<W>(0, -1, 0, 1)] + lv[mapd<W>(0, -1, 1, 1)]) *
+                (lv[mapd<W>(0, -1, 0, 2)] - lv[mapd<W>(0, 0, 0, 2)])))) /
+        lm[mapd<W>(0, 0, 0, 1)];
 #endif
 
-    const FLOAT hyShort = 0.5 * lm[mapd(0, 0, 0, 1)];                           // Distance of corner points in x-direction from center v-value
-    const FLOAT hyLong0 = 0.5 * (lm[mapd(0, 0, 0, 1)] + lm[mapd(0, -1, 0, 1)]); // Distance between center and west v-value
-    const FLOAT hyLong1 = 0.5 * (lm[mapd(0, 0, 0, 1)] + lm[mapd(0, 1, 0, 1)]);  // Distance between center and east v-value
-    const FLOAT hzShort = 0.5 * lm[mapd(0, 0, 0, 2)];                           // Distance of center u-value from upper edge of cell
-    const FLOAT hzLong = 0.5 * (lm[mapd(0, 0, 0, 2)] + lm[mapd(0, 0, 1, 2)]);   // Distance of north and center u-value
+    const FLOAT hyShort = 0.5 * lm[mapd<W>(0, 0, 0, 1)];                           // Distance of corner points in x-direction from center v-value
+    const FLOAT hyLong0 = 0.5 * (lm[mapd<W>(0, 0, 0, 1)] + lm[mapd<W>(0, -1, 0, 1)]); // Distance between center and west v-value
+    const FLOAT hyLong1 = 0.5 * (lm[mapd<W>(0, 0, 0, 1)] + lm[mapd<W>(0, 1, 0, 1)]);  // Distance between center and east v-value
+    const FLOAT hzShort = 0.5 * lm[mapd<W>(0, 0, 0, 2)];                           // Distance of center u-value from upper edge of cell
+    const FLOAT hzLong = 0.5 * (lm[mapd<W>(0, 0, 0, 2)] + lm[mapd<W>(0, 0, 1, 2)]);   // Distance of north and center u-value
 
-    const FLOAT v00 = lv[mapd(0, 0, 0, 1)];
-    const FLOAT v01 = lv[mapd(0, 0, 1, 1)];
-    const FLOAT w00 = lv[mapd(0, 0, 0, 2)];
-    const FLOAT w10 = lv[mapd(0, 1, 0, 2)];
+    const FLOAT v00 = lv[mapd<W>(0, 0, 0, 1)];
+    const FLOAT v01 = lv[mapd<W>(0, 0, 1, 1)];
+    const FLOAT w00 = lv[mapd<W>(0, 0, 0, 2)];
+    const FLOAT w10 = lv[mapd<W>(0, 1, 0, 2)];
 
-    const FLOAT vM10 = lv[mapd(0, -1, 0, 1)];
-    const FLOAT vM11 = lv[mapd(0, -1, 1, 1)];
-    const FLOAT wM10 = lv[mapd(0, -1, 0, 2)];
+    const FLOAT vM10 = lv[mapd<W>(0, -1, 0, 1)];
+    const FLOAT vM11 = lv[mapd<W>(0, -1, 1, 1)];
+    const FLOAT wM10 = lv[mapd<W>(0, -1, 0, 2)];
 
     const FLOAT secondOrder = (((hzLong - hzShort) / hzLong * v00 + hzShort / hzLong * v01) * ((hyLong1 - hyShort) / hyLong1 * w00 + hyShort / hyLong1 * w10)
         - ((hzLong - hzShort) / hzLong * vM10 + hzShort / hzLong * vM11) * ((hyLong0 - hyShort) / hyLong0 * w00 + hyShort / hyLong0 * wM10)) / (2.0 * hyShort);
@@ -480,33 +565,34 @@ inline FLOAT dvwdy(const FLOAT* const lv, const Parameters& parameters, const FL
 }
 
 // Evaluates first derivative w.r.t. z for v*w at location of v-component. For details on implementation, see duvdx.
+template <class W = Cube>
 inline FLOAT dvwdz(const FLOAT* const lv, const Parameters& parameters, const FLOAT* const lm) {
 #ifndef NDEBUG
-    const FLOAT tmp1 = 1.0 / 4.0 * ((((lv[mapd(0, 0, 0, 2)] + lv[mapd(0, 1, 0, 2)]) *
-        (lv[mapd(0, 0, 0, 1)] + lv[mapd(0, 0, 1, 1)])) -
-        ((lv[mapd(0, 0, -1, 2)] + lv[mapd(0, 1, -1, 2)]) *
-            (lv[mapd(0, 0, -1, 1)] + lv[mapd(0, 0, 0, 1)]))) +
-        parameters.solver.gamma * ((fabs(lv[mapd(0, 0, 0, 2)] + lv[mapd(0, 1, 0, 2)]) *
-            (lv[mapd(0, 0, 0, 1)] - lv[mapd(0, 0, 1, 1)])) -
-            (fabs(lv[mapd(0, 0, -1, 2)] + lv[mapd(0, 1, -1, 2)]) *
-                (lv[mapd(0, 0, -1, 1)] - lv[mapd(0, 0, 0, 1)])))) /
-        lm[mapd(0, 0, 0, 2)];
+    const FLOAT tmp1 = 1.0 / 4.0 * ((((lv[mapd<W>(0, 0, 0, 2)] + lv[mapd<W>(0, 1, 0, 2)]) *
+        (lv[mapd<W>(0, 0, 0, 1)] + lv[mapd<W>(0, 0, 1, 1)])) -
+        ((lv[mapd<W>(0, 0, -1, 2)] + lv[mapd<W>(0, 1, -1, 2)]) *
+            (lv[mapd<W>(0, 0, -1, 1)] + lv[mapd<W>(0, 0, 0, 1)]))) +
+        parameters.solver.gamma * ((fabs(lv[mapd<W>(0, 0, 0, 2)] + lv[mapd<W>(0, 1, 0, 2)]) *
+            (lv[mapd<W>(0, 0, 0, 1)] - lv[mapd<W>(0, 0, 1, 1)])) -
+            (fabs(lv[mapd<W>(0, 0, -1, 2)] + lv[mapd<W>(0, 1, -1, 2)]) *
+                (lv[mapd<W>(0, 0, -1, 1)] - lv[mapd<W>(0, 0, 0, 1)])))) /
+        lm[mapd<W>(0, 0, 0, 2)];
 #endif
 
-    const FLOAT hzShort = 0.5 * lm[mapd(0, 0, 0, 2)];                           // Distance of corner points in x-direction from center v-value
-    const FLOAT hzLong0 = 0.5 * (lm[mapd(0, 0, 0, 2)] + lm[mapd(0, 0, -1, 2)]); // Distance between center and west v-value
-    const FLOAT hzLong1 = 0.5 * (lm[mapd(0, 0, 0, 2)] + lm[mapd(0, 0, 1, 2)]);  // Distance between center and east v-value
-    const FLOAT hyShort = 0.5 * lm[mapd(0, 0, 0, 1)];                           // Distance of center u-value from upper edge of cell
-    const FLOAT hyLong = 0.5 * (lm[mapd(0, 0, 0, 1)] + lm[mapd(0, 1, 0, 1)]);   // Distance of north and center u-value
+    const FLOAT hzShort = 0.5 * lm[mapd<W>(0, 0, 0, 2)];                           // Distance of corner points in x-direction from center v-value
+    const FLOAT hzLong0 = 0.5 * (lm[mapd<W>(0, 0, 0, 2)] + lm[mapd<W>(0, 0, -1, 2)]); // Distance between center and west v-value
+    const FLOAT hzLong1 = 0.5 * (lm[mapd<W>(0, 0, 0, 2)] + lm[mapd<W>(0, 0, 1, 2)]);  // Distance between center and east v-value
+    const FLOAT hyShort = 0.5 * lm[mapd<W>(0, 0, 0, 1)];                           // Distance of center u-value from upper edge of cell
+    const FLOAT hyLong = 0.5 * (lm[mapd<W>(0, 0, 0, 1)] + lm[mapd<W>(0, 1, 0, 1)]);   // Distance of north and center u-value
 
-    const FLOAT w00 = lv[mapd(0, 0, 0, 2)];
-    const FLOAT w10 = lv[mapd(0, 1, 0, 2)];
-    const FLOAT v00 = lv[mapd(0, 0, 0, 1)];
-    const FLOAT v01 = lv[mapd(0, 0, 1, 1)];
+    const FLOAT w00 = lv[mapd<W>(0, 0, 0, 2)];
+    const FLOAT w10 = lv[mapd<W>(0, 1, 0, 2)];
+    const FLOAT v00 = lv[mapd<W>(0, 0, 0, 1)];
+    const FLOAT v01 = lv[mapd<W>(0, 0, 1, 1)];
 
-    const FLOAT w0M1 = lv[mapd(0, 0, -1, 2)];
-    const FLOAT w1M1 = lv[mapd(0, 1, -1, 2)];
-    const FLOAT v0M1 = lv[mapd(0, 0, -1, 1)];
+    const FLOAT w0M1 = lv[mapd<W>(0, 0, -1, 2)];
+    const FLOAT w1M1 = lv[mapd<W>(0, 1, -1, 2)];
+    const FLOAT v0M1 = lv[mapd<W>(0, 0, -1, 1)];
 
     const FLOAT secondOrder = (((hyLong - hyShort) / hyLong * w00 + hyShort / hyLong * w10) * ((hzLong1 - hzShort) / hzLong1 * v00 + hzShort / hzLong1 * v01)
         - ((hyLong - hyShort) / hyLong * w0M1 + hyShort / hyLong * w1M1) * ((hzLong0 - hzShort) / hzLong0 * v00 + hzShort / hzLong0 * v0M1)) / (2.0 * hzShort);
@@ -530,26 +616,27 @@ inline FLOAT dvwdz(const FLOAT* const lv, const Parameters& parameters, const FL
 }
 
 // First derivative of u*u w.r.t. x, evaluated at location of u-component.
+template <class W = Cube>
 inline FLOAT du2dx(const FLOAT* const lv, const Parameters& parameters, const FLOAT* const lm) {
 #ifndef NDEBUG
-    const FLOAT tmp1 = 1.0 / 4.0 * ((((lv[mapd(0, 0, 0, 0)] + lv[mapd(1, 0, 0, 0)]) *
-        (lv[mapd(0, 0, 0, 0)] + lv[mapd(1, 0, 0, 0)])) -
-        ((lv[mapd(-1, 0, 0, 0)] + lv[mapd(0, 0, 0, 0)]) *
-            (lv[mapd(-1, 0, 0, 0)] + lv[mapd(0, 0, 0, 0)]))) +
-        parameters.solver.gamma * ((fabs(lv[mapd(0, 0, 0, 0)] + lv[mapd(1, 0, 0, 0)]) *
-            (lv[mapd(0, 0, 0, 0)] - lv[mapd(1, 0, 0, 0)])) -
-            (fabs(lv[mapd(-1, 0, 0, 0)] + lv[mapd(0, 0, 0, 0)]) *
-                (lv[mapd(-1, 0, 0, 0)] - lv[mapd(0, 0, 0, 0)])))) /
-        lm[mapd(0, 0, 0, 0)];
+    const FLOAT tmp1 = 1.0 / 4.0 * ((((lv[mapd<W>(0, 0, 0, 0)] + lv[mapd<W>(1, 0, 0, 0)]) *
+        (lv[mapd<W>(0, 0, 0, 0)] + lv[mapd<W>(1, 0, 0, 0)])) -
+        ((lv[mapd<W>(-1, 0, 0, 0)] + lv[mapd<W>(0, 0, 0, 0)]) *
+            (lv[mapd<W>(-1, 0, 0, 0)] + lv[mapd<W>(0, 0, 0, 0)]))) +
+        parameters.solver.gamma * ((fabs(lv[mapd<W>(0, 0, 0, 0)] + lv[mapd<W>(1, 0, 0, 0)]) *
+            (lv[mapd<W>(0, 0, 0, 0)] - lv[mapd<W>(1, 0, 0, 0)])) -
+            (fabs(lv[mapd<W>(-1, 0, 0, 0)] + lv[mapd<W>(0, 0, 0, 0)]) *
+                (lv[mapd<W>(-1, 0, 0, 0)] - lv[mapd<W>(0, 0, 0, 0)])))) /
+        lm[mapd<W>(0, 0, 0, 0)];
 #endif
 
-    const FLOAT dxShort = 0.5 * lm[mapd(0, 0, 0, 0)];
-    // const FLOAT dxLong0 = 0.5*(lm[mapd(-1,0,0,0)] + lm[mapd(0,0,0,0)]);
-    const FLOAT dxLong1 = 0.5 * (lm[mapd(0, 0, 0, 0)] + lm[mapd(1, 0, 0, 0)]);
+    const FLOAT dxShort = 0.5 * lm[mapd<W>(0, 0, 0, 0)];
+    // const FLOAT dxLong0 = 0.5*(lm[mapd<W>(-1,0,0,0)] + lm[mapd<W>(0,0,0,0)]);
+    const FLOAT dxLong1 = 0.5 * (lm[mapd<W>(0, 0, 0, 0)] + lm[mapd<W>(1, 0, 0, 0)]);
 
-    const FLOAT u0 = lv[mapd(0, 0, 0, 0)];
-    const FLOAT uM1 = lv[mapd(-1, 0, 0, 0)];
-    const FLOAT u1 = lv[mapd(1, 0, 0, 0)];
+    const FLOAT u0 = lv[mapd<W>(0, 0, 0, 0)];
+    const FLOAT uM1 = lv[mapd<W>(-1, 0, 0, 0)];
+    const FLOAT u1 = lv[mapd<W>(1, 0, 0, 0)];
 
     // const FLOAT kr = (dxLong1 - dxShort) / dxLong1 * u0 + dxShort / dxLong1 * u1;
     // const FLOAT kl = (dxLong0 - dxShort) / dxLong0 * u0 + dxShort / dxLong0 * uM1;
@@ -582,26 +669,27 @@ inline FLOAT du2dx(const FLOAT* const lv, const Parameters& parameters, const FL
 }
 
 // First derivative of v*v w.r.t. y, evaluated at location of v-component. For details, see du2dx.
+template <class W = Cube>
 inline FLOAT dv2dy(const FLOAT* const lv, const Parameters& parameters, const FLOAT* const lm) {
 #ifndef NDEBUG
-    const FLOAT tmp1 = 1.0 / 4.0 * ((((lv[mapd(0, 0, 0, 1)] + lv[mapd(0, 1, 0, 1)]) *
-        (lv[mapd(0, 0, 0, 1)] + lv[mapd(0, 1, 0, 1)])) -
-        ((lv[mapd(0, -1, 0, 1)] + lv[mapd(0, 0, 0, 1)]) *
-            (lv[mapd(0, -1, 0, 1)] + lv[mapd(0, 0, 0, 1)]))) +
-        parameters.solver.gamma * ((fabs(lv[mapd(0, 0, 0, 1)] + lv[mapd(0, 1, 0, 1)]) *
-            (lv[mapd(0, 0, 0, 1)] - lv[mapd(0, 1, 0, 1)])) -
-            (fabs(lv[mapd(0, -1, 0, 1)] + lv[mapd(0, 0, 0, 1)]) *
-                (lv[mapd(0, -1, 0, 1)] - lv[mapd(0, 0, 0, 1)])))) /
-        lm[mapd(0, 0, 0, 1)];
+    const FLOAT tmp1 = 1.0 / 4.0 * ((((lv[mapd<W>(0, 0, 0, 1)] + lv[mapd<W>(0, 1, 0, 1)]) *
+        (lv[mapd<W>(0, 0, 0, 1)] + lv[mapd<W>(0, 1, 0, 1)])) -
+        ((lv[mapd<W>(0, -1, 0, 1)] + lv[mapd<W>(0, 0, 0, 1)]) *
+            (lv[mapd<W>(0, -1, 0, 1)] + lv[mapd<W>(0, 0, 0, 1)]))) +
+        parameters.solver.gamma * ((fabs(lv[mapd<W>(0, 0, 0, 1)] + lv[mapd<W>(0, 1, 0, 1)]) *
+            (lv[mapd<W>(0, 0, 0, 1)] - lv[mapd<W>(0, 1, 0, 1)])) -
+            (fabs(lv[mapd<W>(0, -1, 0, 1)] + lv[mapd<W>(0, 0, 0, 1)]) *
+                (lv[mapd<W>(0, -1, 0, 1)] - lv[mapd<W>(0, 0, 0, 1)])))) /
+        lm[mapd<W>(0, 0, 0, 1)];
 #endif
 
-    const FLOAT dyShort = 0.5 * lm[mapd(0, 0, 0, 1)];
-    // const FLOAT dyLong0 = 0.5*(lm[mapd(0,-1,0,1)] + lm[mapd(0,0,0,1)]);
-    const FLOAT dyLong1 = 0.5 * (lm[mapd(0, 0, 0, 1)] + lm[mapd(0, 1, 0, 1)]);
+    const FLOAT dyShort = 0.5 * lm[mapd<W>(0, 0, 0, 1)];
+    // const FLOAT dyLong0 = 0.5*(lm[mapd<W>(0,-1,0,1)] + lm[mapd<W>(0,0,0,1)]);
+    const FLOAT dyLong1 = 0.5 * (lm[mapd<W>(0, 0, 0, 1)] + lm[mapd<W>(0, 1, 0, 1)]);
 
-    const FLOAT v0 = lv[mapd(0, 0, 0, 1)];
-    const FLOAT vM1 = lv[mapd(0, -1, 0, 1)];
-    const FLOAT v1 = lv[mapd(0, 1, 0, 1)];
+    const FLOAT v0 = lv[mapd<W>(0, 0, 0, 1)];
+    const FLOAT vM1 = lv[mapd<W>(0, -1, 0, 1)];
+    const FLOAT v1 = lv[mapd<W>(0, 1, 0, 1)];
 
     // const FLOAT kr = (dyLong1 - dyShort) / dyLong1 * v0 + dyShort / dyLong1 * v1;
     // const FLOAT kl = (dyLong0 - dyShort) / dyLong0 * v0 + dyShort / dyLong0 * vM1;
@@ -629,26 +717,27 @@ inline FLOAT dv2dy(const FLOAT* const lv, const Parameters& parameters, const FL
 }
 
 // First derivative of w*w w.r.t. z, evaluated at location of w-component. For details, see du2dx.
+template <class W = Cube>
 inline FLOAT dw2dz(const FLOAT*  const lv, const Parameters & parameters, const FLOAT* const lm) {
 #ifndef NDEBUG
-    const FLOAT tmp1 = 1.0 / 4.0 * ((((lv[mapd(0, 0, 0, 2)] + lv[mapd(0, 0, 1, 2)]) *
-        (lv[mapd(0, 0, 0, 2)] + lv[mapd(0, 0, 1, 2)])) -
-        ((lv[mapd(0, 0, -1, 2)] + lv[mapd(0, 0, 0, 2)]) *
-            (lv[mapd(0, 0, -1, 2)] + lv[mapd(0, 0, 0, 2)]))) +
-        parameters.solver.gamma * ((fabs(lv[mapd(0, 0, 0, 2)] + lv[mapd(0, 0, 1, 2)]) *
-            (lv[mapd(0, 0, 0, 2)] - lv[mapd(0, 0, 1, 2)])) -
-            (fabs(lv[mapd(0, 0, -1, 2)] + lv[mapd(0, 0, 0, 2)]) *
-                (lv[mapd(0, 0, -1, 2)] - lv[mapd(0, 0, 0, 2)])))) /
-        lm[mapd(0, 0, 0, 2)];
+    const FLOAT tmp1 = 1.0 / 4.0 * ((((lv[mapd<W>(0, 0, 0, 2)] + lv[mapd<W>(0, 0, 1, 2)]) *
+        (lv[mapd<W>(0, 0, 0, 2)] + lv[mapd<W>(0, 0, 1, 2)])) -
+        ((lv[mapd<W>(0, 0, -1, 2)] + lv[mapd<W>(0, 0, 0, 2)]) *
+            (lv[mapd<W>(0, 0, -1, 2)] + lv[mapd<W>(0, 0, 0, 2)]))) +
+        parameters.solver.gamma * ((fabs(lv[mapd<W>(0, 0, 0, 2)] + lv[mapd<W>(0, 0, 1, 2)]) *
+            (lv[mapd<W>(0, 0, 0, 2)] - lv[mapd<W>(0, 0, 1, 2)])) -
+            (fabs(lv[mapd<W>(0, 0, -1, 2)] + lv[mapd<W>(0, 0, 0, 2)]) *
+                (lv[mapd<W>(0, 0, -1, 2)] - lv[mapd<W>(0, 0, 0, 2)])))) /
+        lm[mapd<W>(0, 0, 0, 2)];
 #endif
 
-    const FLOAT dzShort = 0.5 * lm[mapd(0, 0, 0, 2)];
-    // const FLOAT dzLong0 = 0.5 * (lm[mapd(0, 0, -1, 2)] + lm[mapd(0, 0, 0, 2)]);
-    const FLOAT dzLong1 = 0.5 * (lm[mapd(0, 0, 0, 2)] + lm[mapd(0, 0, 1, 2)]);
+    const FLOAT dzShort = 0.5 * lm[mapd<W>(0, 0, 0, 2)];
+    // const FLOAT dzLong0 = 0.5 * (lm[mapd<W>(0, 0, -1, 2)] + lm[mapd<W>(0, 0, 0, 2)]);
+    const FLOAT dzLong1 = 0.5 * (lm[mapd<W>(0, 0, 0, 2)] + lm[mapd<W>(0, 0, 1, 2)]);
 
-    const FLOAT w0 = lv[mapd(0, 0, 0, 2)];
-    const FLOAT wM1 = lv[mapd(0, 0, -1, 2)];
-    const FLOAT w1 = lv[mapd(0, 0, 1, 2)];
+    const FLOAT w0 = lv[mapd<W>(0, 0, 0, 2)];
+    const FLOAT wM1 = lv[mapd<W>(0, 0, -1, 2)];
+    const FLOAT w1 = lv[mapd<W>(0, 0, 1, 2)];
 
     // const FLOAT kr = (dzLong1 - dzShort) / dzLong1 * w0 + dzShort / dzLong1 * w1;
     // const FLOAT kl = (dzLong0 - dzShort) / dzLong0 * w0 + dzShort / dzLong0 * wM1;
@@ -679,13 +768,14 @@ inline FLOAT dw2dz(const FLOAT*  const lv, const Parameters & parameters, const
  * Turbulence Modelling
  */
 
+template <class W = Cube>
 inline FLOAT FT_term1(const FLOAT* const lv, const FLOAT* const lm, FLOAT vijk, FLOAT vi1jk) {
     // vijk: total viscosity: vstar[i,j,k]
     // vi1jk: total viscosity: vstar[i+1,j,k]
 
-    const int index0 = mapd(0, 0, 0, 0); // u[i,j,k]
-    const int index1 = mapd(-1, 0, 0, 0); // u[i-1,j,k]
-    const int index2 = mapd(1, 0, 0, 0); // u[i+1,j,k]
+    const int index0 = mapd<W>(0, 0, 0, 0); // u[i,j,k]
+    const int index1 = mapd<W>(-1, 0, 0, 0); // u[i-1,j,k]
+    const int index2 = mapd<W>(1, 0, 0, 0); // u[i+1,j,k]
 
     //firstTerm: vstar[i+1,j,k]*(u[i+1,j,k] - u[i,j,k])
     FLOAT firstTerm = vi1jk * (lv[index2] - lv[index0]);
@@ -697,17 +787,18 @@ inline FLOAT FT_term1(const FLOAT* const lv, const FLOAT* const lm, FLOAT vijk,
     return 2 * (firstTerm - secondTerm) / (lm[index0] * lm[index0]);
 }
 
+template <class W = Cube>
 inline FLOAT FT_term2(const FLOAT* const lv, const FLOAT* const lm, FLOAT vtr, FLOAT vbr) {
     // vtr: viscosity at top right corner: v*[i+1/2, j+1/2, k]
     // vbr: viscosity at bottom right corner: v*[i+1/2, j-1/2, k]
 
-    const int index0 = mapd(0, 0, 0, 0); // u[i,j,k]
-    const int index1 = mapd(0, 1, 0, 0); // u[i,j+1,k]
-    const int index2 = mapd(0, -1, 0, 0); // u[i,j-1,k]
-    const int index3 = mapd(0, 0, 0, 1); // v[i,j,k]
-    const int index4 = mapd(1, 0, 0, 1); // v[i+1,j,k]
-    const int index5 = mapd(0, -1, 0, 1); // v[i,j-1,k]
-    const int index6 = mapd(1, -1, 0, 1); // v[i+1,j-1,k]
+    const int index0 = mapd<W>(0, 0, 0, 0); // u[i,j,k]
+    const int index1 = mapd<W>(0, 1, 0, 0); // u[i,j+1,k]
+    const int index2 = mapd<W>(0, -1, 0, 0); // u[i,j-1,k]
+    const int index3 = mapd<W>(0, 0, 0, 1); // v[i,j,k]
+    const int index4 = mapd<W>(1, 0, 0, 1); // v[i+1,j,k]
+    const int index5 = mapd<W>(0, -1, 0, 1); // v[i,j-1,k]
+    const int index6 = mapd<W>(1, -1, 0, 1); // v[i+1,j-1,k]
 
     // firstTerm: vstar[i+1/2, j+1/2, k] * ((u[i,j+1,k]-u[i,j,k])/dy + (v[i+1,j,k]-v[i,j,k])/dx)
     FLOAT firstTerm = vtr * ((lv[index1] - lv[index0]) / lm[index3] + (lv[index4] - lv[index3]) / lm[index0]);
@@ -719,17 +810,18 @@ inline FLOAT FT_term2(const FLOAT* const lv, const FLOAT* const lm, FLOAT vtr, F
     return (firstTerm - secondTerm) / lm[index3];
 }
 
+template <class W = Cube>
 inline FLOAT FT_term3(const FLOAT* const lv, const FLOAT* const lm, FLOAT vrf, FLOAT vrb) {
     // vrf: viscosity at right front corner: v*[i+1/2, j, k+1/2]
     // vrb: viscosity at right back corner: v*[i+1/2, j, k-1/2]
 
-    const int index0 = mapd(0, 0, 0, 0); // u[i,j,k]
-    const int index1 = mapd(0, 0, 1, 0); // u[i,j,k+1]
-    const int index2 = mapd(0, 0, -1, 0); // u[i,j,k-1]
-    const int index3 = mapd(0, 0, 0, 2); // w[i,j,k]
-    const int index4 = mapd(1, 0, 0, 2); // w[i+1,j,k]
-    const int index5 = mapd(0, 0, -1, 2); // w[i,j,k-1]
-    const int index6 = mapd(1, 0, -1, 2); // w[i+1,j,k-1]
+    const int index0 = mapd<W>(0, 0, 0, 0); // u[i,j,k]
+    const int index1 = mapd<W>(0, 0, 1, 0); // u[i,j,k+1]
+    const int index2 = mapd<W>(0, 0, -1, 0); // u[i,j,k-1]
+    const int index3 = mapd<W>(0, 0, 0, 2); // w[i,j,k]
+    const int index4 = mapd<W>(1, 0, 0, 2); // w[i+1,j,k]
+    const int index5 = mapd<W>(0, 0, -1, 2); // w[i,j,k-1]
+    const int index6 = mapd<W>(1, 0, -1, 2); // w[i+1,j,k-1]
 
     // firstTerm: vstar[i+1/2, j, k+1/2] * ((u[i,j,k+1]-u[i,j,k])/dz + (w[i+1,j,k]-w[i,j,k])/dx)
     FLOAT firstTerm = vrf * ((lv[index1] - lv[index0]) / lm[index3] + (lv[index4] - lv[index3]) / lm[index0]);
@@ -744,13 +836,14 @@ inline FLOAT FT_term3(const FLOAT* const lv, const FLOAT* const lm, FLOAT vrf, F
 /**
  * Computes the F term for 2D Turbulence momentum equations
  */
+template <class W = Cube>
 inline FLOAT computeF2DT(const FLOAT* const localVelocity, const FLOAT* const localMeshsize, const FLOAT* const localViscosity, const Parameters &parameters, FLOAT dt) {
-    const int index0 = mapd(0, 0, 0,0); // vstar[i,j,k]
-    const int index1 = mapd(1, 0, 0, 0); // vstar[i+1,j,k]
-    const int index2 = mapd(0, 1, 0, 0); // vstar[i,j+1,k]
-    const int index3 = mapd(1, 1, 0, 0); // vstar[i+1,j+1,k]
-    const int index4 = mapd(0, -1, 0, 0); // vstar[i,j-1,k]
-    const int index5 = mapd(1, -1, 0, 0); // vstar[i+1,j-1,k]
+    const int index0 = mapd<W>(0, 0, 0,0); // vstar[i,j,k]
+    const int index1 = mapd<W>(1, 0, 0, 0); // vstar[i+1,j,k]
+    const int index2 = mapd<W>(0, 1, 0, 0); // vstar[i,j+1,k]
+    const int index3 = mapd<W>(1, 1, 0, 0); // vstar[i+1,j+1,k]
+    const int index4 = mapd<W>(0, -1, 0, 0); // vstar[i,j-1,k]
+    const int index5 = mapd<W>(1, -1, 0, 0); // vstar[i+1,j-1,k]
 
     // vijk: total viscosity: vstar[i,j,k]
     FLOAT vijk = localViscosity[index0];
@@ -764,27 +857,28 @@ inline FLOAT computeF2DT(const FLOAT* const localVelocity, const FLOAT* const lo
     // vbr: viscosity at bottom right corner: v*[i+1/2, j-1/2, k]
     FLOAT vbr = (localViscosity[index5] + localViscosity[index4] + localViscosity[index1] + localViscosity[index0]) / 4;
 
-    FLOAT term1 = FT_term1(localVelocity, localMeshsize, vijk, vi1jk);
-    FLOAT term2 = FT_term2(localVelocity, localMeshsize, vtr, vbr);
+    FLOAT term1 = FT_term1<W>(localVelocity, localMeshsize, vijk, vi1jk);
+    FLOAT term2 = FT_term2<W>(localVelocity, localMeshsize, vtr, vbr);
 
-    return localVelocity[mapd(0, 0, 0, 0)] + dt * (term1 + term2  - du2dx(localVelocity, parameters, localMeshsize)
-            - duvdy(localVelocity, parameters, localMeshsize) + parameters.environment.gx);
+    return localVelocity[mapd<W>(0, 0, 0, 0)] + dt * (term1 + term2  - du2dx<W>(localVelocity, parameters, localMeshsize)
+            - duvdy<W>(localVelocity, parameters, localMeshsize) + parameters.environment.gx);
 }
 
 /**
  * Computes the F term for 3D Turbulence momentum equations
  */
+template <class W = Cube>
 inline FLOAT computeF3DT(const FLOAT* const localVelocity, const FLOAT* const localMeshsize, const FLOAT* const localViscosity, const Parameters& parameters, FLOAT dt) {
-    const int index0 = mapd(0, 0, 0, 0); // vstar[i,j,k]
-    const int index1 = mapd(1, 0, 0, 0); // vstar[i+1,j,k]
-    const int index2 = mapd(0, 1, 0, 0); // vstar[i,j+1,k]
-    const int index3 = mapd(1, 1, 0, 0); // vstar[i+1,j+1,k]
-    const int index4 = mapd(0, -1, 0, 0); // vstar[i,j-1,k]
-    const int index5 = mapd(1, -1, 0, 0); // vstar[i+1,j-1,k]
-    const int index6 = mapd(0, 0, 1, 0); // vstar[i,j,k+1]
-    const int index7 = mapd(1, 0, 1, 0); // vstar[i+1,j,k+1]
-    const int index8 = mapd(0, 0, -1, 0); // vstar[i,j,k-1]
-    const int index9 = mapd(1, 0, -1, 0); // vstar[i+1,j,k-1]
+    const int index0 = mapd<W>(0, 0, 0, 0); // vstar[i,j,k]
+    const int index1 = mapd<W>(1, 0, 0, 0); // vstar[i+1,j,k]
+    const int index2 = mapd<W>(0, 1, 0, 0); // vstar[i,j+1,k]
+    const int index3 = mapd<W>(1, 1, 0, 0); // vstar[i+1,j+1,k]
+    const int index4 = mapd<W>(0, -1, 0, 0); // vstar[i,j-1,k]
+    const int index5 = mapd<W>(1, -1, 0, 0); // vstar[i+1,j-1,k]
+    const int index6 = mapd<W>(0, 0, 1, 0); // vstar[i,j,k+1]
+    const int index7 = mapd<W>(1, 0, 1, 0); // vstar[i+1,j,k+1]
+    const int index8 = mapd<W>(0, 0, -1, 0); // vstar[i,j,k-1]
+    const int index9 = mapd<W>(1, 0, -1, 0); // vstar[i+1,j,k-1]
 
     // vijk: total viscosity: vstar[i,j,k]
     FLOAT vijk = localViscosity[index0];
@@ -804,30 +898,31 @@ inline FLOAT computeF3DT(const FLOAT* const localVelocity, const FLOAT* const lo
     // vrb: viscosity at right back corner: v*[i+1/2, j, k-1/2]
     FLOAT vrb = (localViscosity[index0] + localViscosity[index1] + localViscosity[index8] + localViscosity[index9]) / 4;
 
-    FLOAT term1 = FT_term1(localVelocity, localMeshsize, vijk, vi1jk);
-    FLOAT term2 = FT_term2(localVelocity, localMeshsize, vtr, vbr);
-    FLOAT term3 = FT_term3(localVelocity, localMeshsize, vrf, vrb);
+    FLOAT term1 = FT_term1<W>(localVelocity, localMeshsize, vijk, vi1jk);
+    FLOAT term2 = FT_term2<W>(localVelocity, localMeshsize, vtr, vbr);
+    FLOAT term3 = FT_term3<W>(localVelocity, localMeshsize, vrf, vrb);
 
-    return localVelocity[mapd(0, 0, 0, 0)] + dt * (term1 + term2 + term3
-		    - du2dx(localVelocity, parameters, localMeshsize)
-		    - duvdy(localVelocity, parameters, localMeshsize)
-		    - duwdz(localVelocity, parameters, localMeshsize) + parameters.environment.gx);
+    return localVelocity[mapd<W>(0, 0, 0, 0)] + dt * (term1 + term2 + term3
+		    - du2dx<W>(localVelocity, parameters, localMeshsize)
+		    - duvdy<W>(localVelocity, parameters, localMeshsize)
+		    - duwdz<W>(localVelocity, parameters, localMeshsize) + parameters.environment.gx);
 }
 
+template <class W = Cube>
 inline FLOAT GT_term1(const FLOAT* const lv, const FLOAT* const lm, FLOAT vtr, FLOAT vtl) {
     // vtr: viscosity at top right corner: v*[i+1/2, j+1/2, k]
     // vtl: viscosity at top left corner: v*[i-1/2, j+1/2, k]
 
-    const int index0 = mapd(0, 0, 0, 0); // u[i,j,k]
-    const int index1 = mapd(0, 1, 0, 0); // u[i,j+1,k]
-    // Not used: const int index2 = mapd(0, -1, 0, 0); // u[i,j-1,k]
-    const int index3 = mapd(0, 0, 0, 1); // v[i,j,k]
-    const int index4 = mapd(1, 0, 0, 1); // v[i+1,j,k]
-    // Not used: const int index5 = mapd(0, -1, 0, 1); // v[i,j-1,k]
-    // Not used: const int index6 = mapd(1, -1, 0, 1); // v[i+1,j-1,k]
-    const int index7 = mapd(-1, 0, 0, 1); // v[i-1,j,k]
-    const int index8 = mapd(-1, 1, 0, 0); // u[i-1,j+1,k]
-    const int index9 = mapd(-1, 0, 0, 0); // u[i-1,j,k]
+    const int index0 = mapd<W>(0, 0, 0, 0); // u[i,j,k]
+    const int index1 = mapd<W>(0, 1, 0, 0); // u[i,j+1,k]
+    // Not used: const int index2 = mapd<W>(0, -1, 0, 0); // u[i,j-1,k]
+    const int index3 = mapd<W>(0, 0, 0, 1); // v[i,j,k]
+    const int index4 = mapd<W>(1, 0, 0, 1); // v[i+1,j,k]
+    // Not used: const int index5 = mapd<W>(0, -1, 0, 1); // v[i,j-1,k]
+    // Not used: const int index6 = mapd<W>(1, -1, 0, 1); // v[i+1,j-1,k]
+    const int index7 = mapd<W>(-1, 0, 0, 1); // v[i-1,j,k]
+    const int index8 = mapd<W>(-1, 1, 0, 0); // u[i-1,j+1,k]
+    const int index9 = mapd<W>(-1, 0, 0, 0); // u[i-1,j,k]
 
     // firstTerm: vstar[i+1/2, j+1/2, k] * ((u[i,j+1,k]-u[i,j,k])/dy + (v[i+1,j,k]-v[i,j,k])/dx)
     FLOAT firstTerm = vtr * ((lv[index1] - lv[index0]) / lm[index3] + (lv[index4] - lv[index3]) / lm[index0]);
@@ -839,13 +934,14 @@ inline FLOAT GT_term1(const FLOAT* const lv, const FLOAT* const lm, FLOAT vtr, F
     return (firstTerm - secondTerm) / lm[index0];
 }
 
+template <class W = Cube>
 inline FLOAT GT_term2(const FLOAT* const lv, const FLOAT* const lm, FLOAT vijk, FLOAT vij1k) {
     // vijk: total viscosity: vstar[i,j,k]
     // vij1k: total viscosity: vstar[i,j+1,k]
 
-    const int index0 = mapd(0, 0, 0, 1); // v[i,j,k]
-    const int index1 = mapd(0, -1, 0, 1); // v[i,j-1,k]
-    const int index2 = mapd(0, 1, 0, 1); // v[i,j+1,k]
+    const int index0 = mapd<W>(0, 0, 0, 1); // v[i,j,k]
+    const int index1 = mapd<W>(0, -1, 0, 1); // v[i,j-1,k]
+    const int index2 = mapd<W>(0, 1, 0, 1); // v[i,j+1,k]
 
     //firstTerm: vstar[i,j+1,k]*(v[i,j+1,k] - v[i,j,k])
     FLOAT firstTerm = vij1k * (lv[index2] - lv[index0]);
@@ -857,17 +953,18 @@ inline FLOAT GT_term2(const FLOAT* const lv, const FLOAT* const lm, FLOAT vijk,
     return 2 * (firstTerm - secondTerm) / (lm[index0] * lm[index0]);
 }
 
+template <class W = Cube>
 inline FLOAT GT_term3(const FLOAT* const lv, const FLOAT* const lm, FLOAT vtf, FLOAT vtb) {
     // vtf: viscosity at top front corner: v*[i, j+1/2, k+1/2]
     // vtb: viscosity at top back corner: v*[i, j+1/2, k-1/2]
 
-    const int index0 = mapd(0, 0, 0, 1); // v[i,j,k]
-    const int index1 = mapd(0, 0, 1, 1); // v[i,j,k+1]
-    const int index2 = mapd(0, 0, -1, 1); // v[i,j,k-1]
-    const int index3 = mapd(0, 0, 0, 2); // w[i,j,k]
-    const int index4 = mapd(0, 1, 0, 2); // w[i,j+1,k]
-    const int index5 = mapd(0, 0, -1, 2); // w[i,j,k-1]
-    const int index6 = mapd(0, 1, -1, 2); // w[i,j+1,k-1]
+    const int index0 = mapd<W>(0, 0, 0, 1); // v[i,j,k]
+    const int index1 = mapd<W>(0, 0, 1, 1); // v[i,j,k+1]
+    const int index2 = mapd<W>(0, 0, -1, 1); // v[i,j,k-1]
+    const int index3 = mapd<W>(0, 0, 0, 2); // w[i,j,k]
+    const int index4 = mapd<W>(0, 1, 0, 2); // w[i,j+1,k]
+    const int index5 = mapd<W>(0, 0, -1, 2); // w[i,j,k-1]
+    const int index6 = mapd<W>(0, 1, -1, 2); // w[i,j+1,k-1]
 
     // firstTerm: vstar[i, j+1/2, k+1/2] * ((v[i,j,k+1]-v[i,j,k])/dz + (w[i,j+1,k]-w[i,j,k])/dy)
     FLOAT firstTerm = vtf * ((lv[index1] - lv[index0]) / lm[index3] + (lv[index4] - lv[index3]) / lm[index0]);
@@ -882,13 +979,14 @@ inline FLOAT GT_term3(const FLOAT* const lv, const FLOAT* const lm, FLOAT vtf, F
 /**
  * Computes the G term for 2D Turbulence momentum equations
  */
+template <class W = Cube>
 inline FLOAT computeG2DT(const FLOAT* const localVelocity, const FLOAT* const localMeshsize, const FLOAT* const localViscosity, const Parameters& parameters, FLOAT dt) {
-    const int index0 = mapd(0, 0, 0, 0); // vstar[i,j,k]
-    const int index1 = mapd(1, 0, 0, 0); // vstar[i+1,j,k]
-    const int index2 = mapd(0, 1, 0, 0); // vstar[i,j+1,k]
-    const int index3 = mapd(1, 1, 0, 0); // vstar[i+1,j+1,k]
-    const int index4 = mapd(-1, 0, 0, 0); // vstar[i-1,j,k]
-    const int index5 = mapd(-1, 1, 0, 0); // vstar[i-1,j+1,k]
+    const int index0 = mapd<W>(0, 0, 0, 0); // vstar[i,j,k]
+    const int index1 = mapd<W>(1, 0, 0, 0); // vstar[i+1,j,k]
+    const int index2 = mapd<W>(0, 1, 0, 0); // vstar[i,j+1,k]
+    const int index3 = mapd<W>(1, 1, 0, 0); // vstar[i+1,j+1,k]
+    const int index4 = mapd<W>(-1, 0, 0, 0); // vstar[i-1,j,k]
+    const int index5 = mapd<W>(-1, 1, 0, 0); // vstar[i-1,j+1,k]
 
     // vijk: total viscosity: vstar[i,j,k]
     FLOAT vijk =  localViscosity[index0];
@@ -900,28 +998,29 @@ inline FLOAT computeG2DT(const FLOAT* const localVelocity, const FLOAT* const lo
     FLOAT vtl = (localViscosity[index0] + localViscosity[index2] + localViscosity[index4] + localViscosity[index5])/4;
 
 
-    FLOAT term1 = GT_term1(localVelocity, localMeshsize, vtr, vtl);
-    FLOAT term2 = GT_term2(localVelocity, localMeshsize, vijk, vij1k);
+    FLOAT term1 = GT_term1<W>(localVelocity, localMeshsize, vtr, vtl);
+    FLOAT term2 = GT_term2<W>(localVelocity, localMeshsize, vijk, vij1k);
 
-    return localVelocity[mapd(0, 0, 0, 1)] +
-            dt * (term1 + term2 - duvdx(localVelocity, parameters, localMeshsize)
-            - dv2dy(localVelocity, parameters, localMeshsize) + parameters.environment.gy);
+    return localVelocity[mapd<W>(0, 0, 0, 1)] +
+            dt * (term1 + term2 - duvdx<W>(localVelocity, parameters, localMeshsize)
+            - dv2dy<W>(localVelocity, parameters, localMeshsize) + parameters.environment.gy);
 }
 
 /**
  * Computes the G term for 3D Turbulence momentum equations
  */
+template <class W = Cube>
 inline FLOAT computeG3DT(const FLOAT* const localVelocity, const FLOAT* const localMeshsize, const FLOAT* const localViscosity, const Parameters& parameters, FLOAT dt) {
-	const int index0 = mapd(0, 0, 0, 0); // vstar[i,j,k]
-    const int index1 = mapd(1, 0, 0, 0); // vstar[i+1,j,k]
-    const int index2 = mapd(0, 1, 0, 0); // vstar[i,j+1,k]
-    const int index3 = mapd(1, 1, 0, 0); // vstar[i+1,j+1,k]
-    const int index4 = mapd(-1, 0, 0, 0); // vstar[i-1,j,k]
-    const int index5 = mapd(-1, 1, 0, 0); // vstar[i-1,j+1,k]
-    const int index6 = mapd(0, 0, 1, 0); // vstar[i,j,k+1]
-    const int index7 = mapd(0, 1, 1, 0); // vstar[i,j+1,k+1]
-    const int index8 = mapd(0, 0, -1, 0); // vstar[i,j,k-1]
-    const int index9 = mapd(0, 1, -1, 0); // vstar[i,j+1,k-1]
+	const int index0 = mapd<W>(0, 0, 0, 0); // vstar[i,j,k]
+    const int index1 = mapd<W>(1, 0, 0, 0); // vstar[i+1,j,k]
+    const int index2 = mapd<W>(0, 1, 0, 0); // vstar[i,j+1,k]
+    const int index3 = mapd<W>(1, 1, 0, 0); // vstar[i+1,j+1,k]
+    const int index4 = mapd<W>(-1, 0, 0, 0); // vstar[i-1,j,k]
+    const int index5 = mapd<W>(-1, 1, 0, 0); // vstar[i-1,j+1,k]
+    const int index6 = mapd<W>(0, 0, 1, 0); // vstar[i,j,k+1]
+    const int index7 = mapd<W>(0, 1, 1, 0); // vstar[i,j+1,k+1]
+    const int index8 = mapd<W>(0, 0, -1, 0); // vstar[i,j,k-1]
+    const int index9 = mapd<W>(0, 1, -1, 0); // vstar[i,j+1,k-1]
 
     // vijk: total viscosity: vstar[i,j,k]
     FLOAT vijk =  localViscosity[index0];
@@ -941,26 +1040,27 @@ inline FLOAT computeG3DT(const FLOAT* const localVelocity, const FLOAT* const lo
     // vtb: viscosity at top back corner: v*[i, j+1/2, k-1/2]
     FLOAT vtb = (localViscosity[index0] + localViscosity[index2] + localViscosity[index8] + localViscosity[index9]) / 4;
 
-    FLOAT term1 = GT_term1(localVelocity, localMeshsize, vtr, vtl);
-    FLOAT term2 = GT_term2(localVelocity, localMeshsize, vijk, vij1k);
-    FLOAT term3 = GT_term3(localVelocity, localMeshsize, vtf, vtb);
+    FLOAT term1 = GT_term1<W>(localVelocity, localMeshsize, vtr, vtl);
+    FLOAT term2 = GT_term2<W>(localVelocity, localMeshsize, vijk, vij1k);
+    FLOAT term3 = GT_term3<W>(localVelocity, localMeshsize, vtf, vtb);
 
-    return localVelocity[mapd(0, 0, 0, 1)] + dt * (term1 + term2 + term3
-		    - dv2dy(localVelocity, parameters, localMeshsize) - duvdx(localVelocity, parameters, localMeshsize)
-		    - dvwdz(localVelocity, parameters, localMeshsize) + parameters.environment.gy);
+    return localVelocity[mapd<W>(0, 0, 0, 1)] + dt * (term1 + term2 + term3
+		    - dv2dy<W>(localVelocity, parameters, localMeshsize) - duvdx<W>(localVelocity, parameters, localMeshsize)
+		    - dvwdz<W>(localVelocity, parameters, localMeshsize) + parameters.environment.gy);
 }
 
+template <class W = Cube>
 inline FLOAT HT_term1(const FLOAT* const lv, const FLOAT* const lm, FLOAT vfr, FLOAT vfl) {
     // vfr: viscosity at front right corner: v*[i+1/2, j, k+1/2]
     // vfl: viscosity at front left corner: v*[i-1/2, j, k+1/2]
 
-    const int index0 = mapd(0, 0, 0, 0); // u[i,j,k]
-    const int index1 = mapd(0, 0, 1, 0); // u[i,j,k+1]
-    const int index2 = mapd(-1, 0, 0, 2); // w[i-1,j,k]
-    const int index3 = mapd(0, 0, 0, 2); // w[i,j,k]
-    const int index4 = mapd(1, 0, 0, 2); // w[i+1,j,k]
-    const int index5 = mapd(-1, 0, 0, 0); // u[i-1,j,k]
-    const int index6 = mapd(-1, 0, 1, 0); // u[i-1,j,k+1]
+    const int index0 = mapd<W>(0, 0, 0, 0); // u[i,j,k]
+    const int index1 = mapd<W>(0, 0, 1, 0); // u[i,j,k+1]
+    const int index2 = mapd<W>(-1, 0, 0, 2); // w[i-1,j,k]
+    const int index3 = mapd<W>(0, 0, 0, 2); // w[i,j,k]
+    const int index4 = mapd<W>(1, 0, 0, 2); // w[i+1,j,k]
+    const int index5 = mapd<W>(-1, 0, 0, 0); // u[i-1,j,k]
+    const int index6 = mapd<W>(-1, 0, 1, 0); // u[i-1,j,k+1]
 
     // firstTerm: vstar[i+1/2, j, k+1/2] * ((u[i,j,k+1]-u[i,j,k])/dz + (w[i+1,j,k]-w[i,j,k])/dx)
     FLOAT firstTerm = vfr * ((lv[index1] - lv[index0]) / lm[index3] + (lv[index4] - lv[index3]) / lm[index0]);
@@ -972,17 +1072,18 @@ inline FLOAT HT_term1(const FLOAT* const lv, const FLOAT* const lm, FLOAT vfr, F
     return (firstTerm - secondTerm) / lm[index0];
 }
 
+template <class W = Cube>
 inline FLOAT HT_term2(const FLOAT* const lv, const FLOAT* const lm, FLOAT vft, FLOAT vfb) {
     // vft: viscosity at front top corner: v*[i, j+1/2, k+1/2]
     // vfb: viscosity at front bottom corner: v*[i, j-1/2, k+1/2]
 
-    const int index0 = mapd(0, 0, 0, 1); // v[i,j,k]
-    const int index1 = mapd(0, 0, 1, 1); // v[i,j,k+1]
-    const int index2 = mapd(0, -1, 0, 2); // w[i,j-1,k]
-    const int index3 = mapd(0, 0, 0, 2); // w[i,j,k]
-    const int index4 = mapd(0, 1, 0, 2); // w[i,j+1,k]
-    const int index5 = mapd(0, -1, 0, 1); // v[i,j-1,k]
-    const int index6 = mapd(0, -1, 1, 1); // v[i,j-1,k+1]
+    const int index0 = mapd<W>(0, 0, 0, 1); // v[i,j,k]
+    const int index1 = mapd<W>(0, 0, 1, 1); // v[i,j,k+1]
+    const int index2 = mapd<W>(0, -1, 0, 2); // w[i,j-1,k]
+    const int index3 = mapd<W>(0, 0, 0, 2); // w[i,j,k]
+    const int index4 = mapd<W>(0, 1, 0, 2); // w[i,j+1,k]
+    const int index5 = mapd<W>(0, -1, 0, 1); // v[i,j-1,k]
+    const int index6 = mapd<W>(0, -1, 1, 1); // v[i,j-1,k+1]
 
     // firstTerm: vstar[i, j+1/2, k+1/2] * ((v[i,j,k+1]-v[i,j,k])/dz + (w[i,j+1,k]-w[i,j,k])/dy)
     FLOAT firstTerm = vft * ((lv[index1] - lv[index0]) / lm[index3] + (lv[index4] - lv[index3]) / lm[index0]);
@@ -994,13 +1095,14 @@ inline FLOAT HT_term2(const FLOAT* const lv, const FLOAT* const lm, FLOAT vft, F
     return (firstTerm - secondTerm) / lm[index0];
 }
 
+template <class W = Cube>
 inline FLOAT HT_term3(const FLOAT* const lv, const FLOAT* const lm, FLOAT vijk, FLOAT vijk1) {
     // vijk: total viscosity: vstar[i,j],j
     // vijk1: total viscosity: vstar[i,j,k+1]
 
-    const int index0 = mapd(0, 0, 0, 2); // w[i,j,k]
-    const int index1 = mapd(0, 0, -1, 2); // w[i,j,k-1]
-    const int index2 = mapd(0, 0, 1, 2); // w[i,j,k+1]
+    const int index0 = mapd<W>(0, 0, 0, 2); // w[i,j,k]
+    const int index1 = mapd<W>(0, 0, -1, 2); // w[i,j,k-1]
+    const int index2 = mapd<W>(0, 0, 1, 2); // w[i,j,k+1]
 
     //firstTerm: vstar[i,j,k+1]*(w[i,j,k+1] - w[i,j,k])
     FLOAT firstTerm = vijk1 * (lv[index2] - lv[index0]);
@@ -1015,19 +1117,20 @@ inline FLOAT HT_term3(const FLOAT* const lv, const FLOAT* const lm, FLOAT vijk,
 /**
  * Computes the H term for 3D Turbulence momentum equations
  */
+template <class W = Cube>
 inline FLOAT computeH3DT(const FLOAT* const localVelocity, const FLOAT* const localMeshsize, const FLOAT* const localViscosity, const Parameters& parameters, FLOAT dt) {
-    const int index0 = mapd(0, 0, 0, 0); // vstar[i,j,k]
-    const int index1 = mapd(1, 0, 0, 0); // vstar[i+1,j,k]
-    const int index2 = mapd(0, 1, 0, 0); // vstar[i,j+1,k]
-    const int index3 = mapd(1, 0, 1, 0); // vstar[i+1,j,k+1]
-    const int index4 = mapd(-1, 0, 0, 0); // vstar[i-1,j,k]
-    const int index5 = mapd(-1, 0, 1, 0); // vstar[i-1,1,k+1]
+    const int index0 = mapd<W>(0, 0, 0, 0); // vstar[i,j,k]
+    const int index1 = mapd<W>(1, 0, 0, 0); // vstar[i+1,j,k]
+    const int index2 = mapd<W>(0, 1, 0, 0); // vstar[i,j+1,k]
+    const int index3 = mapd<W>(1, 0, 1, 0); // vstar[i+1,j,k+1]
+    const int index4 = mapd<W>(-1, 0, 0, 0); // vstar[i-1,j,k]
+    const int index5 = mapd<W>(-1, 0, 1, 0); // vstar[i-1,1,k+1]
 
-    const int index6 = mapd(0, 0, 1, 0); // vstar[i,j,k+1]
-    const int index7 = mapd(0, 1, 1, 0); // vstar[i,j+1,k+1]
+    const int index6 = mapd<W>(0, 0, 1, 0); // vstar[i,j,k+1]
+    const int index7 = mapd<W>(0, 1, 1, 0); // vstar[i,j+1,k+1]
 
-    const int index8 = mapd(0, -1, 0, 0); // vstar[i,j-1,k]
-    const int index9 = mapd(0, -1, 1, 0); // vstar[i,j-1,k+1]
+    const int index8 = mapd<W>(0, -1, 0, 0); // vstar[i,j-1,k]
+    const int index9 = mapd<W>(0, -1, 1, 0); // vstar[i,j-1,k+1]
 
     // vijk: total viscosity: vstar[i,j,k]
     FLOAT vijk =  localViscosity[index0];
@@ -1047,123 +1150,136 @@ inline FLOAT computeH3DT(const FLOAT* const localVelocity, const FLOAT* const lo
     // vfb: viscosity at front bottom corner: v*[i, j-1/2, k+1/2]
     FLOAT vfb = (localViscosity[index0] + localViscosity[index6] + localViscosity[index8] + localViscosity[index9]) / 4;
 
-    FLOAT term1 = HT_term1(localVelocity, localMeshsize, vfr, vfl);
-    FLOAT term2 = HT_term2(localVelocity, localMeshsize, vft, vfb);
-    FLOAT term3 = HT_term3(localVelocity, localMeshsize, vijk, vijk1);
+    FLOAT term1 = HT_term1<W>(localVelocity, localMeshsize, vfr, vfl);
+    FLOAT term2 = HT_term2<W>(localVelocity, localMeshsize, vft, vfb);
+    FLOAT term3 = HT_term3<W>(localVelocity, localMeshsize, vijk, vijk1);
 
-    return localVelocity[mapd(0, 0, 0, 2)] + dt * (term1 + term2 + term3
-		    - dw2dz(localVelocity, parameters, localMeshsize) - duwdx(localVelocity, parameters, localMeshsize)
-		    - dvwdy(localVelocity, parameters, localMeshsize)  + parameters.environment.gz);
+    return localVelocity[mapd<W>(0, 0, 0, 2)] + dt * (term1 + term2 + term3
+		    - dw2dz<W>(localVelocity, parameters, localMeshsize) - duwdx<W>(localVelocity, parameters, localMeshsize)
+		    - dvwdy<W>(localVelocity, parameters, localMeshsize)  + parameters.environment.gz);
 }
 
+template <class W = Cube>
 inline FLOAT computeF2D(const FLOAT* const localVelocity, const FLOAT* const localMeshsize, const Parameters& parameters, FLOAT dt) {
-    return localVelocity[mapd(0, 0, 0, 0)]
-        + dt * (1 / parameters.flow.Re * (d2udx2(localVelocity, localMeshsize)
-            + d2udy2(localVelocity, localMeshsize)) - du2dx(localVelocity, parameters, localMeshsize)
-            - duvdy(localVelocity, parameters, localMeshsize) + parameters.environment.gx);
+    return localVelocity[mapd<W>(0, 0, 0, 0)]
+        + dt * (1 / parameters.flow.Re * (d2udx2<W>(localVelocity, localMeshsize)
+            + d2udy2<W>(localVelocity, localMeshsize)) - du2dx<W>(localVelocity, parameters, localMeshsize)
+            - duvdy<W>(localVelocity, parameters, localMeshsize) + parameters.environment.gx);
 }
 
+template <class W = Cube>
 inline FLOAT computeG2D(const FLOAT* const localVelocity, const FLOAT* const localMeshsize, const Parameters& parameters, FLOAT dt) {
-    return localVelocity[mapd(0, 0, 0, 1)]
-        + dt * (1 / parameters.flow.Re * (d2vdx2(localVelocity, localMeshsize)
-            + d2vdy2(localVelocity, localMeshsize)) - duvdx(localVelocity, parameters, localMeshsize)
-            - dv2dy(localVelocity, parameters, localMeshsize) + parameters.environment.gy);
+    return localVelocity[mapd<W>(0, 0, 0, 1)]
+        + dt * (1 / parameters.flow.Re * (d2vdx2<W>(localVelocity, localMeshsize)
+            + d2vdy2<W>(localVelocity, localMeshsize)) - duvdx<W>(localVelocity, parameters, localMeshsize)
+            - dv2dy<W>(localVelocity, parameters, localMeshsize) + parameters.environment.gy);
 }
 
+template <class W = Cube>
 inline FLOAT computeF3D(const FLOAT* const localVelocity, const FLOAT* const localMeshsize, const Parameters& parameters, FLOAT dt) {
-    return localVelocity[mapd(0, 0, 0, 0)]
-        + dt * (1 / parameters.flow.Re * (d2udx2(localVelocity, localMeshsize)
-            + d2udy2(localVelocity, localMeshsize) + d2udz2(localVelocity, localMeshsize))
-            - du2dx(localVelocity, parameters, localMeshsize) - duvdy(localVelocity, parameters, localMeshsize)
-            - duwdz(localVelocity, parameters, localMeshsize) + parameters.environment.gx);
+    return localVelocity[mapd<W>(0, 0, 0, 0)]
+        + dt * (1 / parameters.flow.Re * (d2udx2<W>(localVelocity, localMeshsize)
+            + d2udy2<W>(localVelocity, localMeshsize) + d2udz2<W>(localVelocity, localMeshsize))
+            - du2dx<W>(localVelocity, parameters, localMeshsize) - duvdy<W>(localVelocity, parameters, localMeshsize)
+            - duwdz<W>(localVelocity, parameters, localMeshsize) + parameters.environment.gx);
 }
 
+template <class W = Cube>
 inline FLOAT computeG3D(const FLOAT* const localVelocity, const FLOAT* const localMeshsize, const Parameters& parameters, FLOAT dt) {
-    return localVelocity[mapd(0, 0, 0, 1)]
-        + dt * (1 / parameters.flow.Re * (d2vdx2(localVelocity, localMeshsize)
-            + d2vdy2(localVelocity, localMeshsize) + d2vdz2(localVelocity, localMeshsize))
-            - dv2dy(localVelocity, parameters, localMeshsize) - duvdx(localVelocity, parameters, localMeshsize)
-            - dvwdz(localVelocity, parameters, localMeshsize) + parameters.environment.gy);
+    return localVelocity[mapd<W>(0, 0, 0, 1)]
+        + dt * (1 / parameters.flow.Re * (d2vdx2<W>(localVelocity, localMeshsize)
+            + d2vdy2<W>(localVelocity, localMeshsize) + d2vdz2<W>(localVelocity, localMeshsize))
+            - dv2dy<W>(localVelocity, parameters, localMeshsize) - duvdx<W>(localVelocity, parameters, localMeshsize)
+            - dvwdz<W>(localVelocity, parameters, localMeshsize) + parameters.environment.gy);
 }
 
+template <class W = Cube>
 inline FLOAT computeH3D(const FLOAT* const localVelocity, const FLOAT* const localMeshsize, const Parameters& parameters, FLOAT dt) {
-    return localVelocity[mapd(0, 0, 0, 2)]
-        + dt * (1 / parameters.flow.Re * (d2wdx2(localVelocity, localMeshsize)
-            + d2wdy2(localVelocity, localMeshsize) + d2wdz2(localVelocity, localMeshsize))
-            - dw2dz(localVelocity, parameters, localMeshsize) - duwdx(localVelocity, parameters, localMeshsize)
-            - dvwdy(localVelocity, parameters, localMeshsize) + parameters.environment.gz);
+    return localVelocity[mapd<W>(0, 0, 0, 2)]
+        + dt * (1 / parameters.flow.Re * (d2wdx2<W>(localVelocity, localMeshsize)
+            + d2wdy2<W>(localVelocity, localMeshsize) + d2wdz2<W>(localVelocity, localMeshsize))
+            - dw2dz<W>(localVelocity, parameters, localMeshsize) - duwdx<W>(localVelocity, parameters, localMeshsize)
+            - dvwdy<W>(localVelocity, parameters, localMeshsize) + parameters.environment.gz);
 }
 
 // dudy <-> first derivative of u-component of velocity field w.r.t. y-direction.
+template <class W = Cube>
 inline FLOAT dudy(const FLOAT* const lv, const FLOAT* const lm) {
     // Evaluate dudy in the cell center by a central difference
-    const int index0 = mapd(0, 0, 0, 0);
-    const int index1 = mapd(0, -1, 0, 0);
+    const int index0 = mapd<W>(0, 0, 0, 0);
+    const int index1 = mapd<W>(0, -1, 0, 0);
 
-    return (lv[index0] - lv[index1]) / lm[mapd(0, 0, 0, 1)];
+    return (lv[index0] - lv[index1]) / lm[mapd<W>(0, 0, 0, 1)];
 }
 
 // dudz <-> first derivative of u-component of velocity field w.r.t. z-direction.
+template <class W = Cube>
 inline FLOAT dudz(const FLOAT* const lv, const FLOAT* const lm) {
     // Evaluate dudz in the cell center by a central difference
-    const int index0 = mapd(0, 0, 0, 0);
-    const int index1 = mapd(0, 0, -1, 0);
+    const int index0 = mapd<W>(0, 0, 0, 0);
+    const int index1 = mapd<W>(0, 0, -1, 0);
 
-    return (lv[index0] - lv[index1]) / lm[mapd(0, 0, 0, 2)];
+    return (lv[index0] - lv[index1]) / lm[mapd<W>(0, 0, 0, 2)];
 }
 
 // dvdx <-> first derivative of v-component of velocity field w.r.t. x-direction.
+template <class W = Cube>
 inline FLOAT dvdx(const FLOAT* const lv, const FLOAT* const lm) {
-    const int index0 = mapd(0, 0, 0, 1);
-    const int index1 = mapd(-1, 0, 0, 1);
+    const int index0 = mapd<W>(0, 0, 0, 1);
+    const int index1 = mapd<W>(-1, 0, 0, 1);
 
-    return (lv[index0] - lv[index1]) / lm[mapd(0, 0, 0, 0)];
+    return (lv[index0] - lv[index1]) / lm[mapd<W>(0, 0, 0, 0)];
 }
 
 // dvdz <-> first derivative of v-component of velocity field w.r.t. z-direction.
+template <class W = Cube>
 inline FLOAT dvdz(const FLOAT* const lv, const FLOAT* const lm) {
     // Evaluate dudz in the cell center by a central difference
-    const int index0 = mapd(0, 0, 0, 1);
-    const int index1 = mapd(0, 0, -1, 1);
+    const int index0 = mapd<W>(0, 0, 0, 1);
+    const int index1 = mapd<W>(0, 0, -1, 1);
 
-    return (lv[index0] - lv[index1]) / lm[mapd(0, 0, 0, 2)];
+    return (lv[index0] - lv[index1]) / lm[mapd<W>(0, 0, 0, 2)];
 }
 
 // dwdx <-> first derivative of w-component of velocity field w.r.t. x-direction.
+template <class W = Cube>
 inline FLOAT dwdx(const FLOAT* const lv, const FLOAT* const lm) {
     // Evaluate dwdx in the cell center by a central difference
-    const int index0 = mapd(0, 0, 0, 2);
-    const int index1 = mapd(-1, 0, 0, 2);
+    const int index0 = mapd<W>(0, 0, 0, 2);
+    const int index1 = mapd<W>(-1, 0, 0, 2);
 
-    return (lv[index0] - lv[index1]) / lm[mapd(0, 0, 0, 0)];
+    return (lv[index0] - lv[index1]) / lm[mapd<W>(0, 0, 0, 0)];
 }
 
 // dwdy <-> first derivative of w-component of velocity field w.r.t. y-direction.
+template <class W = Cube>
 inline FLOAT dwdy(const FLOAT* const lv, const FLOAT* const lm) {
     // Evaluate dwdy in the cell center by a central difference
-    const int index0 = mapd(0, 0, 0, 2);
-    const int index1 = mapd(0, -1, 0, 2);
+    const int index0 = mapd<W>(0, 0, 0, 2);
+    const int index1 = mapd<W>(0, -1, 0, 2);
 
-    return (lv[index0] - lv[index1]) / lm[mapd(0, 0, 0, 1)];
+    return (lv[index0] - lv[index1]) / lm[mapd<W>(0, 0, 0, 1)];
 }
 
 // function to compute the strain tensor squared in 2D
+template <class W = Cube>
 inline FLOAT computeStrainTensorSquared2D(const FLOAT* const localVelocity, const FLOAT* const localMeshsize) {
-    FLOAT S11 = 2 * dudx(localVelocity, localMeshsize);
-    FLOAT S22 = 2 * dvdy(localVelocity, localMeshsize);
-    FLOAT S12 = dudy(localVelocity, localMeshsize) + dvdx(localVelocity, localMeshsize);
+    FLOAT S11 = 2 * dudx<W>(localVelocity, localMeshsize);
+    FLOAT S22 = 2 * dvdy<W>(localVelocity, localMeshsize);
+    FLOAT S12 = dudy<W>(localVelocity, localMeshsize) + dvdx<W>(localVelocity, localMeshsize);
 
     return std::pow(S11, 2) + std::pow(S22, 2) + 2 * std::pow(S12, 2);
 }
 
 // function to compute the strain tensor squared in 3D
+template <class W = Cube>
 inline FLOAT computeStrainTensorSquared3D(const FLOAT* const localVelocity, const FLOAT* const localMeshsize) {
-	FLOAT S11 = 2 * dudx(localVelocity, localMeshsize);
-	FLOAT S22 = 2 * dvdy(localVelocity, localMeshsize);
-	FLOAT S33 = 2 * dwdz(localVelocity, localMeshsize);
-	FLOAT S12 = dudy(localVelocity, localMeshsize) + dvdx(localVelocity, localMeshsize);
-	FLOAT S13 = dudz(localVelocity, localMeshsize) + dwdx(localVelocity, localMeshsize);
-	FLOAT S23 = dvdz(localVelocity, localMeshsize) + dwdy(localVelocity, localMeshsize);
+	FLOAT S11 = 2 * dudx<W>(localVelocity, localMeshsize);
+	FLOAT S22 = 2 * dvdy<W>(localVelocity, localMeshsize);
+	FLOAT S33 = 2 * dwdz<W>(localVelocity, localMeshsize);
+	FLOAT S12 = dudy<W>(localVelocity, localMeshsize) + dvdx<W>(localVelocity, localMeshsize);
+	FLOAT S13 = dudz<W>(localVelocity, localMeshsize) + dwdx<W>(localVelocity, localMeshsize);
+	FLOAT S23 = dvdz<W>(localVelocity, localMeshsize) + dwdy<W>(localVelocity, localMeshsize);
 
     return std::pow(S11, 2) + std::pow(S22, 2) + std::pow(S33, 2) +
            2 * (std::pow(S12, 2) + std::pow(S13, 2) + std::pow(S23, 2));
@@ -5,36 +5,70 @@ namespace NSEOF::Stencils {
 TurbulentFGHStencil::TurbulentFGHStencil(const Parameters& parameters)
     : FGHStencil(parameters) {}
 
-void TurbulentFGHStencil::computeValues_(FlowField& flowField, int i, int j) {
-    loadLocalViscosity2D(parameters_, flowField, localViscosity_, i, j);
+void TurbulentFGHStencil::apply(FlowField& flowField, int i, int j) {
+    FLOAT localVelocity[VALUES_DIMENSION]{};
+    FLOAT localMeshsize[VALUES_DIMENSION]{};
 
-    FLOAT* values = flowField.getFGH().getVector(i, j);
+    loadLocalVelocity2D(flowField, localVelocity, i, j);
+    loadLocalMeshsize2D(parameters_, localMeshsize, i, j);
 
-    values[0] = computeF2DT(getLocalVelocity_(), getLocalMeshsize_(),
-                            localViscosity_, parameters_, parameters_.timestep.dt);
-    values[1] = computeG2DT(getLocalVelocity_(), getLocalMeshsize_(),
-                            localViscosity_, parameters_, parameters_.timestep.dt);
+    computeValues_(flowField, localVelocity, localMeshsize, i, j);
 }
 
-void TurbulentFGHStencil::computeValues_(FlowField& flowField, int i, int j, int k, const int obstacle) {
-    loadLocalViscosity3D(parameters_, flowField, localViscosity_, i, j, k);
+void TurbulentFGHStencil::apply(FlowField& flowField, int i, int j, int k) {
+    const int obstacle = flowField.getFlags().getValue(i, j, k);
 
-    FLOAT* values = flowField.getFGH().getVector(i, j, k);
+    if ((obstacle & OBSTACLE_SELF) == 0) { // If the cell is fluid
+        FLOAT localVelocity[VALUES_DIMENSION];
+        FLOAT localMeshsize[VALUES_DIMENSION];
+
+        loadLocalVelocity3D(flowField, localVelocity, i, j, k);
+        loadLocalMeshsize3D(parameters_, localMeshsize, i, j, k);
+
+        computeValues_(flowField, localVelocity, localMeshsize, i, j, k, obstacle);
+    }
+}
+
+void TurbulentFGHStencil::computeValues_(FlowField& flowField, const FLOAT* localVelocity, const FLOAT* localMeshsize,
+                                         int i, int j) {
+    FLOAT localViscosity[VALUES_DIMENSION]{};
+    loadLocalViscosity2D(parameters_, flowField, localViscosity, i, j);
+
+    VectorField& values = flowField.getFGH();
+
+    values.getComponent(0, i, j) = computeF2DT(localVelocity, localMeshsize,
+                            localViscosity, parameters_, parameters_.timestep.dt);
+    values.getComponent(1, i, j) = computeG2DT(localVelocity, localMeshsize,
+                            localViscosity, parameters_, parameters_.timestep.dt);
+}
+
+void TurbulentFGHStencil::computeValues_(FlowField& flowField, const FLOAT* localVelocity, const FLOAT* localMeshsize,
+                                         int i, int j, int k, const int obstacle) {
+    FLOAT localViscosity[VALUES_DIMENSION];
+    loadLocalViscosity3D(parameters_, flowField, localViscosity, i, j, k);
+
+    VectorField& values = flowField.getFGH();
 
     if ((obstacle & OBSTACLE_RIGHT) == 0) {
-        values[0] = computeF3DT(getLocalVelocity_(), getLocalMeshsize_(),
-                                localViscosity_, parameters_, parameters_.timestep.dt);
+        values.getComponent(0, i, j, k) = computeF3DT(localVelocity, localMeshsize,
+                                localViscosity, parameters_, parameters_.timestep.dt);
     }
 
     if ((obstacle & OBSTACLE_TOP) == 0) {
-        values[1] = computeG3DT(getLocalVelocity_(), getLocalMeshsize_(),
-                                localViscosity_, parameters_, parameters_.timestep.dt);
+        values.getComponent(1, i, j, k) = computeG3DT(localVelocity, localMeshsize,
+                                localViscosity, parameters_, parameters_.timestep.dt);
     }
 
     if ((obstacle & OBSTACLE_BACK) == 0) {
-        values[2] = computeH3DT(getLocalVelocity_(), getLocalMeshsize_(),
-                                localViscosity_, parameters_, parameters_.timestep.dt);
+        values.getComponent(2, i, j, k) = computeH3DT(localVelocity, localMeshsize,
+                                localViscosity, parameters_, parameters_.timestep.dt);
     }
 }
 
-} // namespace NSEOF::Stencils
\ No newline at end of file
+} // namespace NSEOF::Stencils
+
+namespace NSEOF {
+template class StaticFieldIterator<FlowField, Stencils::TurbulentFGHStencil>;
+template class TiledFieldIterator<FlowField, Stencils::TurbulentFGHStencil>;
+template class FusedFieldIterator<FlowField, Stencils::TurbulentFGHStencil, Stencils::RHSStencil>;
+} // namespace NSEOF
@@ -5,19 +5,27 @@
 
 namespace NSEOF::Stencils {
 
-class TurbulentFGHStencil : public FGHStencil {
+class TurbulentFGHStencil final : public FGHStencil {
 private:
-    FLOAT localViscosity_[VALUES_DIMENSION]{};
-
-protected:
-    void computeValues_(FlowField&, int, int) override;
-    void computeValues_(FlowField&, int, int, int, int) override;
+    // The local viscosity array is loaded here, next to the velocity and meshsize arrays of apply
+    void computeValues_(FlowField&, const FLOAT*, const FLOAT*, int, int);
+    void computeValues_(FlowField&, const FLOAT*, const FLOAT*, int, int, int, int);
 
 public:
     explicit TurbulentFGHStencil(const Parameters& parameters);
     ~TurbulentFGHStencil() override = default;
+
+    void apply(FlowField&, int, int) override;
+    void apply(FlowField&, int, int, int) override;
 };
 
 } // namespace NSEOF::Stencils
 
+namespace NSEOF {
+// Instantiated in TurbulentFGHStencil.cpp, where the stencil body can be inlined into the loops
+extern template class StaticFieldIterator<FlowField, Stencils::TurbulentFGHStencil>;
+extern template class TiledFieldIterator<FlowField, Stencils::TurbulentFGHStencil>;
+extern template class FusedFieldIterator<FlowField, Stencils::TurbulentFGHStencil, Stencils::RHSStencil>;
+} // namespace NSEOF
+
 #endif //__STENCILS_TURBULENT_FGH_STENCIL_HPP__
@@ -43,12 +43,12 @@ namespace NSEOF::Stencils {
 
         // Get the data structures stored
         FLOAT& cellPressure = pressure_.getScalar(i, j, k);
-        FLOAT* cellVelocity = velocity_.getVector(i, j, k);
+        FLOAT cellVelocity[3] = { 0.0, 0.0, 0.0 };
 
         // Make sure that it is a fluid cell, and if it is not, stop the computation and store 0s instead!
         if ((flowField.getFlags().getValue(i, j, k) & OBSTACLE_SELF) != 0) {
             cellPressure = 0.0;
-            for (int dim = 0; dim < parameters_.geometry.dim; dim++) cellVelocity[dim] = 0.0;
+            for (int dim = 0; dim < parameters_.geometry.dim; dim++) velocity_.getComponent(dim, i, j, k) = 0.0;
 
             return;
         }
@@ -59,6 +59,8 @@ namespace NSEOF::Stencils {
         } else { // 3D
             flowField.getPressureAndVelocity(cellPressure, cellVelocity, i, j, k);
         }
+
+        for (int dim = 0; dim < parameters_.geometry.dim; dim++) velocity_.getComponent(dim, i, j, k) = cellVelocity[dim];
     }
 
     void VTKStencil::apply(FlowField& flowField, int i, int j) {
@@ -124,10 +126,11 @@ namespace NSEOF::Stencils {
     void VTKStencil::writeVelocities_(FILE* filePtr) {
         fprintf(filePtr, "VECTORS velocity float\n");
 
-        FLOAT* cellVelocity;
         for (auto& cellIndex : cellIndices_) {
-            cellVelocity = velocity_.getVector(cellIndex.i, cellIndex.j, cellIndex.k);
-            fprintf(filePtr, "%f %f %f\n", cellVelocity[0], cellVelocity[1], cellVelocity[2]);
+            fprintf(filePtr, "%f %f %f\n",
+                    velocity_.getComponent(0, cellIndex.i, cellIndex.j, cellIndex.k),
+                    velocity_.getComponent(1, cellIndex.i, cellIndex.j, cellIndex.k),
+                    velocity_.getComponent(2, cellIndex.i, cellIndex.j, cellIndex.k));
         }
 
         fprintf(filePtr, "\n");
@@ -5,40 +5,60 @@ namespace NSEOF::Stencils {
     VelocityBufferDiagonalFillStencil::VelocityBufferDiagonalFillStencil(const Parameters& parameters)
             : BufferFillStencil(parameters) {}
 
+    template <class D>
+    void VelocityBufferDiagonalFillStencil::applyLeftWall_(FlowField& flowField, int i, int j, int k) {
+        setNextInBufferLeft(flowField.getVelocity().getComponent(0, i + 1, j - 1, k)); // "u"
+        setNextInBufferLeft(flowField.getVelocity().getComponent(1, i + 1, j - 1, k)); // "v"
+
+        if constexpr (D::value == 3) {
+            setNextInBufferLeft(flowField.getVelocity().getComponent(2, i + 1, j, k)); // "w"
+        }
+    }
+
     void VelocityBufferDiagonalFillStencil::applyLeftWall(FlowField& flowField, int i, int j, int k) {
-        getBufferLeft().push_back(flowField.getVelocity().getVector(i + 1, j - 1, k)[0]); // "u"
-        getBufferLeft().push_back(flowField.getVelocity().getVector(i + 1, j - 1, k)[1]); // "v"
+        applyLeftWall_<Dim<3>>(flowField, i, j, k);
+    }
+
+    template <class D>
+    void VelocityBufferDiagonalFillStencil::applyRightWall_(FlowField& flowField, int i, int j, int k) {
+        setNextInBufferRight(flowField.getVelocity().getComponent(0, i - 1, j + 1, k)); // "u"
+        setNextInBufferRight(flowField.getVelocity().getComponent(1, i - 1, j + 1, k)); // "v"
 
-        if (parameters_.geometry.dim == 3) { // 3D
-            getBufferLeft().push_back(flowField.getVelocity().getVector(i + 1, j, k)[2]); // "w"
+        if constexpr (D::value == 3) {
+            setNextInBufferRight(flowField.getVelocity().getComponent(2, i - 1, j, k)); // "w"
         }
     }
 
     void VelocityBufferDiagonalFillStencil::applyRightWall(FlowField& flowField, int i, int j, int k) {
-        getBufferRight().push_back(flowField.getVelocity().getVector(i - 1, j + 1, k)[0]); // "u"
-        getBufferRight().push_back(flowField.getVelocity().getVector(i - 1, j + 1, k)[1]); // "v"
+        applyRightWall_<Dim<3>>(flowField, i, j, k);
+    }
+
+    template <class D>
+    void VelocityBufferDiagonalFillStencil::applyBottomWall_(FlowField& flowField, int i, int j, int k) {
+        setNextInBufferBottom(flowField.getVelocity().getComponent(0, i + 1, j + 1, k)); // "u"
+        setNextInBufferBottom(flowField.getVelocity().getComponent(1, i + 1, j + 1, k)); // "v"
 
-        if (parameters_.geometry.dim == 3) { // 3D
-            getBufferRight().push_back(flowField.getVelocity().getVector(i - 1, j, k)[2]); // "w"
+        if constexpr (D::value == 3) {
+            setNextInBufferBottom(flowField.getVelocity().getComponent(2, i + 1, j + 1, k)); // "w"
         }
     }
 
     void VelocityBufferDiagonalFillStencil::applyBottomWall(FlowField& flowField, int i, int j, int k) {
-        getBufferBottom().push_back(flowField.getVelocity().getVector(i + 1, j + 1, k)[0]); // "u"
-        getBufferBottom().push_back(flowField.getVelocity().getVector(i + 1, j + 1, k)[1]); // "v"
+        applyBottomWall_<Dim<3>>(flowField, i, j, k);
+    }
 
-        if (parameters_.geometry.dim == 3) { // 3D
-            getBufferBottom().push_back(flowField.getVelocity().getVector(i + 1, j + 1, k)[2]); // "w"
+    template <class D>
+    void VelocityBufferDiagonalFillStencil::applyTopWall_(FlowField& flowField, int i, int j, int k) {
+        setNextInBufferTop(flowField.getVelocity().getComponent(0, i - 1, j - 1, k)); // "u"
+        setNextInBufferTop(flowField.getVelocity().getComponent(1, i - 1, j - 1, k)); // "v"
+
+        if constexpr (D::value == 3) {
+            setNextInBufferTop(flowField.getVelocity().getComponent(2, i - 1, j - 1, k)); // "w"
         }
     }
 
     void VelocityBufferDiagonalFillStencil::applyTopWall(FlowField& flowField, int i, int j, int k) {
-        getBufferTop().push_back(flowField.getVelocity().getVector(i - 1, j - 1, k)[0]); // "u"
-        getBufferTop().push_back(flowField.getVelocity().getVector(i - 1, j - 1, k)[1]); // "v"
-
-        if (parameters_.geometry.dim == 3) { // 3D
-            getBufferTop().push_back(flowField.getVelocity().getVector(i - 1, j - 1, k)[2]); // "w"
-        }
+        applyTopWall_<Dim<3>>(flowField, i, j, k);
     }
 
     void VelocityBufferDiagonalFillStencil::applyFrontWall([[maybe_unused]] FlowField& flowField, [[maybe_unused]] int i, [[maybe_unused]] int j, [[maybe_unused]] int k) {}
@@ -50,19 +70,19 @@ namespace NSEOF::Stencils {
      */
 
     void VelocityBufferDiagonalFillStencil::applyLeftWall(FlowField& flowField, int i, int j) {
-        applyLeftWall(flowField, i, j, 0);
+        applyLeftWall_<Dim<2>>(flowField, i, j, 0);
     }
 
     void VelocityBufferDiagonalFillStencil::applyRightWall(FlowField& flowField, int i, int j) {
-        applyRightWall(flowField, i, j, 0);
+        applyRightWall_<Dim<2>>(flowField, i, j, 0);
     }
 
     void VelocityBufferDiagonalFillStencil::applyBottomWall(FlowField& flowField, int i, int j) {
-        applyBottomWall(flowField, i, j, 0);
+        applyBottomWall_<Dim<2>>(flowField, i, j, 0);
     }
 
     void VelocityBufferDiagonalFillStencil::applyTopWall(FlowField& flowField, int i, int j) {
-        applyTopWall(flowField, i, j, 0);
+        applyTopWall_<Dim<2>>(flowField, i, j, 0);
     }
 
 } // namespace NSEOF::Stencils
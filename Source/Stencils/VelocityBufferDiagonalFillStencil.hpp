@@ -2,6 +2,7 @@
 #define __STENCILS_VELOCITY_BUFFER_DIAGONAL_FILL_STENCIL_HPP__
 
 #include "BufferFillStencil.hpp"
+#include "Dimension.hpp"
 
 namespace NSEOF::Stencils {
 
@@ -9,6 +10,13 @@ namespace NSEOF::Stencils {
  * A boundary stencil that fills the velocity buffer (diagonally)
  */
 class VelocityBufferDiagonalFillStencil : public BufferFillStencil {
+private:
+    // The bodies of the 2D and 3D overloads of the lateral walls, see Dim
+    template <class D> void applyLeftWall_  (FlowField&, int, int, int);
+    template <class D> void applyRightWall_ (FlowField&, int, int, int);
+    template <class D> void applyBottomWall_(FlowField&, int, int, int);
+    template <class D> void applyTopWall_   (FlowField&, int, int, int);
+
 public:
     explicit VelocityBufferDiagonalFillStencil(const Parameters&);
     ~VelocityBufferDiagonalFillStencil() override = default;
@@ -2,6 +2,7 @@
 #define __STENCILS_VELOCITY_BUFFER_DIAGONAL_READ_STENCIL_HPP__
 
 #include "BufferReadStencil.hpp"
+#include "Dimension.hpp"
 
 namespace NSEOF::Stencils {
 
@@ -9,6 +10,13 @@ namespace NSEOF::Stencils {
  * A boundary stencil that reads the velocity buffer (diagonally)
  */
 class VelocityBufferDiagonalReadStencil : public BufferReadStencil {
+private:
+    // The bodies of the 2D and 3D overloads of the lateral walls, see Dim
+    template <class D> void applyLeftWall_  (FlowField&, int, int, int);
+    template <class D> void applyRightWall_ (FlowField&, int, int, int);
+    template <class D> void applyBottomWall_(FlowField&, int, int, int);
+    template <class D> void applyTopWall_   (FlowField&, int, int, int);
+
 public:
     explicit VelocityBufferDiagonalReadStencil(const Parameters&);
     ~VelocityBufferDiagonalReadStencil() override = default;
@@ -9,52 +9,72 @@ namespace NSEOF::Stencils {
      * Functions for 3D
      */
 
-    void VelocityBufferFillStencil::applyLeftWall(FlowField& flowField, int i, int j, int k) {
-        getBufferLeft().push_back(flowField.getVelocity().getVector(i + 1, j, k)[0]); // "u"
-        getBufferLeft().push_back(flowField.getVelocity().getVector(i + 1, j, k)[1]); // "v"
+    template <class D>
+    void VelocityBufferFillStencil::applyLeftWall_(FlowField& flowField, int i, int j, int k) {
+        setNextInBufferLeft(flowField.getVelocity().getComponent(0, i + 1, j, k)); // "u"
+        setNextInBufferLeft(flowField.getVelocity().getComponent(1, i + 1, j, k)); // "v"
 
-        if (parameters_.geometry.dim == 3) { // 3D
-            getBufferLeft().push_back(flowField.getVelocity().getVector(i + 1, j, k)[2]); // "w"
+        if constexpr (D::value == 3) {
+            setNextInBufferLeft(flowField.getVelocity().getComponent(2, i + 1, j, k)); // "w"
         }
     }
 
-    void VelocityBufferFillStencil::applyRightWall(FlowField& flowField, int i, int j, int k) {
-        getBufferRight().push_back(flowField.getVelocity().getVector(i - 2, j, k)[0]); // "u"
-        getBufferRight().push_back(flowField.getVelocity().getVector(i - 1, j, k)[1]); // "v"
+    void VelocityBufferFillStencil::applyLeftWall(FlowField& flowField, int i, int j, int k) {
+        applyLeftWall_<Dim<3>>(flowField, i, j, k);
+    }
 
-        if (parameters_.geometry.dim == 3) { // 3D
-            getBufferRight().push_back(flowField.getVelocity().getVector(i - 1, j, k)[2]); // "w"
+    template <class D>
+    void VelocityBufferFillStencil::applyRightWall_(FlowField& flowField, int i, int j, int k) {
+        setNextInBufferRight(flowField.getVelocity().getComponent(0, i - 2, j, k)); // "u"
+        setNextInBufferRight(flowField.getVelocity().getComponent(1, i - 1, j, k)); // "v"
+
+        if constexpr (D::value == 3) {
+            setNextInBufferRight(flowField.getVelocity().getComponent(2, i - 1, j, k)); // "w"
         }
     }
+
+    void VelocityBufferFillStencil::applyRightWall(FlowField& flowField, int i, int j, int k) {
+        applyRightWall_<Dim<3>>(flowField, i, j, k);
+    }
     
-    void VelocityBufferFillStencil::applyBottomWall(FlowField& flowField, int i, int j, int k) {
-        getBufferBottom().push_back(flowField.getVelocity().getVector(i, j + 1, k)[0]); // "u"
-        getBufferBottom().push_back(flowField.getVelocity().getVector(i, j + 1, k)[1]); // "v"
+    template <class D>
+    void VelocityBufferFillStencil::applyBottomWall_(FlowField& flowField, int i, int j, int k) {
+        setNextInBufferBottom(flowField.getVelocity().getComponent(0, i, j + 1, k)); // "u"
+        setNextInBufferBottom(flowField.getVelocity().getComponent(1, i, j + 1, k)); // "v"
 
-        if (parameters_.geometry.dim == 3) { // 3D
-            getBufferBottom().push_back(flowField.getVelocity().getVector(i, j + 1, k)[2]); // "w"
+        if constexpr (D::value == 3) {
+            setNextInBufferBottom(flowField.getVelocity().getComponent(2, i, j + 1, k)); // "w"
         }
     }
+
+    void VelocityBufferFillStencil::applyBottomWall(FlowField& flowField, int i, int j, int k) {
+        applyBottomWall_<Dim<3>>(flowField, i, j, k);
+    }
     
-    void VelocityBufferFillStencil::applyTopWall(FlowField& flowField, int i, int j, int k) {
-        getBufferTop().push_back(flowField.getVelocity().getVector(i, j - 1, k)[0]); // "u" 
-        getBufferTop().push_back(flowField.getVelocity().getVector(i, j - 2, k)[1]); // "v"
+    template <class D>
+    void VelocityBufferFillStencil::applyTopWall_(FlowField& flowField, int i, int j, int k) {
+        setNextInBufferTop(flowField.getVelocity().getComponent(0, i, j - 1, k)); // "u" 
+        setNextInBufferTop(flowField.getVelocity().getComponent(1, i, j - 2, k)); // "v"
 
-        if (parameters_.geometry.dim == 3) { // 3D
-            getBufferTop().push_back(flowField.getVelocity().getVector(i, j - 1, k)[2]); // "w"
+        if constexpr (D::value == 3) {
+            setNextInBufferTop(flowField.getVelocity().getComponent(2, i, j - 1, k)); // "w"
         }
     }
 
+    void VelocityBufferFillStencil::applyTopWall(FlowField& flowField, int i, int j, int k) {
+        applyTopWall_<Dim<3>>(flowField, i, j, k);
+    }
+
     void VelocityBufferFillStencil::applyFrontWall(FlowField& flowField, int i, int j, int k) {
-        getBufferFront().push_back(flowField.getVelocity().getVector(i, j, k + 1)[0]); // "u"
-        getBufferFront().push_back(flowField.getVelocity().getVector(i, j, k + 1)[1]); // "v"
-        getBufferFront().push_back(flowField.getVelocity().getVector(i, j, k + 1)[2]); // "w"
+        setNextInBufferFront(flowField.getVelocity().getComponent(0, i, j, k + 1)); // "u"
+        setNextInBufferFront(flowField.getVelocity().getComponent(1, i, j, k + 1)); // "v"
+        setNextInBufferFront(flowField.getVelocity().getComponent(2, i, j, k + 1)); // "w"
     }
     
     void VelocityBufferFillStencil::applyBackWall(FlowField& flowField, int i, int j, int k) {
-        getBufferBack().push_back(flowField.getVelocity().getVector(i, j, k - 1)[0]); // "u"
-        getBufferBack().push_back(flowField.getVelocity().getVector(i, j, k - 1)[1]); // "v"
-        getBufferBack().push_back(flowField.getVelocity().getVector(i, j, k - 2)[2]); // "w"
+        setNextInBufferBack(flowField.getVelocity().getComponent(0, i, j, k - 1)); // "u"
+        setNextInBufferBack(flowField.getVelocity().getComponent(1, i, j, k - 1)); // "v"
+        setNextInBufferBack(flowField.getVelocity().getComponent(2, i, j, k - 2)); // "w"
     }
 
     /**
@@ -62,19 +82,19 @@ namespace NSEOF::Stencils {
      */
 
     void VelocityBufferFillStencil::applyLeftWall(FlowField& flowField, int i, int j) {
-        applyLeftWall(flowField, i, j, 0);
+        applyLeftWall_<Dim<2>>(flowField, i, j, 0);
     }
 
     void VelocityBufferFillStencil::applyRightWall(FlowField& flowField, int i, int j) {
-        applyRightWall(flowField, i, j, 0);
+        applyRightWall_<Dim<2>>(flowField, i, j, 0);
     }
 
     void VelocityBufferFillStencil::applyBottomWall(FlowField& flowField, int i, int j) {
-        applyBottomWall(flowField, i, j, 0);
+        applyBottomWall_<Dim<2>>(flowField, i, j, 0);
     }
 
     void VelocityBufferFillStencil::applyTopWall(FlowField& flowField, int i, int j) {
-        applyTopWall(flowField, i, j, 0);
+        applyTopWall_<Dim<2>>(flowField, i, j, 0);
     }
 
 } // namespace NSEOF::Stencils
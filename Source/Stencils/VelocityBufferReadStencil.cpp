@@ -9,52 +9,72 @@ namespace NSEOF::Stencils {
      * Functions for 3D
      */
 
+    template <class D>
+    void VelocityBufferReadStencil::applyLeftWall_(FlowField& flowField, int i, int j, int k) {
+        flowField.getVelocity().getComponent(0, i - 1, j, k) = getNextInBufferLeft(); // "u"
+        flowField.getVelocity().getComponent(1, i, j, k) = getNextInBufferLeft(); // "v"
+
+        if constexpr (D::value == 3) {
+            flowField.getVelocity().getComponent(2, i, j, k) = getNextInBufferLeft(); // "w"
+        }
+    }
+
     void VelocityBufferReadStencil::applyLeftWall(FlowField& flowField, int i, int j, int k) {
-        flowField.getVelocity().getVector(i - 1, j, k)[0] = getNextInBufferLeft(); // "u"
-        flowField.getVelocity().getVector(i, j, k)[1] = getNextInBufferLeft(); // "v"
+        applyLeftWall_<Dim<3>>(flowField, i, j, k);
+    }
+
+    template <class D>
+    void VelocityBufferReadStencil::applyRightWall_(FlowField& flowField, int i, int j, int k) {
+        flowField.getVelocity().getComponent(0, i, j, k) = getNextInBufferRight(); // "u"
+        flowField.getVelocity().getComponent(1, i, j, k) = getNextInBufferRight(); // "v"
 
-        if (parameters_.geometry.dim == 3) { // 3D
-            flowField.getVelocity().getVector(i, j, k)[2] = getNextInBufferLeft(); // "w"
+        if constexpr (D::value == 3) {
+            flowField.getVelocity().getComponent(2, i, j, k) = getNextInBufferRight(); // "w"
         }
     }
 
     void VelocityBufferReadStencil::applyRightWall(FlowField& flowField, int i, int j, int k) {
-        flowField.getVelocity().getVector(i, j, k)[0] = getNextInBufferRight(); // "u"
-        flowField.getVelocity().getVector(i, j, k)[1] = getNextInBufferRight(); // "v"
+        applyRightWall_<Dim<3>>(flowField, i, j, k);
+    }
+
+    template <class D>
+    void VelocityBufferReadStencil::applyBottomWall_(FlowField& flowField, int i, int j, int k) {
+        flowField.getVelocity().getComponent(0, i, j, k) = getNextInBufferBottom(); // "u"
+        flowField.getVelocity().getComponent(1, i, j - 1, k) = getNextInBufferBottom(); // "v"
 
-        if (parameters_.geometry.dim == 3) { // 3D
-            flowField.getVelocity().getVector(i, j, k)[2] = getNextInBufferRight(); // "w"
+        if constexpr (D::value == 3) {
+            flowField.getVelocity().getComponent(2, i, j, k) = getNextInBufferBottom(); // "w"
         }
     }
 
     void VelocityBufferReadStencil::applyBottomWall(FlowField& flowField, int i, int j, int k) {
-        flowField.getVelocity().getVector(i, j, k)[0] = getNextInBufferBottom(); // "u"
-        flowField.getVelocity().getVector(i, j - 1, k)[1] = getNextInBufferBottom(); // "v"
+        applyBottomWall_<Dim<3>>(flowField, i, j, k);
+    }
 
-        if (parameters_.geometry.dim == 3) { // 3D
-            flowField.getVelocity().getVector(i, j, k)[2] = getNextInBufferBottom(); // "w"
+    template <class D>
+    void VelocityBufferReadStencil::applyTopWall_(FlowField& flowField, int i, int j, int k) {
+        flowField.getVelocity().getComponent(0, i, j, k) = getNextInBufferTop(); // "u"
+        flowField.getVelocity().getComponent(1, i, j, k) = getNextInBufferTop(); // "v"
+
+        if constexpr (D::value == 3) {
+            flowField.getVelocity().getComponent(2, i, j, k) = getNextInBufferTop(); // "w"
         }
     }
 
     void VelocityBufferReadStencil::applyTopWall(FlowField& flowField, int i, int j, int k) {
-        flowField.getVelocity().getVector(i, j, k)[0] = getNextInBufferTop(); // "u"
-        flowField.getVelocity().getVector(i, j, k)[1] = getNextInBufferTop(); // "v"
-
-        if (parameters_.geometry.dim == 3) { // 3D
-            flowField.getVelocity().getVector(i, j, k)[2] = getNextInBufferTop(); // "w"
-        }
+        applyTopWall_<Dim<3>>(flowField, i, j, k);
     }
 
     void VelocityBufferReadStencil::applyFrontWall(FlowField& flowField, int i, int j, int k) {
-        flowField.getVelocity().getVector(i, j, k)[0] = getNextInBufferFront(); // "u"
-        flowField.getVelocity().getVector(i, j, k)[1] = getNextInBufferFront(); // "v"
-        flowField.getVelocity().getVector(i, j, k - 1)[2] = getNextInBufferFront(); // "w"
+        flowField.getVelocity().getComponent(0, i, j, k) = getNextInBufferFront(); // "u"
+        flowField.getVelocity().getComponent(1, i, j, k) = getNextInBufferFront(); // "v"
+        flowField.getVelocity().getComponent(2, i, j, k - 1) = getNextInBufferFront(); // "w"
     }
 
     void VelocityBufferReadStencil::applyBackWall(FlowField& flowField, int i, int j, int k) {
-        flowField.getVelocity().getVector(i, j, k)[0] = getNextInBufferBack(); // "u"
-        flowField.getVelocity().getVector(i, j, k)[1] = getNextInBufferBack(); // "v"
-        flowField.getVelocity().getVector(i, j, k)[2] = getNextInBufferBack(); // "w"
+        flowField.getVelocity().getComponent(0, i, j, k) = getNextInBufferBack(); // "u"
+        flowField.getVelocity().getComponent(1, i, j, k) = getNextInBufferBack(); // "v"
+        flowField.getVelocity().getComponent(2, i, j, k) = getNextInBufferBack(); // "w"
     }
 
     /**
@@ -62,19 +82,19 @@ namespace NSEOF::Stencils {
      */
 
     void VelocityBufferReadStencil::applyLeftWall(FlowField& flowField, int i, int j) {
-        applyLeftWall(flowField, i, j, 0);
+        applyLeftWall_<Dim<2>>(flowField, i, j, 0);
     }
 
     void VelocityBufferReadStencil::applyRightWall(FlowField& flowField, int i, int j) {
-        applyRightWall(flowField, i, j, 0);
+        applyRightWall_<Dim<2>>(flowField, i, j, 0);
     }
 
     void VelocityBufferReadStencil::applyBottomWall(FlowField& flowField, int i, int j) {
-        applyBottomWall(flowField, i, j, 0);
+        applyBottomWall_<Dim<2>>(flowField, i, j, 0);
     }
 
     void VelocityBufferReadStencil::applyTopWall(FlowField& flowField, int i, int j) {
-        applyTopWall(flowField, i, j, 0);
+        applyTopWall_<Dim<2>>(flowField, i, j, 0);
     }
 
 } // namespace NSEOF::Stencils
@@ -5,7 +5,8 @@ namespace NSEOF::Stencils {
 VelocityStencil::VelocityStencil(const Parameters& parameters)
     : FieldStencil<FlowField>(parameters) {}
 
-void VelocityStencil::apply(FlowField& flowField, int i, int j, int k) {
+template <class D>
+void VelocityStencil::apply_(FlowField& flowField, int i, int j, int k) {
     const FLOAT dt = parameters_.timestep.dt;
     const int obstacle = flowField.getFlags().getValue(i, j, k);
     VectorField& velocity = flowField.getVelocity();
@@ -20,33 +21,45 @@ void VelocityStencil::apply(FlowField& flowField, int i, int j, int k) {
              *
              * Note: We only set one direction per cell. The neighbor at the left is responsible for the other side.
              */
-            const FLOAT dx = 0.5 * (parameters_.meshsize->getDx(i, j, k) + parameters_.meshsize->getDx(i + 1, j, k));
-            velocity.getVector(i, j, k)[0] = flowField.getFGH().getVector(i, j, k)[0] - dt / dx *
+            const FLOAT inverseDx = parameters_.meshMetrics->getInverseCentreSpacing(0)[i];
+            velocity.getComponent(0, i, j, k) = flowField.getFGH().getComponent(0, i, j, k) - dt * inverseDx *
                     (flowField.getPressure().getScalar(i + 1, j, k) - flowField.getPressure().getScalar(i, j, k));
         } else {
-            velocity.getVector(i, j, k)[0] = 0.0;
+            velocity.getComponent(0, i, j, k) = 0.0;
         }
 
         if ((obstacle & OBSTACLE_TOP) == 0) {
-            const FLOAT dy = 0.5 * (parameters_.meshsize->getDy(i, j, k) + parameters_.meshsize->getDy(i, j + 1, k));
-            velocity.getVector(i, j, k)[1] = flowField.getFGH().getVector(i, j, k)[1] - dt / dy *
+            const FLOAT inverseDy = parameters_.meshMetrics->getInverseCentreSpacing(1)[j];
+            velocity.getComponent(1, i, j, k) = flowField.getFGH().getComponent(1, i, j, k) - dt * inverseDy *
                     (flowField.getPressure().getScalar(i, j + 1, k) - flowField.getPressure().getScalar(i, j, k));
         } else {
-            velocity.getVector(i, j, k)[1] = 0.0;
+            velocity.getComponent(1, i, j, k) = 0.0;
         }
 
-        if (parameters_.geometry.dim == 3 && (obstacle & OBSTACLE_BACK) == 0) {
-            const FLOAT dz = 0.5 * (parameters_.meshsize->getDz(i, j, k) + parameters_.meshsize->getDz(i, j, k + 1));
-            velocity.getVector(i, j, k)[2] = flowField.getFGH().getVector(i, j, k)[2] - dt / dz *
-                    (flowField.getPressure().getScalar(i, j, k + 1) - flowField.getPressure().getScalar(i, j, k));
-        } else {
-            velocity.getVector(i, j, k)[2] = 0.0;
+        if constexpr (D::value == 3) { // The 2D field has no third component
+            if ((obstacle & OBSTACLE_BACK) == 0) {
+                const FLOAT inverseDz = parameters_.meshMetrics->getInverseCentreSpacing(2)[k];
+                velocity.getComponent(2, i, j, k) = flowField.getFGH().getComponent(2, i, j, k) - dt * inverseDz *
+                        (flowField.getPressure().getScalar(i, j, k + 1) - flowField.getPressure().getScalar(i, j, k));
+            } else {
+                velocity.getComponent(2, i, j, k) = 0.0;
+            }
         }
     }
 }
 
+void VelocityStencil::apply(FlowField& flowField, int i, int j, int k) {
+    apply_<Dim<3>>(flowField, i, j, k);
+}
+
 void VelocityStencil::apply(FlowField& flowField, int i, int j) {
-    apply(flowField, i, j, 0);
+    apply_<Dim<2>>(flowField, i, j, 0);
 }
 
 } // namespace NSEOF::Stencils
+
+namespace NSEOF {
+template class StaticFieldIterator<FlowField, Stencils::VelocityStencil>;
+template class PostProjectionIterator<FlowField, Stencils::VelocityStencil, Stencils::ObstacleStencil,
+                                      Stencils::MaxUStencil>;
+} // namespace NSEOF
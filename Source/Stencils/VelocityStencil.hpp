@@ -4,12 +4,21 @@
 #include "Stencil.hpp"
 #include "FlowField.hpp"
 #include "Parameters.hpp"
+#include "Iterators.hpp"
+#include "Dimension.hpp"
+#include "ObstacleStencil.hpp"
+#include "MaxUStencil.hpp"
 
 namespace NSEOF::Stencils {
 
 /** Stencil to compute the velocity once the pressure has been found.
  */
-class VelocityStencil : public FieldStencil<FlowField> {
+class VelocityStencil final : public FieldStencil<FlowField> {
+private:
+    // The body of the 2D and 3D apply, see Dim
+    template <class D>
+    void apply_(FlowField& flowField, int i, int j, int k);
+
 public:
     explicit VelocityStencil(const Parameters& parameters);
     ~VelocityStencil() override = default;
@@ -20,4 +29,11 @@ public:
 
 } // namespace NSEOF::Stencils
 
+namespace NSEOF {
+// Instantiated in VelocityStencil.cpp, where the stencil body can be inlined into the loops
+extern template class StaticFieldIterator<FlowField, Stencils::VelocityStencil>;
+extern template class PostProjectionIterator<FlowField, Stencils::VelocityStencil, Stencils::ObstacleStencil,
+                                             Stencils::MaxUStencil>;
+} // namespace NSEOF
+
 #endif // __STENCILS_VELOCITY_STENCIL_HPP__
@@ -10,27 +10,27 @@ namespace NSEOF::Stencils {
      */
 
     void ViscosityBufferFillStencil::applyLeftWall(FlowField& flowField, int i, int j, int k) {
-        getBufferLeft().push_back(flowField.getEddyViscosity().getScalar(i + 1, j, k));
+        setNextInBufferLeft(flowField.getEddyViscosity().getScalar(i + 1, j, k));
     }
 
     void ViscosityBufferFillStencil::applyRightWall(FlowField& flowField, int i, int j, int k) {
-        getBufferRight().push_back(flowField.getEddyViscosity().getScalar(i - 1, j, k));
+        setNextInBufferRight(flowField.getEddyViscosity().getScalar(i - 1, j, k));
     }
 
     void ViscosityBufferFillStencil::applyBottomWall(FlowField& flowField, int i, int j, int k) {
-        getBufferBottom().push_back(flowField.getEddyViscosity().getScalar(i, j + 1, k));
+        setNextInBufferBottom(flowField.getEddyViscosity().getScalar(i, j + 1, k));
     }
 
     void ViscosityBufferFillStencil::applyTopWall(FlowField& flowField, int i, int j, int k) {
-        getBufferTop().push_back(flowField.getEddyViscosity().getScalar(i, j - 1, k));
+        setNextInBufferTop(flowField.getEddyViscosity().getScalar(i, j - 1, k));
     }
 
     void ViscosityBufferFillStencil::applyFrontWall(FlowField& flowField, int i, int j, int k) {
-        getBufferFront().push_back(flowField.getEddyViscosity().getScalar(i, j, k + 1));
+        setNextInBufferFront(flowField.getEddyViscosity().getScalar(i, j, k + 1));
     }
 
     void ViscosityBufferFillStencil::applyBackWall(FlowField& flowField, int i, int j, int k) {
-        getBufferBack().push_back(flowField.getEddyViscosity().getScalar(i, j, k - 1));
+        setNextInBufferBack(flowField.getEddyViscosity().getScalar(i, j, k - 1));
     }
 
     /**
@@ -69,11 +69,16 @@ FLOAT ViscosityStencil::calculateMixingLength_(FlowField& flowField, int i, int
 void ViscosityStencil::apply(FlowField& flowField, int i, int j) {
     FLOAT& eddyViscosity = flowField.getEddyViscosity().getScalar(i, j);
 
+    // A local velocity array that will be used to approximate the derivatives. It lives on the
+    // stack, so that every thread has its own. Size matches 3D cases but can be used for 2D as well.
+    FLOAT localVelocity[VALUES_DIMENSION]{};
+    FLOAT localMeshsize[VALUES_DIMENSION]{};
+
     // Compute strain tensor
-    loadLocalVelocity2D(flowField, localVelocity_, i, j);
-    loadLocalMeshsize2D(parameters_, localMeshsize_, i, j);
+    loadLocalVelocity2D(flowField, localVelocity, i, j);
+    loadLocalMeshsize2D(parameters_, localMeshsize, i, j);
 
-    FLOAT strain_tensor_squared = computeStrainTensorSquared2D(localVelocity_, localMeshsize_);
+    FLOAT strain_tensor_squared = computeStrainTensorSquared2D(localVelocity, localMeshsize);
 
     // Compute eddy viscosity
     const FLOAT mixingLength = calculateMixingLength_(flowField, i, j);
@@ -83,11 +88,14 @@ void ViscosityStencil::apply(FlowField& flowField, int i, int j) {
 void ViscosityStencil::apply(FlowField& flowField, int i, int j, int k) {
     FLOAT& eddyViscosity = flowField.getEddyViscosity().getScalar(i, j, k);
 
+    FLOAT localVelocity[VALUES_DIMENSION];
+    FLOAT localMeshsize[VALUES_DIMENSION];
+
     // Compute strain tensor
-    loadLocalVelocity3D(flowField, localVelocity_, i, j, k);
-    loadLocalMeshsize3D(parameters_, localMeshsize_, i, j, k);
+    loadLocalVelocity3D(flowField, localVelocity, i, j, k);
+    loadLocalMeshsize3D(parameters_, localMeshsize, i, j, k);
 
-    FLOAT strain_tensor_squared = computeStrainTensorSquared3D(localVelocity_, localMeshsize_);
+    FLOAT strain_tensor_squared = computeStrainTensorSquared3D(localVelocity, localMeshsize);
 
     // Compute eddy viscosity
     const FLOAT mixingLength = calculateMixingLength_(flowField, i, j, k);
@@ -95,3 +103,8 @@ void ViscosityStencil::apply(FlowField& flowField, int i, int j, int k) {
 }
 
 } // namespace NSEOF::Stencils
+
+namespace NSEOF {
+template class StaticFieldIterator<FlowField, Stencils::ViscosityStencil>;
+template class TiledFieldIterator<FlowField, Stencils::ViscosityStencil>;
+} // namespace NSEOF
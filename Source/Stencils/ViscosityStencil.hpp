@@ -4,6 +4,7 @@
 #include "Stencil.hpp"
 #include "FlowField.hpp"
 #include "Parameters.hpp"
+#include "Iterators.hpp"
 
 #define VALUES_DIMENSION 27 * 3
 
@@ -12,7 +13,7 @@ namespace NSEOF::Stencils {
 /**
  * Stencil to compute the turbulence/eddy viscosity for a chosen turbulence model
  */
-class ViscosityStencil : public FieldStencil<FlowField> {
+class ViscosityStencil final : public FieldStencil<FlowField> {
 private:
     const FLOAT VISCOSITY_CONSTANT;
     const FLOAT U0 = 1;
@@ -21,11 +22,6 @@ private:
     const FLOAT BOUNDARY_THICKNESS_MULTIPLIER;
     const FLOAT MIXING_LENGTH_MULTIPLIER = 0.09;
 
-	// A local velocity variable that will be used to approximate the derivative.
-    // Size matches 3D cases but can be used for 2D as well.
-	FLOAT localVelocity_[VALUES_DIMENSION];
-    FLOAT localMeshsize_[VALUES_DIMENSION];
-
     FLOAT calculateBoundaryThickness_(int, int, int);
     FLOAT calculateMixingLength_(FlowField&, int, int, int);
 public:
@@ -38,4 +34,10 @@ public:
 
 } // namespace NSEOF::Stencils
 
+namespace NSEOF {
+// Instantiated in ViscosityStencil.cpp, where the stencil body can be inlined into the loops
+extern template class StaticFieldIterator<FlowField, Stencils::ViscosityStencil>;
+extern template class TiledFieldIterator<FlowField, Stencils::ViscosityStencil>;
+} // namespace NSEOF
+
 #endif // __STENCILS_VISCOSITY_STENCIL_HPP__
@@ -0,0 +1,61 @@
+#ifndef __THREADING_HPP__
+#define __THREADING_HPP__
+
+#ifdef OMP
+#include <omp.h>
+#endif
+
+#include <unistd.h>
+
+namespace NSEOF {
+
+// Assumed size of a cache line. Per-thread accumulators are aligned to it, so that threads
+// updating neighbouring slots do not invalidate each other's cache lines.
+static constexpr int CACHE_LINE_SIZE = 64;
+
+/** Returns the size of the level 2 data cache in bytes, or a conservative guess of 256 KiB if the
+ *  system does not report it
+ */
+inline long getL2CacheSize() {
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    const long size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (size > 0) {
+        return size;
+    }
+#endif
+    return 256 * 1024;
+}
+
+/** Returns the number of threads a parallel region may use, or 1 in builds without OpenMP
+ */
+inline int getMaxThreads() {
+#ifdef OMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+/** Returns the number of threads in the current parallel region, or 1 outside of one
+ */
+inline int getNumThreads() {
+#ifdef OMP
+    return omp_get_num_threads();
+#else
+    return 1;
+#endif
+}
+
+/** Returns the index of the calling thread within its parallel region, or 0 outside of one
+ */
+inline int getThreadNum() {
+#ifdef OMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+} // namespace NSEOF
+
+#endif // __THREADING_HPP__
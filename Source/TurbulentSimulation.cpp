@@ -5,15 +5,34 @@ namespace NSEOF {
 TurbulentSimulation::TurbulentSimulation(Parameters& parameters, FlowField& flowField)
     : Simulation(parameters, flowField)
     , minTimeStepStencil_(parameters)
-    , minTimeStepIterator_(flowField, parameters, minTimeStepStencil_)
+    , minTimeStepIterator_(flowField, parameters, minTimeStepStencil_, 0, 0, true)
     , distanceStencil_(parameters, parameters.geometry.sizeX + 3, parameters.geometry.sizeY + 3, parameters.geometry.sizeZ + 3)
     , distanceIterator_(flowField, parameters, distanceStencil_)
     , viscosityStencil_(parameters)
-    , viscosityIterator_(flowField, parameters, viscosityStencil_)
+    , viscosityIterator_(parameters.kernels.tiling
+        ? static_cast<Iterator<FlowField>*>(new TiledFieldIterator<FlowField, Stencils::ViscosityStencil>(
+            flowField, parameters, viscosityStencil_, parameters.kernels.tileSizeX, parameters.kernels.tileSizeY, true))
+        : new StaticFieldIterator<FlowField, Stencils::ViscosityStencil>(flowField, parameters, viscosityStencil_, 0, 0, true))
     , turbulentPetscParallelManager_(parameters, flowField)
 {
-    fghStencil_  = new Stencils::TurbulentFGHStencil(parameters_);
-    fghIterator_ = new FieldIterator<FlowField>(flowField_, parameters_, *fghStencil_);
+    // Replace the laminar stencils created by the base class
+    delete fghIterator_;
+    delete fghRHSIterator_;
+    delete fghStencil_;
+    delete vtkIterator_;
+    delete vtkStencil_;
+
+    Stencils::TurbulentFGHStencil* const fghStencil = new Stencils::TurbulentFGHStencil(parameters_);
+    fghStencil_  = fghStencil;
+    if (parameters_.kernels.tiling) {
+        fghIterator_ = new TiledFieldIterator<FlowField, Stencils::TurbulentFGHStencil>(
+            flowField_, parameters_, *fghStencil, parameters_.kernels.tileSizeX, parameters_.kernels.tileSizeY, true);
+    } else {
+        fghIterator_ = new StaticFieldIterator<FlowField, Stencils::TurbulentFGHStencil>(flowField_, parameters_, *fghStencil,
+                                                                                         0, 0, true);
+    }
+    fghRHSIterator_ = new FusedFieldIterator<FlowField, Stencils::TurbulentFGHStencil, Stencils::RHSStencil>(
+        flowField_, parameters_, *fghStencil, rhsStencil_, wallFGHIterator_, true);
 
     vtkStencil_  = new Stencils::TurbulentVTKStencil(parameters_,
                                                      flowField_.getCellsX(), flowField_.getCellsY(), flowField_.getCellsZ());
@@ -49,7 +68,7 @@ void TurbulentSimulation::solveTimestep() {
     turbulentPetscParallelManager_.communicateDiagonalVelocity();
 
     // Compute eddy viscosities
-    viscosityIterator_.iterate();
+    viscosityIterator_->iterate();
 
     // Communicate viscosity values
     turbulentPetscParallelManager_.communicateViscosity();
@@ -17,13 +17,13 @@ namespace NSEOF {
 class TurbulentSimulation : public Simulation {
 private:
     Stencils::MinTimeStepStencil minTimeStepStencil_;
-    FieldIterator<FlowField> minTimeStepIterator_;
+    StaticFieldIterator<FlowField, Stencils::MinTimeStepStencil> minTimeStepIterator_;
 
     Stencils::DistanceStencil distanceStencil_;
     FieldIterator<FlowField> distanceIterator_;
 
     Stencils::ViscosityStencil viscosityStencil_;
-    FieldIterator<FlowField> viscosityIterator_;
+    std::unique_ptr<Iterator<FlowField>> viscosityIterator_; //! Tiled or not, depending on the kernel parameters
 
     ParallelManagers::TurbulentPetscParallelManager turbulentPetscParallelManager_;
 
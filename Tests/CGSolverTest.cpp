@@ -0,0 +1,73 @@
+#include "PressureSolverTestUtils.hpp"
+
+#include "Solvers/CGSolver.hpp"
+
+#include <string>
+
+/** Solves the discrete pressure equation for a right-hand side computed from a known pressure
+ *  and compares the result with it, with each preconditioner and with the plain and the
+ *  pipelined iteration, also around obstacles, whose faces the operator closes.
+ */
+
+using namespace PressureSolverTest;
+
+static constexpr FLOAT TOLERANCE = 1e-6;
+
+static bool testSolution(int dim, int size, Walls walls, bool obstacles, const std::string& preconditioner,
+                         const std::string& krylov) {
+    NSEOF::Parameters parameters;
+    initializeParameters(parameters, dim, size, walls);
+    parameters.solver.maxIterations = 2000;
+    parameters.solver.tolerance = 1e-12;
+    parameters.solver.preconditioner = preconditioner;
+    parameters.solver.krylov = krylov;
+    parameters.solver.timing = 0;
+
+    NSEOF::FlowField flowField(parameters);
+
+    // A step in the lower left corner, and a block in the interior that covers only some planes in 3D
+    if (obstacles) {
+        setObstacles(flowField, dim, [dim](int i, int j, int k) {
+            return (i <= 5 && j <= 7) || (i >= 9 && i <= 11 && j >= 10 && j <= 12 && (dim == 2 || (k >= 4 && k <= 6)));
+        });
+    }
+
+    const ExactPressure exact(flowField, parameters, walls);
+
+    NSEOF::Solvers::CGSolver solver(flowField, parameters);
+    solver.reInitMatrix();
+    solver.solve();
+
+    const FLOAT error = exact.getError();
+
+    std::cout << dim << "D, " << size << " cells, " << WALL_NAMES[walls] << (obstacles ? ", obstacles" : "") << ", "
+              << krylov << ", " << preconditioner << ": maximum error " << error << std::endl;
+
+    return error < TOLERANCE;
+}
+
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+    std::cout << "Testing the CG solver" << std::endl;
+
+    bool passed = true;
+    for (int dim = 2; dim <= 3; dim++) {
+        for (const std::string krylov : {"cg", "pipecg"}) {
+            for (const std::string preconditioner : {"jacobi", "ssor", "chebyshev"}) {
+                for (int obstacles = 0; obstacles < 2; obstacles++) {
+                    passed = testSolution(dim, 16, CLOSED, obstacles, preconditioner, krylov) && passed;
+                    passed = testSolution(dim, 13, OUTFLOW, obstacles, preconditioner, krylov) && passed;
+                }
+            }
+        }
+    }
+
+    MPI_Finalize();
+
+    if (!passed) {
+        std::cerr << "CG solution does not match the exact pressure" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,53 @@
+#include "PressureSolverTestUtils.hpp"
+
+#include "Solvers/FastPoissonSolver.hpp"
+
+/** Solves the discrete pressure equation for a right-hand side computed from a known pressure
+ *  and compares the result with it, ghost cells across the walls included, for walls of both
+ *  kinds, periodic x and a mesh stretched in y.
+ */
+
+using namespace PressureSolverTest;
+
+static constexpr FLOAT TOLERANCE = 1e-9;
+
+static bool testSolution(int dim, int size, Walls walls, bool stretched = false) {
+    NSEOF::Parameters parameters;
+    initializeParameters(parameters, dim, size, walls, stretched);
+
+    NSEOF::FlowField flowField(parameters);
+    const ExactPressure exact(flowField, parameters, walls);
+
+    NSEOF::Solvers::FastPoissonSolver solver(flowField, parameters);
+    solver.reInitMatrix();
+    solver.solve();
+
+    const FLOAT error = exact.getError(true);
+
+    std::cout << dim << "D, " << size << " cells, " << WALL_NAMES[walls] << (stretched ? ", stretched y" : "")
+              << ": maximum error " << error << std::endl;
+
+    return error < TOLERANCE;
+}
+
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+    std::cout << "Testing the fast Poisson solver" << std::endl;
+
+    bool passed = true;
+    for (int dim = 2; dim <= 3; dim++) {
+        passed = testSolution(dim, 16, CLOSED) && passed;
+        passed = testSolution(dim, 13, OUTFLOW) && passed;
+        passed = testSolution(dim, 12, PERIODIC_X) && passed;
+        passed = testSolution(dim, 15, CLOSED, true) && passed;
+    }
+
+    MPI_Finalize();
+
+    if (!passed) {
+        std::cerr << "Fast Poisson solution does not match the exact pressure" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+#include "PressureSolverTestUtils.hpp"
+
+#include "Solvers/MultigridSolver.hpp"
+
+#include <string>
+
+/** Solves the discrete pressure equation for a right-hand side computed from a known pressure
+ *  and compares the result with it, in double and in mixed precision, with point and line
+ *  smoothing, the latter also on a mesh stretched towards the bottom and top walls. Periodic x
+ *  and obstacles are covered as well; there, the residual and the pressure the solver leaves in
+ *  the obstacle cells are checked, too.
+ */
+
+using namespace PressureSolverTest;
+
+static constexpr FLOAT TOLERANCE = 1e-6;
+static constexpr FLOAT RESIDUAL_TOLERANCE = 1e-8;
+static constexpr FLOAT OBSTACLE_TOLERANCE = 1e-12;
+
+static bool testSolution(int dim, int size, Walls walls, bool mixed, const std::string& smoother, bool stretched = false,
+                         bool obstacles = false) {
+    NSEOF::Parameters parameters;
+    initializeParameters(parameters, dim, size, walls, stretched);
+    parameters.solver.maxIterations = 50;
+    parameters.solver.tolerance = 1e-10;
+    parameters.solver.cycle = "V";
+    parameters.solver.preSmoothing = 2;
+    parameters.solver.postSmoothing = 2;
+    parameters.solver.smoother = smoother;
+    parameters.solver.mixedPrecision = mixed;
+
+    NSEOF::FlowField flowField(parameters);
+
+    // A step in the lower left corner, and a block in the interior that covers only some planes in 3D
+    if (obstacles) {
+        setObstacles(flowField, dim, [dim](int i, int j, int k) {
+            return (i <= 5 && j <= 7) || (i >= 9 && i <= 11 && j >= 10 && j <= 12 && (dim == 2 || (k >= 4 && k <= 6)));
+        });
+    }
+
+    const ExactPressure exact(flowField, parameters, walls);
+
+    NSEOF::Solvers::MultigridSolver solver(flowField, parameters);
+    solver.reInitMatrix();
+    solver.solve();
+
+    const FLOAT error = exact.getError();
+    const FLOAT residual = exact.getResidual();
+    const FLOAT obstacleError = exact.getObstacleError();
+
+    std::cout << dim << "D, " << size << " cells, " << WALL_NAMES[walls] << (obstacles ? ", obstacles" : "")
+              << (mixed ? ", mixed precision" : "") << ", " << smoother << " smoother" << (stretched ? ", stretched" : "")
+              << ": maximum error " << error << ", residual " << residual << ", obstacle error " << obstacleError << std::endl;
+
+    return error < TOLERANCE && residual < RESIDUAL_TOLERANCE && obstacleError < OBSTACLE_TOLERANCE;
+}
+
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+    std::cout << "Testing the multigrid solver" << std::endl;
+
+    bool passed = true;
+    for (int dim = 2; dim <= 3; dim++) {
+        for (int mixed = 0; mixed < 2; mixed++) {
+            for (const std::string smoother : {"point", "line"}) {
+                passed = testSolution(dim, 16, CLOSED, mixed, smoother) && passed;
+                passed = testSolution(dim, 13, OUTFLOW, mixed, smoother) && passed;
+                passed = testSolution(dim, 12, PERIODIC_X, mixed, smoother) && passed;
+                passed = testSolution(dim, 16, CLOSED, mixed, smoother, false, true) && passed;
+                passed = testSolution(dim, 13, OUTFLOW, mixed, smoother, false, true) && passed;
+            }
+            passed = testSolution(dim, 16, CLOSED, mixed, "line", true) && passed;
+            passed = testSolution(dim, 13, OUTFLOW, mixed, "line", true) && passed;
+        }
+    }
+
+    MPI_Finalize();
+
+    if (!passed) {
+        std::cerr << "Multigrid solution does not match the exact pressure" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,321 @@
+#ifndef __TESTS_PRESSURE_SOLVER_TEST_UTILS_HPP__
+#define __TESTS_PRESSURE_SOLVER_TEST_UTILS_HPP__
+
+#include "FlowField.hpp"
+#include "MeshsizeFactory.hpp"
+
+#include <math.h>
+#include <vector>
+
+/** Shared setup of the pressure solver tests: a sequential domain, a known pressure and the
+ *  right-hand side that belongs to it under the operator of the SORSolver
+ */
+namespace PressureSolverTest {
+
+/** Boundaries of the test domain: walls with a velocity condition all around, with an outflow wall
+ *  on the right instead, or periodic in x
+ */
+enum Walls { CLOSED, OUTFLOW, PERIODIC_X };
+
+static const char* const WALL_NAMES[] = {"closed", "outflow", "periodic x"};
+
+/** Sets up a single process with size x (size + 3) x (size - 2) cells (size x (size + 3) in 2D) on
+ *  a domain of 1 x 2 x 1, optionally stretched towards the bottom and top walls. The solver
+ *  parameters are left to the test.
+ */
+inline void initializeParameters(NSEOF::Parameters& parameters, int dim, int size, Walls walls, bool stretchedY = false) {
+    parameters.geometry.dim = dim;
+    parameters.geometry.sizeX = size;
+    parameters.geometry.sizeY = size + 3;
+    parameters.geometry.sizeZ = dim == 3 ? size - 2 : 1;
+    parameters.geometry.lengthX = 1.0;
+    parameters.geometry.lengthY = 2.0;
+    parameters.geometry.lengthZ = 1.0;
+    parameters.geometry.meshsizeType = stretchedY ? NSEOF::TanhStretching : NSEOF::Uniform;
+    parameters.geometry.stretchX = 0;
+    parameters.geometry.stretchY = stretchedY;
+    parameters.geometry.stretchZ = 0;
+
+    const int sizes[3] = {parameters.geometry.sizeX, parameters.geometry.sizeY, parameters.geometry.sizeZ};
+    for (int d = 0; d < 3; d++) {
+        parameters.parallel.localSize[d] = sizes[d];
+        parameters.parallel.firstCorner[d] = 0;
+        parameters.parallel.numProcessors[d] = 1;
+        parameters.parallel.indices[d] = 0;
+    }
+
+    parameters.parallel.rank = 0;
+    parameters.parallel.leftNb = MPI_PROC_NULL;
+    parameters.parallel.rightNb = MPI_PROC_NULL;
+    parameters.parallel.bottomNb = MPI_PROC_NULL;
+    parameters.parallel.topNb = MPI_PROC_NULL;
+    parameters.parallel.frontNb = MPI_PROC_NULL;
+    parameters.parallel.backNb = MPI_PROC_NULL;
+
+    parameters.walls.typeLeft = walls == PERIODIC_X ? NSEOF::PERIODIC : NSEOF::DIRICHLET;
+    parameters.walls.typeRight = walls == PERIODIC_X ? NSEOF::PERIODIC : (walls == OUTFLOW ? NSEOF::NEUMANN : NSEOF::DIRICHLET);
+    parameters.walls.typeBottom = NSEOF::DIRICHLET;
+    parameters.walls.typeTop = NSEOF::DIRICHLET;
+    parameters.walls.typeFront = NSEOF::DIRICHLET;
+    parameters.walls.typeBack = NSEOF::DIRICHLET;
+    parameters.kernels.hugePages = false;
+
+    NSEOF::MeshsizeFactory::getInstance().initMeshsize(parameters);
+}
+
+/** Turns the inner cells for which isObstacle(i, j, k) holds into obstacle cells and sets the
+ *  neighbour flags of all inner cells to match. In 2D, k is 2.
+ */
+template <class Predicate>
+inline void setObstacles(NSEOF::FlowField& flowField, int dim, Predicate isObstacle) {
+    NSEOF::IntScalarField& flags = flowField.getFlags();
+    const int nx = flowField.getNx(), ny = flowField.getNy(), nz = dim == 3 ? flowField.getNz() : 1;
+    const int lastZ = dim == 3 ? nz + 1 : 2;
+
+    auto obstacle = [&](int i, int j, int k) {
+        return i >= 2 && i <= nx + 1 && j >= 2 && j <= ny + 1 && k >= 2 && k <= lastZ && isObstacle(i, j, k);
+    };
+
+    for (int k = 2; k <= lastZ; k++) {
+        for (int j = 2; j <= ny + 1; j++) {
+            for (int i = 2; i <= nx + 1; i++) {
+                int flag = (obstacle(i, j, k) ? NSEOF::OBSTACLE_SELF : 0)
+                         | (obstacle(i - 1, j, k) ? NSEOF::OBSTACLE_LEFT : 0)
+                         | (obstacle(i + 1, j, k) ? NSEOF::OBSTACLE_RIGHT : 0)
+                         | (obstacle(i, j - 1, k) ? NSEOF::OBSTACLE_BOTTOM : 0)
+                         | (obstacle(i, j + 1, k) ? NSEOF::OBSTACLE_TOP : 0);
+                if (dim == 3) {
+                    flag |= (obstacle(i, j, k - 1) ? NSEOF::OBSTACLE_FRONT : 0)
+                          | (obstacle(i, j, k + 1) ? NSEOF::OBSTACLE_BACK : 0);
+                    flags.getValue(i, j, k) = flag;
+                } else {
+                    flags.getValue(i, j) = flag;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Known pressure of a test, which also sets the right-hand side of the flow field to its discrete
+ * Laplacian with the coefficients of the SORSolver. Ghost cells follow the boundary conditions of
+ * the solvers: copies of the inner cell at walls with a velocity condition, negated at outflow
+ * walls, and copies of the opposite side at periodic walls. Faces towards obstacle cells are
+ * closed, so the obstacles have to be set before.
+ */
+class ExactPressure {
+private:
+    NSEOF::FlowField& flowField_;
+    const int dim_;
+    const Walls walls_;
+    const int nx_, ny_, nz_;
+    const int lastZ_;
+    std::vector<FLOAT> values_; //! On (nx + 3) x (ny + 3) x (nz + 3) cells, with ghost cells
+    const FLOAT* centre_[3];
+
+    int index_(int i, int j, int k) const { return i + (nx_ + 3) * (j + (ny_ + 3) * k); }
+
+    bool isObstacle_(int i, int j, int k) const {
+        if (i < 2 || i > nx_ + 1 || j < 2 || j > ny_ + 1 || k < 2 || k > lastZ_) {
+            return false;
+        }
+        const int flag = dim_ == 3 ? flowField_.getFlags().getValue(i, j, k) : flowField_.getFlags().getValue(i, j);
+        return (flag & NSEOF::OBSTACLE_SELF) != 0;
+    }
+
+    FLOAT getPressure_(int i, int j, int k) const {
+        return dim_ == 3 ? flowField_.getPressure().getScalar(i, j, k) : flowField_.getPressure().getScalar(i, j);
+    }
+
+    FLOAT getRHS_(int i, int j, int k) const {
+        return dim_ == 3 ? flowField_.getRHS().getScalar(i, j, k) : flowField_.getRHS().getScalar(i, j);
+    }
+
+    /** Discrete Laplacian of value(i, j, k) in the fluid cell (i, j, k), with the coefficients of
+     *  the SORSolver. A closed face has no flux, as if the neighbour had the value of the cell.
+     */
+    template <class Value>
+    FLOAT getLaplacian_(int i, int j, int k, Value value) const {
+        const int position[3] = {i, j, k};
+        const FLOAT centreValue = value(i, j, k);
+        FLOAT laplacian = 0.0;
+
+        for (int d = 0; d < dim_; d++) {
+            int low[3] = {i, j, k}, high[3] = {i, j, k};
+            low[d]--;
+            high[d]++;
+
+            const FLOAT dLow = centre_[d][position[d] - 1];
+            const FLOAT dHigh = centre_[d][position[d]];
+            const FLOAT lowValue = isObstacle_(low[0], low[1], low[2]) ? centreValue : value(low[0], low[1], low[2]);
+            const FLOAT highValue = isObstacle_(high[0], high[1], high[2]) ? centreValue : value(high[0], high[1], high[2]);
+            laplacian += 2.0 * (lowValue / (dLow * (dLow + dHigh)) + highValue / (dHigh * (dLow + dHigh))
+                              - centreValue / (dLow * dHigh));
+        }
+
+        return laplacian;
+    }
+
+public:
+    ExactPressure(NSEOF::FlowField& flowField, const NSEOF::Parameters& parameters, Walls walls)
+        : flowField_(flowField)
+        , dim_(parameters.geometry.dim)
+        , walls_(walls)
+        , nx_(flowField.getNx())
+        , ny_(flowField.getNy())
+        , nz_(dim_ == 3 ? flowField.getNz() : 1)
+        , lastZ_(dim_ == 3 ? nz_ + 1 : 2)
+        , values_((nx_ + 3) * (ny_ + 3) * (nz_ + 3), 0.0) {
+        for (int k = 2; k <= lastZ_; k++) {
+            for (int j = 2; j <= ny_ + 1; j++) {
+                for (int i = 2; i <= nx_ + 1; i++) {
+                    values_[index_(i, j, k)] = sin(0.7 * i) * cos(0.3 * j) + 0.1 * k * k;
+                }
+            }
+        }
+
+        for (int k = 2; k <= lastZ_; k++) {
+            for (int j = 2; j <= ny_ + 1; j++) {
+                if (walls == PERIODIC_X) {
+                    values_[index_(1, j, k)] = values_[index_(nx_ + 1, j, k)];
+                    values_[index_(nx_ + 2, j, k)] = values_[index_(2, j, k)];
+                } else {
+                    values_[index_(1, j, k)] = values_[index_(2, j, k)];
+                    values_[index_(nx_ + 2, j, k)] = (walls == OUTFLOW ? -1.0 : 1.0) * values_[index_(nx_ + 1, j, k)];
+                }
+            }
+            for (int i = 2; i <= nx_ + 1; i++) {
+                values_[index_(i, 1, k)] = values_[index_(i, 2, k)];
+                values_[index_(i, ny_ + 2, k)] = values_[index_(i, ny_ + 1, k)];
+            }
+        }
+        if (dim_ == 3) {
+            for (int j = 2; j <= ny_ + 1; j++) {
+                for (int i = 2; i <= nx_ + 1; i++) {
+                    values_[index_(i, j, 1)] = values_[index_(i, j, 2)];
+                    values_[index_(i, j, nz_ + 2)] = values_[index_(i, j, nz_ + 1)];
+                }
+            }
+        }
+
+        for (int d = 0; d < 3; d++) {
+            centre_[d] = d < dim_ ? parameters.meshMetrics->getCentreSpacing(d) : NULL;
+        }
+
+        auto value = [this](int i, int j, int k) { return values_[index_(i, j, k)]; };
+
+        NSEOF::ScalarField& rhs = flowField.getRHS();
+        for (int k = 2; k <= lastZ_; k++) {
+            for (int j = 2; j <= ny_ + 1; j++) {
+                for (int i = 2; i <= nx_ + 1; i++) {
+                    const FLOAT laplacian = isObstacle_(i, j, k) ? 0.0 : getLaplacian_(i, j, k, value);
+
+                    if (dim_ == 3) {
+                        rhs.getScalar(i, j, k) = laplacian;
+                    } else {
+                        rhs.getScalar(i, j) = laplacian;
+                    }
+                }
+            }
+        }
+    }
+
+    /** Maximum error of the pressure of the flow field in the fluid cells, and with ghostCells also
+     *  in the ghost cells across the walls. Without an outflow wall, the pressure is only determined
+     *  up to a constant, which is taken out first.
+     */
+    FLOAT getError(bool ghostCells = false) const {
+        FLOAT shift = 0.0;
+        if (walls_ != OUTFLOW) {
+            int cells = 0;
+            for (int k = 2; k <= lastZ_; k++) {
+                for (int j = 2; j <= ny_ + 1; j++) {
+                    for (int i = 2; i <= nx_ + 1; i++) {
+                        if (!isObstacle_(i, j, k)) {
+                            shift += getPressure_(i, j, k) - values_[index_(i, j, k)];
+                            cells++;
+                        }
+                    }
+                }
+            }
+            shift /= cells;
+        }
+
+        const int layer = ghostCells ? 1 : 0;
+        FLOAT error = 0.0;
+        for (int k = dim_ == 3 ? 2 - layer : 2; k <= (dim_ == 3 ? lastZ_ + layer : 2); k++) {
+            for (int j = 2 - layer; j <= ny_ + 1 + layer; j++) {
+                for (int i = 2 - layer; i <= nx_ + 1 + layer; i++) {
+                    // The solvers leave the ghost cells along edges and corners alone
+                    const int outside = (i == 1 || i == nx_ + 2) + (j == 1 || j == ny_ + 2) + (dim_ == 3 && (k == 1 || k == nz_ + 2));
+                    if (outside > 1 || (outside == 0 && isObstacle_(i, j, k))) {
+                        continue;
+                    }
+                    error = std::max(error, fabs(getPressure_(i, j, k) - shift - values_[index_(i, j, k)]));
+                }
+            }
+        }
+
+        return error;
+    }
+
+    /** Maximum residual of the pressure equation for the pressure of the flow field in the fluid
+     *  cells, relative to the maximum of the right-hand side. The ghost cells are taken as the
+     *  solver left them.
+     */
+    FLOAT getResidual() const {
+        auto pressure = [this](int i, int j, int k) { return getPressure_(i, j, k); };
+        FLOAT residual = 0.0, rhs = 0.0;
+
+        for (int k = 2; k <= lastZ_; k++) {
+            for (int j = 2; j <= ny_ + 1; j++) {
+                for (int i = 2; i <= nx_ + 1; i++) {
+                    if (!isObstacle_(i, j, k)) {
+                        residual = std::max(residual, fabs(getRHS_(i, j, k) - getLaplacian_(i, j, k, pressure)));
+                        rhs = std::max(rhs, fabs(getRHS_(i, j, k)));
+                    }
+                }
+            }
+        }
+
+        return residual / rhs;
+    }
+
+    /** Maximum deviation of the pressure in the obstacle cells from the mean of their neighbours
+     *  that are not obstacles, ghost cells included, which the solvers are expected to set
+     */
+    FLOAT getObstacleError() const {
+        FLOAT error = 0.0;
+
+        for (int k = 2; k <= lastZ_; k++) {
+            for (int j = 2; j <= ny_ + 1; j++) {
+                for (int i = 2; i <= nx_ + 1; i++) {
+                    if (!isObstacle_(i, j, k)) {
+                        continue;
+                    }
+
+                    const int neighbours[6][3] = {{i - 1, j, k}, {i + 1, j, k}, {i, j - 1, k}, {i, j + 1, k}, {i, j, k - 1}, {i, j, k + 1}};
+                    FLOAT sum = 0.0;
+                    int fluidNeighbours = 0;
+
+                    for (int n = 0; n < 2 * dim_; n++) {
+                        const int* const neighbour = neighbours[n];
+                        if (!isObstacle_(neighbour[0], neighbour[1], neighbour[2])) {
+                            sum += getPressure_(neighbour[0], neighbour[1], neighbour[2]);
+                            fluidNeighbours++;
+                        }
+                    }
+
+                    const FLOAT mean = fluidNeighbours > 0 ? sum / fluidNeighbours : 0.0;
+                    error = std::max(error, fabs(getPressure_(i, j, k) - mean));
+                }
+            }
+        }
+
+        return error;
+    }
+};
+
+} // namespace PressureSolverTest
+
+#endif // __TESTS_PRESSURE_SOLVER_TEST_UTILS_HPP__
@@ -4,10 +4,16 @@ constexpr auto SIZE_X = 10;
 constexpr auto SIZE_Y = 10;
 constexpr auto SIZE_Z = 10;
 
-bool compareVectorsFails(FLOAT* v1, FLOAT* v2, int dim = 2) {
+bool compareVectorsFails(FLOAT* v1, NSEOF::VectorField& field, int i, int j, int k = 0, int dim = 2) {
     ASSERTION((dim == 2) || (dim == 3));
-    for (int i = 0; i < dim; i++) {
-        if (v1[i] != v2[i]) {
+    for (int component = 0; component < dim; component++) {
+        if (v1[component] != field.getComponent(component, i, j, k)) {
+            return true;
+        }
+
+        // The raw component pointer has to address the same value in any layout
+        const FLOAT* const data = field.getComponentData(component);
+        if (data[field.getComponentStride() * field.index2cell(i, j, k)] != v1[component]) {
             return true;
         }
     }
@@ -37,14 +43,14 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
     for (int i = 0; i < SIZE_X; i++){
         for (int j = 0; j < SIZE_Y; j++) {
             setEntry(entry, d2counter);
-            vfield2D.getVector(i, j)[0] = entry[0];
-            vfield2D.getVector(i, j)[1] = entry[1];
+            vfield2D.getComponent(0, i, j) = entry[0];
+            vfield2D.getComponent(1, i, j) = entry[1];
             d2counter ++;
             for (int k = 0; k < SIZE_Z; k++) {
                 setEntry(entry, d3counter, 3);
-                vfield3D.getVector(i, j, k)[0] = entry[0];
-                vfield3D.getVector(i, j, k)[1] = entry[1];
-                vfield3D.getVector(i, j, k)[2] = entry[2];
+                vfield3D.getComponent(0, i, j, k) = entry[0];
+                vfield3D.getComponent(1, i, j, k) = entry[1];
+                vfield3D.getComponent(2, i, j, k) = entry[2];
                 d3counter ++;
             }
         }
@@ -57,7 +63,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
     for (int i = 0; i < SIZE_X; i++) {
         for (int j = 0; j < SIZE_Y; j++) {
             setEntry(entry, d2counter);
-            if (compareVectorsFails(entry, vfield2D.getVector(i, j))) {
+            if (compareVectorsFails(entry, vfield2D, i, j)) {
                 std::cerr << "Test for 2D vector failed" << std::endl;
                 return EXIT_FAILURE;
             }
@@ -65,7 +71,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
 
             for (int k = 0; k < SIZE_Z; k++) {
                 setEntry(entry, d3counter, 3);
-                if (compareVectorsFails(entry, vfield3D.getVector (i, j, k), 3)) {
+                if (compareVectorsFails(entry, vfield3D, i, j, k, 3)) {
                     std::cerr << "Test for 3D vector failed" << std::endl;
                     return EXIT_FAILURE;
                 }